@@ -157,7 +157,7 @@ tOplkError processSync(void)
 {
     tOplkError      ret = kErrorOk;
 
-    if (oplk_waitSyncEvent(100000) != kErrorOk)
+    if (oplk_waitSyncEvent(100000, NULL) != kErrorOk)
         return ret;
 
     ret = oplk_exchangeProcessImageOut();
@@ -171,7 +171,7 @@ tOplkError processSync(void)
     tOplkError          ret = kErrorOk;
     int                 i;
 
-    if (oplk_waitSyncEvent(100000) != kErrorOk)
+    if (oplk_waitSyncEvent(100000, NULL) != kErrorOk)
         return ret;
 
     ret = oplk_exchangeProcessImageOut();
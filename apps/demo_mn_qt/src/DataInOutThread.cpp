@@ -255,7 +255,7 @@ void DataInOutThread::run()
 
     for (;;)
     {
-        oplk_waitSyncEvent(0);
+        oplk_waitSyncEvent(0, NULL);
         ret = processSync();
         if (ret != kErrorOk)
         {
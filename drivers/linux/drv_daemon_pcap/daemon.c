@@ -62,6 +62,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 #define SET_CPU_AFFINITY
 #define MAIN_THREAD_PRIORITY            20
+#define MAIN_LOOP_PERIOD_US             1000
 
 //------------------------------------------------------------------------------
 // module global vars
@@ -120,6 +121,8 @@ int  main (int argc, char **argv)
 
 	struct sched_param          schedParam;
     int                         opt;
+    ULONGLONG                   deadline;
+    ULONGLONG                   now;
 
     /* get command line parameters */
     while ((opt = getopt(argc, argv, "l:")) != -1)
@@ -177,9 +180,14 @@ int  main (int argc, char **argv)
     PRINTF ("Running...\n");
 
     fExit = FALSE;
+    deadline = target_getTickCountUs();
     while (!fExit)
     {
-        target_msleep(1);
+        deadline += MAIN_LOOP_PERIOD_US;
+        now = target_getTickCountUs();
+        if (deadline < now)
+            deadline = now;         // skip periods missed during long processing
+        target_sleepUntil(deadline);
         if( console_kbhit() )
         {
             cKey = (BYTE)console_getch();
@@ -43,6 +43,9 @@ SET(COMMON_WINDOWS_SOURCES
 
 SET(COMMON_LINUXUSER_SOURCES
     ${ARCH_SOURCE_DIR}/linux/ftracedebug.c
+    ${ARCH_SOURCE_DIR}/linux/mempool.c
+    ${ARCH_SOURCE_DIR}/linux/shmem.c
+    ${ARCH_SOURCE_DIR}/linux/tracering.c
     ${CONTRIB_SOURCE_DIR}/trace/trace-printf.c
     )
 
@@ -58,6 +61,10 @@ SET(COMMON_CAL_DIRECT_SOURCES
     ${COMMON_SOURCE_DIR}/dll/dllcal-direct.c
     )
 
+SET(COMMON_CAL_LOCKFREE_SOURCES
+    ${COMMON_SOURCE_DIR}/dll/dllcal-lockfree.c
+    )
+
 ################################################################################
 # Application library (User) sources
 ################################################################################
@@ -99,6 +106,13 @@ SET(USER_SOURCES
     ${USER_SOURCE_DIR}/ledu.c
     )
 
+################################################################################
+# User LED output task sources
+
+SET(USER_LEDU_LINUXUSER_SOURCES
+    ${USER_SOURCE_DIR}/ledutask-linux.c
+    )
+
 ################################################################################
 # User control CAL sources
 
@@ -172,7 +186,7 @@ SET(PDO_UCAL_LOCAL_SOURCES
 
 SET(PDO_UCAL_POSIX_SOURCES
     ${USER_SOURCE_DIR}/pdo/pdoucalmem-posixshm.c
-    ${USER_SOURCE_DIR}/pdo/pdoucalsync-bsdsem.c
+    ${USER_SOURCE_DIR}/pdo/pdoucalsync-futex.c
     )
 
 SET(PDO_UCAL_LINUXMMAPIOCTL_SOURCES
@@ -203,6 +217,13 @@ SET(KERNEL_SOURCES
     ${KERNEL_SOURCE_DIR}/ctrl/ctrlk.c
     )
 
+################################################################################
+# Kernel DLL TPDO worker sources
+
+SET(DLL_KERNEL_TPDOWORKER_LINUXUSER_SOURCES
+    ${KERNEL_SOURCE_DIR}/dll/dllktpdoworker-linux.c
+    )
+
 ################################################################################
 # Control DLL CAL sources
 
@@ -274,7 +295,7 @@ SET(PDO_KCAL_LOCAL_SOURCES
 
 SET(PDO_KCAL_POSIXMEM_SOURCES
     ${KERNEL_SOURCE_DIR}/pdo/pdokcalmem-posixshm.c
-    ${KERNEL_SOURCE_DIR}/pdo/pdokcalsync-bsdsem.c
+    ${KERNEL_SOURCE_DIR}/pdo/pdokcalsync-futex.c
     )
 
 SET(PDO_KCAL_LINUXKERNEL_SOURCES
@@ -379,10 +400,12 @@ SET(TARGET_MICROBLAZE_SOURCES
 
 SET(ARCH_X86_SOURCES
     ${COMMON_SOURCE_DIR}/ami/amix86.c
+    ${COMMON_SOURCE_DIR}/ami/amibulk.c
     )
 
 SET(ARCH_LE_SOURCES
     ${COMMON_SOURCE_DIR}/ami/amile.c
+    ${COMMON_SOURCE_DIR}/ami/amibulk.c
     )
 
 ################################################################################
@@ -403,7 +426,9 @@ SET(OPLK_HEADERS
     ${STACK_INCLUDE_DIR}/oplk/frame.h
     ${STACK_INCLUDE_DIR}/oplk/oplkinc.h
     ${STACK_INCLUDE_DIR}/oplk/targetsystem.h
+    ${STACK_INCLUDE_DIR}/oplk/thread.h
     ${STACK_INCLUDE_DIR}/oplk/timer.h
+    ${STACK_INCLUDE_DIR}/oplk/tracering.h
     ${STACK_INCLUDE_DIR}/oplk/version.h
     ${STACK_INCLUDE_DIR}/oplk/event.h
     ${STACK_INCLUDE_DIR}/oplk/ftracedebug.h
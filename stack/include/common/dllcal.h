@@ -58,6 +58,20 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_DLLCAL_BUFFER_SIZE_TX_SYNC  8192
 #endif
 
+// number of frame slots of the lock-free queues (must be a power of 2, 0 derives
+// the slot count from the corresponding CONFIG_DLLCAL_BUFFER_SIZE_TX_* budget)
+#ifndef CONFIG_DLLCAL_SLOT_COUNT_TX_NMT
+#define CONFIG_DLLCAL_SLOT_COUNT_TX_NMT    0
+#endif
+
+#ifndef CONFIG_DLLCAL_SLOT_COUNT_TX_GEN
+#define CONFIG_DLLCAL_SLOT_COUNT_TX_GEN    0
+#endif
+
+#ifndef CONFIG_DLLCAL_SLOT_COUNT_TX_SYNC
+#define CONFIG_DLLCAL_SLOT_COUNT_TX_SYNC   0
+#endif
+
 /* setup interface getting function for DLLCAL queue */
 #if (CONFIG_DLLCAL_QUEUE == DIRECT_QUEUE)
 #define GET_DLLKCAL_INTERFACE dllcaldirect_getInterface
@@ -71,6 +85,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #elif (CONFIG_DLLCAL_QUEUE == CIRCBUF_QUEUE)
 #define GET_DLLKCAL_INTERFACE dllkcalcircbuf_getInterface
 #define GET_DLLUCAL_INTERFACE dllucalcircbuf_getInterface
+#elif (CONFIG_DLLCAL_QUEUE == LOCKFREE_QUEUE)
+#define GET_DLLKCAL_INTERFACE dllcallockfree_getInterface
+#define GET_DLLUCAL_INTERFACE dllcallockfree_getInterface
 #else
 #error "Unsupported DLLCAL_QUEUE"
 #endif
@@ -137,6 +154,7 @@ tDllCalFuncIntf* dllcalshb_getInterface(void);
 tDllCalFuncIntf* dllcalioctl_getInterface(void);
 tDllCalFuncIntf* dllucalcircbuf_getInterface(void);
 tDllCalFuncIntf* dllkcalcircbuf_getInterface(void);
+tDllCalFuncIntf* dllcallockfree_getInterface(void);
 
 #ifdef __cplusplus
 }
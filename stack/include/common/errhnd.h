@@ -72,6 +72,34 @@ typedef struct
 #endif
 } tErrHndObjects;
 
+/**
+\brief Shared error handler memory
+
+The structure describes the layout of the shared memory region which is used
+by the posix shared memory CAL modules of the error handler. The sequence
+counter protects the error objects like a seqlock. Only the kernel layer writes
+the error objects, the counter is odd while it modifies them. The user layer
+can take a consistent snapshot of all objects without blocking the kernel layer.
+*/
+typedef struct
+{
+    volatile UINT32     sequence;                   ///< Sequence counter, odd while a write is in progress
+    UINT32              reserved;                   ///< Reserved, keeps the error objects 64 bit aligned
+    tErrHndObjects      errorObjects;               ///< Error objects
+} tErrHndShmRegion;
+
+/**
+\brief Error object write request
+
+The structure is used by the user layer to request the write of an error
+object from the kernel layer (\ref kEventTypeErrhndWrite).
+*/
+typedef struct
+{
+    UINT32              offset;                     ///< Offset of the object in the error objects
+    UINT32              value;                      ///< Value to write
+} tErrHndObjectWrite;
+
 
 //------------------------------------------------------------------------------
 // function prototypes
@@ -0,0 +1,102 @@
+/**
+********************************************************************************
+\file   mempool.h
+
+\brief  Definitions for the memory pool module
+
+This file contains the definitions for the memory pool module. The module
+provides fixed-size block pools which are allocated at stack initialization.
+If CONFIG_MEMPOOL is enabled, OPLK_MALLOC() and OPLK_FREE() are served from the
+pools on Linux userspace.
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2014, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+#ifndef _INC_mempool_H_
+#define _INC_mempool_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <oplk/oplkinc.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define MEMPOOL_CLASS_COUNT     6       // number of block size classes
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+/**
+\brief Memory pool class statistics
+
+The structure contains the statistics of a block size class.
+*/
+typedef struct
+{
+    size_t          blockSize;          ///< Size of the blocks of the class
+    UINT32          blockCount;         ///< Number of blocks of the class
+    UINT32          usedCount;          ///< Number of currently allocated blocks
+    UINT32          peakCount;          ///< Maximum number of allocated blocks
+    UINT32          exhaustedCount;     ///< Number of allocations which found the class empty
+} tMempoolClassStatistics;
+
+/**
+\brief Memory pool statistics
+
+The structure contains the statistics of the memory pool module.
+*/
+typedef struct
+{
+    tMempoolClassStatistics aClass[MEMPOOL_CLASS_COUNT];    ///< Statistics of the block size classes
+    UINT32          heapAllocCount;     ///< Number of allocations served from the heap
+    UINT32          heapViolationCount; ///< Number of heap allocations requested in operational state
+} tMempoolStatistics;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+tOplkError mempool_init(void);
+void       mempool_exit(void);
+void*      mempool_alloc(size_t size_p);
+void       mempool_free(void* pMem_p);
+void       mempool_setOperational(BOOL fOperational_p);
+void       mempool_getStatistics(tMempoolStatistics* pStatistics_p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_mempool_H_ */
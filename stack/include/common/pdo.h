@@ -46,7 +46,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // const defines
 //------------------------------------------------------------------------------
 #define PDO_SHB_BUF_ID                  "PdoMem"
-#define PDO_SYNC_BSDSEM                 "/semPdoSync"
+#define PDO_SYNC_SHM                    "/shmPdoSync"
 #define PDO_SHMEM_NAME                  "/podShm"
 
 #define PDO_MAX_ALLOC_SIZE      239 * 2 * 1500      //jba replace with a clean solution
@@ -108,6 +108,24 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // typedef
 //------------------------------------------------------------------------------
 
+/**
+\brief PDO sync word
+
+The structure is shared between the kernel and the user PDO CAL sync modules.
+The kernel layer stores the timestamp of the next cycle in the timestamp slot
+selected by the lowest bit of the new cycle number before it increments the
+cycle number. The user layer waits on the cycle number with a futex. As a
+timestamp slot is only overwritten two cycles later, a reader which sees the
+cycle number changed by less than two after reading the timestamp got a
+consistent pair.
+*/
+typedef struct
+{
+    volatile UINT32     cycleNumber;            ///< Number of the latest sync event, used as futex word
+    UINT32              reserved;               ///< Alignment of the timestamps
+    volatile UINT64     aTimestamp[2];          ///< Timestamps of the latest two sync events in ns
+} tPdoSyncWord;
+
 /**
 \brief PDO allocation param structure
 
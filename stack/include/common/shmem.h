@@ -0,0 +1,106 @@
+/**
+********************************************************************************
+\file   shmem.h
+
+\brief  Definitions for the shared memory allocator
+
+This file contains the definitions for the shared memory allocator used by the
+POSIX shared memory CAL modules on Linux userspace. The allocator maps named
+shared memory regions and prepares them for the real-time path: the regions
+can be backed by huge pages, are prefaulted, locked into RAM and placed on
+the NUMA node of the calling thread.
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2014, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+#ifndef _INC_shmem_H_
+#define _INC_shmem_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <oplk/oplkinc.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define SHMEM_MAX_NAME_LEN      32          // maximum length of a region name including terminator
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+/**
+\brief Shared memory mapping mode
+
+The enumeration defines how shmem_map() handles the shared memory object.
+*/
+typedef enum
+{
+    kShmemModeCreate        = 0,    ///< Create the object if necessary and set its size
+    kShmemModeOpen          = 1,    ///< Open or create the object, the size is only set if it is created
+    kShmemModeAttach        = 2,    ///< Attach to an existing object, size 0 maps the whole object
+} tShmemMode;
+
+/**
+\brief Shared memory region
+
+The structure describes a mapped shared memory region.
+*/
+typedef struct
+{
+    void*           pBase;                      ///< Start address of the mapping
+    size_t          size;                       ///< Usable size of the region
+    size_t          mapSize;                    ///< Size of the mapping (multiple of the page size)
+    size_t          pageSize;                   ///< Size of the pages backing the region
+    int             fd;                         ///< File descriptor of the shared memory object
+    BOOL            fCreator;                   ///< The object was created by this mapping
+    BOOL            fHugePages;                 ///< The region is backed by huge pages
+    BOOL            fLocked;                    ///< The region is locked into RAM
+    int             numaNode;                   ///< NUMA node of the first page, -1 if unknown
+    char            aName[SHMEM_MAX_NAME_LEN];  ///< Name of the shared memory object
+} tShmemRegion;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+tOplkError shmem_map(const char* pName_p, size_t size_p, tShmemMode mode_p,
+                     tShmemRegion* pRegion_p);
+void       shmem_unmap(tShmemRegion* pRegion_p);
+void       shmem_unlink(const char* pName_p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_shmem_H_ */
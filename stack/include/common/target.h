@@ -43,6 +43,11 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 #include <oplk/oplkinc.h>
 
+#if (TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__)
+#include <pthread.h>
+#include <oplk/thread.h>
+#endif
+
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
@@ -50,7 +55,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
-
+#if (TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__)
+/// Condition callback for target_pollUntil()
+typedef BOOL (*tTargetPollCondition)(void* pArg_p);
+#endif
 
 //------------------------------------------------------------------------------
 // function prototypes
@@ -69,6 +77,17 @@ ULONGLONG  target_getCurrentTimestamp(void);
 void       target_enableGlobalInterrupt(BYTE fEnable_p);
 UINT32     target_getTickCount(void);
 
+#if (TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__)
+tOplkError target_setThreadParam(const tOplkThreadParam* pThreadParam_p);
+tOplkError target_setupThread(pthread_t thread_p, tOplkThreadId threadId_p);
+void       target_prefaultThreadStack(void);
+void       target_usleep(UINT32 microSeconds_p);
+void       target_sleepUntil(ULONGLONG deadlineUs_p);
+BOOL       target_pollUntil(tTargetPollCondition pfnCondition_p, void* pArg_p,
+                            UINT32 periodUs_p, ULONGLONG timeoutUs_p);
+ULONGLONG  target_getTickCountUs(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
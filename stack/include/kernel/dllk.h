@@ -80,7 +80,7 @@ struct _tDllkNodeInfo
     ULONG                       dllErrorEvents;
     UINT32                      presTimeoutNs;          // object 0x1F92: NMT_MNCNPResTimeout_AU32
     struct sEdrvTxBuffer*       pPreqTxBuffer;
-    struct _tDllkNodeInfo*      pNextNodeInfo;
+    ULONGLONG                   preqTxTimeStamp;        // Tx time stamp of the last PReq [ns], 0 if not valid
 #endif
 
 };
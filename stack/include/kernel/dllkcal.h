@@ -48,9 +48,67 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // const defines
 //------------------------------------------------------------------------------
 
+#if defined(CONFIG_INCLUDE_NMT_MN)
+#define DLLKCAL_SOA_CLASS_COUNT     6       ///< Number of SoA scheduler classes
+#define DLLKCAL_PRES_HISTOGRAM_SIZE 16      ///< Number of buckets of the PRes latency histogram
+#endif
+
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
+#if defined(CONFIG_INCLUDE_NMT_MN)
+/**
+\brief SoA scheduler classes
+
+The enumeration lists the request classes which are served by the SoA
+invitation scheduler of the MN. Each class has its own weight.
+*/
+typedef enum
+{
+    kDllkCalSoaClassCnNmt       = 0,        ///< NMT requests of CNs
+    kDllkCalSoaClassCnGen       = 1,        ///< Generic requests of CNs
+    kDllkCalSoaClassMnGenNmt    = 2,        ///< Generic and NMT requests of the MN
+    kDllkCalSoaClassMnIdent     = 3,        ///< IdentRequests of the MN
+    kDllkCalSoaClassMnStatus    = 4,        ///< StatusRequests of the MN
+    kDllkCalSoaClassMnSync      = 5,        ///< SyncRequests of the MN
+} tDllkCalSoaClass;
+
+/**
+\brief Per-node SoA statistics
+
+The structure contains the asynchronous invitation statistics of a CN. Wait
+times are counted in SoA slots, i.e. calls of dllkcal_getSoaRequest().
+*/
+typedef struct
+{
+    ULONG       invitationCount;            ///< Number of invitations granted to the node
+    ULONG       lastWaitCount;              ///< Wait time of the last granted request
+    ULONG       maxWaitCount;               ///< Maximum wait time of a request
+    ULONG       totalWaitCount;             ///< Sum of all wait times (mean = totalWaitCount / invitationCount)
+} tDllkCalSoaNodeStatistics;
+
+/**
+\brief Per-node PRes statistics
+
+The structure contains the PRes statistics of an isochronous CN. The latency
+is the time between the transmission of the PReq and the reception of the
+PRes. Bucket 0 of the histogram counts latencies below 1 us, bucket n counts
+latencies from 2^(n-1) us to below 2^n us. The last bucket also counts all
+larger latencies.
+*/
+typedef struct
+{
+    ULONG       presCount;                  ///< Number of PRes frames with measured latency
+    ULONG       lossCount;                  ///< Number of lost PRes frames
+    ULONG       consecutiveLossCount;       ///< Number of PRes frames lost in a row until now
+    ULONG       maxConsecutiveLossCount;    ///< Maximum number of PRes frames lost in a row
+    UINT32      latencyMinNs;               ///< Minimum latency [ns]
+    UINT32      latencyMaxNs;               ///< Maximum latency [ns]
+    ULONGLONG   latencySumNs;               ///< Sum of all latencies [ns] (mean = latencySumNs / presCount)
+    ULONG       aLatencyHistogram[DLLKCAL_PRES_HISTOGRAM_SIZE]; ///< Log2 histogram of the latency
+} tDllkCalPresNodeStatistics;
+#endif
+
 typedef struct
 {
     ULONG       curTxFrameCountGen;
@@ -59,6 +117,14 @@ typedef struct
     ULONG       maxTxFrameCountGen;
     ULONG       maxTxFrameCountNmt;
     ULONG       maxRxFrameCount;
+#if defined(CONFIG_INCLUDE_NMT_MN)
+    ULONG                       aSoaClassCount[DLLKCAL_SOA_CLASS_COUNT];    ///< Granted invitations per scheduler class
+    UINT                        aSoaClassWeight[DLLKCAL_SOA_CLASS_COUNT];   ///< Current weights of the scheduler classes
+    ULONG                       soaIdleSlotCount;                           ///< SoA slots without any invitation
+    ULONG                       soaWeightAdaptCount;                        ///< Weight changes of the adaptive SoA scheduler
+    tDllkCalSoaNodeStatistics   aSoaNodeStatistics[254];                    ///< SoA statistics per CN (index = node ID - 1)
+    tDllkCalPresNodeStatistics  aPresNodeStatistics[254];                   ///< PRes statistics per CN (index = node ID - 1)
+#endif
 } tDllkCalStatistics;
 
 //------------------------------------------------------------------------------
@@ -105,6 +171,10 @@ tOplkError dllkcal_getSoaRequest(tDllReqServiceId* pReqServiceId_p,
 tOplkError dllkcal_setAsyncPendingRequests(UINT nodeId_p, tDllAsyncReqPriority asyncReqPrio_p,
                                            UINT count_p);
 
+tOplkError dllkcal_setSoaNodeCredit(UINT nodeId_p, UINT credit_p);
+
+tDllkCalPresNodeStatistics* dllkcal_getPresNodeStatistics(UINT nodeId_p);
+
 #endif
 
 
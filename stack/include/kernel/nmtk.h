@@ -49,11 +49,46 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#define NMTK_MAX_TRANSITIONS        160     ///< Maximum number of (state, event) transitions of the NMT state machine
 
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
 
+#if (CONFIG_NMTK_STATISTICS != FALSE)
+/**
+\brief NMT transition statistics
+
+The structure contains the statistics of a single transition of the NMT state
+machine, i.e. of an event processed in a specific state. The latency is
+measured from the dispatch of the event until the state change was handed to
+the DLL and the user layer.
+*/
+typedef struct
+{
+    tNmtState           nmtState;               ///< NMT state in which the event is processed
+    tNmtEvent           nmtEvent;               ///< NMT event triggering the transition
+    UINT32              count;                  ///< Number of processed transitions
+    UINT32              minLatency;             ///< Minimum latency in ns
+    UINT32              maxLatency;             ///< Maximum latency in ns
+    ULONGLONG           totalLatency;           ///< Sum of all latencies in ns
+} tNmtkTransitionStatistics;
+
+/**
+\brief NMT state machine statistics
+
+The structure contains the statistics of the NMT state machine. Events without
+a transition in the current state are not counted.
+*/
+typedef struct
+{
+    UINT32                      eventCount;         ///< Number of events which triggered a transition
+    UINT32                      stateChangeCount;   ///< Number of state changes
+    UINT                        transitionCount;    ///< Number of valid entries in aTransition
+    tNmtkTransitionStatistics   aTransition[NMTK_MAX_TRANSITIONS];  ///< Statistics of each transition
+} tNmtkStatistics;
+#endif
+
 //------------------------------------------------------------------------------
 // function prototypes
 //------------------------------------------------------------------------------
@@ -65,6 +100,10 @@ extern "C" {
 tOplkError nmtk_init(void);
 tOplkError nmtk_delInstance(void);
 tOplkError nmtk_process(tEvent* pEvent_p);
+#if (CONFIG_NMTK_STATISTICS != FALSE)
+tOplkError nmtk_getStatistics(tNmtkStatistics* pStatistics_p);
+void       nmtk_resetStatistics(void);
+#endif
 
 #ifdef __cplusplus
 }
@@ -46,6 +46,13 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // const defines
 //------------------------------------------------------------------------------
 
+// The byte order accessors are expanded inline if the compiler provides the
+// required builtins. The out-of-line versions are still compiled into the
+// stack library (the ami source files define AMI_OUT_OF_LINE).
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && !defined(AMI_OUT_OF_LINE)
+#define AMI_INLINE_ACCESSORS
+#endif
+
 // Conversion macros for datatype UINT8 (saves code size)
 #define ami_setUint8Be(pAddr_p, uint8Val_p) {*(UINT8 *)(pAddr_p) = (uint8Val_p);}
 #define ami_setUint8Le(pAddr_p, uint8Val_p) {*(UINT8 *)(pAddr_p) = (uint8Val_p);}
@@ -65,6 +72,220 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     extern "C" {
 #endif
 
+#if defined(AMI_INLINE_ACCESSORS)
+
+/*
+The accessors below are expanded in place instead of being called. The
+memory is accessed with __builtin_memcpy() so that unaligned frame fields are
+handled correctly, the compiler turns it into single load/store instructions
+on all architectures supporting unaligned access. The byte order is fixed up
+with __builtin_bswap*() if the host byte order differs from the requested one.
+The odd sized types are composed byte by byte, the compiler merges the byte
+accesses where possible.
+*/
+
+#if (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define AMI_TO_LE16(val_p)  (val_p)
+#define AMI_TO_LE32(val_p)  (val_p)
+#define AMI_TO_LE64(val_p)  (val_p)
+#define AMI_TO_BE16(val_p)  ((UINT16)(((val_p) << 8) | ((val_p) >> 8)))
+#define AMI_TO_BE32(val_p)  __builtin_bswap32(val_p)
+#define AMI_TO_BE64(val_p)  __builtin_bswap64(val_p)
+#else
+#define AMI_TO_LE16(val_p)  ((UINT16)(((val_p) << 8) | ((val_p) >> 8)))
+#define AMI_TO_LE32(val_p)  __builtin_bswap32(val_p)
+#define AMI_TO_LE64(val_p)  __builtin_bswap64(val_p)
+#define AMI_TO_BE16(val_p)  (val_p)
+#define AMI_TO_BE32(val_p)  (val_p)
+#define AMI_TO_BE64(val_p)  (val_p)
+#endif
+
+// Conversion functions for datatype WORD
+static __inline__ void ami_setUint16Be(void* pAddr_p, UINT16 uint16Val_p)
+{
+    uint16Val_p = AMI_TO_BE16(uint16Val_p);
+    __builtin_memcpy(pAddr_p, &uint16Val_p, sizeof(uint16Val_p));
+}
+
+static __inline__ void ami_setUint16Le(void* pAddr_p, UINT16 uint16Val_p)
+{
+    uint16Val_p = AMI_TO_LE16(uint16Val_p);
+    __builtin_memcpy(pAddr_p, &uint16Val_p, sizeof(uint16Val_p));
+}
+
+static __inline__ UINT16 ami_getUint16Be(void* pAddr_p)
+{
+    UINT16 val;
+
+    __builtin_memcpy(&val, pAddr_p, sizeof(val));
+    return AMI_TO_BE16(val);
+}
+
+static __inline__ UINT16 ami_getUint16Le(void* pAddr_p)
+{
+    UINT16 val;
+
+    __builtin_memcpy(&val, pAddr_p, sizeof(val));
+    return AMI_TO_LE16(val);
+}
+
+// Conversion functions for datatype DWORD24
+static __inline__ void ami_setUint24Be(void* pAddr_p, UINT32 uint32Val_p)
+{
+    UINT8*  pAddr = (UINT8*)pAddr_p;
+
+    pAddr[0] = (UINT8)(uint32Val_p >> 16);
+    pAddr[1] = (UINT8)(uint32Val_p >> 8);
+    pAddr[2] = (UINT8)uint32Val_p;
+}
+
+static __inline__ void ami_setUint24Le(void* pAddr_p, UINT32 uint32Val_p)
+{
+    UINT8*  pAddr = (UINT8*)pAddr_p;
+
+    pAddr[0] = (UINT8)uint32Val_p;
+    pAddr[1] = (UINT8)(uint32Val_p >> 8);
+    pAddr[2] = (UINT8)(uint32Val_p >> 16);
+}
+
+static __inline__ UINT32 ami_getUint24Be(void* pAddr_p)
+{
+    UINT8*  pAddr = (UINT8*)pAddr_p;
+
+    return ((UINT32)pAddr[0] << 16) | ((UINT32)pAddr[1] << 8) | pAddr[2];
+}
+
+static __inline__ UINT32 ami_getUint24Le(void* pAddr_p)
+{
+    UINT8*  pAddr = (UINT8*)pAddr_p;
+
+    return ((UINT32)pAddr[2] << 16) | ((UINT32)pAddr[1] << 8) | pAddr[0];
+}
+
+// Conversion functions for datatype DWORD
+static __inline__ void ami_setUint32Be(void* pAddr_p, UINT32 uint32Val_p)
+{
+    uint32Val_p = AMI_TO_BE32(uint32Val_p);
+    __builtin_memcpy(pAddr_p, &uint32Val_p, sizeof(uint32Val_p));
+}
+
+static __inline__ void ami_setUint32Le(void* pAddr_p, UINT32 uint32Val_p)
+{
+    uint32Val_p = AMI_TO_LE32(uint32Val_p);
+    __builtin_memcpy(pAddr_p, &uint32Val_p, sizeof(uint32Val_p));
+}
+
+static __inline__ UINT32 ami_getUint32Be(void* pAddr_p)
+{
+    UINT32 val;
+
+    __builtin_memcpy(&val, pAddr_p, sizeof(val));
+    return AMI_TO_BE32(val);
+}
+
+static __inline__ UINT32 ami_getUint32Le(void* pAddr_p)
+{
+    UINT32 val;
+
+    __builtin_memcpy(&val, pAddr_p, sizeof(val));
+    return AMI_TO_LE32(val);
+}
+
+// Conversion functions for datatypes QWORD40, QWORD48 and QWORD56
+static __inline__ void ami_setUintNBe(void* pAddr_p, UINT64 uint64Val_p, UINT size_p)
+{
+    UINT8*  pAddr = (UINT8*)pAddr_p;
+    UINT    i;
+
+    for (i = size_p; i > 0; i--)
+    {
+        pAddr[i - 1] = (UINT8)uint64Val_p;
+        uint64Val_p >>= 8;
+    }
+}
+
+static __inline__ void ami_setUintNLe(void* pAddr_p, UINT64 uint64Val_p, UINT size_p)
+{
+    UINT8*  pAddr = (UINT8*)pAddr_p;
+    UINT    i;
+
+    for (i = 0; i < size_p; i++)
+    {
+        pAddr[i] = (UINT8)uint64Val_p;
+        uint64Val_p >>= 8;
+    }
+}
+
+static __inline__ UINT64 ami_getUintNBe(void* pAddr_p, UINT size_p)
+{
+    UINT8*  pAddr = (UINT8*)pAddr_p;
+    UINT64  val = 0;
+    UINT    i;
+
+    for (i = 0; i < size_p; i++)
+        val = (val << 8) | pAddr[i];
+
+    return val;
+}
+
+static __inline__ UINT64 ami_getUintNLe(void* pAddr_p, UINT size_p)
+{
+    UINT8*  pAddr = (UINT8*)pAddr_p;
+    UINT64  val = 0;
+    UINT    i;
+
+    for (i = size_p; i > 0; i--)
+        val = (val << 8) | pAddr[i - 1];
+
+    return val;
+}
+
+#define ami_setUint40Be(pAddr_p, uint64Val_p)   ami_setUintNBe(pAddr_p, uint64Val_p, 5)
+#define ami_setUint40Le(pAddr_p, uint64Val_p)   ami_setUintNLe(pAddr_p, uint64Val_p, 5)
+#define ami_getUint40Be(pAddr_p)                ami_getUintNBe(pAddr_p, 5)
+#define ami_getUint40Le(pAddr_p)                ami_getUintNLe(pAddr_p, 5)
+
+#define ami_setUint48Be(pAddr_p, uint64Val_p)   ami_setUintNBe(pAddr_p, uint64Val_p, 6)
+#define ami_setUint48Le(pAddr_p, uint64Val_p)   ami_setUintNLe(pAddr_p, uint64Val_p, 6)
+#define ami_getUint48Be(pAddr_p)                ami_getUintNBe(pAddr_p, 6)
+#define ami_getUint48Le(pAddr_p)                ami_getUintNLe(pAddr_p, 6)
+
+#define ami_setUint56Be(pAddr_p, uint64Val_p)   ami_setUintNBe(pAddr_p, uint64Val_p, 7)
+#define ami_setUint56Le(pAddr_p, uint64Val_p)   ami_setUintNLe(pAddr_p, uint64Val_p, 7)
+#define ami_getUint56Be(pAddr_p)                ami_getUintNBe(pAddr_p, 7)
+#define ami_getUint56Le(pAddr_p)                ami_getUintNLe(pAddr_p, 7)
+
+// Conversion functions for datatype QWORD
+static __inline__ void ami_setUint64Be(void* pAddr_p, UINT64 uint64Val_p)
+{
+    uint64Val_p = AMI_TO_BE64(uint64Val_p);
+    __builtin_memcpy(pAddr_p, &uint64Val_p, sizeof(uint64Val_p));
+}
+
+static __inline__ void ami_setUint64Le(void* pAddr_p, UINT64 uint64Val_p)
+{
+    uint64Val_p = AMI_TO_LE64(uint64Val_p);
+    __builtin_memcpy(pAddr_p, &uint64Val_p, sizeof(uint64Val_p));
+}
+
+static __inline__ UINT64 ami_getUint64Be(void* pAddr_p)
+{
+    UINT64 val;
+
+    __builtin_memcpy(&val, pAddr_p, sizeof(val));
+    return AMI_TO_BE64(val);
+}
+
+static __inline__ UINT64 ami_getUint64Le(void* pAddr_p)
+{
+    UINT64 val;
+
+    __builtin_memcpy(&val, pAddr_p, sizeof(val));
+    return AMI_TO_LE64(val);
+}
+
+#else
+
 // Conversion functions for datatype WORD
 void ami_setUint16Be(void* pAddr_p, UINT16 uint16Val_p);
 void ami_setUint16Le(void* pAddr_p, UINT16 uint16Val_p);
@@ -114,10 +335,28 @@ void ami_setUint64Le(void* pAddr_p, UINT64 uint64Val_p);
 UINT64 ami_getUint64Be(void* pAddr_p);
 UINT64 ami_getUint64Le(void* pAddr_p);
 
+#endif
+
 // Conversion functions for type tTimeOfDay
 void ami_setTimeOfDay(void* pAddr_p, tTimeOfDay* pTimeOfDay_p);
 void ami_getTimeOfDay(void* pAddr_p, tTimeOfDay* pTimeOfDay_p);
 
+// Conversion functions for arrays of numerical values
+void ami_setUint16ArrayBe(void* pAddr_p, const UINT16* pData_p, UINT count_p);
+void ami_setUint16ArrayLe(void* pAddr_p, const UINT16* pData_p, UINT count_p);
+void ami_getUint16ArrayBe(const void* pAddr_p, UINT16* pData_p, UINT count_p);
+void ami_getUint16ArrayLe(const void* pAddr_p, UINT16* pData_p, UINT count_p);
+
+void ami_setUint32ArrayBe(void* pAddr_p, const UINT32* pData_p, UINT count_p);
+void ami_setUint32ArrayLe(void* pAddr_p, const UINT32* pData_p, UINT count_p);
+void ami_getUint32ArrayBe(const void* pAddr_p, UINT32* pData_p, UINT count_p);
+void ami_getUint32ArrayLe(const void* pAddr_p, UINT32* pData_p, UINT count_p);
+
+void ami_setUint64ArrayBe(void* pAddr_p, const UINT64* pData_p, UINT count_p);
+void ami_setUint64ArrayLe(void* pAddr_p, const UINT64* pData_p, UINT count_p);
+void ami_getUint64ArrayBe(const void* pAddr_p, UINT64* pData_p, UINT count_p);
+void ami_getUint64ArrayLe(const void* pAddr_p, UINT64* pData_p, UINT count_p);
+
 #ifdef __cplusplus
     }
 #endif
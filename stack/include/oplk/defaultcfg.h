@@ -81,6 +81,49 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_DLLCAL_SIZE_CIRCBUF_REQ_STATUS           256                 // Default size for status request queue
 #endif
 
+// SoA scheduler class weights. With all weights set to 1 the classes are served
+// round-robin as before. A weighted profile which prefers NMT and SyncRequests
+// (e.g. 4/2/4/2/1/4 in the order below) can be enabled in oplkcfg.h.
+#ifndef CONFIG_DLLCAL_SOA_WEIGHT_CN_NMT
+#define CONFIG_DLLCAL_SOA_WEIGHT_CN_NMT                 1                   // SoA scheduler weight of CN NMT requests
+#endif
+
+#ifndef CONFIG_DLLCAL_SOA_WEIGHT_CN_GEN
+#define CONFIG_DLLCAL_SOA_WEIGHT_CN_GEN                 1                   // SoA scheduler weight of CN generic requests
+#endif
+
+#ifndef CONFIG_DLLCAL_SOA_WEIGHT_MN_GENNMT
+#define CONFIG_DLLCAL_SOA_WEIGHT_MN_GENNMT              1                   // SoA scheduler weight of MN generic/NMT requests
+#endif
+
+#ifndef CONFIG_DLLCAL_SOA_WEIGHT_MN_IDENT
+#define CONFIG_DLLCAL_SOA_WEIGHT_MN_IDENT               1                   // SoA scheduler weight of IdentRequests
+#endif
+
+#ifndef CONFIG_DLLCAL_SOA_WEIGHT_MN_STATUS
+#define CONFIG_DLLCAL_SOA_WEIGHT_MN_STATUS              1                   // SoA scheduler weight of StatusRequests
+#endif
+
+#ifndef CONFIG_DLLCAL_SOA_WEIGHT_MN_SYNC
+#define CONFIG_DLLCAL_SOA_WEIGHT_MN_SYNC                1                   // SoA scheduler weight of SyncRequests
+#endif
+
+#ifndef CONFIG_DLLCAL_SOA_NODE_CREDIT
+#define CONFIG_DLLCAL_SOA_NODE_CREDIT                   1                   // Default number of consecutive invitations per CN and round
+#endif
+
+#ifndef CONFIG_DLLCAL_SOA_ADAPTIVE
+#define CONFIG_DLLCAL_SOA_ADAPTIVE                      FALSE               // adapt the SoA scheduler weights to the measured backlog
+#endif
+
+#ifndef CONFIG_DLLCAL_SOA_ADAPT_PERIOD
+#define CONFIG_DLLCAL_SOA_ADAPT_PERIOD                  64                  // number of SoA slots between two weight adaptations
+#endif
+
+#ifndef CONFIG_DLLCAL_SOA_ADAPT_MAX_FACTOR
+#define CONFIG_DLLCAL_SOA_ADAPT_MAX_FACTOR              4                   // maximum adapted weight as multiple of the configured weight
+#endif
+
 #ifndef CONFIG_DLL_PRES_CHAINING_CN
 #define CONFIG_DLL_PRES_CHAINING_CN                     FALSE
 #endif
@@ -149,6 +192,54 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_DLL_SOC_SYNC_SHIFT_US                    150                 // negative time shift of isochronous task in relation to SoC
 #endif
 
+#ifndef CONFIG_DLL_TPDO_WORKER
+#define CONFIG_DLL_TPDO_WORKER                          FALSE               // prepare TPDOs of the next cycle on a worker thread (MN on Linux userspace only)
+#endif
+
+#ifndef CONFIG_DLL_TPDO_WORKER_CPU
+#define CONFIG_DLL_TPDO_WORKER_CPU                      -1                  // CPU the TPDO worker thread is pinned to (-1 = not pinned)
+#endif
+
+#ifndef CONFIG_NMTK_STATISTICS
+#define CONFIG_NMTK_STATISTICS                          FALSE               // count the transitions of the NMT state machine and measure their latency
+#endif
+
+#ifndef CONFIG_LEDU_OUTPUT_TASK
+#define CONFIG_LEDU_OUTPUT_TASK                         FALSE               // render the LED patterns on a separate output thread instead of user timers (Linux userspace only), LED events are still delivered on the user event thread
+#endif
+
+#ifndef CONFIG_LEDU_OUTPUT_MIN_INTERVAL_MS
+#define CONFIG_LEDU_OUTPUT_MIN_INTERVAL_MS              20                  // minimum time between two writes to the same LED of the output thread [ms]
+#endif
+
+#ifndef CONFIG_LEDU_SYSFS_STATUS_LED
+#define CONFIG_LEDU_SYSFS_STATUS_LED                    ""                  // name of the status LED in /sys/class/leds, "" reports it to the application
+#endif
+
+#ifndef CONFIG_LEDU_SYSFS_ERROR_LED
+#define CONFIG_LEDU_SYSFS_ERROR_LED                     ""                  // name of the error LED in /sys/class/leds, "" reports it to the application
+#endif
+
+#ifndef CONFIG_THREAD_PRIORITY_EVENT_KERNEL
+#define CONFIG_THREAD_PRIORITY_EVENT_KERNEL             55                  // default priority of the kernel event thread (Linux userspace)
+#endif
+
+#ifndef CONFIG_THREAD_PRIORITY_EVENT_USER
+#if (CONFIG_DLLCAL_QUEUE == IOCTL_QUEUE)
+#define CONFIG_THREAD_PRIORITY_EVENT_USER               20                  // default priority of the user event thread (Linux kernel interface)
+#else
+#define CONFIG_THREAD_PRIORITY_EVENT_USER               45                  // default priority of the user event thread (Linux userspace)
+#endif
+#endif
+
+#ifndef CONFIG_THREAD_PRIORITY_TPDO_WORKER
+#define CONFIG_THREAD_PRIORITY_TPDO_WORKER              60                  // default priority of the TPDO worker thread (Linux userspace)
+#endif
+
+#ifndef CONFIG_DLL_PRES_LATENCY_STATISTICS
+#define CONFIG_DLL_PRES_LATENCY_STATISTICS              FALSE               // measure PReq/PRes latency per CN (MN only, requires target_getCurrentTimestamp())
+#endif
+
 #ifndef CONFIG_DLL_PRES_FILTER_COUNT
 #if defined(CONFIG_INCLUDE_NMT_MN)
 #define CONFIG_DLL_PRES_FILTER_COUNT                           -1                  // maximum count of Rx filter entries for PRes frames
@@ -173,6 +264,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define NMTMNU_PRC_NODE_ADD_MAX_NUM                     D_NMT_MaxCNNumber_U8
 #endif
 
+#ifndef CONFIG_NMTMNU_COALESCE_NMT_COMMANDS
+#define CONFIG_NMTMNU_COALESCE_NMT_COMMANDS             TRUE                // send NMT state commands to several CNs as extended NMT command with node list
+#endif
+
 // defines for EPL API layer static process image
 #ifndef API_PROCESS_IMAGE_SIZE_IN
 #define API_PROCESS_IMAGE_SIZE_IN                       0
@@ -247,4 +342,72 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_EDRV_AUTO_RESPONSE_DELAY                 FALSE
 #endif
 
+#ifndef CONFIG_TRACE_RING
+#define CONFIG_TRACE_RING                               FALSE               // record trace events in per-thread binary ring buffers (Linux userspace only)
+#endif
+
+#ifndef CONFIG_TRACE_RING_ENTRIES
+#define CONFIG_TRACE_RING_ENTRIES                       4096                // number of entries per thread, must be a power of two
+#endif
+
+#ifndef CONFIG_TRACE_RING_THREADS
+#define CONFIG_TRACE_RING_THREADS                       16                  // maximum number of threads which can record trace events
+#endif
+
+#ifndef CONFIG_TRACE_RING_USE_TSC
+#define CONFIG_TRACE_RING_USE_TSC                       FALSE               // use the CPU time stamp counter instead of CLOCK_MONOTONIC (x86 only)
+#endif
+
+#ifndef CONFIG_SHMEM_HUGEPAGES
+#define CONFIG_SHMEM_HUGEPAGES                          FALSE               // back shared memory regions by huge pages if possible (Linux userspace only)
+#endif
+
+#ifndef CONFIG_SHMEM_HUGETLBFS_PATH
+#define CONFIG_SHMEM_HUGETLBFS_PATH                     "/dev/hugepages"    // mount point of the hugetlbfs used for shared memory regions
+#endif
+
+#ifndef CONFIG_SHMEM_PREFAULT
+#define CONFIG_SHMEM_PREFAULT                           TRUE                // populate all pages of shared memory regions when mapping them
+#endif
+
+#ifndef CONFIG_SHMEM_LOCK
+#define CONFIG_SHMEM_LOCK                               TRUE                // lock shared memory regions into RAM
+#endif
+
+#ifndef CONFIG_SHMEM_NUMA_LOCAL
+#define CONFIG_SHMEM_NUMA_LOCAL                         FALSE               // allocate shared memory regions on the NUMA node of the mapping thread
+#endif
+
+#ifndef CONFIG_MEMPOOL
+#define CONFIG_MEMPOOL                                  FALSE               // serve OPLK_MALLOC() from fixed-size memory pools (Linux userspace only)
+#endif
+
+#ifndef CONFIG_MEMPOOL_STRICT
+#define CONFIG_MEMPOOL_STRICT                           TRUE                // heap allocations in operational state fail instead of only being reported
+#endif
+
+#ifndef CONFIG_MEMPOOL_BLOCKS_64
+#define CONFIG_MEMPOOL_BLOCKS_64                        256                 // number of 64 byte blocks
+#endif
+
+#ifndef CONFIG_MEMPOOL_BLOCKS_256
+#define CONFIG_MEMPOOL_BLOCKS_256                       64                  // number of 256 byte blocks
+#endif
+
+#ifndef CONFIG_MEMPOOL_BLOCKS_1K
+#define CONFIG_MEMPOOL_BLOCKS_1K                        32                  // number of 1 KiB blocks
+#endif
+
+#ifndef CONFIG_MEMPOOL_BLOCKS_4K
+#define CONFIG_MEMPOOL_BLOCKS_4K                        16                  // number of 4 KiB blocks
+#endif
+
+#ifndef CONFIG_MEMPOOL_BLOCKS_16K
+#define CONFIG_MEMPOOL_BLOCKS_16K                       8                   // number of 16 KiB blocks
+#endif
+
+#ifndef CONFIG_MEMPOOL_BLOCKS_64K
+#define CONFIG_MEMPOOL_BLOCKS_64K                       4                   // number of 64 KiB blocks
+#endif
+
 #endif /* _INC_oplk_defaultcfg_H_ */
@@ -99,6 +99,9 @@ typedef enum
     kEventTypePdokControlSync       = 0x26,     ///< enable/disable the pdokcal sync trigger (arg is pointer to BOOL)
     kEventTypeReleaseRxFrame        = 0x27,     ///< Free receive buffer (arg is pointer to the buffer to release)
     kEventTypeAsndNotRx             = 0x28,     ///< Didn't receive ASnd frame for DLL user module (arg is pointer to tDllAsndNotRx)
+    kEventTypeNmtMnuFlushCmd        = 0x29,     ///< send coalesced NMT commands (arg is pointer to nothing)
+    kEventTypeErrhndWrite           = 0x2A,     ///< write error handler object (arg is pointer to tErrHndObjectWrite)
+    kEventTypeLeduOutput            = 0x2B,     ///< LED output changed by the LED output thread (arg is pointer to tLeduOutputEvent)
 } tEventType;
 
 /**
@@ -246,6 +249,19 @@ typedef struct
 */
 typedef tOplkError (*tSyncCb) (void);
 
+/**
+\brief Sync event information
+
+The structure provides information about the sync event which was received by
+oplk_waitSyncEvent().
+*/
+typedef struct
+{
+    UINT32              cycleNumber;            ///< Number of the received sync event
+    UINT32              skippedCycles;          ///< Number of sync events which were missed since the last call
+    UINT64              timestamp;              ///< Timestamp of the sync event in ns, 0 if not available
+} tSyncEventInfo;
+
 /**
 \brief Callback for event post
 
@@ -118,6 +118,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define PLK_DEF_FEATURE_DLL_MULTIPLEX       (PLK_FEATURE_DLL_MULTIPLEX)
 #endif
 
+#ifndef PLK_DEF_FEATURE_NMT_EXT
+#define PLK_DEF_FEATURE_NMT_EXT             (PLK_FEATURE_NMT_EXT)
+#endif
+
 #ifndef PLK_DEF_FEATURE_MASND
 #if defined(CONFIG_INCLUDE_MASND)
 #define PLK_DEF_FEATURE_MASND               (PLK_FEATURE_MASND)
@@ -142,6 +146,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
                                PLK_DEF_FEATURE_PDO_DYN | \
                                PLK_DEF_FEATURE_CFM | \
                                PLK_DEF_FEATURE_DLL_MULTIPLEX | \
+                               PLK_DEF_FEATURE_NMT_EXT | \
                                PLK_DEF_FEATURE_MASND | \
                                PLK_DEF_FEATURE_PRES_CHAINING)
 
@@ -386,6 +386,27 @@ typedef struct
 
 typedef tObdEntry * tObdEntryPtr;
 
+/**
+\brief Handle of a resolved object
+
+This structure contains the result of resolving an object (index/sub-index)
+in the OD. It is filled by obd_resolveEntry() and can be used for repeated
+accesses to the same object by obd_readEntryByHdl() and obd_writeEntryByHdl()
+without searching the OD again.
+*/
+typedef struct
+{
+    UINT                index;              ///< Index of the object
+    UINT                subIndex;           ///< Subindex of the object
+    tObdEntryPtr        pObdEntry;          ///< Pointer to the index entry of the object
+    tObdSubEntryPtr     pSubEntry;          ///< Pointer to the subindex entry of the object
+    void MEM*           pData;              ///< Pointer to the object data at the time of resolving
+    tObdSize            size;               ///< Size of the object data at the time of resolving
+    tObdAccess          access;             ///< Access type of the object
+    tObdType            type;               ///< Data type of the object
+    BOOL                fNumerical;         ///< TRUE if the object has a numerical type
+} tObdEntryHdl;
+
 /**
 \brief Structure for OBD init parameters
 
@@ -457,6 +478,9 @@ tOplkError  obd_writeEntryFromLe(UINT index_p, UINT subIndex_p, void* pSrcData_p
 tOplkError  obd_readEntryToLe(UINT index_p, UINT subIndex_p, void* pDstData_p, tObdSize* pSize_p);
 tOplkError  obd_getAccessType(UINT index_p, UINT subIndex_p, tObdAccess* pAccessType_p);
 tOplkError  obd_searchVarEntry(UINT index_p, UINT subindex_p, tObdVarEntry MEM** ppVarEntry_p);
+tOplkError  obd_resolveEntry(UINT index_p, UINT subIndex_p, tObdEntryHdl* pHdl_p);
+tOplkError  obd_readEntryByHdl(tObdEntryHdl* pHdl_p, void* pDstData_p, tObdSize* pSize_p);
+tOplkError  obd_writeEntryByHdl(tObdEntryHdl* pHdl_p, void* pSrcData_p, tObdSize size_p);
 
 tOplkError  obd_initObd(tObdInitParam MEM* pInitParam_p);
 
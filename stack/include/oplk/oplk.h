@@ -48,6 +48,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <oplk/led.h>
 #include <oplk/cfm.h>
 #include <oplk/event.h>
+#include <oplk/thread.h>
 
 //------------------------------------------------------------------------------
 // const defines
@@ -309,6 +310,7 @@ typedef struct
     UINT32              syncResLatency;             ///< Constant response latency for SyncRes in ns
     UINT                syncNodeId;                 ///< Specifies the synchronization point for the MN. The synchronization take place after a PRes from a CN with this node-ID (0 = SoC, 255 = SoA)
     BOOL                fSyncOnPrcNode;             ///< If it is TRUE, Sync on PRes chained CN; FALSE: conventional CN (PReq/PRes)
+    tOplkThreadParam*   pThreadParam;               ///< Pointer to the real-time thread configuration, NULL for the default configuration (only Linux userspace)
 } tOplkApiInitParam;
 
 /**
@@ -354,7 +356,7 @@ OPLKDLLEXPORT tOplkError oplk_setCdcFilename(char* pszCdcFilename_p);
 OPLKDLLEXPORT tOplkError oplk_process(void);
 OPLKDLLEXPORT tOplkError oplk_getIdentResponse(UINT nodeId_p, tIdentResponse** ppIdentResponse_p);
 OPLKDLLEXPORT BOOL       oplk_checkKernelStack(void);
-OPLKDLLEXPORT tOplkError oplk_waitSyncEvent(ULONG timeout_p);
+OPLKDLLEXPORT tOplkError oplk_waitSyncEvent(ULONG timeout_p, tSyncEventInfo* pSyncInfo_p);
 
 // Process image API functions
 OPLKDLLEXPORT tOplkError oplk_allocProcessImage(UINT sizeProcessImageIn_p, UINT sizeProcessImageOut_p);
@@ -365,6 +367,10 @@ OPLKDLLEXPORT tOplkError oplk_exchangeProcessImageIn(void);
 OPLKDLLEXPORT tOplkError oplk_exchangeProcessImageOut(void);
 OPLKDLLEXPORT void*      oplk_getProcessImageIn(void);
 OPLKDLLEXPORT void*      oplk_getProcessImageOut(void);
+OPLKDLLEXPORT tOplkError oplk_getProcessImageInSnapshot(UINT offset_p, void* pDst_p, UINT size_p);
+OPLKDLLEXPORT tOplkError oplk_getProcessImageOutSnapshot(UINT offset_p, void* pDst_p, UINT size_p);
+OPLKDLLEXPORT tOplkError oplk_enableProcessImageSnapshot(BOOL fOutputPI_p, BOOL fEnable_p);
+OPLKDLLEXPORT tOplkError oplk_publishProcessImageIn(UINT offset_p, const void* pSrc_p, UINT size_p);
 
 // objdict specific process image functions
 OPLKDLLEXPORT tOplkError oplk_setupProcessImage(void);
@@ -134,6 +134,7 @@ These constants determine the different queue implementations.
 #define HOSTINTERFACE_QUEUE                             3                   ///< Use host interface IP core and library for queue
 #define IOCTL_QUEUE                                     4                   ///< Use Linux IOCTL calls for queue
 #define CIRCBUF_QUEUE                                   5                   ///< Use circular buffer library for queue
+#define LOCKFREE_QUEUE                                  6                   ///< Use lock-free queue with preallocated slots (user and kernel layer in one process)
 /// \}
 
 //------------------------------------------------------------------------------
@@ -66,6 +66,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define OPLK_MEMCPY(dst,src,siz)    memcpy((dst),(src),(siz))
 #endif
 
+#ifndef OPLK_MEMMOVE
+#define OPLK_MEMMOVE(dst,src,siz)   memmove((dst),(src),(siz))
+#endif
+
 #ifndef OPLK_MEMSET
 #define OPLK_MEMSET(dst,val,siz)    memset((dst),(val),(siz))
 #endif
@@ -73,6 +77,22 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef OPLK_MEMCMP
 #define OPLK_MEMCMP(src1,src2,siz)  memcmp((src1),(src2),(siz))
 #endif
+#if (TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__) && (CONFIG_MEMPOOL != FALSE)
+#define OPLK_MALLOC(siz)            mempool_alloc(siz)
+#define OPLK_FREE(ptr)              mempool_free(ptr)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void* mempool_alloc(size_t size_p);
+void  mempool_free(void* pMem_p);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
+
 #ifndef OPLK_MALLOC
 #define OPLK_MALLOC(siz)            malloc(siz)
 #endif
@@ -85,6 +105,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define OPLK_ATOMIC_INIT(ignore)    ((void)0)
 #endif
 
+#ifndef OPLK_MEMBAR
+#define OPLK_MEMBAR()               ((void)0)
+#endif
+
 #ifndef TIME_STAMP_T
 #define TIME_STAMP_T                UINT32
 #endif
@@ -89,6 +89,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define OPLK_ATOMIC_T    UINT8
 #define OPLK_ATOMIC_EXCHANGE(address, newval, oldval) \
     oldval = __sync_lock_test_and_set(address, newval);
+#define OPLK_ATOMIC_COMPARE_EXCHANGE32(address, oldval, newval, fSuccess) \
+    fSuccess = __sync_bool_compare_and_swap(address, oldval, newval);
+
+#ifdef __KERNEL__
+#define OPLK_MEMBAR()    smp_mb()
+#else
+#define OPLK_MEMBAR()    __sync_synchronize()
+#endif
 
 
 
@@ -106,5 +106,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define OPLK_ATOMIC_T    ULONG
 #define OPLK_ATOMIC_EXCHANGE(address, newval, oldval) \
             oldval = InterlockedExchange(address, newval);
+#define OPLK_ATOMIC_COMPARE_EXCHANGE32(address, oldval, newval, fSuccess) \
+            fSuccess = (InterlockedCompareExchange((volatile LONG*)(address), (LONG)(newval), (LONG)(oldval)) == (LONG)(oldval));
+
+#define OPLK_MEMBAR()    MemoryBarrier()
 
 #endif /* _INC_targetdefs_windows_H_ */
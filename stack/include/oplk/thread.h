@@ -0,0 +1,102 @@
+/**
+********************************************************************************
+\file   thread.h
+
+\brief  Definitions for the real-time thread configuration
+
+This file contains the definitions which are used to configure the scheduling
+policy, priority, CPU affinity and name of the threads created by the stack.
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2014, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+#ifndef _INC_oplk_thread_H_
+#define _INC_oplk_thread_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <oplk/oplkinc.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+/**
+\brief Stack threads
+
+The enumeration lists the threads which can be created by the stack.
+*/
+typedef enum
+{
+    kOplkThreadEventKernel  = 0,    ///< Kernel event thread
+    kOplkThreadEventUser,           ///< User event thread
+    kOplkThreadEdrv,                ///< Ethernet driver receive thread
+    kOplkThreadHresTimer,           ///< High-resolution timer thread(s)
+    kOplkThreadTimerUser,           ///< User timer thread
+    kOplkThreadTpdoWorker,          ///< TPDO worker thread of the MN DLL
+    kOplkThreadLedOutput,           ///< LED output thread of the user LED module
+    kOplkThreadCount                ///< Number of stack threads
+} tOplkThreadId;
+
+/**
+\brief Thread configuration
+
+The structure specifies the configuration of a single stack thread.
+*/
+typedef struct
+{
+    INT                 policy;                 ///< Scheduling policy (e.g. SCHED_FIFO)
+    INT                 priority;               ///< Scheduling priority
+    UINT32              cpuMask;                ///< CPU affinity mask, 0 if the thread shall not be pinned
+    const char*         pName;                  ///< Name of the thread, NULL keeps the name of the process
+} tOplkThreadConfig;
+
+/**
+\brief Real-time thread parameters
+
+The structure specifies the configuration of all threads created by the
+stack and the memory locking of the process. It can be passed to oplk_init()
+in the initialization parameters.
+*/
+typedef struct
+{
+    tOplkThreadConfig   aThread[kOplkThreadCount];  ///< Configuration of the stack threads
+    BOOL                fLockMemory;            ///< Lock all current and future pages of the process with mlockall()
+    UINT                prefaultStackSize;      ///< Stack size in bytes every stack thread prefaults at its start, 0 to disable
+} tOplkThreadParam;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+
+#endif /* _INC_oplk_thread_H_ */
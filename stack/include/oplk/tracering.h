@@ -0,0 +1,154 @@
+/**
+********************************************************************************
+\file   tracering.h
+
+\brief  Definitions for the binary trace ring module
+
+This file contains the definitions for the binary trace ring module. Every
+thread writing trace events gets its own ring buffer in a POSIX shared memory
+object, so events are recorded without locks and can be read by the trace dump
+tool while the stack is running.
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2014, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+#ifndef _INC_oplk_tracering_H_
+#define _INC_oplk_tracering_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <oplk/oplkinc.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TRACERING_SHM_NAME_FORMAT       "/oplkTrace.%d"     // name of the shared memory, formatted with the process ID
+#define TRACERING_MAGIC                 0x4B4C504FUL        // "OPLK"
+#define TRACERING_VERSION               1
+
+#define TRACERING_TIMESTAMP_NS          0                   // timestamps are CLOCK_MONOTONIC in ns
+#define TRACERING_TIMESTAMP_TSC         1                   // timestamps are CPU time stamp counter values
+
+#define TRACERING_BUFFER_SIZE(entryCount_p) \
+            (sizeof(tTraceRingBuffer) + ((entryCount_p) * sizeof(tTraceRingEntry)))
+
+#define TRACERING_GET_BUFFER(pHeader_p, index_p) \
+            ((tTraceRingBuffer*)((BYTE*)(pHeader_p) + sizeof(tTraceRingHeader) + \
+                                 ((index_p) * TRACERING_BUFFER_SIZE((pHeader_p)->entryCount))))
+
+#if (TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__) && (CONFIG_TRACE_RING != FALSE)
+#define TRACE_RING(traceId_p, arg_p)    tracering_write(traceId_p, arg_p)
+#else
+#define TRACE_RING(traceId_p, arg_p)
+#endif
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+/**
+\brief Trace event IDs
+
+The enumeration lists the trace events recorded by the stack. The argument of
+each event is described in its comment.
+*/
+typedef enum
+{
+    kTraceIdSocTransmitted  = 1,        ///< SoC handler of the MN (arg: NMT state)
+    kTraceIdSocReceived,                ///< SoC handler of the CN (arg: NMT state)
+    kTraceIdFrameRx,                    ///< Frame received by Ethernet driver (arg: frame size)
+    kTraceIdFrameTx,                    ///< Frame passed to Ethernet driver (arg: frame size)
+    kTraceIdEventPostKernel,            ///< Kernel event posted (arg: sink << 16 | event type)
+    kTraceIdEventPostUser,              ///< User event posted (arg: sink << 16 | event type)
+    kTraceIdPdoRxCopy,                  ///< RPDO copied from frame (arg: source node ID)
+    kTraceIdPdoTxCopy,                  ///< TPDO copied to frame (arg: destination node ID)
+    kTraceIdSyncSignal,                 ///< Sync event signaled by kernel layer (arg: cycle number)
+    kTraceIdSyncWakeup,                 ///< Application woken up by sync event (arg: cycle number)
+    kTraceIdCount                       ///< Number of trace event IDs
+} tTraceId;
+
+/**
+\brief Trace entry
+
+The structure describes a single trace event.
+*/
+typedef struct
+{
+    UINT64              timestamp;              ///< Timestamp of the event
+    UINT16              traceId;                ///< Trace event ID (\ref tTraceId)
+    UINT16              reserved;               ///< Reserved
+    UINT32              arg;                    ///< Event argument
+} tTraceRingEntry;
+
+/**
+\brief Trace ring buffer
+
+The structure describes the ring buffer of a single thread. It is followed by
+the trace entries. Only the owning thread writes to the buffer. The entry
+belonging to a write count is located at write count modulo entry count.
+*/
+typedef struct
+{
+    volatile UINT32     writeCount;             ///< Number of events written to the ring buffer
+    UINT32              threadId;               ///< Linux thread ID of the owning thread
+} tTraceRingBuffer;
+
+/**
+\brief Trace ring shared memory header
+
+The structure describes the header of the trace ring shared memory. It is
+followed by ringCount ring buffers with entryCount entries each.
+*/
+typedef struct
+{
+    UINT32              magic;                  ///< Magic number (TRACERING_MAGIC)
+    UINT32              version;                ///< Layout version (TRACERING_VERSION)
+    UINT32              entryCount;             ///< Number of entries of each ring buffer, a power of two
+    UINT32              ringCount;              ///< Number of ring buffers
+    volatile UINT32     usedRingCount;          ///< Number of ring buffers assigned to threads
+    UINT32              timestampType;          ///< Type of the timestamps (TRACERING_TIMESTAMP_xxx)
+} tTraceRingHeader;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__) && (CONFIG_TRACE_RING != FALSE)
+void tracering_write(tTraceId traceId_p, UINT32 arg_p);
+void tracering_exit(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_oplk_tracering_H_ */
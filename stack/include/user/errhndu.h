@@ -66,6 +66,9 @@ tOplkError errhndu_init(void);
 // delete instance
 tOplkError errhndu_exit(void);
 
+// read all error objects at once
+tOplkError errhndu_getErrorObjects(tErrHndObjects* pErrorObjects_p);
+
 // object callback functions
 tOplkError errhndu_cbObdAccess(tObdCbParam MEM* pParam_p);
 tOplkError errhndu_mnCnLossPresCbObdAccess(tObdCbParam MEM* pParam_p);
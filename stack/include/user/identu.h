@@ -68,6 +68,8 @@ tOplkError identu_delInstance(void);
 tOplkError identu_reset(void);
 tOplkError identu_getIdentResponse(UINT nodeId_p, tIdentResponse** ppIdentResponse_p);
 tOplkError identu_requestIdentResponse(UINT nodeId_p, tIdentuCbResponse pfnCbResponse_p);
+UINT32     identu_getGeneration(UINT nodeId_p);
+tOplkError identu_copyIdentResponse(UINT nodeId_p, tIdentResponse* pIdentResponse_p);
 UINT32     identu_getRunningRequests(void);
 
 #ifdef __cplusplus
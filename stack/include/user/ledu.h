@@ -49,12 +49,39 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#define LEDU_PATTERN_MAX_PHASES     6           ///< Maximum number of phases of an LED pattern
+#define LEDU_PHASE_CONTINUE         0xFFFFFFFF  ///< Continue with the next phase of the running pattern
 
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
 typedef tOplkError (*tLeduStateChangeCallback) (tLedType ledType_p, BOOL fOn_p);
 
+/**
+\brief LED pattern
+
+The structure describes the output pattern of an LED. The phases alternate
+between on and off, starting with an on phase. A pattern without phases keeps
+the LED off, a pattern with a single phase keeps it on.
+*/
+typedef struct
+{
+    UINT                phaseCount;                             ///< Number of phases of the pattern
+    UINT16              aDuration[LEDU_PATTERN_MAX_PHASES];     ///< Duration of each phase [ms]
+} tLeduPattern;
+
+/**
+\brief LED output event
+
+The structure is the argument of the event kEventTypeLeduOutput, which the LED
+output thread posts to report a changed LED state to the application.
+*/
+typedef struct
+{
+    tLedType            ledType;                                ///< Type of the LED
+    BOOL                fOn;                                    ///< State of the LED
+} tLeduOutputEvent;
+
 //------------------------------------------------------------------------------
 // function prototypes
 //------------------------------------------------------------------------------
@@ -68,6 +95,13 @@ tOplkError ledu_addInstance(tLeduStateChangeCallback pfnCbStateChange_p);
 tOplkError ledu_exit(void);
 tOplkError ledu_cbNmtStateChange(tEventNmtStateChange nmtStateChange_p);
 tOplkError ledu_processEvent(tEvent* pEplEvent_p);
+UINT       ledu_getNextPhase(const tLeduPattern* pPattern_p, UINT phase_p, UINT phaseCount_p);
+
+#if (CONFIG_LEDU_OUTPUT_TASK != FALSE)
+tOplkError ledu_initOutputTask(tLeduStateChangeCallback pfnCbStateChange_p);
+void       ledu_exitOutputTask(void);
+void       ledu_setOutput(tLedType ledType_p, const tLeduPattern* pPattern_p, UINT startPhase_p);
+#endif
 
 #ifdef __cplusplus
 }
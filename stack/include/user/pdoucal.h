@@ -84,7 +84,7 @@ tOplkError pdoucal_getRxPdo(BYTE** ppPdo_p, UINT channelId_p, WORD pdoSize_p);
 // PDO sync functions
 tOplkError pdoucal_initSync(tSyncCb pfnSyncCb_p);
 void       pdoucal_exitSync(void);
-tOplkError pdoucal_waitSyncEvent(ULONG timeout_p);
+tOplkError pdoucal_waitSyncEvent(ULONG timeout_p, tSyncEventInfo* pSyncInfo_p);
 tOplkError pdoucal_callSyncCb(void);
 
 #ifdef __cplusplus
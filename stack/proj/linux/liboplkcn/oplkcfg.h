@@ -68,7 +68,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_INCLUDE_SDO_ASND
 #define CONFIG_INCLUDE_MASND
 
-#define CONFIG_DLLCAL_QUEUE                         CIRCBUF_QUEUE
+#define CONFIG_DLLCAL_QUEUE                         LOCKFREE_QUEUE
 
 #define CONFIG_VETH_SET_DEFAULT_GATEWAY             FALSE
 
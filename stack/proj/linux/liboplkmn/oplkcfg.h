@@ -71,7 +71,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_INCLUDE_VETH
 #define CONFIG_INCLUDE_CFM
 
-#define CONFIG_DLLCAL_QUEUE                         CIRCBUF_QUEUE
+#define CONFIG_DLLCAL_QUEUE                         LOCKFREE_QUEUE
 
 #define CONFIG_VETH_SET_DEFAULT_GATEWAY             FALSE
 
@@ -113,6 +113,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC    FALSE
 #define CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC   FALSE
 
+// MN measures the PReq/PRes latency of each CN
+#define CONFIG_DLL_PRES_LATENCY_STATISTICS          TRUE
+
 //==============================================================================
 // OBD specific defines
 //==============================================================================
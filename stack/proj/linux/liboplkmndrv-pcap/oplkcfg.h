@@ -107,6 +107,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC    FALSE
 #define CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC   FALSE
 
+// MN measures the PReq/PRes latency of each CN
+#define CONFIG_DLL_PRES_LATENCY_STATISTICS          TRUE
+
 //==============================================================================
 // Timer module specific defines
 //==============================================================================
@@ -0,0 +1,488 @@
+/**
+********************************************************************************
+\file   mempool.c
+
+\brief  Memory pools for Linux userspace
+
+The file implements the memory pool module. At stack initialization one arena
+is allocated and prefaulted. It is divided into block size classes, whose block
+counts are configured by CONFIG_MEMPOOL_BLOCKS_*. Every class keeps its free
+blocks in a lock-free list, so allocations of the stack threads do not contend
+on allocator locks and do not take page faults.
+
+Requests which don't fit into a class or find all suitable classes empty are
+served from the heap. While the node is in NMT state operational, such a heap
+allocation is reported as an error. If CONFIG_MEMPOOL_STRICT is enabled, it
+fails in addition.
+
+\ingroup module_target
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2014, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <oplk/oplkinc.h>
+#include <common/mempool.h>
+
+#if (CONFIG_MEMPOOL != FALSE)
+
+#include <stdlib.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define MEMPOOL_ARENA_ALIGNMENT     64      // alignment of the arena (cache line size)
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief Block size class
+
+The structure describes a block size class. The head of the free list contains
+the index of the first free block plus one in the lower 32 bits and a
+modification tag in the upper 32 bits. The tag protects the lock-free list
+against the ABA problem. A free block stores the index of the next free block
+plus one in its first word.
+*/
+typedef struct
+{
+    size_t          blockSize;          ///< Size of the blocks of the class
+    UINT32          blockCount;         ///< Number of blocks of the class
+    BYTE*           pBase;              ///< Start address of the blocks in the arena
+    UINT64          freeHead;           ///< Head of the free list (tag and index)
+    UINT32          usedCount;          ///< Number of currently allocated blocks
+    UINT32          peakCount;          ///< Maximum number of allocated blocks
+    UINT32          exhaustedCount;     ///< Number of allocations which found the class empty
+} tMempoolClass;
+
+/**
+\brief Memory pool instance
+
+The structure contains all information of the memory pool module.
+*/
+typedef struct
+{
+    tMempoolClass   aClass[MEMPOOL_CLASS_COUNT];    ///< Block size classes, ascending block size
+    BYTE*           pArena;             ///< Start address of the arena
+    size_t          arenaSize;          ///< Size of the arena
+    volatile BOOL   fOperational;       ///< Node is in NMT state operational
+    UINT32          heapAllocCount;     ///< Number of allocations served from the heap
+    UINT32          heapViolationCount; ///< Number of heap allocations requested in operational state
+} tMempoolInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tMempoolInstance     instance_l =
+{
+    {
+        { 64,    CONFIG_MEMPOOL_BLOCKS_64,  NULL, 0, 0, 0, 0 },
+        { 256,   CONFIG_MEMPOOL_BLOCKS_256, NULL, 0, 0, 0, 0 },
+        { 1024,  CONFIG_MEMPOOL_BLOCKS_1K,  NULL, 0, 0, 0, 0 },
+        { 4096,  CONFIG_MEMPOOL_BLOCKS_4K,  NULL, 0, 0, 0, 0 },
+        { 16384, CONFIG_MEMPOOL_BLOCKS_16K, NULL, 0, 0, 0, 0 },
+        { 65536, CONFIG_MEMPOOL_BLOCKS_64K, NULL, 0, 0, 0, 0 },
+    },
+    NULL,
+    0,
+    FALSE,
+    0,
+    0
+};
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void*    popBlock(tMempoolClass* pClass_p);
+static void     pushBlock(tMempoolClass* pClass_p, void* pBlock_p);
+static void*    allocHeap(size_t size_p, void* pCaller_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize memory pools
+
+The function allocates the arena of the memory pools, touches all its pages and
+sets up the free lists of the block size classes.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+tOplkError mempool_init(void)
+{
+    tMempoolClass*  pClass;
+    BYTE*           pBase;
+    UINT            classIdx;
+    UINT32          blockIdx;
+    void*           pArena;
+    size_t          arenaSize = 0;
+
+    if (instance_l.pArena != NULL)
+        return kErrorOk;
+
+    for (classIdx = 0; classIdx < MEMPOOL_CLASS_COUNT; classIdx++)
+        arenaSize += instance_l.aClass[classIdx].blockSize * instance_l.aClass[classIdx].blockCount;
+
+    if (posix_memalign(&pArena, MEMPOOL_ARENA_ALIGNMENT, arenaSize) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't allocate memory pool arena!\n", __func__);
+        return kErrorNoResource;
+    }
+
+    // prefault the arena
+    OPLK_MEMSET(pArena, 0, arenaSize);
+
+    pBase = (BYTE*)pArena;
+    for (classIdx = 0; classIdx < MEMPOOL_CLASS_COUNT; classIdx++)
+    {
+        pClass = &instance_l.aClass[classIdx];
+        pClass->pBase = pBase;
+        pClass->usedCount = 0;
+        pClass->peakCount = 0;
+        pClass->exhaustedCount = 0;
+
+        for (blockIdx = 0; blockIdx < pClass->blockCount; blockIdx++)
+        {
+            *(UINT32*)(pBase + (blockIdx * pClass->blockSize)) =
+                        ((blockIdx + 1) < pClass->blockCount) ? (blockIdx + 2) : 0;
+        }
+        pClass->freeHead = (pClass->blockCount > 0) ? 1 : 0;
+
+        pBase += pClass->blockSize * pClass->blockCount;
+    }
+
+    instance_l.arenaSize = arenaSize;
+    instance_l.fOperational = FALSE;
+    instance_l.heapAllocCount = 0;
+    instance_l.heapViolationCount = 0;
+    __atomic_store_n(&instance_l.pArena, (BYTE*)pArena, __ATOMIC_RELEASE);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clean up memory pools
+
+The function reports the usage of the memory pools and frees the arena. If
+blocks are still allocated, the arena is kept to prevent dangling pointers.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+void mempool_exit(void)
+{
+    tMempoolClass*  pClass;
+    UINT            classIdx;
+    UINT32          usedCount = 0;
+
+    if (instance_l.pArena == NULL)
+        return;
+
+    for (classIdx = 0; classIdx < MEMPOOL_CLASS_COUNT; classIdx++)
+    {
+        pClass = &instance_l.aClass[classIdx];
+        DEBUG_LVL_ALWAYS_TRACE("Memory pool %6lu bytes: %4u blocks, peak %4u, exhausted %u\n",
+                               (ULONG)pClass->blockSize, pClass->blockCount,
+                               pClass->peakCount, pClass->exhaustedCount);
+        usedCount += pClass->usedCount;
+    }
+    DEBUG_LVL_ALWAYS_TRACE("Memory pool heap allocations: %u, in operational state: %u\n",
+                           instance_l.heapAllocCount, instance_l.heapViolationCount);
+
+    instance_l.fOperational = FALSE;
+    if (usedCount != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() %u blocks still allocated, arena is not freed!\n",
+                              __func__, usedCount);
+        return;
+    }
+
+    free(instance_l.pArena);
+    instance_l.pArena = NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Allocate memory
+
+The function allocates a block from the smallest block size class which fits
+the requested size. If no block is available, the request is served from the
+heap unless the node is operational.
+
+\param  size_p              Size of the requested memory.
+
+\return The function returns the pointer to the memory or NULL on error.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+void* mempool_alloc(size_t size_p)
+{
+    tMempoolClass*  pClass;
+    UINT            classIdx;
+    void*           pBlock;
+    UINT32          usedCount;
+
+    if (__atomic_load_n(&instance_l.pArena, __ATOMIC_ACQUIRE) == NULL)
+        return allocHeap(size_p, __builtin_return_address(0));
+
+    for (classIdx = 0; classIdx < MEMPOOL_CLASS_COUNT; classIdx++)
+    {
+        pClass = &instance_l.aClass[classIdx];
+        if (pClass->blockSize < size_p)
+            continue;
+
+        if ((pBlock = popBlock(pClass)) != NULL)
+        {
+            usedCount = __atomic_add_fetch(&pClass->usedCount, 1, __ATOMIC_RELAXED);
+            if (usedCount > pClass->peakCount)
+                pClass->peakCount = usedCount;
+            return pBlock;
+        }
+
+        __atomic_add_fetch(&pClass->exhaustedCount, 1, __ATOMIC_RELAXED);
+    }
+
+    return allocHeap(size_p, __builtin_return_address(0));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free memory
+
+The function frees memory allocated with mempool_alloc(). Blocks are returned
+to their class, other memory is returned to the heap.
+
+\param  pMem_p              Pointer to the memory to be freed.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+void mempool_free(void* pMem_p)
+{
+    tMempoolClass*  pClass;
+    UINT            classIdx;
+    BYTE*           pArena;
+
+    if (pMem_p == NULL)
+        return;
+
+    pArena = __atomic_load_n(&instance_l.pArena, __ATOMIC_ACQUIRE);
+    if ((pArena == NULL) || ((BYTE*)pMem_p < pArena) ||
+        ((BYTE*)pMem_p >= (pArena + instance_l.arenaSize)))
+    {
+        free(pMem_p);
+        return;
+    }
+
+    for (classIdx = MEMPOOL_CLASS_COUNT; classIdx-- > 0;)
+    {
+        pClass = &instance_l.aClass[classIdx];
+        if ((BYTE*)pMem_p >= pClass->pBase)
+        {
+            pushBlock(pClass, pMem_p);
+            __atomic_sub_fetch(&pClass->usedCount, 1, __ATOMIC_RELAXED);
+            return;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set operational state
+
+The function informs the memory pool module whether the node is in NMT state
+operational. In this state heap allocations are reported as errors.
+
+\param  fOperational_p      TRUE if the node is operational.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+void mempool_setOperational(BOOL fOperational_p)
+{
+    instance_l.fOperational = fOperational_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get memory pool statistics
+
+The function returns the statistics of the memory pools.
+
+\param  pStatistics_p       Pointer to store the statistics.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+void mempool_getStatistics(tMempoolStatistics* pStatistics_p)
+{
+    tMempoolClass*  pClass;
+    UINT            classIdx;
+
+    for (classIdx = 0; classIdx < MEMPOOL_CLASS_COUNT; classIdx++)
+    {
+        pClass = &instance_l.aClass[classIdx];
+        pStatistics_p->aClass[classIdx].blockSize = pClass->blockSize;
+        pStatistics_p->aClass[classIdx].blockCount = pClass->blockCount;
+        pStatistics_p->aClass[classIdx].usedCount = pClass->usedCount;
+        pStatistics_p->aClass[classIdx].peakCount = pClass->peakCount;
+        pStatistics_p->aClass[classIdx].exhaustedCount = pClass->exhaustedCount;
+    }
+    pStatistics_p->heapAllocCount = instance_l.heapAllocCount;
+    pStatistics_p->heapViolationCount = instance_l.heapViolationCount;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Take block from free list
+
+\param  pClass_p            Pointer to block size class.
+
+\return The function returns the pointer to the block or NULL if the class is
+        empty.
+*/
+//------------------------------------------------------------------------------
+static void* popBlock(tMempoolClass* pClass_p)
+{
+    UINT64      head;
+    UINT64      newHead;
+    UINT32      index;
+    UINT32      next;
+
+    head = __atomic_load_n(&pClass_p->freeHead, __ATOMIC_ACQUIRE);
+    do
+    {
+        index = (UINT32)head;
+        if (index == 0)
+            return NULL;
+
+        next = __atomic_load_n((UINT32*)(pClass_p->pBase + ((index - 1) * pClass_p->blockSize)),
+                               __ATOMIC_RELAXED);
+        newHead = (((head >> 32) + 1) << 32) | next;
+    } while (!__atomic_compare_exchange_n(&pClass_p->freeHead, &head, newHead, TRUE,
+                                          __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+    return pClass_p->pBase + ((index - 1) * pClass_p->blockSize);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Return block to free list
+
+\param  pClass_p            Pointer to block size class.
+\param  pBlock_p            Pointer to the block.
+*/
+//------------------------------------------------------------------------------
+static void pushBlock(tMempoolClass* pClass_p, void* pBlock_p)
+{
+    UINT64      head;
+    UINT64      newHead;
+    UINT32      index;
+
+    index = (UINT32)(((BYTE*)pBlock_p - pClass_p->pBase) / pClass_p->blockSize) + 1;
+
+    head = __atomic_load_n(&pClass_p->freeHead, __ATOMIC_RELAXED);
+    do
+    {
+        __atomic_store_n((UINT32*)pBlock_p, (UINT32)head, __ATOMIC_RELAXED);
+        newHead = (((head >> 32) + 1) << 32) | index;
+    } while (!__atomic_compare_exchange_n(&pClass_p->freeHead, &head, newHead, TRUE,
+                                          __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Allocate memory from heap
+
+The function allocates memory from the heap. If the node is operational, the
+allocation is reported as an error.
+
+\param  size_p              Size of the requested memory.
+\param  pCaller_p           Return address of the caller, used for the error report.
+
+\return The function returns the pointer to the memory or NULL on error.
+*/
+//------------------------------------------------------------------------------
+static void* allocHeap(size_t size_p, void* pCaller_p)
+{
+    UNUSED_PARAMETER(pCaller_p);
+
+    if (instance_l.fOperational)
+    {
+        __atomic_add_fetch(&instance_l.heapViolationCount, 1, __ATOMIC_RELAXED);
+        DEBUG_LVL_ERROR_TRACE("%s() heap allocation of %lu bytes in operational state (caller %p)!\n",
+                              __func__, (ULONG)size_p, pCaller_p);
+#if (CONFIG_MEMPOOL_STRICT != FALSE)
+        return NULL;
+#endif
+    }
+
+    __atomic_add_fetch(&instance_l.heapAllocCount, 1, __ATOMIC_RELAXED);
+    return malloc(size_p);
+}
+
+///\}
+
+#endif
@@ -0,0 +1,420 @@
+/**
+********************************************************************************
+\file   shmem.c
+
+\brief  Shared memory allocator for Linux userspace
+
+The file implements the shared memory allocator used by the POSIX shared memory
+CAL modules. A region is a named shared memory object which is mapped by the
+kernel and the user part of the stack. The allocator prepares the regions for
+the real-time path so that the first cycles do not suffer from page faults and
+TLB misses:
+
+- If CONFIG_SHMEM_HUGEPAGES is enabled, the object is created in the hugetlbfs
+  mount CONFIG_SHMEM_HUGETLBFS_PATH. If this fails, a normal POSIX shared
+  memory object is used.
+- If CONFIG_SHMEM_PREFAULT is enabled, all pages are populated on mapping.
+- If CONFIG_SHMEM_LOCK is enabled, the region is locked into RAM.
+- If CONFIG_SHMEM_NUMA_LOCAL is enabled, the pages are allocated on the NUMA
+  node of the calling thread.
+
+Every mapped region is reported with its layout.
+
+\ingroup module_target
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2014, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <oplk/oplkinc.h>
+#include <common/shmem.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/vfs.h>
+#include <sys/syscall.h>
+
+#if (CONFIG_SHMEM_NUMA_LOCAL != FALSE)
+#include <linux/mempolicy.h>
+#endif
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define SHMEM_ACCESS_MODE       (S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP)
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static int  openObject(tShmemRegion* pRegion_p, int flags_p);
+static int  setLocalNodePolicy(void);
+static void resetNodePolicy(void);
+static int  getNode(void* pAddr_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Map shared memory region
+
+The function opens or creates the specified shared memory object according to
+the mapping mode and maps it into the address space of the calling process.
+
+\param  pName_p             Name of the shared memory object. It must start
+                            with a slash.
+\param  size_p              Size of the region. In mode kShmemModeAttach a size
+                            of 0 maps the whole object.
+\param  mode_p              Mapping mode.
+\param  pRegion_p           Pointer to the region descriptor to be filled.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk              The region was mapped.
+\retval kErrorNoResource      The region couldn't be mapped.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+tOplkError shmem_map(const char* pName_p, size_t size_p, tShmemMode mode_p,
+                     tShmemRegion* pRegion_p)
+{
+    struct stat     stat;
+    int             mmapFlags;
+    BOOL            fNodePolicy = FALSE;
+    void*           pMem;
+
+    OPLK_MEMSET(pRegion_p, 0, sizeof(tShmemRegion));
+    pRegion_p->fd = -1;
+    pRegion_p->numaNode = -1;
+
+    if (strlen(pName_p) >= sizeof(pRegion_p->aName))
+        return kErrorNoResource;
+    strcpy(pRegion_p->aName, pName_p);
+
+    if (openObject(pRegion_p, (mode_p == kShmemModeAttach) ? O_RDWR : (O_RDWR | O_CREAT)) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() opening %s failed! (%s)\n", __func__, pName_p, strerror(errno));
+        return kErrorNoResource;
+    }
+
+    if (fstat(pRegion_p->fd, &stat) != 0)
+        goto ExitClose;
+
+    if ((mode_p == kShmemModeAttach) && (size_p == 0))
+        size_p = (size_t)stat.st_size;
+
+    if (size_p == 0)
+        goto ExitClose;
+
+    pRegion_p->size = size_p;
+    pRegion_p->mapSize = (size_p + pRegion_p->pageSize - 1) & ~(pRegion_p->pageSize - 1);
+
+    switch (mode_p)
+    {
+        case kShmemModeCreate:
+            pRegion_p->fCreator = (stat.st_size == 0);
+            if ((size_t)stat.st_size != pRegion_p->mapSize)
+            {
+                if (ftruncate(pRegion_p->fd, pRegion_p->mapSize) != 0)
+                    goto ExitUnlink;
+            }
+            break;
+
+        case kShmemModeOpen:
+            if (stat.st_size == 0)
+            {
+                pRegion_p->fCreator = TRUE;
+                if (ftruncate(pRegion_p->fd, pRegion_p->mapSize) != 0)
+                    goto ExitUnlink;
+            }
+            else if ((size_t)stat.st_size < size_p)
+            {
+                goto ExitClose;
+            }
+            break;
+
+        case kShmemModeAttach:
+        default:
+            if ((size_t)stat.st_size < size_p)
+                goto ExitClose;
+            break;
+    }
+
+    mmapFlags = MAP_SHARED;
+#if (CONFIG_SHMEM_PREFAULT != FALSE)
+    mmapFlags |= MAP_POPULATE;
+#endif
+
+    // pages populated by the mapping are allocated according to the thread policy
+    if (CONFIG_SHMEM_NUMA_LOCAL != FALSE)
+        fNodePolicy = (setLocalNodePolicy() == 0);
+
+    pMem = mmap(NULL, pRegion_p->mapSize, PROT_READ | PROT_WRITE, mmapFlags, pRegion_p->fd, 0);
+    if ((pMem != MAP_FAILED) && (CONFIG_SHMEM_LOCK != FALSE))
+    {
+        if (mlock(pMem, pRegion_p->mapSize) == 0)
+        {
+            pRegion_p->fLocked = TRUE;
+        }
+        else
+        {
+            DEBUG_LVL_ERROR_TRACE("%s() locking %s failed! (%s)\n", __func__, pName_p, strerror(errno));
+        }
+    }
+
+    if (fNodePolicy)
+        resetNodePolicy();
+
+    if (pMem == MAP_FAILED)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() mapping %s failed! (%s)\n", __func__, pName_p, strerror(errno));
+        goto ExitUnlink;
+    }
+
+    pRegion_p->pBase = pMem;
+    pRegion_p->numaNode = getNode(pMem);
+
+    DEBUG_LVL_ALWAYS_TRACE("Shared memory %-16s at %p size %8lu map %8lu page %7lu%s%s%s node %d\n",
+                           pName_p, pMem, (ULONG)pRegion_p->size, (ULONG)pRegion_p->mapSize,
+                           (ULONG)pRegion_p->pageSize,
+                           pRegion_p->fHugePages ? " huge" : "",
+                           pRegion_p->fLocked ? " locked" : "",
+                           pRegion_p->fCreator ? " created" : "",
+                           pRegion_p->numaNode);
+    return kErrorOk;
+
+ExitUnlink:
+    if (pRegion_p->fCreator)
+        shmem_unlink(pName_p);
+
+ExitClose:
+    close(pRegion_p->fd);
+    pRegion_p->fd = -1;
+    return kErrorNoResource;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Unmap shared memory region
+
+The function unmaps a shared memory region. The shared memory object itself is
+not removed, see shmem_unlink().
+
+\param  pRegion_p           Pointer to the region descriptor.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+void shmem_unmap(tShmemRegion* pRegion_p)
+{
+    if (pRegion_p->pBase != NULL)
+    {
+        munmap(pRegion_p->pBase, pRegion_p->mapSize);
+        pRegion_p->pBase = NULL;
+    }
+
+    if (pRegion_p->fd >= 0)
+    {
+        close(pRegion_p->fd);
+        pRegion_p->fd = -1;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Remove shared memory object
+
+The function removes the name of the specified shared memory object. Existing
+mappings stay valid until they are unmapped.
+
+\param  pName_p             Name of the shared memory object.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+void shmem_unlink(const char* pName_p)
+{
+#if (CONFIG_SHMEM_HUGEPAGES != FALSE)
+    char    aPath[sizeof(CONFIG_SHMEM_HUGETLBFS_PATH) + SHMEM_MAX_NAME_LEN];
+
+    snprintf(aPath, sizeof(aPath), "%s%s", CONFIG_SHMEM_HUGETLBFS_PATH, pName_p);
+    unlink(aPath);
+#endif
+
+    shm_unlink(pName_p);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Open shared memory object
+
+The function opens the shared memory object of a region and determines the
+page size backing it. If huge pages are enabled, the object is opened in the
+hugetlbfs mount first.
+
+\param  pRegion_p           Pointer to the region descriptor.
+\param  flags_p             Open flags.
+
+\return The function returns the file descriptor or -1 on error.
+*/
+//------------------------------------------------------------------------------
+static int openObject(tShmemRegion* pRegion_p, int flags_p)
+{
+#if (CONFIG_SHMEM_HUGEPAGES != FALSE)
+    char            aPath[sizeof(CONFIG_SHMEM_HUGETLBFS_PATH) + SHMEM_MAX_NAME_LEN];
+    struct statfs   fsStat;
+
+    snprintf(aPath, sizeof(aPath), "%s%s", CONFIG_SHMEM_HUGETLBFS_PATH, pRegion_p->aName);
+    if ((pRegion_p->fd = open(aPath, flags_p, SHMEM_ACCESS_MODE)) >= 0)
+    {
+        if ((fstatfs(pRegion_p->fd, &fsStat) == 0) && (fsStat.f_bsize > 0))
+        {
+            pRegion_p->pageSize = (size_t)fsStat.f_bsize;
+            pRegion_p->fHugePages = TRUE;
+            return pRegion_p->fd;
+        }
+        close(pRegion_p->fd);
+    }
+#endif
+
+    pRegion_p->pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    pRegion_p->fd = shm_open(pRegion_p->aName, flags_p, SHMEM_ACCESS_MODE);
+    return pRegion_p->fd;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Prefer NUMA node of the calling thread
+
+The function sets the memory policy of the calling thread to prefer the NUMA
+node of the CPU it is currently running on.
+
+\return The function returns 0 on success or -1 on error.
+*/
+//------------------------------------------------------------------------------
+static int setLocalNodePolicy(void)
+{
+#if (CONFIG_SHMEM_NUMA_LOCAL != FALSE)
+    unsigned int    cpu;
+    unsigned int    node;
+    unsigned long   nodeMask;
+
+    if ((syscall(SYS_getcpu, &cpu, &node, NULL) != 0) ||
+        (node >= (sizeof(nodeMask) * 8)))
+        return -1;
+
+    nodeMask = 1UL << node;
+    return (int)syscall(SYS_set_mempolicy, MPOL_PREFERRED, &nodeMask, sizeof(nodeMask) * 8);
+#else
+    return -1;
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reset NUMA memory policy
+
+The function resets the memory policy of the calling thread to the default
+policy.
+*/
+//------------------------------------------------------------------------------
+static void resetNodePolicy(void)
+{
+#if (CONFIG_SHMEM_NUMA_LOCAL != FALSE)
+    syscall(SYS_set_mempolicy, MPOL_DEFAULT, NULL, 0);
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get NUMA node of address
+
+The function determines the NUMA node of the page at the specified address.
+
+\param  pAddr_p             Address to query.
+
+\return The function returns the NUMA node or -1 if it is unknown.
+*/
+//------------------------------------------------------------------------------
+static int getNode(void* pAddr_p)
+{
+#if (CONFIG_SHMEM_NUMA_LOCAL != FALSE)
+    int     node = -1;
+
+    if (syscall(SYS_get_mempolicy, &node, NULL, 0, pAddr_p, MPOL_F_NODE | MPOL_F_ADDR) != 0)
+        return -1;
+    return node;
+#else
+    UNUSED_PARAMETER(pAddr_p);
+    return -1;
+#endif
+}
+
+///\}
@@ -42,7 +42,51 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <unistd.h>
 #include <fcntl.h>
 #include <signal.h>
+#include <time.h>
+#include <errno.h>
+#include <sched.h>
+#include <alloca.h>
+#include <sys/mman.h>
 #include <oplk/oplk.h>
+#include <common/target.h>
+#include <oplk/tracering.h>
+#include <common/mempool.h>
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#if CONFIG_DLL_TPDO_WORKER_CPU >= 0
+#define TARGET_TPDO_WORKER_CPU_MASK     (1UL << CONFIG_DLL_TPDO_WORKER_CPU)
+#else
+#define TARGET_TPDO_WORKER_CPU_MASK     0
+#endif
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static const tOplkThreadParam   defaultThreadParam_l =
+{
+    {
+        { SCHED_FIFO, CONFIG_THREAD_PRIORITY_EVENT_KERNEL, 0, "oplk-eventk" },   // kOplkThreadEventKernel
+        { SCHED_FIFO, CONFIG_THREAD_PRIORITY_EVENT_USER, 0, "oplk-eventu" },     // kOplkThreadEventUser
+        { SCHED_FIFO, CONFIG_THREAD_PRIORITY_MEDIUM, 0, "oplk-edrv" },           // kOplkThreadEdrv
+        { SCHED_FIFO, CONFIG_THREAD_PRIORITY_HIGH, 0, "oplk-hrestimer" },        // kOplkThreadHresTimer
+        { SCHED_RR, CONFIG_THREAD_PRIORITY_LOW, 0, "oplk-timeru" },              // kOplkThreadTimerUser
+        { SCHED_FIFO, CONFIG_THREAD_PRIORITY_TPDO_WORKER,
+          TARGET_TPDO_WORKER_CPU_MASK, "oplk-tpdo" },                            // kOplkThreadTpdoWorker
+        { SCHED_OTHER, 0, 0, "oplk-led" },                                       // kOplkThreadLedOutput
+    },
+    FALSE,
+    0
+};
+
+static tOplkThreadParam         threadParam_l;
+static const tOplkThreadParam*  pThreadParam_l = &defaultThreadParam_l;
+static BOOL                     fMemoryLocked_l = FALSE;
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -72,6 +116,10 @@ tOplkError target_init(void)
     sigaddset(&mask, SIGRTMIN + 1);
     pthread_sigmask(SIG_BLOCK, &mask, NULL);
 
+#if (CONFIG_MEMPOOL != FALSE)
+    Ret = mempool_init();
+#endif
+
     return Ret;
 }
 
@@ -87,9 +135,160 @@ The function cleans-up target specific stuff.
 tOplkError target_cleanup(void)
 {
     tOplkError  Ret  = kErrorOk;
+
+    if (fMemoryLocked_l)
+    {
+        munlockall();
+        fMemoryLocked_l = FALSE;
+    }
+
+#if (CONFIG_MEMPOOL != FALSE)
+    mempool_exit();
+#endif
+
+#if (CONFIG_TRACE_RING != FALSE)
+    tracering_exit();
+#endif
+
     return Ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Set real-time thread parameters
+
+The function sets the configuration which is applied to the threads created by
+the stack afterwards. If requested, all current and future pages of the process
+are locked into memory.
+
+\param  pThreadParam_p      Pointer to the thread parameters. If NULL, the
+                            default configuration is used.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk            Thread parameters successfully set.
+\retval kErrorNoResource    Memory couldn't be locked.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+tOplkError target_setThreadParam(const tOplkThreadParam* pThreadParam_p)
+{
+    if (pThreadParam_p == NULL)
+    {
+        pThreadParam_l = &defaultThreadParam_l;
+    }
+    else
+    {
+        OPLK_MEMCPY(&threadParam_l, pThreadParam_p, sizeof(threadParam_l));
+        pThreadParam_l = &threadParam_l;
+    }
+
+    if (pThreadParam_l->fLockMemory && !fMemoryLocked_l)
+    {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+        {
+            DEBUG_LVL_ERROR_TRACE("%s() couldn't lock memory!\n", __func__);
+            return kErrorNoResource;
+        }
+        fMemoryLocked_l = TRUE;
+    }
+    else if (!pThreadParam_l->fLockMemory && fMemoryLocked_l)
+    {
+        munlockall();
+        fMemoryLocked_l = FALSE;
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set up a stack thread
+
+The function applies the scheduling policy, priority, CPU affinity and name
+configured for the specified stack thread. It is called by the modules after
+creating their threads. Failures to set the CPU affinity or the name are only
+reported.
+
+\param  thread_p            Thread which shall be set up.
+\param  threadId_p          Identifies the configuration of the thread.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                Thread successfully set up.
+\retval kErrorNoResource        Scheduling parameters couldn't be set.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+tOplkError target_setupThread(pthread_t thread_p, tOplkThreadId threadId_p)
+{
+    const tOplkThreadConfig*    pConfig;
+    struct sched_param          schedParam;
+    cpu_set_t                   cpuSet;
+    UINT                        cpu;
+    tOplkError                  ret = kErrorOk;
+
+    if (threadId_p >= kOplkThreadCount)
+        return kErrorInvalidInstanceParam;
+
+    pConfig = &pThreadParam_l->aThread[threadId_p];
+
+    schedParam.sched_priority = pConfig->priority;
+    if (pthread_setschedparam(thread_p, pConfig->policy, &schedParam) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't set scheduling parameters of thread %d! %d\n",
+                              __func__, threadId_p, pConfig->priority);
+        ret = kErrorNoResource;
+    }
+
+    if (pConfig->cpuMask != 0)
+    {
+        CPU_ZERO(&cpuSet);
+        for (cpu = 0; cpu < 32; cpu++)
+        {
+            if ((pConfig->cpuMask & (1UL << cpu)) != 0)
+                CPU_SET(cpu, &cpuSet);
+        }
+
+        if (pthread_setaffinity_np(thread_p, sizeof(cpuSet), &cpuSet) != 0)
+        {
+            DEBUG_LVL_ERROR_TRACE("%s() couldn't set CPU affinity of thread %d! 0x%08X\n",
+                                  __func__, threadId_p, pConfig->cpuMask);
+        }
+    }
+
+    if (pConfig->pName != NULL)
+        pthread_setname_np(thread_p, pConfig->pName);
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Prefault the stack of the calling thread
+
+The function touches every page of the configured stack size of the calling
+thread, so no page faults occur on the stack during real-time operation. It
+is called by the stack threads at their start.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+void target_prefaultThreadStack(void)
+{
+    volatile BYTE*  pStack;
+    size_t          pageSize;
+    size_t          offset;
+
+    if (pThreadParam_l->prefaultStackSize == 0)
+        return;
+
+    pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    pStack = (volatile BYTE*)alloca(pThreadParam_l->prefaultStackSize);
+    for (offset = 0; offset < pThreadParam_l->prefaultStackSize; offset += pageSize)
+        pStack[offset] = 0;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief Sleep for the specified number of milliseconds
@@ -104,39 +303,153 @@ milliseconds have elapsed.
 //------------------------------------------------------------------------------
 void target_msleep(UINT32 milliSeconds_p)
 {
-    struct  timeval timeout;
-    fd_set          readFds;
-    int             maxFd;
-    int             selectRetVal;
-    unsigned int    seconds;
-    unsigned int    microSeconds;
-
-    // initialize file descriptor set
-    maxFd = 0 + 1;
-    FD_ZERO(&readFds);
-
-    // Calculate timeout values
-    seconds = milliSeconds_p / 1000;
-    microSeconds = (milliSeconds_p - (seconds * 1000)) * 1000;
-
-    // initialize timeout value
-    timeout.tv_sec = seconds;
-    timeout.tv_usec = microSeconds;
-
-    selectRetVal = select(maxFd, &readFds, NULL, NULL, &timeout);
-    switch (selectRetVal)
+    target_sleepUntil(target_getTickCountUs() + ((ULONGLONG)milliSeconds_p * 1000ULL));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief Sleep for the specified number of microseconds
+
+The function makes the calling thread sleep until the number of specified
+microseconds have elapsed.
+
+\param  microSeconds_p      Number of microseconds to sleep
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+void target_usleep(UINT32 microSeconds_p)
+{
+    target_sleepUntil(target_getTickCountUs() + (ULONGLONG)microSeconds_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief Sleep until an absolute point in time
+
+The function makes the calling thread sleep until the specified deadline has
+been reached. The deadline refers to the time base of target_getTickCountUs().
+As the wait is absolute, it is resumed with the original deadline if it is
+interrupted by a signal. Periodic polling loops shall advance their deadline by
+a fixed period so that they do not drift.
+
+\param  deadlineUs_p        Deadline in microseconds
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+void target_sleepUntil(ULONGLONG deadlineUs_p)
+{
+    struct timespec     deadline;
+
+    deadline.tv_sec = (time_t)(deadlineUs_p / 1000000ULL);
+    deadline.tv_nsec = (long)((deadlineUs_p % 1000000ULL) * 1000ULL);
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR)
+        ;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief Poll a condition until it is fulfilled or a timeout expires
+
+The function calls the condition callback immediately and then periodically
+until it returns TRUE or the timeout expires. The condition is checked at
+absolute deadlines so that the poll period does not drift.
+
+\param  pfnCondition_p      Condition callback
+\param  pArg_p              Argument passed to the condition callback
+\param  periodUs_p          Poll period in microseconds
+\param  timeoutUs_p         Timeout in microseconds
+
+\return Returns TRUE if the condition is fulfilled, FALSE if the timeout expired.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+BOOL target_pollUntil(tTargetPollCondition pfnCondition_p, void* pArg_p,
+                      UINT32 periodUs_p, ULONGLONG timeoutUs_p)
+{
+    ULONGLONG       deadline;
+    ULONGLONG       timeout;
+
+    deadline = target_getTickCountUs();
+    timeout = deadline + timeoutUs_p;
+
+    for (;;)
     {
-        case 0:     // select timeout occurred, no packet received
-            break;
+        if (pfnCondition_p(pArg_p))
+            return TRUE;
 
-        case -1:    // select error occurred
-            break;
+        if (deadline >= timeout)
+            return FALSE;
 
-        default:    // packet available for receive
-            break;
+        deadline += periodUs_p;
+        target_sleepUntil(deadline);
     }
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief    Get current system tick in microseconds
+
+This function returns the current system tick of the monotonic clock in
+microseconds. Unlike target_getTickCount() it does not wrap around.
+
+\return Returns the system tick in microseconds
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+ULONGLONG target_getTickCountUs(void)
+{
+    struct timespec     curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+
+    return ((ULONGLONG)curTime.tv_sec * 1000000ULL) + (ULONGLONG)(curTime.tv_nsec / 1000);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Get current system tick
+
+This function returns the current system tick determined by the system timer.
+
+\return Returns the system tick in milliseconds
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+UINT32 target_getTickCount(void)
+{
+    struct timespec     curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+
+    return (UINT32)((curTime.tv_sec * 1000) + (curTime.tv_nsec / 1000000));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get current timestamp
+
+The function returns the current timestamp in nanoseconds.
+
+\return The function returns the timestamp in nanoseconds
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+ULONGLONG target_getCurrentTimestamp(void)
+{
+    struct timespec     curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+
+    return ((ULONGLONG)curTime.tv_sec * 1000000000ULL) + (ULONGLONG)curTime.tv_nsec;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Set IP address of specified Ethernet interface
@@ -0,0 +1,291 @@
+/**
+********************************************************************************
+\file   tracering.c
+
+\brief  Binary trace ring for Linux userspace
+
+The file implements the binary trace ring module. On the first trace event of
+a process a POSIX shared memory object is created which holds a ring buffer
+for every thread writing trace events. A thread is assigned its ring buffer on
+its first trace event. As only the owning thread writes to a ring buffer, no
+locks are needed. The trace dump tool maps the shared memory object to read
+the events.
+
+\ingroup module_debug
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2014, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <oplk/oplkinc.h>
+#include <oplk/tracering.h>
+
+#if (CONFIG_TRACE_RING != FALSE)
+
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#if ((CONFIG_TRACE_RING_ENTRIES & (CONFIG_TRACE_RING_ENTRIES - 1)) != 0)
+#error "CONFIG_TRACE_RING_ENTRIES must be a power of two!"
+#endif
+
+#if (CONFIG_TRACE_RING_USE_TSC != FALSE) && (defined(__i386__) || defined(__x86_64__))
+#define TRACERING_TIMESTAMP_TYPE        TRACERING_TIMESTAMP_TSC
+#else
+#define TRACERING_TIMESTAMP_TYPE        TRACERING_TIMESTAMP_NS
+#endif
+
+#define TRACERING_SHM_SIZE              (sizeof(tTraceRingHeader) + \
+                                         (CONFIG_TRACE_RING_THREADS * \
+                                          TRACERING_BUFFER_SIZE(CONFIG_TRACE_RING_ENTRIES)))
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static pthread_once_t               mapOnce_l = PTHREAD_ONCE_INIT;
+static tTraceRingHeader*            pHeader_l = NULL;
+static char                         aShmName_l[32];
+static __thread tTraceRingBuffer*   pThreadRing_l = NULL;
+static __thread BOOL                fThreadRingFailed_l = FALSE;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void                 mapTraceRing(void);
+static tTraceRingBuffer*    attachThread(void);
+static inline UINT64        getTimestamp(void);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write trace event
+
+The function writes a trace event to the ring buffer of the calling thread. If
+the ring buffer is full, the oldest event is overwritten. The function should
+be used by the TRACE_RING() macro only.
+
+\param  traceId_p           Trace event ID.
+\param  arg_p               Event argument.
+
+\ingroup module_debug
+*/
+//------------------------------------------------------------------------------
+void tracering_write(tTraceId traceId_p, UINT32 arg_p)
+{
+    tTraceRingBuffer*   pRing = pThreadRing_l;
+    tTraceRingEntry*    pEntry;
+    UINT32              writeCount;
+
+    if (pRing == NULL)
+    {
+        if (fThreadRingFailed_l || ((pRing = attachThread()) == NULL))
+            return;
+    }
+
+    writeCount = pRing->writeCount;
+    pEntry = (tTraceRingEntry*)(pRing + 1) + (writeCount & (CONFIG_TRACE_RING_ENTRIES - 1));
+    pEntry->timestamp = getTimestamp();
+    pEntry->traceId = (UINT16)traceId_p;
+    pEntry->arg = arg_p;
+
+    // publish the entry after it has been written completely
+    __atomic_store_n(&pRing->writeCount, writeCount + 1, __ATOMIC_RELEASE);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clean up trace ring
+
+The function removes the name of the trace ring shared memory object. The
+mapping stays valid until the process terminates, so threads which are still
+running can continue to write trace events.
+
+\ingroup module_debug
+*/
+//------------------------------------------------------------------------------
+void tracering_exit(void)
+{
+    if (pHeader_l != NULL)
+        shm_unlink(aShmName_l);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Create the trace ring shared memory
+
+The function creates and initializes the trace ring shared memory object of
+the process. It is executed once per process.
+*/
+//------------------------------------------------------------------------------
+static void mapTraceRing(void)
+{
+    int                 fd;
+    void*               pMem;
+    tTraceRingHeader*   pHeader;
+
+    snprintf(aShmName_l, sizeof(aShmName_l), TRACERING_SHM_NAME_FORMAT, (int)getpid());
+
+    if ((fd = shm_open(aShmName_l, O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR)) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't create trace ring shared memory!\n", __func__);
+        return;
+    }
+
+    if (ftruncate(fd, TRACERING_SHM_SIZE) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't size trace ring shared memory!\n", __func__);
+        close(fd);
+        shm_unlink(aShmName_l);
+        return;
+    }
+
+    pMem = mmap(NULL, TRACERING_SHM_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    close(fd);
+    if (pMem == MAP_FAILED)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't map trace ring shared memory!\n", __func__);
+        shm_unlink(aShmName_l);
+        return;
+    }
+
+    pHeader = (tTraceRingHeader*)pMem;
+    pHeader->version = TRACERING_VERSION;
+    pHeader->entryCount = CONFIG_TRACE_RING_ENTRIES;
+    pHeader->ringCount = CONFIG_TRACE_RING_THREADS;
+    pHeader->usedRingCount = 0;
+    pHeader->timestampType = TRACERING_TIMESTAMP_TYPE;
+    OPLK_MEMBAR();
+    pHeader->magic = TRACERING_MAGIC;
+
+    pHeader_l = pHeader;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Assign ring buffer to calling thread
+
+The function assigns a free ring buffer to the calling thread.
+
+\return The function returns the ring buffer of the thread or NULL if no ring
+        buffer is available.
+*/
+//------------------------------------------------------------------------------
+static tTraceRingBuffer* attachThread(void)
+{
+    UINT32              index;
+    tTraceRingBuffer*   pRing;
+
+    pthread_once(&mapOnce_l, mapTraceRing);
+    if (pHeader_l == NULL)
+    {
+        fThreadRingFailed_l = TRUE;
+        return NULL;
+    }
+
+    index = __sync_fetch_and_add(&pHeader_l->usedRingCount, 1);
+    if (index >= pHeader_l->ringCount)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() no trace ring buffer left for thread %ld!\n",
+                              __func__, syscall(SYS_gettid));
+        fThreadRingFailed_l = TRUE;
+        return NULL;
+    }
+
+    pRing = TRACERING_GET_BUFFER(pHeader_l, index);
+    pRing->threadId = (UINT32)syscall(SYS_gettid);
+    pThreadRing_l = pRing;
+
+    return pRing;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get trace timestamp
+
+\return The function returns the current timestamp.
+*/
+//------------------------------------------------------------------------------
+static inline UINT64 getTimestamp(void)
+{
+#if (TRACERING_TIMESTAMP_TYPE == TRACERING_TIMESTAMP_TSC)
+    return __builtin_ia32_rdtsc();
+#else
+    struct timespec     curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+    return ((UINT64)curTime.tv_sec * 1000000000ULL) + (UINT64)curTime.tv_nsec;
+#endif
+}
+
+///\}
+
+#endif
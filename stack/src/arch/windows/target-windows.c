@@ -91,3 +91,41 @@ void target_msleep(UINT32 milliSeconds_p)
     Sleep(milliSeconds_p);
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief    Get current system tick
+
+This function returns the current system tick determined by the system timer.
+
+\return Returns the system tick in milliseconds
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+UINT32 target_getTickCount(void)
+{
+    return GetTickCount();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get current timestamp
+
+The function returns the current timestamp in nanoseconds.
+
+\return The function returns the timestamp in nanoseconds
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+ULONGLONG target_getCurrentTimestamp(void)
+{
+    LARGE_INTEGER   frequency;
+    LARGE_INTEGER   counter;
+
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+
+    return (ULONGLONG)((counter.QuadPart / frequency.QuadPart) * 1000000000ULL) +
+           (ULONGLONG)(((counter.QuadPart % frequency.QuadPart) * 1000000000ULL) / frequency.QuadPart);
+}
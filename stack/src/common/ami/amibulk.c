@@ -0,0 +1,495 @@
+/**
+********************************************************************************
+\file   amibulk.c
+
+\brief  Array conversion functions of the Abstract Memory Interface (ami)
+
+This file implements the ami functions converting arrays of 16, 32 and 64 bit
+values. If the requested byte order matches the host byte order the data is
+simply copied. Otherwise the bytes are swapped with SSSE3 (x86, selected at
+runtime) or NEON (ARM) instructions if available and with scalar code for the
+remaining elements.
+
+\ingroup module_ami
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2014, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <oplk/ami.h>
+
+#if !defined(__KERNEL__) && defined(__GNUC__)
+#if defined(__x86_64__) || defined(__i386__)
+#include <tmmintrin.h>
+#define AMI_SWAP_SSSE3
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define AMI_SWAP_NEON
+#endif
+#endif
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static BOOL isHostLittleEndian(void);
+static void convertArray(void* pDst_p, const void* pSrc_p, UINT elemSize_p,
+                         UINT count_p, BOOL fSwap_p);
+static UINT swapArrayVector(UINT8* pDst_p, const UINT8* pSrc_p, UINT elemSize_p,
+                            UINT count_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief    Set Uint16 array to big endian
+
+Sets an array of 16 bit values to a buffer in big endian
+
+\param[out] pAddr_p         Pointer to the destination buffer
+\param[in]  pData_p         Pointer to the source values
+\param[in]  count_p         Number of values to convert
+
+\ingroup module_ami
+*/
+//------------------------------------------------------------------------------
+void ami_setUint16ArrayBe(void* pAddr_p, const UINT16* pData_p, UINT count_p)
+{
+    convertArray(pAddr_p, pData_p, sizeof(UINT16), count_p, isHostLittleEndian());
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Set Uint16 array to little endian
+
+Sets an array of 16 bit values to a buffer in little endian
+
+\param[out] pAddr_p         Pointer to the destination buffer
+\param[in]  pData_p         Pointer to the source values
+\param[in]  count_p         Number of values to convert
+
+\ingroup module_ami
+*/
+//------------------------------------------------------------------------------
+void ami_setUint16ArrayLe(void* pAddr_p, const UINT16* pData_p, UINT count_p)
+{
+    convertArray(pAddr_p, pData_p, sizeof(UINT16), count_p, !isHostLittleEndian());
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Get Uint16 array from big endian
+
+Reads an array of 16 bit values from a buffer in big endian
+
+\param[in]  pAddr_p         Pointer to the source buffer
+\param[out] pData_p         Pointer to the destination values
+\param[in]  count_p         Number of values to convert
+
+\ingroup module_ami
+*/
+//------------------------------------------------------------------------------
+void ami_getUint16ArrayBe(const void* pAddr_p, UINT16* pData_p, UINT count_p)
+{
+    convertArray(pData_p, pAddr_p, sizeof(UINT16), count_p, isHostLittleEndian());
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Get Uint16 array from little endian
+
+Reads an array of 16 bit values from a buffer in little endian
+
+\param[in]  pAddr_p         Pointer to the source buffer
+\param[out] pData_p         Pointer to the destination values
+\param[in]  count_p         Number of values to convert
+
+\ingroup module_ami
+*/
+//------------------------------------------------------------------------------
+void ami_getUint16ArrayLe(const void* pAddr_p, UINT16* pData_p, UINT count_p)
+{
+    convertArray(pData_p, pAddr_p, sizeof(UINT16), count_p, !isHostLittleEndian());
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Set Uint32 array to big endian
+
+Sets an array of 32 bit values to a buffer in big endian
+
+\param[out] pAddr_p         Pointer to the destination buffer
+\param[in]  pData_p         Pointer to the source values
+\param[in]  count_p         Number of values to convert
+
+\ingroup module_ami
+*/
+//------------------------------------------------------------------------------
+void ami_setUint32ArrayBe(void* pAddr_p, const UINT32* pData_p, UINT count_p)
+{
+    convertArray(pAddr_p, pData_p, sizeof(UINT32), count_p, isHostLittleEndian());
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Set Uint32 array to little endian
+
+Sets an array of 32 bit values to a buffer in little endian
+
+\param[out] pAddr_p         Pointer to the destination buffer
+\param[in]  pData_p         Pointer to the source values
+\param[in]  count_p         Number of values to convert
+
+\ingroup module_ami
+*/
+//------------------------------------------------------------------------------
+void ami_setUint32ArrayLe(void* pAddr_p, const UINT32* pData_p, UINT count_p)
+{
+    convertArray(pAddr_p, pData_p, sizeof(UINT32), count_p, !isHostLittleEndian());
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Get Uint32 array from big endian
+
+Reads an array of 32 bit values from a buffer in big endian
+
+\param[in]  pAddr_p         Pointer to the source buffer
+\param[out] pData_p         Pointer to the destination values
+\param[in]  count_p         Number of values to convert
+
+\ingroup module_ami
+*/
+//------------------------------------------------------------------------------
+void ami_getUint32ArrayBe(const void* pAddr_p, UINT32* pData_p, UINT count_p)
+{
+    convertArray(pData_p, pAddr_p, sizeof(UINT32), count_p, isHostLittleEndian());
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Get Uint32 array from little endian
+
+Reads an array of 32 bit values from a buffer in little endian
+
+\param[in]  pAddr_p         Pointer to the source buffer
+\param[out] pData_p         Pointer to the destination values
+\param[in]  count_p         Number of values to convert
+
+\ingroup module_ami
+*/
+//------------------------------------------------------------------------------
+void ami_getUint32ArrayLe(const void* pAddr_p, UINT32* pData_p, UINT count_p)
+{
+    convertArray(pData_p, pAddr_p, sizeof(UINT32), count_p, !isHostLittleEndian());
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Set Uint64 array to big endian
+
+Sets an array of 64 bit values to a buffer in big endian
+
+\param[out] pAddr_p         Pointer to the destination buffer
+\param[in]  pData_p         Pointer to the source values
+\param[in]  count_p         Number of values to convert
+
+\ingroup module_ami
+*/
+//------------------------------------------------------------------------------
+void ami_setUint64ArrayBe(void* pAddr_p, const UINT64* pData_p, UINT count_p)
+{
+    convertArray(pAddr_p, pData_p, sizeof(UINT64), count_p, isHostLittleEndian());
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Set Uint64 array to little endian
+
+Sets an array of 64 bit values to a buffer in little endian
+
+\param[out] pAddr_p         Pointer to the destination buffer
+\param[in]  pData_p         Pointer to the source values
+\param[in]  count_p         Number of values to convert
+
+\ingroup module_ami
+*/
+//------------------------------------------------------------------------------
+void ami_setUint64ArrayLe(void* pAddr_p, const UINT64* pData_p, UINT count_p)
+{
+    convertArray(pAddr_p, pData_p, sizeof(UINT64), count_p, !isHostLittleEndian());
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Get Uint64 array from big endian
+
+Reads an array of 64 bit values from a buffer in big endian
+
+\param[in]  pAddr_p         Pointer to the source buffer
+\param[out] pData_p         Pointer to the destination values
+\param[in]  count_p         Number of values to convert
+
+\ingroup module_ami
+*/
+//------------------------------------------------------------------------------
+void ami_getUint64ArrayBe(const void* pAddr_p, UINT64* pData_p, UINT count_p)
+{
+    convertArray(pData_p, pAddr_p, sizeof(UINT64), count_p, isHostLittleEndian());
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Get Uint64 array from little endian
+
+Reads an array of 64 bit values from a buffer in little endian
+
+\param[in]  pAddr_p         Pointer to the source buffer
+\param[out] pData_p         Pointer to the destination values
+\param[in]  count_p         Number of values to convert
+
+\ingroup module_ami
+*/
+//------------------------------------------------------------------------------
+void ami_getUint64ArrayLe(const void* pAddr_p, UINT64* pData_p, UINT count_p)
+{
+    convertArray(pData_p, pAddr_p, sizeof(UINT64), count_p, !isHostLittleEndian());
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief    Check host byte order
+
+\return The function returns TRUE on little endian hosts.
+*/
+//------------------------------------------------------------------------------
+static BOOL isHostLittleEndian(void)
+{
+    UINT16  test = 1;
+
+    return (*((UINT8*)&test) == 1);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Convert array
+
+The function copies an array of values and swaps the bytes of each value if
+requested.
+
+\param[out] pDst_p          Pointer to the destination buffer
+\param[in]  pSrc_p          Pointer to the source buffer
+\param[in]  elemSize_p      Size of a single value in bytes (2, 4 or 8)
+\param[in]  count_p         Number of values to convert
+\param[in]  fSwap_p         TRUE if the bytes of each value shall be swapped
+*/
+//------------------------------------------------------------------------------
+static void convertArray(void* pDst_p, const void* pSrc_p, UINT elemSize_p,
+                         UINT count_p, BOOL fSwap_p)
+{
+    UINT8*          pDst = (UINT8*)pDst_p;
+    const UINT8*    pSrc = (const UINT8*)pSrc_p;
+    UINT            index;
+    UINT            byte;
+
+    if (!fSwap_p)
+    {
+        OPLK_MEMCPY(pDst, pSrc, elemSize_p * count_p);
+        return;
+    }
+
+    index = swapArrayVector(pDst, pSrc, elemSize_p, count_p);
+
+    for (pDst += index * elemSize_p, pSrc += index * elemSize_p;
+         index < count_p;
+         index++, pDst += elemSize_p, pSrc += elemSize_p)
+    {
+        for (byte = 0; byte < elemSize_p; byte++)
+            pDst[byte] = pSrc[elemSize_p - 1 - byte];
+    }
+}
+
+#if defined(AMI_SWAP_SSSE3)
+//------------------------------------------------------------------------------
+/**
+\brief    Swap array with SSSE3 instructions
+
+The function swaps the bytes of the values in blocks of 16 bytes by using the
+SSSE3 byte shuffle instruction. It must only be called if the CPU supports
+SSSE3.
+
+\param[out] pDst_p          Pointer to the destination buffer
+\param[in]  pSrc_p          Pointer to the source buffer
+\param[in]  elemSize_p      Size of a single value in bytes (2, 4 or 8)
+\param[in]  count_p         Number of values to convert
+
+\return The function returns the number of converted values.
+*/
+//------------------------------------------------------------------------------
+__attribute__((target("ssse3")))
+static UINT swapArraySsse3(UINT8* pDst_p, const UINT8* pSrc_p, UINT elemSize_p,
+                           UINT count_p)
+{
+    __m128i     mask;
+    UINT        blockCount = (elemSize_p * count_p) / 16;
+    UINT        block;
+
+    switch (elemSize_p)
+    {
+        case 2:
+            mask = _mm_set_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+            break;
+
+        case 4:
+            mask = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+            break;
+
+        case 8:
+            mask = _mm_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+            break;
+
+        default:
+            return 0;
+    }
+
+    for (block = 0; block < blockCount; block++)
+    {
+        __m128i val = _mm_loadu_si128((const __m128i*)(pSrc_p + block * 16));
+
+        _mm_storeu_si128((__m128i*)(pDst_p + block * 16), _mm_shuffle_epi8(val, mask));
+    }
+
+    return (blockCount * 16) / elemSize_p;
+}
+#endif
+
+//------------------------------------------------------------------------------
+/**
+\brief    Swap array with vector instructions
+
+The function swaps the bytes of as many values as possible with the vector
+instructions of the CPU.
+
+\param[out] pDst_p          Pointer to the destination buffer
+\param[in]  pSrc_p          Pointer to the source buffer
+\param[in]  elemSize_p      Size of a single value in bytes (2, 4 or 8)
+\param[in]  count_p         Number of values to convert
+
+\return The function returns the number of converted values. The remaining
+        values have to be converted by the caller.
+*/
+//------------------------------------------------------------------------------
+static UINT swapArrayVector(UINT8* pDst_p, const UINT8* pSrc_p, UINT elemSize_p,
+                            UINT count_p)
+{
+#if defined(AMI_SWAP_SSSE3)
+    if (!__builtin_cpu_supports("ssse3"))
+        return 0;
+
+    return swapArraySsse3(pDst_p, pSrc_p, elemSize_p, count_p);
+#elif defined(AMI_SWAP_NEON)
+    UINT        blockCount = (elemSize_p * count_p) / 16;
+    UINT        block;
+    uint8x16_t  val;
+
+    for (block = 0; block < blockCount; block++)
+    {
+        val = vld1q_u8(pSrc_p + block * 16);
+        switch (elemSize_p)
+        {
+            case 2:
+                val = vrev16q_u8(val);
+                break;
+
+            case 4:
+                val = vrev32q_u8(val);
+                break;
+
+            default:
+                val = vrev64q_u8(val);
+                break;
+        }
+        vst1q_u8(pDst_p + block * 16, val);
+    }
+
+    return (blockCount * 16) / elemSize_p;
+#else
+    UNUSED_PARAMETER(pDst_p);
+    UNUSED_PARAMETER(pSrc_p);
+    UNUSED_PARAMETER(elemSize_p);
+    UNUSED_PARAMETER(count_p);
+
+    return 0;
+#endif
+}
+
+///\}
@@ -41,6 +41,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // includes
 //------------------------------------------------------------------------------
+// Compile the exported functions instead of the inline versions of ami.h
+#define AMI_OUT_OF_LINE
+
 #include <oplk/ami.h>
 
 //============================================================================//
@@ -43,14 +43,11 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <oplk/oplkinc.h>
 
 #include "circbuf-arch.h"
+#include <common/shmem.h>
 
-#include <unistd.h>
-#include <sys/mman.h>
-#include <sys/types.h>
 #include <fcntl.h>           /* For O_* constants */
 #include <sys/stat.h>        /* For mode constants */
 #include <semaphore.h>
-#include <errno.h>
 
 
 //============================================================================//
@@ -76,6 +73,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#define CIRCBUF_HEADER_SIZE     4096    ///< Offset of the buffer in the shared memory region, keeps the header on a separate page
 
 //------------------------------------------------------------------------------
 // local types
@@ -84,7 +82,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 /** \brief Architecture specific part of circular buffer instance */
 typedef struct
 {
-    int                 fd;             ///< Shared memory file descriptor
+    tShmemRegion        shmRegion;      ///< Shared memory region of the buffer
     sem_t               *lockSem;       ///< Semaphore used for locking
 } tCircBufArchInstance;
 
@@ -178,50 +176,20 @@ The function allocates the memory needed for the circular buffer.
 tCircBufError circbuf_allocBuffer(tCircBufInstance* pInstance_p, size_t size_p)
 {
     char                        shmName[16];
-    size_t                      size;
     tCircBufArchInstance*       pArch;
-    size_t                      pageSize;
 
     pArch = (tCircBufArchInstance*)pInstance_p->pCircBufArchInstance;
 
     sprintf (shmName, "/shmCircbuf-%d", pInstance_p->bufferId);
-    pageSize = (sizeof(tCircBufHeader) + sysconf(_SC_PAGE_SIZE) - 1) & (~(sysconf(_SC_PAGE_SIZE) - 1));
-    size = size_p + pageSize;
-
-    if ((pArch->fd = shm_open(shmName, O_RDWR | O_CREAT, 0)) < 0)
-    {
-        TRACE("%s() shm_open failed!\n", __func__);
-        return kCircBufNoResource;
-    }
-
-    if (ftruncate(pArch->fd, size) == -1)
+    if (shmem_map(shmName, CIRCBUF_HEADER_SIZE + size_p, kShmemModeCreate,
+                  &pArch->shmRegion) != kErrorOk)
     {
-        TRACE("%s() ftruncate failed!\n", __func__);
-        close (pArch->fd);
-        shm_unlink(shmName);
+        TRACE("%s() mapping shared memory failed!\n", __func__);
         return kCircBufNoResource;
     }
 
-    pInstance_p->pCircBufHeader = mmap(NULL, sizeof(tCircBufHeader),
-                                       PROT_READ | PROT_WRITE, MAP_SHARED, pArch->fd, 0);
-    if (pInstance_p->pCircBufHeader == MAP_FAILED)
-    {
-        TRACE("%s() mmap header failed!\n", __func__);
-        close (pArch->fd);
-        shm_unlink(shmName);
-        return kCircBufNoResource;
-    }
-
-    pInstance_p->pCircBuf = mmap(NULL, size_p, PROT_READ | PROT_WRITE, MAP_SHARED,
-                                 pArch->fd, pageSize);
-    if (pInstance_p->pCircBuf == MAP_FAILED)
-    {
-        TRACE("%s() mmap buffer failed! (%s)\n", __func__, strerror(errno));
-        munmap(pInstance_p->pCircBufHeader, sizeof(tCircBufHeader));
-        close (pArch->fd);
-        shm_unlink(shmName);
-        return kCircBufNoResource;
-    }
+    pInstance_p->pCircBufHeader = (tCircBufHeader*)pArch->shmRegion.pBase;
+    pInstance_p->pCircBuf = (BYTE*)pArch->shmRegion.pBase + CIRCBUF_HEADER_SIZE;
 
     return kCircBufOk;
 }
@@ -245,10 +213,8 @@ void circbuf_freeBuffer(tCircBufInstance* pInstance_p)
     pArch = (tCircBufArchInstance*)pInstance_p->pCircBufArchInstance;
     sprintf (shmName, "/shmCircbuf-%d", pInstance_p->bufferId);
 
-    munmap(pInstance_p->pCircBuf, pInstance_p->pCircBufHeader->bufferSize);
-    munmap(pInstance_p->pCircBufHeader, sizeof(tCircBufHeader));
-    close (pArch->fd);
-    shm_unlink(shmName);
+    shmem_unmap(&pArch->shmRegion);
+    shmem_unlink(shmName);
 }
 
 //------------------------------------------------------------------------------
@@ -267,38 +233,20 @@ The function connects the calling thread to the circular buffer.
 tCircBufError circbuf_connectBuffer(tCircBufInstance* pInstance_p)
 {
     char                        shmName[16];
-    size_t                      size;
     tCircBufArchInstance*       pArch;
-    size_t                      pageSize;
 
-    pageSize = sysconf(_SC_PAGE_SIZE);
     pArch = (tCircBufArchInstance*)pInstance_p->pCircBufArchInstance;
 
     sprintf (shmName, "/shmCircbuf-%d", pInstance_p->bufferId);
-    if ((pArch->fd = shm_open(shmName, O_RDWR, 0)) < 0)
-    {
-        return kCircBufNoResource;
-    }
-
-    pInstance_p->pCircBufHeader = mmap(NULL, sizeof(tCircBufHeader),
-                                       PROT_READ | PROT_WRITE, MAP_SHARED, pArch->fd, 0);
-    if (pInstance_p->pCircBufHeader == MAP_FAILED)
+    if (shmem_map(shmName, 0, kShmemModeAttach, &pArch->shmRegion) != kErrorOk)
     {
-        close(pArch->fd);
         return kCircBufNoResource;
     }
 
-    size = pInstance_p->pCircBufHeader->bufferSize;
-    pInstance_p->pCircBuf = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED,
-                                 pArch->fd, pageSize);
-    if(pInstance_p->pCircBuf == MAP_FAILED)
-    {
-        munmap(pInstance_p->pCircBufHeader, sizeof(tCircBufHeader));
-        close(pArch->fd);
-        return kCircBufNoResource;
-    }
+    pInstance_p->pCircBufHeader = (tCircBufHeader*)pArch->shmRegion.pBase;
+    pInstance_p->pCircBuf = (BYTE*)pArch->shmRegion.pBase + CIRCBUF_HEADER_SIZE;
 
-     return kCircBufOk;
+    return kCircBufOk;
 }
 
 //------------------------------------------------------------------------------
@@ -317,9 +265,7 @@ void circbuf_disconnectBuffer(tCircBufInstance* pInstance_p)
     tCircBufArchInstance*       pArch;
 
     pArch = (tCircBufArchInstance*)pInstance_p->pCircBufArchInstance;
-    munmap(pInstance_p->pCircBuf, pInstance_p->pCircBufHeader->bufferSize);
-    munmap(pInstance_p->pCircBufHeader, sizeof(tCircBufHeader));
-    close (pArch->fd);
+    shmem_unmap(&pArch->shmRegion);
 }
 
 //------------------------------------------------------------------------------
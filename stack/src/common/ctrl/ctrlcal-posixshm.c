@@ -41,12 +41,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // includes
 //------------------------------------------------------------------------------
 #include <oplk/oplk.h>
-
-#include <unistd.h>
-#include <sys/mman.h>
-#include <sys/types.h>
-#include <fcntl.h>           /* For O_* constants */
-#include <sys/stat.h>
+#include <common/shmem.h>
 
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
@@ -80,10 +75,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
-static int          fd_l;
+static tShmemRegion shmRegion_l;
 static BYTE*        pCtrlMem_l;
-static int          size_l;
-static BOOL         fCreator_l;
 
 //------------------------------------------------------------------------------
 // local function prototypes
@@ -108,47 +101,17 @@ The function initializes the control CAL module.
 //------------------------------------------------------------------------------
 tOplkError ctrlcal_init(UINT size_p)
 {
-    struct stat             stat;
-
-    if ((fd_l = shm_open(CTRL_SHM_NAME, O_RDWR | O_CREAT, 0)) < 0)
-    {
-        DEBUG_LVL_ERROR_TRACE("%s() shm_open failed!\n", __func__);
-        return kErrorNoResource;
-    }
-
-    if (fstat(fd_l, &stat) != 0)
-    {
-        close (fd_l);
-        return kErrorNoResource;
-    }
-
-    if (stat.st_size == 0)
-    {
-        if (ftruncate(fd_l, size_p) == -1)
-        {
-            DEBUG_LVL_ERROR_TRACE("%s() ftruncate failed!\n", __func__);
-            close (fd_l);
-            shm_unlink(CTRL_SHM_NAME);
-            return kErrorNoResource;
-        }
-        fCreator_l = TRUE;
-    }
-
-    pCtrlMem_l = mmap(NULL, size_p, PROT_READ | PROT_WRITE, MAP_SHARED, fd_l, 0);
-    if (pCtrlMem_l == MAP_FAILED)
+    if (shmem_map(CTRL_SHM_NAME, size_p, kShmemModeOpen, &shmRegion_l) != kErrorOk)
     {
-        DEBUG_LVL_ERROR_TRACE("%s() mmap header failed!\n", __func__);
-        close (fd_l);
-        if (fCreator_l)
-            shm_unlink(CTRL_SHM_NAME);
+        DEBUG_LVL_ERROR_TRACE("%s() mapping shared memory failed!\n", __func__);
         return kErrorNoResource;
     }
 
-    if (fCreator_l)
+    pCtrlMem_l = (BYTE*)shmRegion_l.pBase;
+    if (shmRegion_l.fCreator)
     {
         OPLK_MEMSET(pCtrlMem_l, 0, size_p);
     }
-    size_l = size_p;
     return kErrorOk;
 }
 
@@ -169,13 +132,10 @@ tOplkError ctrlcal_exit (void)
 
     if (pCtrlMem_l != NULL)
     {
-        munmap(pCtrlMem_l, size_l);
-        close(fd_l);
-        if (fCreator_l)
-            shm_unlink(CTRL_SHM_NAME);
-        fd_l = 0;
-        pCtrlMem_l = 0;
-        size_l = 0;
+        shmem_unmap(&shmRegion_l);
+        if (shmRegion_l.fCreator)
+            shmem_unlink(CTRL_SHM_NAME);
+        pCtrlMem_l = NULL;
     }
     return ret;
 }
@@ -253,7 +253,12 @@ static char* eventTypeStr_l[] =
     "EventTypeGw309AsciiReq",           // GW309ASCII request
     "EventTypeNmtMnuNodeAdded",         // node was added to isochronous phase by DLL
     "EventTypePdokSetupPdoBuf",         // dealloc PDOs
-    "EventTypePdokControlSync"          // enable/disable the pdokcal sync trigger (arg is pointer to BOOL)
+    "EventTypePdokControlSync",         // enable/disable the pdokcal sync trigger (arg is pointer to BOOL)
+    "EventTypeReleaseRxFrame",          // free receive buffer
+    "EventTypeAsndNotRx",               // didn't receive ASnd frame for DLL user module
+    "EventTypeNmtMnuFlushCmd",          // send coalesced NMT commands
+    "EventTypeErrhndWrite",             // write error handler object
+    "EventTypeLeduOutput"               // LED output changed by the LED output thread
 };
 
 // text strings for POWERLINK states
@@ -0,0 +1,488 @@
+/**
+********************************************************************************
+\file   dllcal-lockfree.c
+
+\brief  Source file for DLL CAL lock-free queue module
+
+This DLL CAL queue implementation provides preallocated fixed-size frame
+slots for each queue instance. It can be used if the user and the kernel layer
+are located in the same process. Neither the producers nor the consumer
+(kernel DLL) take a lock. Producers claim a slot by a compare-and-swap on the
+write counter, a sequence number in each slot tells the consumer when the
+slot content is complete and the producers when the slot is free again.
+
+\ingroup module_dllcal
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2014, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/dllcal.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define DLLCALLOCKFREE_SLOT_SIZE    C_IP_MAX_MTU        ///< Size of a frame slot
+#define DLLCALLOCKFREE_QUEUE_COUNT  3                   ///< Number of DLL CAL queues
+#define DLLCALLOCKFREE_MIN_FRAME    60                  ///< Minimum frame size used to derive the slot count from a buffer budget
+
+#ifndef OPLK_ATOMIC_COMPARE_EXCHANGE32
+#error "The lock-free DLL CAL queue requires OPLK_ATOMIC_COMPARE_EXCHANGE32!"
+#endif
+
+#if ((CONFIG_DLLCAL_SLOT_COUNT_TX_NMT & (CONFIG_DLLCAL_SLOT_COUNT_TX_NMT - 1)) != 0) || \
+    ((CONFIG_DLLCAL_SLOT_COUNT_TX_GEN & (CONFIG_DLLCAL_SLOT_COUNT_TX_GEN - 1)) != 0) || \
+    ((CONFIG_DLLCAL_SLOT_COUNT_TX_SYNC & (CONFIG_DLLCAL_SLOT_COUNT_TX_SYNC - 1)) != 0)
+#error "The number of DLL CAL queue slots must be a power of 2!"
+#endif
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief DLL CAL queue slot
+
+The structure contains a frame slot of a lock-free queue. The sequence number
+of slot i is i + 1 + n * slotCount if the frame of write count i + n * slotCount
+is ready for the consumer, and i + n * slotCount if the slot is free for that
+write count.
+*/
+typedef struct
+{
+    volatile UINT32     sequence;                               ///< Sequence number of the slot
+    UINT                frameSize;                              ///< Size of the frame in the slot
+    UINT8               aFrame[DLLCALLOCKFREE_SLOT_SIZE];       ///< Frame buffer
+} tDllCalLockFreeSlot;
+
+/**
+\brief DLL CAL lock-free queue instance
+
+The structure describes a lock-free queue. The producers claim slots by
+incrementing writeCount with a compare-and-swap, only the consumer writes
+readCount. Both counters run freely, the slot index is obtained by masking them
+with the slot count.
+*/
+typedef struct
+{
+    tDllCalLockFreeSlot*    pSlots;                 ///< Preallocated frame slots
+    UINT32                  slotMask;               ///< Number of slots - 1
+    volatile UINT32         writeCount;             ///< Number of inserted frames
+    volatile UINT32         readCount;              ///< Number of removed frames
+    UINT                    refCount;               ///< Number of users of the queue instance
+} tDllCalLockFreeInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tDllCalLockFreeInstance  aInstance_l[DLLCALLOCKFREE_QUEUE_COUNT];
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tOplkError addInstance(tDllCalQueueInstance* ppDllCalQueue_p, tDllCalQueue DllCalQueue_p);
+static tOplkError delInstance(tDllCalQueueInstance pDllCalQueue_p);
+static tOplkError insertDataBlock(tDllCalQueueInstance pDllCalQueue_p, BYTE *pData_p, UINT* pDataSize_p);
+static tOplkError getDataBlock(tDllCalQueueInstance pDllCalQueue_p, BYTE *pData_p, UINT* pDataSize_p);
+static tOplkError getDataBlockCount(tDllCalQueueInstance pDllCalQueue_p, ULONG* pDataBlockCount_p);
+static tOplkError resetDataBlockQueue(tDllCalQueueInstance pDllCalQueue_p, ULONG timeOutMs_p);
+static UINT       getSlotCount(UINT configSlotCount_p, UINT bufferSize_p);
+
+/* define external function interface */
+static tDllCalFuncIntf funcintf_l =
+{
+    addInstance,
+    delInstance,
+    insertDataBlock,
+    getDataBlock,
+    getDataBlockCount,
+    resetDataBlockQueue
+};
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Return pointer to function interface
+
+This function returns a pointer to the function interface structure which
+is used to access the dllcal functions of the lock-free queue implementation.
+
+\return Returns a pointer to the local function interface
+
+\ingroup module_dllcal
+*/
+//------------------------------------------------------------------------------
+tDllCalFuncIntf* dllcallockfree_getInterface(void)
+{
+    return &funcintf_l;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Add lock-free DLL CAL instance
+
+Add a lock-free queue instance for TX packet forwarding in DLL CAL. The user
+and the kernel layer get the same instance for a queue. The frame slots are
+allocated when the instance is added for the first time.
+
+\param  ppDllCalQueue_p         Double-pointer to DllCal Queue instance
+\param  dllCalQueue_p           Parameter that determines the queue
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk          if function executes correctly
+\retval other                   error
+*/
+//------------------------------------------------------------------------------
+static tOplkError addInstance(tDllCalQueueInstance* ppDllCalQueue_p,
+                              tDllCalQueue dllCalQueue_p)
+{
+    tDllCalLockFreeInstance*    pInstance;
+    UINT                        slotCount;
+    UINT                        index;
+
+    switch (dllCalQueue_p)
+    {
+        case kDllCalQueueTxNmt:
+            slotCount = getSlotCount(CONFIG_DLLCAL_SLOT_COUNT_TX_NMT,
+                                     CONFIG_DLLCAL_BUFFER_SIZE_TX_NMT);
+            break;
+
+        case kDllCalQueueTxGen:
+            slotCount = getSlotCount(CONFIG_DLLCAL_SLOT_COUNT_TX_GEN,
+                                     CONFIG_DLLCAL_BUFFER_SIZE_TX_GEN);
+            break;
+
+        case kDllCalQueueTxSync:
+            slotCount = getSlotCount(CONFIG_DLLCAL_SLOT_COUNT_TX_SYNC,
+                                     CONFIG_DLLCAL_BUFFER_SIZE_TX_SYNC);
+            break;
+
+        default:
+            DEBUG_LVL_ERROR_TRACE("%s() Invalid Queue!\n", __func__);
+            return kErrorInvalidInstanceParam;
+    }
+
+    pInstance = &aInstance_l[dllCalQueue_p - kDllCalQueueTxNmt];
+    if (pInstance->refCount == 0)
+    {
+        OPLK_MEMSET(pInstance, 0, sizeof(*pInstance));
+        pInstance->pSlots = (tDllCalLockFreeSlot*)OPLK_MALLOC(sizeof(tDllCalLockFreeSlot) * slotCount);
+        if (pInstance->pSlots == NULL)
+        {
+            DEBUG_LVL_ERROR_TRACE("%s() malloc error!\n", __func__);
+            return kErrorNoResource;
+        }
+        pInstance->slotMask = slotCount - 1;
+        for (index = 0; index < slotCount; index++)
+            pInstance->pSlots[index].sequence = index;
+    }
+    pInstance->refCount++;
+
+    *ppDllCalQueue_p = (tDllCalQueueInstance*)pInstance;
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Delete lock-free DLL CAL instance
+
+Delete the lock-free queue instance. The frame slots are freed when the last
+user deletes the instance.
+
+\param  pDllCalQueue_p          Pointer to DllCal Queue instance
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk          if function executes correctly
+\retval other                   error
+*/
+//------------------------------------------------------------------------------
+static tOplkError delInstance(tDllCalQueueInstance pDllCalQueue_p)
+{
+    tDllCalLockFreeInstance*    pInstance = (tDllCalLockFreeInstance*)pDllCalQueue_p;
+
+    if ((pInstance == NULL) || (pInstance->refCount == 0))
+        return kErrorInvalidInstanceParam;
+
+    pInstance->refCount--;
+    if (pInstance->refCount == 0)
+    {
+        OPLK_FREE(pInstance->pSlots);
+        pInstance->pSlots = NULL;
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Insert data block into lock-free queue
+
+Copies a data block into the next free slot of the queue. Concurrent
+producers claim different slots by a compare-and-swap on the write counter and
+fill them in parallel.
+
+\param  pDllCalQueue_p          Pointer to DllCal Queue instance
+\param  pData_p                 Pointer to the data block to be inserted.
+\param  pDataSize_p             Pointer to the size of the data block to be
+                                inserted.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk          if function executes correctly
+\retval other                   error
+*/
+//------------------------------------------------------------------------------
+static tOplkError insertDataBlock(tDllCalQueueInstance pDllCalQueue_p,
+                                  BYTE* pData_p, UINT* pDataSize_p)
+{
+    tDllCalLockFreeInstance*    pInstance = (tDllCalLockFreeInstance*)pDllCalQueue_p;
+    tDllCalLockFreeSlot*        pSlot;
+    UINT32                      writeCount;
+    INT32                       seqDiff;
+    BOOL                        fClaimed;
+
+    if ((pInstance == NULL) || (pInstance->pSlots == NULL))
+        return kErrorInvalidInstanceParam;
+
+    if (*pDataSize_p > DLLCALLOCKFREE_SLOT_SIZE)
+        return kErrorDllAsyncTxBufferFull;
+
+    for (;;)
+    {
+        writeCount = pInstance->writeCount;
+        pSlot = &pInstance->pSlots[writeCount & pInstance->slotMask];
+        OPLK_MEMBAR();
+        seqDiff = (INT32)(pSlot->sequence - writeCount);
+        if (seqDiff < 0)
+        {   // slot has not yet been released by the consumer, all slots are occupied
+            return kErrorDllAsyncTxBufferFull;
+        }
+
+        if (seqDiff == 0)
+        {
+            OPLK_ATOMIC_COMPARE_EXCHANGE32(&pInstance->writeCount, writeCount,
+                                           writeCount + 1, fClaimed);
+            if (fClaimed)
+                break;
+        }
+        // otherwise another producer has claimed the slot, retry with the next one
+    }
+
+    OPLK_MEMCPY(pSlot->aFrame, pData_p, *pDataSize_p);
+    pSlot->frameSize = *pDataSize_p;
+
+    // publish the slot after its content is written
+    OPLK_MEMBAR();
+    pSlot->sequence = writeCount + 1;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get data block from lock-free queue
+
+Copies the oldest data block of the queue into the provided buffer and
+releases its slot. The function does not take any lock.
+
+\param  pDllCalQueue_p          Pointer to DllCal Queue instance
+\param  pData_p                 Pointer to data buffer
+\param  pDataSize_p             Pointer to the size of the data buffer
+                                (will be replaced with actual data block size)
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk          if function executes correctly
+\retval other                   error
+*/
+//------------------------------------------------------------------------------
+static tOplkError getDataBlock(tDllCalQueueInstance pDllCalQueue_p,
+                               BYTE* pData_p, UINT* pDataSize_p)
+{
+    tDllCalLockFreeInstance*    pInstance = (tDllCalLockFreeInstance*)pDllCalQueue_p;
+    tDllCalLockFreeSlot*        pSlot;
+    UINT32                      readCount;
+
+    if ((pInstance == NULL) || (pInstance->pSlots == NULL))
+        return kErrorInvalidInstanceParam;
+
+    readCount = pInstance->readCount;
+    pSlot = &pInstance->pSlots[readCount & pInstance->slotMask];
+    if (pSlot->sequence != (readCount + 1))
+        return kErrorDllAsyncTxBufferEmpty;
+
+    // read the slot content only after the sequence number
+    OPLK_MEMBAR();
+
+    if (pSlot->frameSize > *pDataSize_p)
+        return kErrorNoResource;
+
+    OPLK_MEMCPY(pData_p, pSlot->aFrame, pSlot->frameSize);
+    *pDataSize_p = pSlot->frameSize;
+
+    // release the slot after its content is read
+    OPLK_MEMBAR();
+    pSlot->sequence = readCount + pInstance->slotMask + 1;
+    pInstance->readCount = readCount + 1;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get data block count of lock-free queue
+
+Returns the number of data blocks in the queue. The count includes slots which
+are claimed by a producer but not yet completely written. It is 0 if the oldest
+slot is not yet complete.
+
+\param  pDllCalQueue_p          Pointer to DllCal Queue instance
+\param  pDataBlockCount_p       Pointer which returns the data block count
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk          if function executes correctly
+\retval other                   error
+*/
+//------------------------------------------------------------------------------
+static tOplkError getDataBlockCount(tDllCalQueueInstance pDllCalQueue_p,
+                                    ULONG* pDataBlockCount_p)
+{
+    tDllCalLockFreeInstance*    pInstance = (tDllCalLockFreeInstance*)pDllCalQueue_p;
+    UINT32                      readCount;
+
+    if ((pInstance == NULL) || (pInstance->pSlots == NULL))
+        return kErrorInvalidInstanceParam;
+
+    readCount = pInstance->readCount;
+    if (pInstance->pSlots[readCount & pInstance->slotMask].sequence != (readCount + 1))
+        *pDataBlockCount_p = 0;
+    else
+        *pDataBlockCount_p = (ULONG)(pInstance->writeCount - readCount);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reset lock-free queue
+
+Discards all completely written data blocks of the queue. The function must
+only be called by the consumer of the queue.
+
+\param  pDllCalQueue_p          Pointer to DllCal Queue instance
+\param  timeOutMs_p             Timeout in milliseconds.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk          if function executes correctly
+\retval other                   error
+*/
+//------------------------------------------------------------------------------
+static tOplkError resetDataBlockQueue(tDllCalQueueInstance pDllCalQueue_p,
+                                      ULONG timeOutMs_p)
+{
+    tDllCalLockFreeInstance*    pInstance = (tDllCalLockFreeInstance*)pDllCalQueue_p;
+    tDllCalLockFreeSlot*        pSlot;
+    UINT32                      readCount;
+
+    UNUSED_PARAMETER(timeOutMs_p);
+
+    if ((pInstance == NULL) || (pInstance->pSlots == NULL))
+        return kErrorInvalidInstanceParam;
+
+    for (readCount = pInstance->readCount; ; readCount++)
+    {
+        pSlot = &pInstance->pSlots[readCount & pInstance->slotMask];
+        if (pSlot->sequence != (readCount + 1))
+            break;
+
+        pSlot->sequence = readCount + pInstance->slotMask + 1;
+    }
+
+    OPLK_MEMBAR();
+    pInstance->readCount = readCount;
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get slot count of a queue
+
+Returns the number of frame slots of a queue. If no slot count is configured,
+the queue gets as many slots as minimum-size frames fit into the buffer budget
+of the circular buffer queue implementation, rounded down to a power of 2.
+Thereby the lock-free queue accepts at least as many small frames (e.g. NMT
+commands for all CNs) as the circular buffer queue.
+
+\param  configSlotCount_p       Configured slot count (0 = derive from budget)
+\param  bufferSize_p            Buffer budget of the queue in bytes
+
+\return The function returns the number of slots.
+*/
+//------------------------------------------------------------------------------
+static UINT getSlotCount(UINT configSlotCount_p, UINT bufferSize_p)
+{
+    UINT    frameCount;
+    UINT    slotCount = 1;
+
+    if (configSlotCount_p != 0)
+        return configSlotCount_p;
+
+    frameCount = bufferSize_p / DLLCALLOCKFREE_MIN_FRAME;
+    while ((slotCount * 2) <= frameCount)
+        slotCount *= 2;
+
+    return slotCount;
+}
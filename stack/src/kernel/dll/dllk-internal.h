@@ -166,6 +166,21 @@ typedef struct
     BOOL      fTimeoutOccurred;     ///< The sync interrupt occurred after a report of a loss of SoC
 } tDllLossSocStatus;
 
+#if defined(CONFIG_INCLUDE_NMT_MN)
+/**
+ * \brief Slot of the precompiled isochronous schedule of the MN
+ *
+ * The isochronous phase of the MN is compiled into a flat array of slots
+ * whenever a node is added to or removed from the isochronous phase. Each
+ * slot describes one PReq (or the PRes of the MN) which is sent per cycle.
+ */
+typedef struct
+{
+    tDllkNodeInfo*  pNodeInfo;          ///< Node served in this slot
+    BOOL            fMnPres;            ///< The slot contains the PRes of the MN
+} tDllkSyncSlot;
+#endif
+
 typedef struct
 {
     tNmtState               nmtState;
@@ -200,7 +215,8 @@ typedef struct
 #endif
 
 #if defined(CONFIG_INCLUDE_NMT_MN)
-    tDllkNodeInfo*          pFirstNodeInfo;
+    UINT8                   aIsoNodeIdList[NMT_MAX_NODE_ID]; // node-IDs of PReq slots, own node first, CNs ascending
+    UINT                    isoNodeCount;                   // number of entries in aIsoNodeIdList
     UINT8                   aCnNodeIdList[2][NMT_MAX_NODE_ID];
     UINT8                   curNodeIndex;
     tEdrvTxBuffer**         ppTxBufferList;
@@ -210,7 +226,13 @@ typedef struct
     UINT8                   curLastSoaReq;
     BOOL                    fSyncProcessed;
     BOOL                    fPrcSlotFinished;
-    tDllkNodeInfo*          pFirstPrcNodeInfo;
+    UINT8                   aPrcNodeIdList[NMT_MAX_NODE_ID]; // node-IDs of PRes chained CNs, ascending
+    UINT                    prcNodeCount;                   // number of entries in aPrcNodeIdList
+    tDllkSyncSlot           aSyncSchedule[NMT_MAX_NODE_ID]; // precompiled isochronous phase
+    UINT                    syncScheduleCount;              // number of slots in aSyncSchedule
+    UINT8                   aSyncCnNodeIdList[NMT_MAX_NODE_ID]; // precompiled CN node-ID list of the isochronous phase
+    UINT                    syncCnNodeIdCount;              // number of entries in aSyncCnNodeIdList incl. terminator
+    BOOL                    fTpdoReadyFlag;                 // ready flag of the last prepared cycle
 #endif
 
 #if CONFIG_TIMER_USE_HIGHRES != FALSE
@@ -257,6 +279,9 @@ void       dllk_processTransmittedNonEpl(tEdrvTxBuffer * pTxBuffer_p);
 #if defined(CONFIG_INCLUDE_NMT_MN)
 void       dllk_processTransmittedSoc(tEdrvTxBuffer * pTxBuffer_p);
 void       dllk_processTransmittedSoa(tEdrvTxBuffer * pTxBuffer_p);
+#if CONFIG_DLL_PRES_LATENCY_STATISTICS != FALSE
+void       dllk_processTransmittedPreq(tEdrvTxBuffer * pTxBuffer_p);
+#endif
 #endif
 tOplkError dllk_updateFrameIdentRes(tEdrvTxBuffer* pTxBuffer_p, tNmtState nmtState_p);
 tOplkError dllk_updateFrameStatusRes(tEdrvTxBuffer* pTxBuffer_p, tNmtState NmtState_p);
@@ -314,6 +339,17 @@ tOplkError dllk_setupLocalNodeCn(void);
 tOplkError dllk_setupLocalNodeMn(void);
 tOplkError dllk_addNodeIsochronous(tDllkNodeInfo* pIntNodeInfo_p);
 tOplkError dllk_deleteNodeIsochronous(tDllkNodeInfo* pIntNodeInfo_p);
+void       dllk_buildSyncSchedule(void);
+tOplkError dllk_prepareTpdos(UINT txBufferOffset_p, BOOL fReadyFlag_p);
+#if CONFIG_DLL_TPDO_WORKER != FALSE
+/* TPDO worker functions (dllktpdoworker-*.c) */
+tOplkError dllk_initTpdoWorker(void);
+void       dllk_exitTpdoWorker(void);
+void       dllk_triggerTpdoWorker(UINT txBufferOffset_p, BOOL fReadyFlag_p);
+BOOL       dllk_waitTpdoWorker(UINT txBufferOffset_p);
+void       dllk_suspendTpdoWorker(void);
+void       dllk_resumeTpdoWorker(void);
+#endif
 tOplkError dllk_setupAsyncPhase(tNmtState nmtState_p, UINT nextTxBufferOffset_p,
                                 UINT32 nextTimeOffsetNs_p, UINT* pIndex_p) SECTION_DLLK_PROCESS_SYNC;
 tOplkError dllk_setupSyncPhase(tNmtState nmtState_p, BOOL fReadyFlag_p, UINT nextTxBufferOffset_p,
@@ -81,6 +81,10 @@ TGT_DLLK_DEFINE_CRITICAL_SECTION
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
+#if defined(CONFIG_INCLUDE_NMT_MN)
+static UINT findNodeId(const UINT8* pNodeIdList_p, UINT count_p, UINT nodeId_p);
+static void removeNodeId(UINT8* pNodeIdList_p, UINT* pCount_p, UINT index_p);
+#endif
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -173,6 +177,11 @@ tOplkError dllk_addInstance(tDllkInitParam* pInitParam_p)
 
     if ((ret = edrvcyclic_regErrorHandler(dllk_cbCyclicError)) != kErrorOk)
         return ret;
+
+#if CONFIG_DLL_TPDO_WORKER != FALSE
+    if ((ret = dllk_initTpdoWorker()) != kErrorOk)
+        return ret;
+#endif
 #endif
     return ret;
 }
@@ -197,6 +206,9 @@ tOplkError dllk_delInstance(void)
 
 #if defined (CONFIG_INCLUDE_NMT_MN)
     ret = edrvcyclic_shutdown();
+#if CONFIG_DLL_TPDO_WORKER != FALSE
+    dllk_exitTpdoWorker();
+#endif
 #endif
 
 #if (CONFIG_DLL_PROCESS_SYNC == DLL_PROCESS_SYNC_ON_TIMER)
@@ -921,6 +933,16 @@ tOplkError dllk_cbMnSyncHandler(void)
     dllkInstance_g.curTxBufferOffsetCycle ^= 1;
     dllkInstance_g.curNodeIndex = 0;
 
+#if CONFIG_DLL_TPDO_WORKER != FALSE
+    // PDO mappings are fixed in ReadyToOp and Operational, so the TPDOs of the
+    // next cycle can be prepared in parallel to the cycle finish processing
+    if ((nmtState == kNmtMsReadyToOperate) || (nmtState == kNmtMsOperational))
+    {
+        dllk_triggerTpdoWorker(dllkInstance_g.curTxBufferOffsetCycle ^ 1,
+                               dllkInstance_g.fTpdoReadyFlag);
+    }
+#endif
+
     ret = dllk_postEvent(kEventTypeDllkCycleFinish);
 
 Exit:
@@ -1082,9 +1104,10 @@ tOplkError dllk_setupLocalNode(tNmtState nmtState_p)
     dllkInstance_g.flag2 = 0;
 
 #if defined(CONFIG_INCLUDE_NMT_MN)
-    // initialize linked node list
-    dllkInstance_g.pFirstNodeInfo = NULL;
-    dllkInstance_g.pFirstPrcNodeInfo = NULL;
+    // initialize isochronous node lists
+    dllkInstance_g.isoNodeCount = 0;
+    dllkInstance_g.prcNodeCount = 0;
+    dllk_buildSyncSchedule();
 #endif
 
     /*-----------------------------------------------------------------------*/
@@ -1269,6 +1292,10 @@ tOplkError dllk_setupLocalNodeMn(void)
             if (ret != kErrorOk)
                 return ret;
             pIntNodeInfo->pPreqTxBuffer = &dllkInstance_g.pTxBuffer[handle];
+#if CONFIG_DLL_PRES_LATENCY_STATISTICS != FALSE
+            dllkInstance_g.pTxBuffer[handle].pfnTxHandler = dllk_processTransmittedPreq;
+            dllkInstance_g.pTxBuffer[handle + 1].pfnTxHandler = dllk_processTransmittedPreq;
+#endif
         }
     }
 
@@ -1551,20 +1578,21 @@ This function adds a node to the isochronous phase.
 tOplkError dllk_addNodeIsochronous(tDllkNodeInfo* pIntNodeInfo_p)
 {
     tOplkError          ret = kErrorOk;
-    tDllkNodeInfo**     ppIntNodeInfo;
+    UINT8*              pNodeIdList;
+    UINT*               pCount;
+    UINT                index;
     tPlkFrame *         pTxFrame;
 
     if (pIntNodeInfo_p->nodeId == dllkInstance_g.dllConfigParam.nodeId)
     {   // we shall send PRes ourself
         // insert our node as first entry in the list
-        ppIntNodeInfo = &dllkInstance_g.pFirstNodeInfo;
-        if (*ppIntNodeInfo != NULL)
-        {
-            if ((*ppIntNodeInfo)->nodeId == pIntNodeInfo_p->nodeId)
-            {   // node was already added to list
-                // $$$ d.k. maybe this should be an error
-                goto Exit;
-            }
+        pNodeIdList = &dllkInstance_g.aIsoNodeIdList[0];
+        pCount = &dllkInstance_g.isoNodeCount;
+        index = 0;
+        if ((*pCount > 0) && (pNodeIdList[0] == pIntNodeInfo_p->nodeId))
+        {   // node was already added to list
+            // $$$ d.k. maybe this should be an error
+            goto Exit;
         }
         // set "PReq"-TxBuffer to PRes-TxBuffer
         pIntNodeInfo_p->pPreqTxBuffer = &dllkInstance_g.pTxBuffer[DLLK_TXFRAME_PRES];
@@ -1578,21 +1606,23 @@ tOplkError dllk_addNodeIsochronous(tDllkNodeInfo* pIntNodeInfo_p)
         // insert node into list in ascending order
         if (pIntNodeInfo_p->pPreqTxBuffer == NULL)
         {
-            ppIntNodeInfo = &dllkInstance_g.pFirstPrcNodeInfo;
+            pNodeIdList = &dllkInstance_g.aPrcNodeIdList[0];
+            pCount = &dllkInstance_g.prcNodeCount;
         }
         else
         {
-            ppIntNodeInfo = &dllkInstance_g.pFirstNodeInfo;
+            pNodeIdList = &dllkInstance_g.aIsoNodeIdList[0];
+            pCount = &dllkInstance_g.isoNodeCount;
         }
 
-        while ((*ppIntNodeInfo != NULL) &&
-               (((*ppIntNodeInfo)->nodeId < pIntNodeInfo_p->nodeId) ||
-               ((*ppIntNodeInfo)->nodeId == dllkInstance_g.dllConfigParam.nodeId)))
+        for (index = 0; index < *pCount; index++)
         {
-            ppIntNodeInfo = &(*ppIntNodeInfo)->pNextNodeInfo;
+            if ((pNodeIdList[index] >= pIntNodeInfo_p->nodeId) &&
+                (pNodeIdList[index] != dllkInstance_g.dllConfigParam.nodeId))
+                break;
         }
 
-        if ((*ppIntNodeInfo != NULL) && ((*ppIntNodeInfo)->nodeId == pIntNodeInfo_p->nodeId))
+        if ((index < *pCount) && (pNodeIdList[index] == pIntNodeInfo_p->nodeId))
         {   // node was already added to list
             // $$$ d.k. maybe this should be an error
             goto Exit;
@@ -1633,8 +1663,16 @@ tOplkError dllk_addNodeIsochronous(tDllkNodeInfo* pIntNodeInfo_p)
     pIntNodeInfo_p->nmtState = kNmtCsNotActive;
     pIntNodeInfo_p->dllErrorEvents = 0L;
     // add node to list
-    pIntNodeInfo_p->pNextNodeInfo = *ppIntNodeInfo;
-    *ppIntNodeInfo = pIntNodeInfo_p;
+    if (*pCount >= NMT_MAX_NODE_ID)
+    {
+        ret = kErrorDllInvalidParam;
+        goto Exit;
+    }
+    OPLK_MEMMOVE(&pNodeIdList[index + 1], &pNodeIdList[index], *pCount - index);
+    pNodeIdList[index] = (UINT8)pIntNodeInfo_p->nodeId;
+    (*pCount)++;
+
+    dllk_buildSyncSchedule();
 
 Exit:
     return ret;
@@ -1654,30 +1692,33 @@ This function removes a node from the isochronous phase.
 tOplkError dllk_deleteNodeIsochronous(tDllkNodeInfo* pIntNodeInfo_p)
 {
     tOplkError          ret = kErrorOk;
-    tDllkNodeInfo**     ppIntNodeInfo;
+    UINT8*              pNodeIdList;
+    UINT*               pCount;
+    UINT                index;
     tPlkFrame *         pTxFrame;
 
     if (pIntNodeInfo_p->pPreqTxBuffer == NULL)
     {
-        ppIntNodeInfo = &dllkInstance_g.pFirstPrcNodeInfo;
+        pNodeIdList = &dllkInstance_g.aPrcNodeIdList[0];
+        pCount = &dllkInstance_g.prcNodeCount;
     }
     else
     {
-        ppIntNodeInfo = &dllkInstance_g.pFirstNodeInfo;
+        pNodeIdList = &dllkInstance_g.aIsoNodeIdList[0];
+        pCount = &dllkInstance_g.isoNodeCount;
     }
     // search node in whole list
-    while ((*ppIntNodeInfo != NULL) && (*ppIntNodeInfo != pIntNodeInfo_p))
-    {
-        ppIntNodeInfo = &(*ppIntNodeInfo)->pNextNodeInfo;
-    }
-    if ((*ppIntNodeInfo == NULL) || (*ppIntNodeInfo != pIntNodeInfo_p))
+    index = findNodeId(pNodeIdList, *pCount, pIntNodeInfo_p->nodeId);
+    if (index >= *pCount)
     {   // node was not found in list
         // $$$ d.k. maybe this should be an error
         return ret;
     }
 
     // remove node from list
-    *ppIntNodeInfo = pIntNodeInfo_p->pNextNodeInfo;
+    removeNodeId(pNodeIdList, pCount, index);
+    dllk_buildSyncSchedule();
+
     if (pIntNodeInfo_p->pPreqTxBuffer != NULL)
     {   // disable TPDO
         pTxFrame = (tPlkFrame *) pIntNodeInfo_p->pPreqTxBuffer[0].pBuffer;
@@ -1696,6 +1737,109 @@ tOplkError dllk_deleteNodeIsochronous(tDllkNodeInfo* pIntNodeInfo_p)
     }
     return ret;
 }
+
+//------------------------------------------------------------------------------
+/**
+\brief  Build the isochronous schedule of the MN
+
+This function compiles the node-ID lists of isochronous nodes into the flat
+schedule which is processed by dllk_setupSyncPhase() in every cycle. It also
+precompiles the node-ID list of the CNs which are expected to respond in the
+isochronous phase. The function must be called whenever the set of isochronous
+nodes changes.
+*/
+//------------------------------------------------------------------------------
+void dllk_buildSyncSchedule(void)
+{
+    tDllkNodeInfo*      pIntNodeInfo;
+    UINT                index;
+    UINT                prcIndex;
+    tDllkSyncSlot*      pSlot = &dllkInstance_g.aSyncSchedule[0];
+    UINT8*              pCnNodeId = &dllkInstance_g.aSyncCnNodeIdList[0];
+    UINT8*              pCnNodeIdLast = &dllkInstance_g.aSyncCnNodeIdList[NMT_MAX_NODE_ID - 1];
+
+#if CONFIG_DLL_TPDO_WORKER != FALSE
+    // the worker must not use the schedule while it is modified, results of
+    // jobs overlapping with the rebuild are discarded
+    dllk_suspendTpdoWorker();
+#endif
+
+    for (index = 0; index < dllkInstance_g.isoNodeCount; index++)
+    {
+        pIntNodeInfo = dllk_getNodeInfo(dllkInstance_g.aIsoNodeIdList[index]);
+        if ((pIntNodeInfo->pPreqTxBuffer == NULL) ||
+            (pIntNodeInfo->pPreqTxBuffer[0].pBuffer == NULL) ||
+            (pIntNodeInfo->pPreqTxBuffer[1].pBuffer == NULL))
+        {   // PReq does not exist
+            continue;
+        }
+
+        pSlot->pNodeInfo = pIntNodeInfo;
+        pSlot->fMnPres = (pIntNodeInfo->pPreqTxBuffer == &dllkInstance_g.pTxBuffer[DLLK_TXFRAME_PRES]);
+
+        if (pSlot->fMnPres)
+        {   // PRes of MN will be sent, followed by the PRes of the chained CNs
+            for (prcIndex = 0;
+                 (prcIndex < dllkInstance_g.prcNodeCount) && (pCnNodeId < pCnNodeIdLast);
+                 prcIndex++)
+            {
+                *pCnNodeId++ = dllkInstance_g.aPrcNodeIdList[prcIndex];
+            }
+
+            if (pCnNodeId < pCnNodeIdLast)
+                *pCnNodeId++ = C_ADR_BROADCAST;    // mark this entry as PRC slot finished
+        }
+        else if (pCnNodeId < pCnNodeIdLast)
+        {   // PReq to CN
+            *pCnNodeId++ = (UINT8)pIntNodeInfo->nodeId;
+        }
+
+        pSlot++;
+    }
+    *pCnNodeId++ = C_ADR_INVALID;    // mark last entry in node-ID list
+
+    dllkInstance_g.syncScheduleCount = (UINT)(pSlot - &dllkInstance_g.aSyncSchedule[0]);
+    dllkInstance_g.syncCnNodeIdCount = (UINT)(pCnNodeId - &dllkInstance_g.aSyncCnNodeIdList[0]);
+
+#if CONFIG_DLL_TPDO_WORKER != FALSE
+    dllk_resumeTpdoWorker();
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Prepare TPDOs of the isochronous schedule
+
+This function copies the TPDOs of all slots of the isochronous schedule into
+the frames of the specified TX buffer set. It is used by the TPDO worker to
+prepare the next cycle ahead of dllk_setupSyncPhase().
+
+\param  txBufferOffset_p    TX buffer set which shall be prepared.
+\param  fReadyFlag_p        Status of the ready flag.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+tOplkError dllk_prepareTpdos(UINT txBufferOffset_p, BOOL fReadyFlag_p)
+{
+    tOplkError          ret = kErrorOk;
+    tEdrvTxBuffer*      pTxBuffer;
+    tFrameInfo          frameInfo;
+    tDllkSyncSlot*      pSlot;
+    tDllkSyncSlot*      pSlotEnd;
+
+    pSlotEnd = &dllkInstance_g.aSyncSchedule[dllkInstance_g.syncScheduleCount];
+    for (pSlot = &dllkInstance_g.aSyncSchedule[0]; pSlot < pSlotEnd; pSlot++)
+    {
+        pTxBuffer = &pSlot->pNodeInfo->pPreqTxBuffer[txBufferOffset_p];
+        frameInfo.pFrame = (tPlkFrame*)pTxBuffer->pBuffer;
+        frameInfo.frameSize = pTxBuffer->txFrameSize;
+        ret = dllk_processTpdo(&frameInfo, fReadyFlag_p);
+        if (ret != kErrorOk)
+            break;
+    }
+    return ret;
+}
 #endif
 
 #if CONFIG_DLL_PRES_CHAINING_CN != FALSE
@@ -1992,7 +2136,9 @@ tOplkError dllk_setupAsyncPhase(tNmtState nmtState_p, UINT nextTxBufferOffset_p,
 /**
 \brief  Setup synchronous phase of cycle
 
-The function sets up the buffer structures for the synchronous phase.
+The function sets up the buffer structures for the synchronous phase. It
+processes the isochronous schedule which was precompiled by
+dllk_buildSyncSchedule().
 
 \param  nmtState_p              NMT state of the node.
 \param  fReadyFlag_p            Status of ready flag.
@@ -2009,14 +2155,14 @@ tOplkError dllk_setupSyncPhase(tNmtState nmtState_p, BOOL fReadyFlag_p,
                                UINT nextTxBufferOffset_p, UINT32* pNextTimeOffsetNs_p, UINT* pIndex_p)
 {
     tOplkError          ret = kErrorOk;
-    BYTE*               pCnNodeId;
-    UINT32              accFrameLenNs = 0;
-    UINT                nextTimeOffsetNs = 0;
     tPlkFrame *         pTxFrame;
     tEdrvTxBuffer*      pTxBuffer;
     tFrameInfo          FrameInfo;
     tDllkNodeInfo*      pIntNodeInfo;
+    tDllkSyncSlot*      pSlot;
+    tDllkSyncSlot*      pSlotEnd;
     BYTE                flag1;
+    BOOL                fTpdoPrepared = FALSE;
 
     // calculate WaitSoCPReq delay
     if (dllkInstance_g.dllConfigParam.waitSocPreq != 0)
@@ -2024,87 +2170,106 @@ tOplkError dllk_setupSyncPhase(tNmtState nmtState_p, BOOL fReadyFlag_p,
         *pNextTimeOffsetNs_p = dllkInstance_g.dllConfigParam.waitSocPreq
                             + C_DLL_T_PREAMBLE + C_DLL_T_MIN_FRAME + C_DLL_T_IFG;
     }
-    else
-    {
-        accFrameLenNs = C_DLL_T_PREAMBLE + C_DLL_T_MIN_FRAME + C_DLL_T_IFG;
-    }
-
-    pCnNodeId = &dllkInstance_g.aCnNodeIdList[nextTxBufferOffset_p][0];
 
     if (nmtState_p != kNmtMsOperational)
         fReadyFlag_p = FALSE;
 
-    pIntNodeInfo = dllkInstance_g.pFirstNodeInfo;
-    while (pIntNodeInfo != NULL)
+#if CONFIG_DLL_TPDO_WORKER != FALSE
+    fTpdoPrepared = dllk_waitTpdoWorker(nextTxBufferOffset_p);
+    dllkInstance_g.fTpdoReadyFlag = fReadyFlag_p;
+#endif
+
+    pSlotEnd = &dllkInstance_g.aSyncSchedule[dllkInstance_g.syncScheduleCount];
+    for (pSlot = &dllkInstance_g.aSyncSchedule[0]; pSlot < pSlotEnd; pSlot++)
     {
+        pIntNodeInfo = pSlot->pNodeInfo;
         pTxBuffer = &pIntNodeInfo->pPreqTxBuffer[nextTxBufferOffset_p];
-        if ((pTxBuffer != NULL) && (pTxBuffer->pBuffer != NULL))
-        {   // PReq does exist
-            pTxFrame = (tPlkFrame *) pTxBuffer->pBuffer;
+        pTxFrame = (tPlkFrame *) pTxBuffer->pBuffer;
+
+        flag1 = pIntNodeInfo->soaFlag1 & PLK_FRAME_FLAG1_EA;
 
-            flag1 = pIntNodeInfo->soaFlag1 & PLK_FRAME_FLAG1_EA;
+        if (fTpdoPrepared)
+        {   // TPDO was already processed by the worker, keep its RD flag
+            flag1 |= ami_getUint8Le(&pTxFrame->data.preq.flag1) & PLK_FRAME_FLAG1_RD;
+        }
 
-            // $$$ d.k. set PLK_FRAME_FLAG1_MS if necessary
-            // update frame (Flag1)
-            ami_setUint8Le(&pTxFrame->data.preq.flag1, flag1);
+        // $$$ d.k. set PLK_FRAME_FLAG1_MS if necessary
+        // update frame (Flag1)
+        ami_setUint8Le(&pTxFrame->data.preq.flag1, flag1);
 
-            // process TPDO
+        if (!fTpdoPrepared)
+        {   // process TPDO
             FrameInfo.pFrame = pTxFrame;
             FrameInfo.frameSize = pTxBuffer->txFrameSize;
             ret = dllk_processTpdo(&FrameInfo, fReadyFlag_p);
             if (ret != kErrorOk)
                 return ret;
+        }
 
-            pTxBuffer->timeOffsetNs = *pNextTimeOffsetNs_p;
-            dllkInstance_g.ppTxBufferList[*pIndex_p] = pTxBuffer;
-            (*pIndex_p)++;
+        pTxBuffer->timeOffsetNs = *pNextTimeOffsetNs_p;
+        dllkInstance_g.ppTxBufferList[*pIndex_p] = pTxBuffer;
+        (*pIndex_p)++;
 
-            if (pTxBuffer == &dllkInstance_g.pTxBuffer[DLLK_TXFRAME_PRES + nextTxBufferOffset_p])
-            {   // PRes of MN will be sent
-                // update NMT state
-                ami_setUint8Le(&pTxFrame->data.pres.nmtStatus, (BYTE) nmtState_p);
+        if (pSlot->fMnPres)
+        {   // PRes of MN will be sent
+            // update NMT state
+            ami_setUint8Le(&pTxFrame->data.pres.nmtStatus, (BYTE) nmtState_p);
+        }
 
-                *pNextTimeOffsetNs_p = pIntNodeInfo->presTimeoutNs;
-                {
-                    tDllkNodeInfo*   pIntPrcNodeInfo;
+        *pNextTimeOffsetNs_p = pIntNodeInfo->presTimeoutNs;
+    }
 
-                    pIntPrcNodeInfo = dllkInstance_g.pFirstPrcNodeInfo;
-                    while (pIntPrcNodeInfo != NULL)
-                    {
-                        *pCnNodeId = (BYTE) pIntPrcNodeInfo->nodeId;
-                        pCnNodeId++;
-                        *pNextTimeOffsetNs_p = pIntNodeInfo->presTimeoutNs;
-                        pIntPrcNodeInfo = pIntPrcNodeInfo->pNextNodeInfo;
-                    }
+    OPLK_MEMCPY(&dllkInstance_g.aCnNodeIdList[nextTxBufferOffset_p][0],
+                dllkInstance_g.aSyncCnNodeIdList, dllkInstance_g.syncCnNodeIdCount);
 
-                    *pCnNodeId = C_ADR_BROADCAST;    // mark this entry as PRC slot finished
-                    pCnNodeId++;
-                }
-            }
-            else
-            {   // PReq to CN
-                *pCnNodeId = (BYTE) pIntNodeInfo->nodeId;
-                pCnNodeId++;
-                *pNextTimeOffsetNs_p = pIntNodeInfo->presTimeoutNs;
-            }
+    return ret;
+}
+#endif
 
-            if (nextTimeOffsetNs == 0)
-            {   // add SoC frame length
-                accFrameLenNs += C_DLL_T_PREAMBLE +
-                                 (pTxBuffer->txFrameSize * C_DLL_T_BITTIME) + C_DLL_T_IFG;
-            }
-            else
-            {
-                *pNextTimeOffsetNs_p += accFrameLenNs;
-                accFrameLenNs = 0;
-            }
-        }
+#if defined(CONFIG_INCLUDE_NMT_MN)
+//------------------------------------------------------------------------------
+/**
+\brief  Find node-ID in node-ID list
+
+The function searches the specified node-ID in a list of isochronous nodes.
 
-        pIntNodeInfo = pIntNodeInfo->pNextNodeInfo;
+\param  pNodeIdList_p       Pointer to node-ID list.
+\param  count_p             Number of entries in the list.
+\param  nodeId_p            Node-ID to search for.
+
+\return The function returns the index of the node-ID in the list or count_p
+        if it is not contained.
+*/
+//------------------------------------------------------------------------------
+static UINT findNodeId(const UINT8* pNodeIdList_p, UINT count_p, UINT nodeId_p)
+{
+    UINT    index;
+
+    for (index = 0; index < count_p; index++)
+    {
+        if (pNodeIdList_p[index] == nodeId_p)
+            break;
     }
-    *pCnNodeId = C_ADR_INVALID;    // mark last entry in node-ID list
 
-    return ret;
+    return index;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Remove entry from node-ID list
+
+The function removes the entry at the specified index from a list of
+isochronous nodes. The order of the remaining entries is preserved.
+
+\param  pNodeIdList_p       Pointer to node-ID list.
+\param  pCount_p            Pointer to number of entries in the list.
+\param  index_p             Index of the entry which shall be removed.
+*/
+//------------------------------------------------------------------------------
+static void removeNodeId(UINT8* pNodeIdList_p, UINT* pCount_p, UINT index_p)
+{
+    (*pCount_p)--;
+    OPLK_MEMMOVE(&pNodeIdList_p[index_p], &pNodeIdList_p[index_p + 1], *pCount_p - index_p);
 }
 #endif
 
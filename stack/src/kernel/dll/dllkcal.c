@@ -80,15 +80,31 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
-#if defined(CONFIG_INCLUDE_NMT_MN)
-#define DLLKCAL_MAX_QUEUES  6   // CnGenReq, CnNmtReq, {MnGenReq, MnNmtReq}, MnIdentReq, MnStatusReq, SyncReq
-#else
-#define DLLKCAL_MAX_QUEUES  5   // CnGenReq, CnNmtReq, {MnGenReq, MnNmtReq}, MnIdentReq, MnStatusReq
-#endif
 
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
+#if defined(CONFIG_INCLUDE_NMT_MN)
+/**
+\brief CN request queue
+
+The structure describes the scheduler state of the asynchronous requests of
+the CNs for one priority (NMT or generic). Every node with pending requests is
+contained in the round-robin queue only once. The node at the head of the
+queue is served until its credit is consumed and is then moved to the tail.
+*/
+typedef struct
+{
+    tCircBufInstance*       pQueue;                 ///< Round-robin queue of node IDs with pending requests
+    UINT                    aRequestCnt[254];       ///< Request count of the nodes which were taken over into the scheduler
+    UINT                    aPendingCnt[254];       ///< Number of invitations which are still owed to the nodes
+    UINT32                  aWaitStart[254];        ///< SoA slot in which the oldest pending request of the node started waiting
+    BOOL                    afQueued[254];          ///< Node is contained in the queue or is the current node
+    UINT                    curNodeId;              ///< Node which is currently served (0 = none)
+    UINT                    curCredit;              ///< Remaining credit of the current node
+} tDllkCalCnReqQueue;
+#endif
+
 typedef struct
 {
     tDllCalQueueInstance    dllCalQueueTxNmt;       ///< Dll Cal Queue instance for NMT priority
@@ -110,12 +126,18 @@ typedef struct
     // StatusRequest queue with CN node IDs
     tCircBufInstance*       pQueueStatusReq;
 
-    tCircBufInstance*       pQueueCnRequestNmt;
-    UINT                    aCnRequestCntNmt[254];
-    tCircBufInstance*       pQueueCnRequestGen;
-    UINT                    aCnRequestCntGen[254];
-
-    UINT                    nextRequestQueue;
+    tDllkCalCnReqQueue      cnRequestNmt;           ///< Scheduler state of CN NMT requests
+    tDllkCalCnReqQueue      cnRequestGen;           ///< Scheduler state of CN generic requests
+    UINT                    aNodeCredit[254];       ///< Consecutive invitations per node and round
+
+    UINT                    aSoaClassBaseWeight[DLLKCAL_SOA_CLASS_COUNT];   ///< Configured weights of the scheduler classes
+    UINT                    aSoaClassWeight[DLLKCAL_SOA_CLASS_COUNT];   ///< Weights of the scheduler classes
+    INT                     aSoaClassCredit[DLLKCAL_SOA_CLASS_COUNT];   ///< Current credit of the scheduler classes
+    UINT32                  soaSlotCount;           ///< Number of SoA slots which have been scheduled
+#if CONFIG_DLLCAL_SOA_ADAPTIVE != FALSE
+    UINT                    aSoaClassBacklog[DLLKCAL_SOA_CLASS_COUNT];  ///< SoA slots of the current period in which the class waited
+    UINT                    adaptSlotCount;         ///< SoA slots of the current adaptation period
+#endif
 #endif
 } tDllkCalInstance;
 
@@ -129,13 +151,22 @@ static tDllkCalInstance     instance_l;
 // local function prototypes
 //------------------------------------------------------------------------------
 #if defined(CONFIG_INCLUDE_NMT_MN)
-static BOOL getCnGenRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p);
-static BOOL getCnNmtRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p);
+static BOOL getCnRequest(tDllkCalCnReqQueue* pReqQueue_p, tDllReqServiceId reqServiceId_p,
+                         tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p);
+static void resetCnRequestQueue(tDllkCalCnReqQueue* pReqQueue_p);
+static BOOL hasSoaClassRequest(UINT soaClass_p, tDllReqServiceId reqServiceId_p,
+                               ULONG syncReqCount_p);
+static BOOL getSoaClassRequest(UINT soaClass_p, tDllReqServiceId* pReqServiceId_p,
+                               UINT* pNodeId_p, tSoaPayload* pSoaPayload_p,
+                               ULONG syncReqCount_p);
 static BOOL getMnGenNmtRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p);
 static BOOL getMnIdentRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p);
 static BOOL getMnStatusRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p);
 static BOOL getMnSyncRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p,
-                             tSoaPayload* pSoaPayload_p);
+                             tSoaPayload* pSoaPayload_p, ULONG syncReqCount_p);
+#if CONFIG_DLLCAL_SOA_ADAPTIVE != FALSE
+static void adaptSoaClassWeights(const BOOL* afPending_p, INT servedClass_p);
+#endif
 #endif
 
 //============================================================================//
@@ -158,6 +189,7 @@ tOplkError dllkcal_init(void)
     tOplkError      ret = kErrorOk;
 #if defined(CONFIG_INCLUDE_NMT_MN)
     tCircBufError   circErr;
+    UINT            index;
 #endif
 
     // reset instance structure
@@ -194,7 +226,7 @@ tOplkError dllkcal_init(void)
         goto Exit;
     }
     circErr = circbuf_alloc(CIRCBUF_DLLCAL_CN_REQ_NMT, CONFIG_DLLCAL_SIZE_CIRCBUF_CN_REQ_NMT,
-            &instance_l.pQueueCnRequestNmt);
+            &instance_l.cnRequestNmt.pQueue);
     if(circErr != kCircBufOk)
     {
         DEBUG_LVL_ERROR_TRACE("%s() Allocate CIRCBUF_ASYNC_SCHED_NMT failed\n", __func__);
@@ -202,7 +234,7 @@ tOplkError dllkcal_init(void)
     }
 
     circErr = circbuf_alloc(CIRCBUF_DLLCAL_CN_REQ_GEN, CONFIG_DLLCAL_SIZE_CIRCBUF_CN_REQ_GEN,
-            &instance_l.pQueueCnRequestGen);
+            &instance_l.cnRequestGen.pQueue);
     if(circErr != kCircBufOk)
     {
         DEBUG_LVL_ERROR_TRACE("%s() Allocate CIRCBUF_ASYNC_SCHED_GEN failed\n", __func__);
@@ -224,6 +256,20 @@ tOplkError dllkcal_init(void)
         DEBUG_LVL_ERROR_TRACE("%s() Allocate CIRCBUF_DLLCAL_CN_REQ_STATUS failed\n", __func__);
         goto Exit;
     }
+
+    for (index = 0; index < tabentries(instance_l.aNodeCredit); index++)
+        instance_l.aNodeCredit[index] = CONFIG_DLLCAL_SOA_NODE_CREDIT;
+
+    instance_l.aSoaClassBaseWeight[kDllkCalSoaClassCnNmt] = CONFIG_DLLCAL_SOA_WEIGHT_CN_NMT;
+    instance_l.aSoaClassBaseWeight[kDllkCalSoaClassCnGen] = CONFIG_DLLCAL_SOA_WEIGHT_CN_GEN;
+    instance_l.aSoaClassBaseWeight[kDllkCalSoaClassMnGenNmt] = CONFIG_DLLCAL_SOA_WEIGHT_MN_GENNMT;
+    instance_l.aSoaClassBaseWeight[kDllkCalSoaClassMnIdent] = CONFIG_DLLCAL_SOA_WEIGHT_MN_IDENT;
+    instance_l.aSoaClassBaseWeight[kDllkCalSoaClassMnStatus] = CONFIG_DLLCAL_SOA_WEIGHT_MN_STATUS;
+    instance_l.aSoaClassBaseWeight[kDllkCalSoaClassMnSync] = CONFIG_DLLCAL_SOA_WEIGHT_MN_SYNC;
+    OPLK_MEMCPY(instance_l.aSoaClassWeight, instance_l.aSoaClassBaseWeight,
+                sizeof(instance_l.aSoaClassWeight));
+    OPLK_MEMCPY(instance_l.statistics.aSoaClassWeight, instance_l.aSoaClassWeight,
+                sizeof(instance_l.statistics.aSoaClassWeight));
 #endif
 
 Exit:
@@ -246,8 +292,8 @@ tOplkError dllkcal_exit(void)
     tOplkError      ret = kErrorOk;
 
 #ifdef CONFIG_INCLUDE_NMT_MN
-    circbuf_free(instance_l.pQueueCnRequestGen);
-    circbuf_free(instance_l.pQueueCnRequestNmt);
+    circbuf_free(instance_l.cnRequestGen.pQueue);
+    circbuf_free(instance_l.cnRequestNmt.pQueue);
     circbuf_free(instance_l.pQueueIdentReq);
     circbuf_free(instance_l.pQueueStatusReq);
 #endif
@@ -654,10 +700,18 @@ tOplkError dllkcal_clearAsyncQueues(void)
                                     instance_l.dllCalQueueTxSync, 1000);
 
     // clear MN asynchronous queues
-    instance_l.nextRequestQueue = 0;
+    OPLK_MEMSET(instance_l.aSoaClassCredit, 0, sizeof(instance_l.aSoaClassCredit));
+#if CONFIG_DLLCAL_SOA_ADAPTIVE != FALSE
+    OPLK_MEMCPY(instance_l.aSoaClassWeight, instance_l.aSoaClassBaseWeight,
+                sizeof(instance_l.aSoaClassWeight));
+    OPLK_MEMCPY(instance_l.statistics.aSoaClassWeight, instance_l.aSoaClassWeight,
+                sizeof(instance_l.statistics.aSoaClassWeight));
+    OPLK_MEMSET(instance_l.aSoaClassBacklog, 0, sizeof(instance_l.aSoaClassBacklog));
+    instance_l.adaptSlotCount = 0;
+#endif
 
-    circbuf_reset(instance_l.pQueueCnRequestGen);
-    circbuf_reset(instance_l.pQueueCnRequestNmt);
+    resetCnRequestQueue(&instance_l.cnRequestGen);
+    resetCnRequestQueue(&instance_l.cnRequestNmt);
     circbuf_reset(instance_l.pQueueIdentReq);
     circbuf_reset(instance_l.pQueueStatusReq);
 
@@ -764,6 +818,17 @@ Exit:
 The function returns the next request for SoA. It is called by the kernel
 DLL module.
 
+The requests are scheduled by a smooth weighted round-robin over the scheduler
+classes (see \ref tDllkCalSoaClass). In every SoA slot each class with pending
+requests earns credit according to its weight and the class with the highest
+credit is served. Thus every class gets a share of the asynchronous slots
+which is proportional to its weight and no class can be starved. Within the
+CN request classes, the nodes are served round-robin with their per-node
+credit.
+
+If CONFIG_DLLCAL_SOA_ADAPTIVE is enabled, the weights are adapted to the
+measured backlog of the classes at the end of every adaptation period.
+
 \param  pReqServiceId_p         Pointer to the request service ID of available
                                 request for MN NMT or generic request queue
                                 (Flag2.PR) or kDllReqServiceNo if queues are
@@ -783,46 +848,71 @@ tOplkError dllkcal_getSoaRequest(tDllReqServiceId* pReqServiceId_p,
                                  UINT* pNodeId_p, tSoaPayload* pSoaPayload_p)
 {
     tOplkError      ret = kErrorOk;
-    UINT            count;
+    BOOL            afPending[DLLKCAL_SOA_CLASS_COUNT];
+    INT             totalWeight = 0;
+    INT             bestClass;
+    UINT            soaClass;
+    ULONG           syncReqCount = 0;
+
+    instance_l.soaSlotCount++;
+
+    // the Sync request queue is shared with the user layer, read its fill
+    // level only once per SoA
+    if (instance_l.pTxSyncFuncs->pfnGetDataBlockCount(instance_l.dllCalQueueTxSync,
+                                                      &syncReqCount) != kErrorOk)
+        syncReqCount = 0;
+
+    // every class with pending requests earns its weight
+    for (soaClass = 0; soaClass < DLLKCAL_SOA_CLASS_COUNT; soaClass++)
+    {
+        afPending[soaClass] = hasSoaClassRequest(soaClass, *pReqServiceId_p, syncReqCount);
+        if (afPending[soaClass])
+        {
+            instance_l.aSoaClassCredit[soaClass] += (INT)instance_l.aSoaClassWeight[soaClass];
+            totalWeight += (INT)instance_l.aSoaClassWeight[soaClass];
+        }
+        else
+        {   // idle classes must not save up credit
+            instance_l.aSoaClassCredit[soaClass] = 0;
+        }
+    }
 
-    for (count = DLLKCAL_MAX_QUEUES; count > 0; count--)
+    for (;;)
     {
-        switch (instance_l.nextRequestQueue)
+        bestClass = -1;
+        for (soaClass = 0; soaClass < DLLKCAL_SOA_CLASS_COUNT; soaClass++)
+        {
+            if (afPending[soaClass] &&
+                ((bestClass < 0) ||
+                 (instance_l.aSoaClassCredit[soaClass] > instance_l.aSoaClassCredit[bestClass])))
+            {
+                bestClass = (INT)soaClass;
+            }
+        }
+
+        if (bestClass < 0)
+            break;      // no request available
+
+        if (getSoaClassRequest((UINT)bestClass, pReqServiceId_p, pNodeId_p,
+                               pSoaPayload_p, syncReqCount))
         {
-            case 0:
-                if (getCnGenRequest(pReqServiceId_p, pNodeId_p) == TRUE)
-                    goto Exit;
-                break;
-
-            case 1:
-                if (getCnNmtRequest(pReqServiceId_p, pNodeId_p) == TRUE)
-                    goto Exit;
-                break;
-
-            case 2:
-                if (getMnGenNmtRequest(pReqServiceId_p, pNodeId_p) == TRUE)
-                    goto Exit;
-                break;
-
-            case 3:
-                if (getMnIdentRequest(pReqServiceId_p, pNodeId_p) == TRUE)
-                    goto Exit;
-                break;
-
-            case 4:
-                if (getMnStatusRequest(pReqServiceId_p, pNodeId_p) == TRUE)
-                    goto Exit;
-                break;
-
-            case 5:
-                if (getMnSyncRequest(pReqServiceId_p, pNodeId_p, pSoaPayload_p)
-                                == TRUE)
-                    goto Exit;
-                break;
+            instance_l.aSoaClassCredit[bestClass] -= totalWeight;
+            instance_l.statistics.aSoaClassCount[bestClass]++;
+            break;
         }
+
+        // class contained only outdated requests
+        afPending[bestClass] = FALSE;
+        instance_l.aSoaClassCredit[bestClass] = 0;
     }
 
-Exit:
+    if (bestClass < 0)
+        instance_l.statistics.soaIdleSlotCount++;
+
+#if CONFIG_DLLCAL_SOA_ADAPTIVE != FALSE
+    adaptSoaClassWeights(afPending, bestClass);
+#endif
+
     return ret;
 }
 
@@ -848,39 +938,102 @@ tOplkError dllkcal_setAsyncPendingRequests(UINT nodeId_p,
 {
     tOplkError          ret = kErrorOk;
     tCircBufError       err;
-    UINT*               pLocalRequestCnt;
-    tCircBufInstance*   pTargetQueue;
+    tDllkCalCnReqQueue* pReqQueue;
+    UINT                nodeIdx = nodeId_p - 1;
 
-    // get local request count for the node and the target queue
+    // get the target queue
     switch(asyncReqPrio_p)
     {
         case kDllAsyncReqPrioNmt:
-            pLocalRequestCnt = &instance_l.aCnRequestCntNmt[nodeId_p-1];
-            pTargetQueue = instance_l.pQueueCnRequestNmt;
+            pReqQueue = &instance_l.cnRequestNmt;
             break;
         default:
-            pLocalRequestCnt = &instance_l.aCnRequestCntGen[nodeId_p-1];
-            pTargetQueue = instance_l.pQueueCnRequestGen;
+            pReqQueue = &instance_l.cnRequestGen;
             break;
     }
 
     // compare the node request count with the locally stored one
-    if(*pLocalRequestCnt < count_p)
+    if (pReqQueue->aRequestCnt[nodeIdx] < count_p)
     {
-        // The node has added some requests, but post only one for fair
-        // scheduling among the other nodes.
-        err = circbuf_writeData(pTargetQueue, &nodeId_p, sizeof(nodeId_p));
-        if(err == kCircBufOk)
-            (*pLocalRequestCnt)++; // increment locally only by successful post
+        // The node has added some requests, but take over only one per
+        // cycle for fair scheduling among the other nodes.
+        if (!pReqQueue->afQueued[nodeIdx])
+        {
+            err = circbuf_writeData(pReqQueue->pQueue, &nodeId_p, sizeof(nodeId_p));
+            if (err != kCircBufOk)
+                goto Exit;
+            pReqQueue->afQueued[nodeIdx] = TRUE;
+        }
+
+        if (pReqQueue->aPendingCnt[nodeIdx] == 0)
+            pReqQueue->aWaitStart[nodeIdx] = instance_l.soaSlotCount;
+
+        pReqQueue->aPendingCnt[nodeIdx]++;
+        pReqQueue->aRequestCnt[nodeIdx]++;
     }
     else
     {
         // the node's request count is equal or less the local one
-        *pLocalRequestCnt = count_p;
+        pReqQueue->aRequestCnt[nodeIdx] = count_p;
+        if (pReqQueue->aPendingCnt[nodeIdx] > count_p)
+            pReqQueue->aPendingCnt[nodeIdx] = count_p;
     }
 
+Exit:
     return ret;
 }
+
+//------------------------------------------------------------------------------
+/**
+\brief	Get PRes statistics of a node
+
+The function returns the PRes statistics entry of the specified node. It is
+used by the kernel DLL module to update the statistics.
+
+\param  nodeId_p                Node ID of the node.
+
+\return The function returns a pointer to the PRes statistics of the node or
+        NULL if the node ID is invalid.
+
+\ingroup module_dllkcal
+*/
+//------------------------------------------------------------------------------
+tDllkCalPresNodeStatistics* dllkcal_getPresNodeStatistics(UINT nodeId_p)
+{
+    if ((nodeId_p == C_ADR_INVALID) ||
+        (nodeId_p > tabentries(instance_l.statistics.aPresNodeStatistics)))
+        return NULL;
+
+    return &instance_l.statistics.aPresNodeStatistics[nodeId_p - 1];
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief	Set SoA credit of a node
+
+The function sets the number of consecutive asynchronous invitations which a
+node gets in its round of the CN request scheduler before the next node with
+pending requests is served.
+
+\param  nodeId_p                Node ID of the node.
+\param  credit_p                Credit of the node. Must not be zero.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_dllkcal
+*/
+//------------------------------------------------------------------------------
+tOplkError dllkcal_setSoaNodeCredit(UINT nodeId_p, UINT credit_p)
+{
+    if ((nodeId_p == C_ADR_INVALID) || (nodeId_p > tabentries(instance_l.aNodeCredit)))
+        return kErrorInvalidNodeId;
+
+    if (credit_p == 0)
+        return kErrorDllInvalidParam;
+
+    instance_l.aNodeCredit[nodeId_p - 1] = credit_p;
+    return kErrorOk;
+}
 #endif
 
 //============================================================================//
@@ -888,57 +1041,173 @@ tOplkError dllkcal_setAsyncPendingRequests(UINT nodeId_p,
 //============================================================================//
 
 #if defined(CONFIG_INCLUDE_NMT_MN)
+#if CONFIG_DLLCAL_SOA_ADAPTIVE != FALSE
+//------------------------------------------------------------------------------
+/**
+\brief	Adapt weights of the scheduler classes
+
+The function implements the adaptive SoA scheduler. It counts the SoA slots in
+which a class had pending requests but was not served. At the end of every
+period of CONFIG_DLLCAL_SOA_ADAPT_PERIOD slots the weight of each class which
+waited in more than half of the slots is increased by its configured weight,
+up to CONFIG_DLLCAL_SOA_ADAPT_MAX_FACTOR times the configured weight. The
+weight of a class which never waited falls back by one step towards the
+configured weight. The adaptation only depends on the scheduled requests and
+therefore is deterministic.
+
+\param  afPending_p             Classes which had pending requests in this slot.
+\param  servedClass_p           Class which was served in this slot, -1 if none.
+*/
+//------------------------------------------------------------------------------
+static void adaptSoaClassWeights(const BOOL* afPending_p, INT servedClass_p)
+{
+    UINT    soaClass;
+    UINT    baseWeight;
+    UINT    weight;
+
+    for (soaClass = 0; soaClass < DLLKCAL_SOA_CLASS_COUNT; soaClass++)
+    {
+        if (afPending_p[soaClass] && ((INT)soaClass != servedClass_p))
+            instance_l.aSoaClassBacklog[soaClass]++;
+    }
+
+    if (++instance_l.adaptSlotCount < CONFIG_DLLCAL_SOA_ADAPT_PERIOD)
+        return;
+
+    for (soaClass = 0; soaClass < DLLKCAL_SOA_CLASS_COUNT; soaClass++)
+    {
+        baseWeight = instance_l.aSoaClassBaseWeight[soaClass];
+        weight = instance_l.aSoaClassWeight[soaClass];
+
+        if ((instance_l.aSoaClassBacklog[soaClass] * 2 > CONFIG_DLLCAL_SOA_ADAPT_PERIOD) &&
+            (weight < baseWeight * CONFIG_DLLCAL_SOA_ADAPT_MAX_FACTOR))
+        {   // class is congested
+            weight += baseWeight;
+        }
+        else if ((instance_l.aSoaClassBacklog[soaClass] == 0) && (weight > baseWeight))
+        {   // class is not congested anymore
+            weight -= baseWeight;
+        }
+
+        if (weight != instance_l.aSoaClassWeight[soaClass])
+        {
+            instance_l.aSoaClassWeight[soaClass] = weight;
+            instance_l.statistics.aSoaClassWeight[soaClass] = weight;
+            instance_l.statistics.soaWeightAdaptCount++;
+        }
+        instance_l.aSoaClassBacklog[soaClass] = 0;
+    }
+    instance_l.adaptSlotCount = 0;
+}
+#endif
+
 //------------------------------------------------------------------------------
 /**
-\brief	Get CN Generic request
+\brief	Check for pending requests of a scheduler class
+
+The function checks whether the specified scheduler class has pending
+requests. The CN request classes may contain outdated requests, therefore a
+positive result doesn't guarantee that getSoaClassRequest() succeeds.
+
+\param  soaClass_p              Scheduler class to be checked.
+\param  reqServiceId_p          Request service ID of the MN's own queues.
+\param  syncReqCount_p          Number of entries in the Sync request queue.
+
+\return Returns TRUE if the class has pending requests, otherwise FALSE.
+*/
+//------------------------------------------------------------------------------
+static BOOL hasSoaClassRequest(UINT soaClass_p, tDllReqServiceId reqServiceId_p,
+                               ULONG syncReqCount_p)
+{
+    switch (soaClass_p)
+    {
+        case kDllkCalSoaClassCnNmt:
+            return ((instance_l.cnRequestNmt.curNodeId != 0) ||
+                    (circbuf_getDataCount(instance_l.cnRequestNmt.pQueue) > 0));
+
+        case kDllkCalSoaClassCnGen:
+            return ((instance_l.cnRequestGen.curNodeId != 0) ||
+                    (circbuf_getDataCount(instance_l.cnRequestGen.pQueue) > 0));
 
-The function returns the next CN generic request.
+        case kDllkCalSoaClassMnGenNmt:
+            return (reqServiceId_p != kDllReqServiceNo);
 
-\param  pReqServiceId_p			Pointer to store the next request.
+        case kDllkCalSoaClassMnIdent:
+            return (circbuf_getDataCount(instance_l.pQueueIdentReq) > 0);
+
+        case kDllkCalSoaClassMnStatus:
+            return (circbuf_getDataCount(instance_l.pQueueStatusReq) > 0);
+
+        case kDllkCalSoaClassMnSync:
+            return (syncReqCount_p > 0);
+
+        default:
+            return FALSE;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief	Get request of a scheduler class
+
+The function returns the next request of the specified scheduler class.
+
+\param  soaClass_p              Scheduler class to be served.
+\param  pReqServiceId_p         Pointer to store the next request.
 \param  pNodeId_p               Pointer to store the node ID for the next
                                 request.
+\param  pSoaPayload_p           Pointer to SoA payload.
+\param  syncReqCount_p          Number of entries in the Sync request queue.
 
 \return Returns if a request was found
 \retval TRUE        A request was found
 \retval FALSE       No request was found
 */
 //------------------------------------------------------------------------------
-static BOOL getCnGenRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p)
+static BOOL getSoaClassRequest(UINT soaClass_p, tDllReqServiceId* pReqServiceId_p,
+                               UINT* pNodeId_p, tSoaPayload* pSoaPayload_p,
+                               ULONG syncReqCount_p)
 {
-    tCircBufError   err;
-    UINT            rxNodeId;
-    size_t          size = sizeof(rxNodeId);
+    switch (soaClass_p)
+    {
+        case kDllkCalSoaClassCnNmt:
+            return getCnRequest(&instance_l.cnRequestNmt, kDllReqServiceNmtRequest,
+                                pReqServiceId_p, pNodeId_p);
 
-    // next queue will be CnNmtReq queue
-    instance_l.nextRequestQueue = 1;
+        case kDllkCalSoaClassCnGen:
+            return getCnRequest(&instance_l.cnRequestGen, kDllReqServiceUnspecified,
+                                pReqServiceId_p, pNodeId_p);
 
-    err = circbuf_readData(instance_l.pQueueCnRequestGen, &rxNodeId, size, &size);
+        case kDllkCalSoaClassMnGenNmt:
+            return getMnGenNmtRequest(pReqServiceId_p, pNodeId_p);
 
-    switch(err)
-    {
-        case kCircBufOk:
-            if(instance_l.aCnRequestCntGen[rxNodeId-1] > 0)
-            {
-                *pNodeId_p = rxNodeId;
-                *pReqServiceId_p = kDllReqServiceUnspecified;
+        case kDllkCalSoaClassMnIdent:
+            return getMnIdentRequest(pReqServiceId_p, pNodeId_p);
 
-                return TRUE;
-            }
-            // fall-trough
+        case kDllkCalSoaClassMnStatus:
+            return getMnStatusRequest(pReqServiceId_p, pNodeId_p);
+
+        case kDllkCalSoaClassMnSync:
+            return getMnSyncRequest(pReqServiceId_p, pNodeId_p, pSoaPayload_p,
+                                    syncReqCount_p);
 
-        case kCircBufNoReadableData:
         default:
-            // an empty or faulty queue has no requests
             return FALSE;
     }
 }
 
 //------------------------------------------------------------------------------
 /**
-\brief  Get CN NMT request
+\brief	Get CN request
 
-The function returns the next CN NMT request.
+The function returns the next request of the specified CN request queue. The
+current node is served until its credit is consumed or it has no more pending
+requests. Afterwards it is moved to the tail of the queue if it still has
+pending requests. The wait time of the granted request is added to the
+statistics of the node.
 
+\param  pReqQueue_p             Pointer to CN request queue.
+\param  reqServiceId_p          Request service ID of the queue.
 \param  pReqServiceId_p         Pointer to store the next request.
 \param  pNodeId_p               Pointer to store the node ID for the next
                                 request.
@@ -948,34 +1217,87 @@ The function returns the next CN NMT request.
 \retval FALSE       No request was found
 */
 //------------------------------------------------------------------------------
-static BOOL getCnNmtRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p)
+static BOOL getCnRequest(tDllkCalCnReqQueue* pReqQueue_p, tDllReqServiceId reqServiceId_p,
+                         tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p)
 {
-    tCircBufError   err;
-    UINT            rxNodeId;
-    size_t          size = sizeof(rxNodeId);
-
-    // next queue will be MnGenReq queue
-    instance_l.nextRequestQueue = 2;
-
-    err = circbuf_readData(instance_l.pQueueCnRequestNmt, &rxNodeId, size, &size);
+    tCircBufError               err;
+    UINT                        nodeId = pReqQueue_p->curNodeId;
+    UINT                        rxNodeId;
+    size_t                      size;
+    ULONG                       waitCount;
+    tDllkCalSoaNodeStatistics*  pNodeStat;
+
+    if ((nodeId != 0) &&
+        ((pReqQueue_p->aPendingCnt[nodeId - 1] == 0) || (pReqQueue_p->curCredit == 0)))
+    {   // round of the current node is over
+        pReqQueue_p->curNodeId = 0;
+        pReqQueue_p->afQueued[nodeId - 1] = FALSE;
+        if (pReqQueue_p->aPendingCnt[nodeId - 1] > 0)
+        {   // move node to the tail of the queue
+            err = circbuf_writeData(pReqQueue_p->pQueue, &nodeId, sizeof(nodeId));
+            if (err == kCircBufOk)
+                pReqQueue_p->afQueued[nodeId - 1] = TRUE;
+        }
+        nodeId = 0;
+    }
 
-    switch(err)
+    while (nodeId == 0)
     {
-        case kCircBufOk:
-            if(instance_l.aCnRequestCntNmt[rxNodeId-1] > 0)
-            {
-                *pNodeId_p = rxNodeId;
-                *pReqServiceId_p = kDllReqServiceNmtRequest;
+        size = sizeof(rxNodeId);
+        err = circbuf_readData(pReqQueue_p->pQueue, &rxNodeId, size, &size);
+        if (err != kCircBufOk)
+        {   // an empty or faulty queue has no requests
+            return FALSE;
+        }
 
-                return TRUE;
-            }
-            // fall-trough
+        if (pReqQueue_p->aPendingCnt[rxNodeId - 1] == 0)
+        {   // node has no more requests
+            pReqQueue_p->afQueued[rxNodeId - 1] = FALSE;
+            continue;
+        }
 
-        case kCircBufNoReadableData:
-        default:
-            // an empty or faulty queue has no requests
-            return FALSE;
+        nodeId = rxNodeId;
+        pReqQueue_p->curNodeId = nodeId;
+        pReqQueue_p->curCredit = instance_l.aNodeCredit[nodeId - 1];
     }
+
+    pReqQueue_p->aPendingCnt[nodeId - 1]--;
+    pReqQueue_p->curCredit--;
+
+    waitCount = (ULONG)(instance_l.soaSlotCount - pReqQueue_p->aWaitStart[nodeId - 1]);
+    pReqQueue_p->aWaitStart[nodeId - 1] = instance_l.soaSlotCount;
+
+    pNodeStat = &instance_l.statistics.aSoaNodeStatistics[nodeId - 1];
+    pNodeStat->invitationCount++;
+    pNodeStat->lastWaitCount = waitCount;
+    pNodeStat->totalWaitCount += waitCount;
+    if (waitCount > pNodeStat->maxWaitCount)
+        pNodeStat->maxWaitCount = waitCount;
+
+    *pNodeId_p = nodeId;
+    *pReqServiceId_p = reqServiceId_p;
+
+    return TRUE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief	Reset CN request queue
+
+The function resets the specified CN request queue.
+
+\param  pReqQueue_p             Pointer to CN request queue.
+*/
+//------------------------------------------------------------------------------
+static void resetCnRequestQueue(tDllkCalCnReqQueue* pReqQueue_p)
+{
+    circbuf_reset(pReqQueue_p->pQueue);
+
+    OPLK_MEMSET(pReqQueue_p->aRequestCnt, 0, sizeof(pReqQueue_p->aRequestCnt));
+    OPLK_MEMSET(pReqQueue_p->aPendingCnt, 0, sizeof(pReqQueue_p->aPendingCnt));
+    OPLK_MEMSET(pReqQueue_p->afQueued, 0, sizeof(pReqQueue_p->afQueued));
+    pReqQueue_p->curNodeId = 0;
+    pReqQueue_p->curCredit = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -996,8 +1318,6 @@ The function returns the next MN Generic/NMT request.
 static BOOL getMnGenNmtRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p)
 {
     // MnNmtReq and MnGenReq
-    // next queue will be MnIdentReq queue
-    instance_l.nextRequestQueue = 3;
     if (*pReqServiceId_p != kDllReqServiceNo)
     {
         *pNodeId_p = C_ADR_INVALID;   // DLLk must exchange this with the actual node ID
@@ -1027,9 +1347,6 @@ static BOOL getMnIdentRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p
     UINT            rxNodeId;
     size_t          size = sizeof(rxNodeId);
 
-    // next queue will be MnStatusReq queue
-    instance_l.nextRequestQueue = 4;
-
     err = circbuf_readData(instance_l.pQueueIdentReq, &rxNodeId, size, &size);
 
     if(err == kCircBufOk)
@@ -1062,8 +1379,6 @@ static BOOL getMnStatusRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_
     UINT            rxNodeId;
     size_t          size = sizeof(rxNodeId);
 
-    // next queue will be MnSyncReq queue
-    instance_l.nextRequestQueue = 5;
     err = circbuf_readData(instance_l.pQueueStatusReq, &rxNodeId, size, &size);
 
     if(err == kCircBufOk)
@@ -1088,6 +1403,8 @@ todo how to handle errors (ret != kErrorOk)? Is it sufficient that we
 \param  pNodeId_p               Pointer to store the node ID for the next
                                 request.
 \param  pSoaPayload_p           Pointer to SoA payload.
+\param  syncReqCount_p          Number of entries in the Sync request queue
+                                which was read by the caller for this SoA.
 
 \return Returns if a request was found
 \retval TRUE        A request was found
@@ -1095,23 +1412,14 @@ todo how to handle errors (ret != kErrorOk)? Is it sufficient that we
 */
 //------------------------------------------------------------------------------
 static BOOL getMnSyncRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p,
-                             tSoaPayload* pSoaPayload_p)
+                             tSoaPayload* pSoaPayload_p, ULONG syncReqCount_p)
 {
     tOplkError          ret;
-    ULONG               syncReqCount = 0;
     UINT                syncReqSize = 0;
     tDllSyncRequest     syncRequest;
     tDllNodeOpParam     nodeOpParam;
 
-    // next queue will be CnGenReq queue
-    instance_l.nextRequestQueue = 0;
-    ret = instance_l.pTxSyncFuncs->pfnGetDataBlockCount(
-                                instance_l.dllCalQueueTxSync, &syncReqCount);
-    if(ret != kErrorOk)
-    {
-        return TRUE;
-    }
-    if (syncReqCount > 0)
+    if (syncReqCount_p > 0)
     {
         syncReqSize = sizeof(syncRequest);
         ret = instance_l.pTxSyncFuncs->pfnGetDataBlock(
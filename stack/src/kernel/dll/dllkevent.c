@@ -184,14 +184,26 @@ The function forwards a loss of PRes event to the error handler module.
 //------------------------------------------------------------------------------
 tOplkError dllk_issueLossOfPres(UINT nodeId_p)
 {
-    tOplkError          ret = kErrorOk;
-    tDllkNodeInfo*      pIntNodeInfo;
-    tEvent              event;
-    tDllNodeOpParam     nodeOpParam;
+    tOplkError                  ret = kErrorOk;
+    tDllkNodeInfo*              pIntNodeInfo;
+    tEvent                      event;
+    tDllNodeOpParam             nodeOpParam;
+    tDllkCalPresNodeStatistics* pStatistics;
 
     pIntNodeInfo = dllk_getNodeInfo(nodeId_p);
     if (pIntNodeInfo != NULL)
     {
+        pIntNodeInfo->preqTxTimeStamp = 0;
+
+        pStatistics = dllkcal_getPresNodeStatistics(nodeId_p);
+        if (pStatistics != NULL)
+        {
+            pStatistics->lossCount++;
+            pStatistics->consecutiveLossCount++;
+            if (pStatistics->consecutiveLossCount > pStatistics->maxConsecutiveLossCount)
+                pStatistics->maxConsecutiveLossCount = pStatistics->consecutiveLossCount;
+        }
+
         if (pIntNodeInfo->fSoftDelete == FALSE)
         {   // normal isochronous CN
             tEventDllError  dllEvent;
@@ -1040,16 +1052,16 @@ static tOplkError processStartReducedCycle(void)
     dllkInstance_g.cycleCount = 0;
 
     // remove any CN from isochronous phase
-    while (dllkInstance_g.pFirstNodeInfo != NULL)
+    while (dllkInstance_g.isoNodeCount > 0)
     {
-        ret = dllk_deleteNodeIsochronous(dllkInstance_g.pFirstNodeInfo);
+        ret = dllk_deleteNodeIsochronous(dllk_getNodeInfo(dllkInstance_g.aIsoNodeIdList[0]));
         if (ret != kErrorOk)
             goto Exit;
     }
 
-    while (dllkInstance_g.pFirstPrcNodeInfo != NULL)
+    while (dllkInstance_g.prcNodeCount > 0)
     {
-        ret = dllk_deleteNodeIsochronous(dllkInstance_g.pFirstPrcNodeInfo);
+        ret = dllk_deleteNodeIsochronous(dllk_getNodeInfo(dllkInstance_g.aPrcNodeIdList[0]));
         if (ret != kErrorOk)
             goto Exit;
     }
@@ -43,6 +43,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stddef.h>
 
 #include <oplk/ami.h>
+#include <common/target.h>
+#include <oplk/tracering.h>
 #include "dllk-internal.h"
 
 //============================================================================//
@@ -90,6 +92,9 @@ static tOplkError processReceivedSoa(tEdrvRxBuffer* pRxBuffer_p, tNmtState nmtSt
 static tOplkError processReceivedAsnd(tFrameInfo* pFrameInfo_p, tEdrvRxBuffer* pRxBuffer_p,
                                       tNmtState nmtState_p, tEdrvReleaseRxBuffer* pReleaseRxBuffer_p);
 static tOplkError forwardRpdo(tFrameInfo * pFrameInfo_p);
+#if defined(CONFIG_INCLUDE_NMT_MN)
+static void       updatePresStatistics(tDllkNodeInfo* pIntNodeInfo_p);
+#endif
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -446,6 +451,7 @@ void dllk_processTransmittedSoc(tEdrvTxBuffer * pTxBuffer_p)
     TGT_DLLK_ENTER_CRITICAL_SECTION()
 
     nmtState = dllkInstance_g.nmtState;
+    TRACE_RING(kTraceIdSocTransmitted, nmtState);
     if (nmtState <= kNmtGsResetConfiguration)
         goto Exit;
 
@@ -467,6 +473,32 @@ Exit:
 #endif
 
 #if defined(CONFIG_INCLUDE_NMT_MN)
+#if CONFIG_DLL_PRES_LATENCY_STATISTICS != FALSE
+//------------------------------------------------------------------------------
+/**
+\brief  Callback function for transmitted PReq frame
+
+The function implements the callback function which is called when a PReq
+frame was transmitted. It stores the transmission time stamp for the PRes
+latency statistics of the addressed node.
+
+\param  pTxBuffer_p         Pointer to TxBuffer structure of transmitted frame.
+*/
+//------------------------------------------------------------------------------
+void dllk_processTransmittedPreq(tEdrvTxBuffer * pTxBuffer_p)
+{
+    tDllkNodeInfo*  pIntNodeInfo;
+    tPlkFrame*      pTxFrame = (tPlkFrame*)pTxBuffer_p->pBuffer;
+
+    if (pTxFrame == NULL)
+        return;
+
+    pIntNodeInfo = dllk_getNodeInfo(ami_getUint8Le(&pTxFrame->dstNodeId));
+    if (pIntNodeInfo != NULL)
+        pIntNodeInfo->preqTxTimeStamp = target_getCurrentTimestamp();
+}
+#endif
+
 //------------------------------------------------------------------------------
 /**
 \brief  Callback function for transmitted SoA frame
@@ -1523,6 +1555,8 @@ static tOplkError processReceivedPres(tFrameInfo* pFrameInfo_p, tNmtState nmtSta
             goto Exit;
         }
 
+        updatePresStatistics(pIntNodeInfo);
+
         if (fPrcSlotFinished != FALSE)
         {
             dllkInstance_g.fPrcSlotFinished = TRUE;
@@ -1692,6 +1726,8 @@ static tOplkError processReceivedSoc(tEdrvRxBuffer* pRxBuffer_p, tNmtState nmtSt
     UNUSED_PARAMETER(pRxBuffer_p);
 #endif
 
+    TRACE_RING(kTraceIdSocReceived, nmtState_p);
+
     if (nmtState_p >= kNmtMsNotActive)
     {   // MN is active -> wrong msg type
         return ret;
@@ -2243,5 +2279,57 @@ static tOplkError forwardRpdo(tFrameInfo * pFrameInfo_p)
     return ret;
 }
 
+#if defined(CONFIG_INCLUDE_NMT_MN)
+//------------------------------------------------------------------------------
+/**
+\brief  Update PRes statistics of a node
+
+The function updates the PRes statistics of the specified node after its PRes
+has been received. The latency is only measured if the transmission time of
+the PReq is known.
+
+\param  pIntNodeInfo_p      Pointer to internal node info structure.
+*/
+//------------------------------------------------------------------------------
+static void updatePresStatistics(tDllkNodeInfo* pIntNodeInfo_p)
+{
+    tDllkCalPresNodeStatistics* pStatistics;
+#if CONFIG_DLL_PRES_LATENCY_STATISTICS != FALSE
+    ULONGLONG                   latencyNs;
+    UINT32                      latencyUs;
+    UINT                        bucket;
+#endif
+
+    pStatistics = dllkcal_getPresNodeStatistics(pIntNodeInfo_p->nodeId);
+    if (pStatistics == NULL)
+        return;
+
+    pStatistics->consecutiveLossCount = 0;
+
+#if CONFIG_DLL_PRES_LATENCY_STATISTICS != FALSE
+    if (pIntNodeInfo_p->preqTxTimeStamp == 0)
+        return;
+
+    latencyNs = target_getCurrentTimestamp() - pIntNodeInfo_p->preqTxTimeStamp;
+    pIntNodeInfo_p->preqTxTimeStamp = 0;
+    if (latencyNs > 0xFFFFFFFFULL)
+        latencyNs = 0xFFFFFFFFULL;
+
+    if ((pStatistics->presCount == 0) || ((UINT32)latencyNs < pStatistics->latencyMinNs))
+        pStatistics->latencyMinNs = (UINT32)latencyNs;
+    if ((UINT32)latencyNs > pStatistics->latencyMaxNs)
+        pStatistics->latencyMaxNs = (UINT32)latencyNs;
+    pStatistics->latencySumNs += latencyNs;
+    pStatistics->presCount++;
+
+    // bucket 0: < 1 us, bucket n: [2^(n-1) us, 2^n us)
+    latencyUs = (UINT32)latencyNs / 1000;
+    for (bucket = 0; (latencyUs != 0) && (bucket < (DLLKCAL_PRES_HISTOGRAM_SIZE - 1)); bucket++)
+        latencyUs >>= 1;
+    pStatistics->aLatencyHistogram[bucket]++;
+#endif
+}
+#endif
+
 ///\}
 
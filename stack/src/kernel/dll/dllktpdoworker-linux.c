@@ -0,0 +1,350 @@
+/**
+********************************************************************************
+\file   dllktpdoworker-linux.c
+
+\brief  TPDO worker thread of the kernel DLL for Linux userspace
+
+This file implements the TPDO worker of the kernel DLL on Linux userspace.
+If CONFIG_DLL_TPDO_WORKER is enabled, the TPDOs of the next cycle are copied
+into the PReq/PRes frames of the MN by a dedicated thread. The thread is
+triggered by the cycle start callback and runs in parallel to the cycle
+finish processing of the kernel event thread. dllk_setupSyncPhase() then only
+waits for the worker instead of processing all TPDOs by itself.
+
+While the sync schedule is rebuilt, the worker is suspended. Every job stores
+the schedule generation it was started with, results of jobs which overlapped
+with a rebuild are discarded.
+
+\ingroup module_dllk
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2014, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include "dllk-internal.h"
+
+#if defined(CONFIG_INCLUDE_NMT_MN) && (CONFIG_DLL_TPDO_WORKER != FALSE)
+
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <errno.h>
+
+#include <common/target.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief TPDO worker instance
+
+The structure contains all information needed by the TPDO worker.
+*/
+typedef struct
+{
+    pthread_t               threadId;               ///< Thread ID of the worker thread
+    sem_t                   semTrigger;             ///< Signals a new job to the worker
+    sem_t                   semDone;                ///< Signals the end of the job to the waiter
+    volatile BOOL           fStopThread;            ///< Flag requests the termination of the thread
+    UINT32                  pending;                ///< A job was triggered and its result was not consumed yet (atomic)
+    UINT32                  generation;             ///< Sync schedule generation, odd while the schedule is rebuilt (atomic)
+    UINT32                  jobGeneration;          ///< Sync schedule generation of the current job
+    UINT                    txBufferOffset;         ///< TX buffer set of the current job
+    BOOL                    fReadyFlag;             ///< Ready flag of the current job
+    BOOL                    fInitialized;           ///< Worker is initialized
+} tDllkTpdoWorkerInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tDllkTpdoWorkerInstance  instance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void* workerThread(void* arg_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize TPDO worker
+
+The function creates the TPDO worker thread. Its scheduling parameters and
+CPU affinity are taken from the real-time thread configuration.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_dllk
+*/
+//------------------------------------------------------------------------------
+tOplkError dllk_initTpdoWorker(void)
+{
+    OPLK_MEMSET(&instance_l, 0, sizeof(instance_l));
+
+    if (sem_init(&instance_l.semTrigger, 0, 0) != 0)
+        return kErrorNoResource;
+
+    if (sem_init(&instance_l.semDone, 0, 0) != 0)
+    {
+        sem_destroy(&instance_l.semTrigger);
+        return kErrorNoResource;
+    }
+
+    if (pthread_create(&instance_l.threadId, NULL, workerThread, &instance_l) != 0)
+    {
+        sem_destroy(&instance_l.semDone);
+        sem_destroy(&instance_l.semTrigger);
+        return kErrorNoResource;
+    }
+
+    target_setupThread(instance_l.threadId, kOplkThreadTpdoWorker);
+
+    instance_l.fInitialized = TRUE;
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Shut down TPDO worker
+
+The function terminates the TPDO worker thread.
+
+\ingroup module_dllk
+*/
+//------------------------------------------------------------------------------
+void dllk_exitTpdoWorker(void)
+{
+    if (!instance_l.fInitialized)
+        return;
+
+    instance_l.fStopThread = TRUE;
+    sem_post(&instance_l.semTrigger);
+    pthread_join(instance_l.threadId, NULL);
+
+    sem_destroy(&instance_l.semDone);
+    sem_destroy(&instance_l.semTrigger);
+    instance_l.fInitialized = FALSE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Trigger TPDO worker
+
+The function requests the worker to prepare the TPDOs of the specified TX
+buffer set. It is called from the cycle start callback. If the result of the
+previous job has not been consumed yet, no new job is started.
+
+The job is claimed by setting the pending flag before the schedule generation
+is read. Thereby either the trigger sees a generation advanced by
+dllk_suspendTpdoWorker(), or the suspend sees the pending flag and waits for
+the job. If the sync schedule is being rebuilt, the job is completed at once
+without starting the worker and its result is discarded by
+dllk_waitTpdoWorker().
+
+\param  txBufferOffset_p    TX buffer set which shall be prepared.
+\param  fReadyFlag_p        Ready flag which shall be used for the TPDOs.
+
+\ingroup module_dllk
+*/
+//------------------------------------------------------------------------------
+void dllk_triggerTpdoWorker(UINT txBufferOffset_p, BOOL fReadyFlag_p)
+{
+    UINT32      generation;
+    UINT32      expected = 0;
+
+    if (!instance_l.fInitialized)
+        return;
+
+    if (!__atomic_compare_exchange_n(&instance_l.pending, &expected, 1, FALSE,
+                                     __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+        return;         // result of previous job not consumed yet
+
+    generation = __atomic_load_n(&instance_l.generation, __ATOMIC_SEQ_CST);
+    instance_l.txBufferOffset = txBufferOffset_p;
+    instance_l.fReadyFlag = fReadyFlag_p;
+    instance_l.jobGeneration = generation;
+
+    if (((generation & 1) != 0) ||
+        (generation != __atomic_load_n(&instance_l.generation, __ATOMIC_SEQ_CST)))
+    {   // schedule is being rebuilt, complete the job without running it
+        instance_l.jobGeneration = generation - 1;
+        sem_post(&instance_l.semDone);
+        return;
+    }
+
+    sem_post(&instance_l.semTrigger);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Wait for TPDO worker
+
+The function waits until a triggered job of the worker is finished and
+consumes its result.
+
+\param  txBufferOffset_p    TX buffer set which is about to be set up.
+
+\return The function returns TRUE if the TPDOs of the specified TX buffer set
+        have been prepared by the worker with the current sync schedule.
+        Otherwise FALSE is returned and the caller has to process the TPDOs
+        by itself.
+
+\ingroup module_dllk
+*/
+//------------------------------------------------------------------------------
+BOOL dllk_waitTpdoWorker(UINT txBufferOffset_p)
+{
+    BOOL        fValid;
+
+    if (__atomic_load_n(&instance_l.pending, __ATOMIC_SEQ_CST) == 0)
+        return FALSE;
+
+    while (sem_wait(&instance_l.semDone) != 0)
+    {
+        if (errno != EINTR)
+            break;
+    }
+
+    fValid = (instance_l.txBufferOffset == txBufferOffset_p) &&
+             (instance_l.jobGeneration == __atomic_load_n(&instance_l.generation, __ATOMIC_ACQUIRE));
+    __atomic_store_n(&instance_l.pending, 0, __ATOMIC_RELEASE);
+
+    return fValid;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Suspend TPDO worker
+
+The function is called before the sync schedule is rebuilt. It advances the
+schedule generation, so no new job is started and the result of every job
+which overlaps with the rebuild is discarded. A pending job is finished and
+its result is discarded. When the function returns, no job is running and
+none can be started until dllk_resumeTpdoWorker() is called.
+
+\ingroup module_dllk
+*/
+//------------------------------------------------------------------------------
+void dllk_suspendTpdoWorker(void)
+{
+    if (!instance_l.fInitialized)
+        return;
+
+    __atomic_add_fetch(&instance_l.generation, 1, __ATOMIC_SEQ_CST);
+    dllk_waitTpdoWorker((UINT)-1);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Resume TPDO worker
+
+The function is called after the sync schedule has been rebuilt. It advances
+the schedule generation again, so new jobs can be started.
+
+\ingroup module_dllk
+*/
+//------------------------------------------------------------------------------
+void dllk_resumeTpdoWorker(void)
+{
+    if (!instance_l.fInitialized)
+        return;
+
+    __atomic_add_fetch(&instance_l.generation, 1, __ATOMIC_ACQ_REL);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  TPDO worker thread function
+
+This function contains the main function of the TPDO worker thread.
+
+\param  arg_p               Pointer to worker instance.
+
+\return The function returns the thread exit code.
+*/
+//------------------------------------------------------------------------------
+static void* workerThread(void* arg_p)
+{
+    tDllkTpdoWorkerInstance*    pInstance = (tDllkTpdoWorkerInstance*)arg_p;
+
+    target_prefaultThreadStack();
+
+    for (;;)
+    {
+        if (sem_wait(&pInstance->semTrigger) != 0)
+            continue;
+
+        if (pInstance->fStopThread)
+            break;
+
+        dllk_prepareTpdos(pInstance->txBufferOffset, pInstance->fReadyFlag);
+        sem_post(&pInstance->semDone);
+    }
+
+    return NULL;
+}
+
+///\}
+
+#endif
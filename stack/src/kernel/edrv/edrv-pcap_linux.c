@@ -41,6 +41,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // includes
 //------------------------------------------------------------------------------
 #include <kernel/edrv.h>
+#include <common/target.h>
+#include <oplk/tracering.h>
 
 #include <unistd.h>
 #include <pcap.h>
@@ -130,7 +132,6 @@ tOplkError edrv_init(tEdrvInitParam* pEdrvInitParam_p)
 {
     tOplkError          ret = kErrorOk;
     char                aErrorMessage[PCAP_ERRBUF_SIZE];
-    struct sched_param  schedParam;
 
     // clear instance structure
     OPLK_MEMSET(&edrvInstance_l, 0, sizeof(edrvInstance_l));
@@ -203,12 +204,7 @@ tOplkError edrv_init(tEdrvInitParam* pEdrvInitParam_p)
         goto Exit;
     }
 
-    schedParam.__sched_priority = CONFIG_THREAD_PRIORITY_MEDIUM;
-    if (pthread_setschedparam(edrvInstance_l.hThread, SCHED_FIFO, &schedParam) != 0)
-    {
-        DEBUG_LVL_ERROR_TRACE("%s() couldn't set thread scheduling parameters!\n",
-                                __func__);
-    }
+    target_setupThread(edrvInstance_l.hThread, kOplkThreadEdrv);
 
     /* wait until thread is started */
     sem_wait(&edrvInstance_l.syncSem);
@@ -266,6 +262,7 @@ tOplkError edrv_sendTxBuffer(tEdrvTxBuffer* pBuffer_p)
     INT         pcapRet;
 
     FTRACE_MARKER("%s", __func__);
+    TRACE_RING(kTraceIdFrameTx, pBuffer_p->txFrameSize);
 
     if (pBuffer_p->txBufferNumber.pArg != NULL)
     {
@@ -474,6 +471,7 @@ static void packetHandler(u_char* pParam_p, const struct pcap_pkthdr* pHeader_p,
         rxBuffer.pBuffer = (UINT8*)pPktData_p;
 
         FTRACE_MARKER("%s RX", __func__);
+        TRACE_RING(kTraceIdFrameRx, pHeader_p->caplen);
         pInstance->initParam.pfnRxHandler(&rxBuffer);
     }
     else
@@ -555,6 +553,8 @@ static void* workerThread(void* pArgument_p)
 
     DEBUG_LVL_EDRV_TRACE("%s(): ThreadId:%ld\n", __func__, syscall(SYS_gettid));
 
+    target_prefaultThreadStack();
+
     pInstance->pPcapThread =
         pcap_open_live(pInstance->initParam.hwParam.pDevName,
                        65535,  // snaplen
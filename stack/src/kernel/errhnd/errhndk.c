@@ -80,6 +80,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#define ERRHNDK_MNCN_BITMAP_WORDS   ((NUM_DLL_MNCN_LOSSPRES_OBJS + 31) / 32)
 
 //------------------------------------------------------------------------------
 // local types
@@ -95,6 +96,10 @@ typedef struct
     ULONG               dllErrorEvents;                                 ///< Variable stores detected error events
     BYTE                aMnCnLossPresEvent[NUM_DLL_MNCN_LOSSPRES_OBJS]; ///< Variable stores detected error events from CNs
     tErrHndObjects      errorObjects;                                   ///< Error objects (counters and thresholds)
+#ifdef CONFIG_INCLUDE_NMT_MN
+    UINT32              aMnCnLossPresThresholdCnt[NUM_DLL_MNCN_LOSSPRES_OBJS]; ///< Kernel copy of the LossPres threshold counters of all CNs
+    UINT32              aMnCnActiveBitmap[ERRHNDK_MNCN_BITMAP_WORDS];   ///< Bitmap of CNs with a non-zero LossPres threshold counter
+#endif
 } tErrHndkInstance;
 
 //------------------------------------------------------------------------------
@@ -116,6 +121,7 @@ static tOplkError handleDllErrors(tEvent* pEvent_p);
 static tOplkError decrementMnCounters(void);
 static tOplkError postHeartbeatEvent(UINT nodeId_p, tNmtState state_p, UINT16 errorCode_p);
 static tOplkError generateHistoryEntryWithError(UINT16 errorCode_p, tNetTime netTime_p, UINT16 eplError_p);
+static void       setMnCnLossPresThresholdCnt(UINT nodeIdx_p, UINT32 thresholdCnt_p);
 #endif
 
 //============================================================================//
@@ -140,6 +146,12 @@ tOplkError errhndk_init(void)
 
     ret = kErrorOk;
     instance_l.dllErrorEvents = 0;
+#ifdef CONFIG_INCLUDE_NMT_MN
+    OPLK_MEMSET(instance_l.aMnCnLossPresThresholdCnt, 0,
+                sizeof(instance_l.aMnCnLossPresThresholdCnt));
+    OPLK_MEMSET(instance_l.aMnCnActiveBitmap, 0,
+                sizeof(instance_l.aMnCnActiveBitmap));
+#endif
 
     ret = errhndkcal_init();
     return ret;
@@ -190,6 +202,14 @@ tOplkError errhndk_process(tEvent* pEvent_p)
             ret = handleDllErrors(pEvent_p);
             break;
 
+        case kEventTypeErrhndWrite:
+            {
+                tErrHndObjectWrite*     pWrite = (tErrHndObjectWrite*)pEvent_p->pEventArg;
+
+                errhndkcal_writeErrorObject(pWrite->offset, pWrite->value);
+            }
+            break;
+
         // unknown type
         default:
             ret = kErrorInvalidEvent;
@@ -311,27 +331,29 @@ The function decrements the error counters used by a MN node.
 //------------------------------------------------------------------------------
 static tOplkError decrementMnCounters(void)
 {
-    BYTE*           pCnNodeId;
+    UINT            wordIdx;
     UINT            nodeIdx;
+    UINT32          activeMask;
     UINT32          thresholdCnt;
 
-    dllk_getCurrentCnNodeIdList(&pCnNodeId);
-
-    // iterate through node info structure list
-    while (*pCnNodeId != C_ADR_INVALID)
+    // Only CNs with a non-zero LossPres threshold counter are visited. The
+    // counters are stored in a separate array, therefore the scan over the
+    // bitmap only touches the cache lines of active CNs.
+    for (wordIdx = 0; wordIdx < ERRHNDK_MNCN_BITMAP_WORDS; wordIdx++)
     {
-        nodeIdx = *pCnNodeId - 1;
-        if (nodeIdx < NUM_DLL_MNCN_LOSSPRES_OBJS)
+        activeMask = instance_l.aMnCnActiveBitmap[wordIdx];
+
+        for (nodeIdx = wordIdx * 32; activeMask != 0; nodeIdx++, activeMask >>= 1)
         {
+            if ((activeMask & 1) == 0)
+                continue;
+
             if (instance_l.aMnCnLossPresEvent[nodeIdx] ==
                 ERRORHANDLERK_CN_LOSS_PRES_EVENT_NONE)
             {
-                errhndkcal_getMnCnLossPresThresholdCnt(nodeIdx, &thresholdCnt);
-                if (thresholdCnt > 0)
-                {
-                    thresholdCnt--;
-                    errhndkcal_setMnCnLossPresThresholdCnt(nodeIdx, thresholdCnt);
-                }
+                thresholdCnt = instance_l.aMnCnLossPresThresholdCnt[nodeIdx] - 1;
+                setMnCnLossPresThresholdCnt(nodeIdx, thresholdCnt);
+                errhndkcal_setMnCnLossPresThresholdCnt(nodeIdx, thresholdCnt);
             }
             else
             {
@@ -343,7 +365,6 @@ static tOplkError decrementMnCounters(void)
                 }
             }
         }
-        pCnNodeId++;
     }
 
     if ((instance_l.dllErrorEvents & DLL_ERR_MN_CRC) == 0)
@@ -805,6 +826,7 @@ static tOplkError handleMnCnLossPres(tEvent* pEvent_p)
                                              pErrorHandlerEvent->nodeId);
             if (ret != kErrorOk)
             {
+                setMnCnLossPresThresholdCnt(nodeIdx, thresholdCnt);
                 errhndkcal_setMnCnLossPresCounters(nodeIdx, cumulativeCnt,
                                                    thresholdCnt);
                 return ret;
@@ -826,10 +848,35 @@ static tOplkError handleMnCnLossPres(tEvent* pEvent_p)
                             ERRORHANDLERK_CN_LOSS_PRES_EVENT_OCC;
         }
     }
+    setMnCnLossPresThresholdCnt(nodeIdx, thresholdCnt);
     errhndkcal_setMnCnLossPresCounters(nodeIdx, cumulativeCnt, thresholdCnt);
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief    Update kernel copy of a LossPres threshold counter
+
+The function stores the LossPres threshold counter of a CN in the kernel copy
+and updates the bitmap of CNs with a non-zero threshold counter accordingly.
+The threshold counter is read-only in the object dictionary, so the kernel
+error handler is its only writer and the copy is always up to date.
+
+\param  nodeIdx_p           Index of node (node ID - 1).
+\param  thresholdCnt_p      New threshold counter.
+*/
+//------------------------------------------------------------------------------
+static void setMnCnLossPresThresholdCnt(UINT nodeIdx_p, UINT32 thresholdCnt_p)
+{
+    UINT32      mask = (UINT32)1 << (nodeIdx_p & 31);
+
+    instance_l.aMnCnLossPresThresholdCnt[nodeIdx_p] = thresholdCnt_p;
+    if (thresholdCnt_p != 0)
+        instance_l.aMnCnActiveBitmap[nodeIdx_p >> 5] |= mask;
+    else
+        instance_l.aMnCnActiveBitmap[nodeIdx_p >> 5] &= ~mask;
+}
+
 #endif
 
 //------------------------------------------------------------------------------
@@ -137,6 +137,26 @@ tErrHndObjects* errhndkcal_getMemPtr(void)
     return &errhndk_errorObjects_g;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief    Write an error handler object
+
+The function writes an error handler object on request of the user layer.
+
+\param  offset_p            Offset of the object in the error objects.
+\param  value_p             Value to write.
+
+\ingroup module_errhndkcal
+*/
+//------------------------------------------------------------------------------
+void errhndkcal_writeErrorObject(UINT offset_p, UINT32 value_p)
+{
+    if (offset_p > (sizeof(tErrHndObjects) - sizeof(UINT32)))
+        return;
+
+    *(UINT32*)((BYTE*)&errhndk_errorObjects_g + offset_p) = value_p;
+}
+
 //------------------------------------------------------------------------------
 // getters
 //------------------------------------------------------------------------------
@@ -46,11 +46,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <common/errhnd.h>
 #include "errhndkcal.h"
 
-#include <unistd.h>
-#include <sys/mman.h>
-#include <sys/types.h>
-#include <fcntl.h>           /* For O_* constants */
-#include <sys/stat.h>
+#include <common/shmem.h>
 
 
 //============================================================================//
@@ -86,13 +82,15 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
-static int                      fd_l;
+static tShmemRegion             shmRegion_l;
+static tErrHndShmRegion*        pErrHndShm_l;
 static tErrHndObjects*          pErrHndMem_l;
-static BOOL                     fCreator_l;
 
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
+static UINT32 beginWrite(void);
+static void   endWrite(UINT32 sequence_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -111,49 +109,22 @@ The function initializes the kernel layer CAL module of the error handler.
 //------------------------------------------------------------------------------
 tOplkError errhndkcal_init(void)
 {
-    struct stat             stat;
-
     if (pErrHndMem_l != NULL)
         return kErrorNoFreeInstance;
 
-    if ((fd_l = shm_open(ERRHND_SHM_NAME, O_RDWR | O_CREAT, 0)) < 0)
-    {
-        TRACE("%s() shm_open failed!\n", __func__);
-        return kErrorNoResource;
-    }
-
-    if (fstat(fd_l, &stat) != 0)
+    if (shmem_map(ERRHND_SHM_NAME, sizeof(tErrHndShmRegion), kShmemModeOpen,
+                  &shmRegion_l) != kErrorOk)
     {
-        close(fd_l);
+        TRACE("%s() mapping shared memory failed!\n", __func__);
         return kErrorNoResource;
     }
 
-    if (stat.st_size == 0)
+    pErrHndShm_l = (tErrHndShmRegion*)shmRegion_l.pBase;
+    if (shmRegion_l.fCreator)
     {
-        if (ftruncate(fd_l, sizeof(tErrHndObjects)) == -1)
-        {
-            TRACE("%s() ftruncate failed!\n", __func__);
-            close(fd_l);
-            shm_unlink(ERRHND_SHM_NAME);
-            return kErrorNoResource;
-        }
-        fCreator_l = TRUE;
-    }
-
-    pErrHndMem_l = mmap(NULL, sizeof(tErrHndObjects), PROT_READ | PROT_WRITE, MAP_SHARED, fd_l, 0);
-    if (pErrHndMem_l == MAP_FAILED)
-    {
-        TRACE("%s() mmap header failed!\n", __func__);
-        close(fd_l);
-        if (fCreator_l)
-            shm_unlink(ERRHND_SHM_NAME);
-        return kErrorNoResource;
-    }
-
-    if (fCreator_l)
-    {
-        OPLK_MEMSET(pErrHndMem_l, 0, sizeof(tErrHndObjects));
+        OPLK_MEMSET(pErrHndShm_l, 0, sizeof(tErrHndShmRegion));
     }
+    pErrHndMem_l = &pErrHndShm_l->errorObjects;
     return kErrorOk;
 }
 
@@ -171,15 +142,39 @@ void errhndkcal_exit(void)
 {
     if (pErrHndMem_l != NULL)
     {
-        munmap(pErrHndMem_l, sizeof(tErrHndObjects));
-        close(fd_l);
-        if (fCreator_l)
-            shm_unlink(ERRHND_SHM_NAME);
-        fd_l = 0;
-        pErrHndMem_l = 0;
+        shmem_unmap(&shmRegion_l);
+        if (shmRegion_l.fCreator)
+            shmem_unlink(ERRHND_SHM_NAME);
+        pErrHndShm_l = NULL;
+        pErrHndMem_l = NULL;
     }
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief    Write an error handler object
+
+The function writes an error handler object on request of the user layer. The write is
+protected by the sequence counter like all other writes of the kernel layer.
+
+\param  offset_p            Offset of the object in the error objects.
+\param  value_p             Value to write.
+
+\ingroup module_errhndkcal
+*/
+//------------------------------------------------------------------------------
+void errhndkcal_writeErrorObject(UINT offset_p, UINT32 value_p)
+{
+    UINT32      sequence;
+
+    if (offset_p > (sizeof(tErrHndObjects) - sizeof(UINT32)))
+        return;
+
+    sequence = beginWrite();
+    *(UINT32*)((BYTE*)pErrHndMem_l + offset_p) = value_p;
+    endWrite(sequence);
+}
+
 //------------------------------------------------------------------------------
 // getters
 //------------------------------------------------------------------------------
@@ -412,8 +407,12 @@ void errhndkcal_getMnCnLossPresThresholdCnt(UINT nodeIdx_p,
 void errhndkcal_setCnLossSocCounters(UINT32 dwCumulativeCnt_p,
                                      UINT32 dwThresholdCnt_p)
 {
+    UINT32      sequence;
+
+    sequence = beginWrite();
     pErrHndMem_l->cnLossSoc.cumulativeCnt = dwCumulativeCnt_p;
     pErrHndMem_l->cnLossSoc.thresholdCnt = dwThresholdCnt_p;
+    endWrite(sequence);
 }
 
 //------------------------------------------------------------------------------
@@ -429,8 +428,12 @@ void errhndkcal_setCnLossSocCounters(UINT32 dwCumulativeCnt_p,
 void errhndkcal_setCnLossPreqCounters(UINT32 dwCumulativeCnt_p,
                                       UINT32 dwThresholdCnt_p)
 {
+    UINT32      sequence;
+
+    sequence = beginWrite();
     pErrHndMem_l->cnLossPreq.cumulativeCnt = dwCumulativeCnt_p;
     pErrHndMem_l->cnLossPreq.thresholdCnt = dwThresholdCnt_p;
+    endWrite(sequence);
 }
 
 //------------------------------------------------------------------------------
@@ -446,8 +449,12 @@ void errhndkcal_setCnLossPreqCounters(UINT32 dwCumulativeCnt_p,
 void errhndkcal_setCnCrcCounters(UINT32 dwCumulativeCnt_p,
                                  UINT32 dwThresholdCnt_p)
 {
+    UINT32      sequence;
+
+    sequence = beginWrite();
     pErrHndMem_l->cnCrcErr.cumulativeCnt = dwCumulativeCnt_p;
     pErrHndMem_l->cnCrcErr.thresholdCnt = dwThresholdCnt_p;
+    endWrite(sequence);
 }
 
 #ifdef CONFIG_INCLUDE_NMT_MN
@@ -464,8 +471,12 @@ void errhndkcal_setCnCrcCounters(UINT32 dwCumulativeCnt_p,
 void errhndkcal_setMnCrcCounters(UINT32 dwCumulativeCnt_p,
                                  UINT32 dwThresholdCnt_p)
 {
+    UINT32      sequence;
+
+    sequence = beginWrite();
     pErrHndMem_l->mnCrcErr.cumulativeCnt = dwCumulativeCnt_p;
     pErrHndMem_l->mnCrcErr.thresholdCnt = dwThresholdCnt_p;
+    endWrite(sequence);
 }
 
 //------------------------------------------------------------------------------
@@ -481,8 +492,12 @@ void errhndkcal_setMnCrcCounters(UINT32 dwCumulativeCnt_p,
 void errhndkcal_setMnCycTimeExceedCounters(UINT32 dwCumulativeCnt_p,
                                            UINT32 dwThresholdCnt_p)
 {
+    UINT32      sequence;
+
+    sequence = beginWrite();
     pErrHndMem_l->mnCycTimeExceed.cumulativeCnt = dwCumulativeCnt_p;
     pErrHndMem_l->mnCycTimeExceed.thresholdCnt = dwThresholdCnt_p;
+    endWrite(sequence);
 }
 
 //------------------------------------------------------------------------------
@@ -500,8 +515,12 @@ void errhndkcal_setMnCnLossPresCounters(UINT nodeIdx_p,
                                         UINT32 dwCumulativeCnt_p,
                                         UINT32 dwThresholdCnt_p)
 {
+    UINT32      sequence;
+
+    sequence = beginWrite();
     pErrHndMem_l->aMnCnLossPres[nodeIdx_p].cumulativeCnt = dwCumulativeCnt_p;
     pErrHndMem_l->aMnCnLossPres[nodeIdx_p].thresholdCnt = dwThresholdCnt_p;
+    endWrite(sequence);
 }
 #endif
 
@@ -516,7 +535,11 @@ void errhndkcal_setMnCnLossPresCounters(UINT nodeIdx_p,
 //------------------------------------------------------------------------------
 void errhndkcal_setLossSocThresholdCnt(UINT32 dwThresholdCnt_p)
 {
+    UINT32      sequence;
+
+    sequence = beginWrite();
     pErrHndMem_l->cnLossSoc.thresholdCnt = dwThresholdCnt_p;
+    endWrite(sequence);
 }
 
 //------------------------------------------------------------------------------
@@ -530,7 +553,11 @@ void errhndkcal_setLossSocThresholdCnt(UINT32 dwThresholdCnt_p)
 //------------------------------------------------------------------------------
 void errhndkcal_setLossPreqThresholdCnt(UINT32 dwThresholdCnt_p)
 {
+    UINT32      sequence;
+
+    sequence = beginWrite();
     pErrHndMem_l->cnLossPreq.thresholdCnt = dwThresholdCnt_p;
+    endWrite(sequence);
 }
 
 //------------------------------------------------------------------------------
@@ -544,7 +571,11 @@ void errhndkcal_setLossPreqThresholdCnt(UINT32 dwThresholdCnt_p)
 //------------------------------------------------------------------------------
 void errhndkcal_setCnCrcThresholdCnt(UINT32 dwThresholdCnt_p)
 {
+    UINT32      sequence;
+
+    sequence = beginWrite();
     pErrHndMem_l->cnCrcErr.thresholdCnt = dwThresholdCnt_p;
+    endWrite(sequence);
 }
 
 #ifdef CONFIG_INCLUDE_NMT_MN
@@ -559,7 +590,11 @@ void errhndkcal_setCnCrcThresholdCnt(UINT32 dwThresholdCnt_p)
 //------------------------------------------------------------------------------
 void errhndkcal_setMnCrcThresholdCnt(UINT32 dwThresholdCnt_p)
 {
+    UINT32      sequence;
+
+    sequence = beginWrite();
     pErrHndMem_l->mnCrcErr.thresholdCnt = dwThresholdCnt_p;
+    endWrite(sequence);
 }
 
 //------------------------------------------------------------------------------
@@ -573,7 +608,11 @@ void errhndkcal_setMnCrcThresholdCnt(UINT32 dwThresholdCnt_p)
 //------------------------------------------------------------------------------
 void errhndkcal_setMnCycTimeExceedThresholdCnt(UINT32 dwThresholdCnt_p)
 {
+    UINT32      sequence;
+
+    sequence = beginWrite();
     pErrHndMem_l->mnCycTimeExceed.thresholdCnt = dwThresholdCnt_p;
+    endWrite(sequence);
 }
 
 //------------------------------------------------------------------------------
@@ -589,11 +628,60 @@ void errhndkcal_setMnCycTimeExceedThresholdCnt(UINT32 dwThresholdCnt_p)
 void errhndkcal_setMnCnLossPresThresholdCnt(UINT nodeIdx_p,
                                             UINT32 dwThresholdCnt_p)
 {
+    UINT32      sequence;
+
+    sequence = beginWrite();
     pErrHndMem_l->aMnCnLossPres[nodeIdx_p].thresholdCnt = dwThresholdCnt_p;
+    endWrite(sequence);
 }
 #endif
 
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Begin write access to shared error objects
+
+The function starts a write access to the shared error objects by making the
+sequence counter odd. All error objects are written by the kernel event
+thread, the user layer requests its writes by events. Therefore there is only
+one writer and the counter can be advanced without a lock, so the kernel layer
+never waits for the user layer.
+
+\return The function returns the sequence counter value before the write.
+*/
+//------------------------------------------------------------------------------
+static UINT32 beginWrite(void)
+{
+    UINT32      sequence;
+
+    sequence = pErrHndShm_l->sequence;
+    pErrHndShm_l->sequence = sequence + 1;
+    OPLK_MEMBAR();
+
+    return sequence;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  End write access to shared error objects
+
+The function finishes a write access to the shared error objects. The sequence
+counter becomes even again and differs from the value before the write, so
+readers which overlapped with the write will retry.
+
+\param  sequence_p          Sequence counter value returned by beginWrite().
+*/
+//------------------------------------------------------------------------------
+static void endWrite(UINT32 sequence_p)
+{
+    OPLK_MEMBAR();
+    pErrHndShm_l->sequence = sequence_p + 2;
+}
+
+///\}
 
@@ -64,6 +64,7 @@ extern "C" {
 tOplkError errhndkcal_init (void);
 void errhndkcal_exit (void);
 tErrHndObjects* errhndkcal_getMemPtr(void);
+void errhndkcal_writeErrorObject(UINT offset_p, UINT32 value_p);
 
 /* Reading of error objects */
 void errhndkcal_getCnLossSocError(UINT32* pCumulativeCnt_p, UINT32* pThresholdCnt_p, UINT32* pThreshold_p);
@@ -50,6 +50,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <kernel/dllkcal.h>
 #include <kernel/errhndk.h>
 #include <oplk/benchmark.h>
+#include <oplk/tracering.h>
 
 #if defined(CONFIG_INCLUDE_PDO)
 #include <kernel/pdok.h>
@@ -247,6 +248,8 @@ tOplkError eventk_postEvent (tEvent *pEvent_p)
 {
     tOplkError ret = kErrorOk;
 
+    TRACE_RING(kTraceIdEventPostKernel, ((UINT32)pEvent_p->eventSink << 16) | pEvent_p->eventType);
+
     switch(pEvent_p->eventSink)
     {
         case kEventSinkNmtMnu:
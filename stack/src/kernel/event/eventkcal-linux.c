@@ -62,7 +62,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
-#define KERNEL_EVENT_THREAD_PRIORITY        55
+#define EVENT_THREAD_POLL_PERIOD_US     10000       ///< Poll period while waiting for the event thread
+#define EVENT_THREAD_STOP_TIMEOUT_US    1000000     ///< Time to wait for the event thread to terminate
 
 //------------------------------------------------------------------------------
 // module global vars
@@ -130,8 +131,6 @@ The function initializes the kernel event CAL module on Linux.
 //------------------------------------------------------------------------------
 tOplkError eventkcal_init (void)
 {
-    struct sched_param  schedParam;
-
     OPLK_MEMSET(&instance_l, 0, sizeof(tEventkCalInstance));
 
     if ((instance_l.semUserData = sem_open("/semUserEvent", O_CREAT | O_RDWR, S_IRWXG, 0)) == SEM_FAILED)
@@ -157,12 +156,7 @@ tOplkError eventkcal_init (void)
     if (pthread_create(&instance_l.threadId, NULL, eventThread, (void*)&instance_l) != 0)
         goto Exit;
 
-    schedParam.__sched_priority = KERNEL_EVENT_THREAD_PRIORITY;
-    if (pthread_setschedparam(instance_l.threadId, SCHED_FIFO, &schedParam) != 0)
-    {
-        DEBUG_LVL_ERROR_TRACE("%s(): couldn't set thread scheduling parameters! %d\n",
-               __func__, schedParam.__sched_priority);
-    }
+    target_setupThread(instance_l.threadId, kOplkThreadEventKernel);
 
     instance_l.fInitialized = TRUE;
     return kErrorOk;
@@ -198,19 +192,23 @@ functions of the queue implementations for each used queue.
 //------------------------------------------------------------------------------
 tOplkError eventkcal_exit (void)
 {
-    UINT             i = 0;
+    ULONGLONG       deadline;
+    ULONGLONG       timeout;
 
     if (instance_l.fInitialized == TRUE)
     {
         instance_l.fStopThread = TRUE;
+        deadline = target_getTickCountUs();
+        timeout = deadline + EVENT_THREAD_STOP_TIMEOUT_US;
         while (instance_l.fStopThread == TRUE)
         {
-            target_msleep(10);
-            if (i++ > 100)
+            if (deadline >= timeout)
             {
                 TRACE("Event Thread is not terminating, continue shutdown...!\n");
                 break;
             }
+            deadline += EVENT_THREAD_POLL_PERIOD_US;
+            target_sleepUntil(deadline);
         }
 
         eventkcal_exitQueueCircbuf(kEventQueueK2U);
@@ -309,6 +307,8 @@ static void * eventThread(void *arg)
     struct timespec         curTime, timeout;
     tEventkCalInstance*     pInstance = (tEventkCalInstance*)arg;
 
+    target_prefaultThreadStack();
+
     while (!pInstance->fStopThread)
     {
         clock_gettime(CLOCK_REALTIME, &curTime);
@@ -6,6 +6,14 @@
 
 This file contains the implementation of the NMT kernel module.
 
+The NMT state machine is driven by a transition table. Each entry describes a
+transition of the NMT specification, the states it starts from, the triggering
+event and the resulting state. Transitions which depend on additional
+conditions are decided by a transition function. At initialization the table
+is expanded into a flat (state, event) lookup table, so that each NMT event is
+dispatched with a single table access. Events without a transition in the
+current state, e.g. most of the cyclic frame events, are ignored immediately.
+
 \ingroup module_nmtk
 *******************************************************************************/
 
@@ -44,6 +52,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <oplk/timer.h>
 #include "kernel/dllk.h"
 
+#if (TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__) && (CONFIG_MEMPOOL != FALSE)
+#include <common/mempool.h>
+#endif
+
+#if (CONFIG_NMTK_STATISTICS != FALSE)
+#include <common/target.h>
+#endif
+
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
 //============================================================================//
@@ -77,8 +93,6 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 //============================================================================//
 //            P R I V A T E   D E F I N I T I O N S                           //
-//============================================================================//
-
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
@@ -105,10 +119,65 @@ typedef enum
     kNmtkMsBasicEthernet
 } tNmtkStateIndexes;
 
+#define NMTK_STATE_COUNT            (kNmtkMsBasicEthernet + 1)
+#define NMTK_EVENT_COUNT            (kNmtEventCriticalError + 1)    // the last NMT event
+
+// State masks used by the transition table
+#define NMTK_STATE(stateIndex_p)    ((UINT32)1 << (stateIndex_p))
+
+#define NMTK_STATES_CS              (NMTK_STATE(kNmtkCsNotActive) | \
+                                     NMTK_STATE(kNmtkCsPreOperational1) | \
+                                     NMTK_STATE(kNmtkCsStopped) | \
+                                     NMTK_STATE(kNmtkCsPreOperational2) | \
+                                     NMTK_STATE(kNmtkCsReadyToOperate) | \
+                                     NMTK_STATE(kNmtkCsOperational) | \
+                                     NMTK_STATE(kNmtkCsBasicEthernet))
+
+#if defined(CONFIG_INCLUDE_NMT_MN)
+#define NMTK_STATES_MS_ACTIVE       (NMTK_STATE(kNmtkMsPreOperational1) | \
+                                     NMTK_STATE(kNmtkMsPreOperational2) | \
+                                     NMTK_STATE(kNmtkMsReadyToOperate) | \
+                                     NMTK_STATE(kNmtkMsOperational) | \
+                                     NMTK_STATE(kNmtkMsBasicEthernet))
+#define NMTK_STATES_MS              (NMTK_STATE(kNmtkMsNotActive) | NMTK_STATES_MS_ACTIVE)
+#else
+#define NMTK_STATES_MS              0
+#endif
+
+// States of the CN or MN state machine (sub-states of NMT_GS_COMMUNICATING)
+#define NMTK_STATES_COMMUNICATING   (NMTK_STATES_CS | NMTK_STATES_MS)
+
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
-typedef tOplkError (*tNmtkStateFunc)(tNmtEvent nmtEvent_p);
+
+/**
+\brief Transition function
+
+A transition function is called if the event of its transition occurs in one
+of the start states. It updates the instance flags and decides about the
+transition.
+
+\param  newStateIndex_p     State after the transition as specified in the
+                            transition table.
+
+\return The function returns the state the state machine shall enter. It returns
+        the current state if the transition is not taken.
+*/
+typedef tNmtkStateIndexes (*tNmtkTransitionFunc)(tNmtkStateIndexes newStateIndex_p);
+
+/**
+\brief Transition table entry
+
+The structure describes a transition of the NMT state machine.
+*/
+typedef struct
+{
+    UINT32                      stateMask;              ///< States the transition starts from (see NMTK_STATE())
+    tNmtEvent                   nmtEvent;               ///< Event triggering the transition
+    tNmtkStateIndexes           newStateIndex;          ///< State after the transition
+    tNmtkTransitionFunc         pfnTransition;          ///< Transition function, NULL for unconditional transitions
+} tNmtkTransition;
 
 typedef struct
 {
@@ -118,69 +187,217 @@ typedef struct
     volatile BOOL               fTimerMsPreOp2;
     volatile BOOL               fAllMandatoryCNIdent;
     volatile BOOL               fFrozen;
+    const tNmtkTransition*      apTransition[NMTK_MAX_TRANSITIONS];                 ///< Transitions of the lookup table
+    UINT8                       aLookup[NMTK_STATE_COUNT][NMTK_EVENT_COUNT];        ///< Transition of each state and event (index + 1, 0 = none)
+    UINT                        transitionCount;                                    ///< Number of used entries in apTransition
+#if (CONFIG_NMTK_STATISTICS != FALSE)
+    volatile UINT32             statSequence;                                       ///< Sequence counter of the statistics, odd while they are updated (single writer: kernel event context)
+    tNmtkStatistics             statistics;                                         ///< Transition statistics
+#endif
 } tNmtkInstance;
 
-typedef struct
-{
-    tNmtState                   nmtState;
-    tNmtkStateFunc              pfnState;
-} tNmtkStateTable;
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tOplkError           buildLookupTable(void);
+static tNmtkStateIndexes    resetReadyToOperate(tNmtkStateIndexes newStateIndex_p);
+static tNmtkStateIndexes    resetConfiguration(tNmtkStateIndexes newStateIndex_p);
+static tNmtkStateIndexes    appReadyToOperate(tNmtkStateIndexes newStateIndex_p);
+static tNmtkStateIndexes    enableReadyToOperate(tNmtkStateIndexes newStateIndex_p);
+static tNmtkStateIndexes    freeze(tNmtkStateIndexes newStateIndex_p);
+#if defined(CONFIG_INCLUDE_NMT_MN)
+static tNmtkStateIndexes    leaveMsNotActive(tNmtkStateIndexes newStateIndex_p);
+static tNmtkStateIndexes    enterMsPreOperational1(tNmtkStateIndexes newStateIndex_p);
+static tNmtkStateIndexes    allMandatoryCnIdent(tNmtkStateIndexes newStateIndex_p);
+static tNmtkStateIndexes    timerMsPreOperational2(tNmtkStateIndexes newStateIndex_p);
+#endif
+#if (CONFIG_NMTK_STATISTICS != FALSE)
+static void                 updateStatistics(UINT transition_p, ULONGLONG startTime_p,
+                                             BOOL fStateChange_p);
+#endif
 
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
 tNmtkInstance               nmtkInstance_g;
 
-//------------------------------------------------------------------------------
-// local function prototypes
-//------------------------------------------------------------------------------
-static tOplkError doStateGsOff(tNmtEvent nmtEvent_p);
-static tOplkError doStateGsInitialising(tNmtEvent nmtEvent_p);
-static tOplkError doStateGsResetApplication(tNmtEvent nmtEvent_p);
-static tOplkError doStateGsResetCommunication(tNmtEvent nmtEvent_p);
-static tOplkError doStateGsResetConfiguration(tNmtEvent nmtEvent_p);
+static const tNmtState      nmtkStates_l[] =
+{
+    kNmtGsOff,
+    kNmtGsInitialising,
+    kNmtGsResetApplication,
+    kNmtGsResetCommunication,
+    kNmtGsResetConfiguration,
+    kNmtCsNotActive,
+    kNmtCsPreOperational1,
+    kNmtCsStopped,
+    kNmtCsPreOperational2,
+    kNmtCsReadyToOperate,
+    kNmtCsOperational,
+    kNmtCsBasicEthernet,
+    kNmtMsNotActive,
+    kNmtMsPreOperational1,
+    kNmtMsPreOperational2,
+    kNmtMsReadyToOperate,
+    kNmtMsOperational,
+    kNmtMsBasicEthernet
+};
 
-static tOplkError doStateMsNotActive(tNmtEvent nmtEvent_p);
+/**
+\brief NMT state machine transitions
+
+The comments refer to the transitions of the POWERLINK specification.
+*/
+static const tNmtkTransition    nmtkTransitions_l[] =
+{
+    // NMT_GT1, NMT_GT8: NMT Command SwReset
+    { NMTK_STATE(kNmtkGsOff) | NMTK_STATE(kNmtkGsResetApplication) |
+      NMTK_STATE(kNmtkGsResetCommunication) | NMTK_STATE(kNmtkGsResetConfiguration) |
+      NMTK_STATES_COMMUNICATING,
+      kNmtEventSwReset,                 kNmtkGsInitialising,        NULL },
+
+    // NMT_GT3: NMT Command SwitchOff or critical error
+    { NMTK_STATE(kNmtkGsInitialising) | NMTK_STATE(kNmtkGsResetApplication) |
+      NMTK_STATE(kNmtkGsResetCommunication) | NMTK_STATE(kNmtkGsResetConfiguration) |
+      NMTK_STATES_COMMUNICATING,
+      kNmtEventSwitchOff,               kNmtkGsOff,                 NULL },
+    { NMTK_STATE(kNmtkGsInitialising) | NMTK_STATE(kNmtkGsResetApplication) |
+      NMTK_STATE(kNmtkGsResetCommunication) | NMTK_STATE(kNmtkGsResetConfiguration) |
+      NMTK_STATES_COMMUNICATING,
+      kNmtEventCriticalError,           kNmtkGsOff,                 NULL },
+
+    // NMT_GT4: NMT Command ResetNode
+    { NMTK_STATE(kNmtkGsResetCommunication) | NMTK_STATE(kNmtkGsResetConfiguration) |
+      NMTK_STATES_COMMUNICATING,
+      kNmtEventResetNode,               kNmtkGsResetApplication,    NULL },
+
+    // NMT_GT5: NMT Command ResetCommunication
+    { NMTK_STATE(kNmtkGsResetConfiguration) | NMTK_STATES_COMMUNICATING,
+      kNmtEventResetCom,                kNmtkGsResetCommunication,  NULL },
+
+    // NMT_GT6: internal communication error
+    { NMTK_STATES_COMMUNICATING,
+      kNmtEventInternComError,          kNmtkGsResetCommunication,  NULL },
+
+    // NMT_GT7: NMT Command ResetConfiguration
+    { NMTK_STATES_COMMUNICATING,
+      kNmtEventResetConfig,             kNmtkGsResetConfiguration,  resetConfiguration },
+
+    // NMT_GT10, NMT_GT11, NMT_GT12: leave reset states if the higher layer says so
+    { NMTK_STATE(kNmtkGsInitialising),
+      kNmtEventEnterResetApp,           kNmtkGsResetApplication,    NULL },
+    { NMTK_STATE(kNmtkGsResetApplication),
+      kNmtEventEnterResetCom,           kNmtkGsResetCommunication,  NULL },
+    { NMTK_STATE(kNmtkGsResetCommunication),
+      kNmtEventEnterResetConfig,        kNmtkGsResetConfiguration,  resetConfiguration },
+
+    // NMT_CT1: node should be CN
+    { NMTK_STATE(kNmtkGsResetConfiguration),
+      kNmtEventEnterCsNotActive,        kNmtkCsNotActive,           NULL },
+
+    // NMT_MT1: node should be MN
 #if defined(CONFIG_INCLUDE_NMT_MN)
-static tOplkError doStateMsPreOperational1(tNmtEvent nmtEvent_p);
-static tOplkError doStateMsPreOperational2(tNmtEvent nmtEvent_p);
-static tOplkError doStateMsReadyToOperate(tNmtEvent nmtEvent_p);
-static tOplkError doStateMsOperational(tNmtEvent nmtEvent_p);
-static tOplkError doStateMsBasicEthernet(tNmtEvent nmtEvent_p);
+    { NMTK_STATE(kNmtkGsResetConfiguration),
+      kNmtEventEnterMsNotActive,        kNmtkMsNotActive,           NULL },
+#else
+    // no MN functionality
+    // TODO: -create error E_NMT_BA1_NO_MN_SUPPORT
+    { NMTK_STATE(kNmtkGsResetConfiguration),
+      kNmtEventEnterMsNotActive,        kNmtkGsResetConfiguration,  freeze },
 #endif
 
-static tOplkError doStateCsNotActive(tNmtEvent nmtEvent_p);
-static tOplkError doStateCsBasicEthernet(tNmtEvent nmtEvent_p);
-static tOplkError doStateCsPreOperational1(tNmtEvent nmtEvent_p);
-static tOplkError doStateCsPreOperational2(tNmtEvent nmtEvent_p);
-static tOplkError doStateCsReadyToOperate(tNmtEvent nmtEvent_p);
-static tOplkError doStateCsOperational(tNmtEvent nmtEvent_p);
-static tOplkError doStateCsStopped(tNmtEvent nmtEvent_p);
+    // NMT_CT2: SoC or SoA received
+    { NMTK_STATE(kNmtkCsNotActive),
+      kNmtEventDllCeSoc,                kNmtkCsPreOperational1,     NULL },
+    { NMTK_STATE(kNmtkCsNotActive),
+      kNmtEventDllCeSoa,                kNmtkCsPreOperational1,     NULL },
+
+    // NMT_CT3: timeout for SoA and SoC
+    { NMTK_STATE(kNmtkCsNotActive),
+      kNmtEventTimerBasicEthernet,      kNmtkCsBasicEthernet,       NULL },
+
+    // NMT_CT4: SoC received
+    { NMTK_STATE(kNmtkCsPreOperational1),
+      kNmtEventDllCeSoc,                kNmtkCsPreOperational2,     NULL },
+
+    // NMT_CT5, NMT_CT6: application ready and NMT Command EnableReadyToOperate
+    { NMTK_STATE(kNmtkCsPreOperational2),
+      kNmtEventEnterReadyToOperate,     kNmtkCsReadyToOperate,      appReadyToOperate },
+    { NMTK_STATE(kNmtkCsPreOperational2),
+      kNmtEventEnableReadyToOperate,    kNmtkCsReadyToOperate,      enableReadyToOperate },
+
+    // NMT_CT7: NMT Command StartNode
+    { NMTK_STATE(kNmtkCsReadyToOperate),
+      kNmtEventStartNode,               kNmtkCsOperational,         NULL },
+
+    // NMT_CT8: NMT Command StopNode
+    { NMTK_STATE(kNmtkCsPreOperational2),
+      kNmtEventStopNode,                kNmtkCsStopped,             resetReadyToOperate },
+    { NMTK_STATE(kNmtkCsReadyToOperate) | NMTK_STATE(kNmtkCsOperational),
+      kNmtEventStopNode,                kNmtkCsStopped,             NULL },
+
+    // NMT_CT9, NMT_CT10: NMT Command EnterPreOperational2
+    { NMTK_STATE(kNmtkCsOperational) | NMTK_STATE(kNmtkCsStopped),
+      kNmtEventEnterPreOperational2,    kNmtkCsPreOperational2,     NULL },
+
+    // NMT_CT11: error during cycle
+    { NMTK_STATE(kNmtkCsPreOperational2),
+      kNmtEventNmtCycleError,           kNmtkCsPreOperational1,     resetReadyToOperate },
+    { NMTK_STATE(kNmtkCsReadyToOperate) | NMTK_STATE(kNmtkCsOperational) |
+      NMTK_STATE(kNmtkCsStopped),
+      kNmtEventNmtCycleError,           kNmtkCsPreOperational1,     NULL },
+
+    // NMT_CT12: POWERLINK frame on the network -> stop any communication
+    { NMTK_STATE(kNmtkCsBasicEthernet),
+      kNmtEventDllCeSoc,                kNmtkCsPreOperational1,     NULL },
+    { NMTK_STATE(kNmtkCsBasicEthernet),
+      kNmtEventDllCePreq,               kNmtkCsPreOperational1,     NULL },
+    { NMTK_STATE(kNmtkCsBasicEthernet),
+      kNmtEventDllCePres,               kNmtkCsPreOperational1,     NULL },
+    { NMTK_STATE(kNmtkCsBasicEthernet),
+      kNmtEventDllCeSoa,                kNmtkCsPreOperational1,     NULL },
 
-//------------------------------------------------------------------------------
-// local vars
-//------------------------------------------------------------------------------
-tNmtkStateTable             nmtkStates_g[] =
-{
-    { kNmtGsOff,                 doStateGsOff },
-    { kNmtGsInitialising,        doStateGsInitialising },
-    { kNmtGsResetApplication,    doStateGsResetApplication },
-    { kNmtGsResetCommunication,  doStateGsResetCommunication },
-    { kNmtGsResetConfiguration,  doStateGsResetConfiguration },
-    { kNmtCsNotActive,           doStateCsNotActive },
-    { kNmtCsPreOperational1,     doStateCsPreOperational1 },
-    { kNmtCsStopped,             doStateCsStopped },
-    { kNmtCsPreOperational2,     doStateCsPreOperational2 },
-    { kNmtCsReadyToOperate,      doStateCsReadyToOperate },
-    { kNmtCsOperational,         doStateCsOperational },
-    { kNmtCsBasicEthernet,       doStateCsBasicEthernet },
-    { kNmtMsNotActive,           doStateMsNotActive },
 #if defined(CONFIG_INCLUDE_NMT_MN)
-    { kNmtMsPreOperational1,     doStateMsPreOperational1 },
-    { kNmtMsPreOperational2,     doStateMsPreOperational2 },
-    { kNmtMsReadyToOperate,      doStateMsReadyToOperate },
-    { kNmtMsOperational,         doStateMsOperational },
-    { kNmtMsBasicEthernet,       doStateMsBasicEthernet }
+    // POWERLINK frames received in MS_NOT_ACTIVE: other MN in network
+    // $$$ d.k.: generate error history entry
+    { NMTK_STATE(kNmtkMsNotActive),
+      kNmtEventDllCeSoc,                kNmtkMsNotActive,           freeze },
+    { NMTK_STATE(kNmtkMsNotActive),
+      kNmtEventDllCeSoa,                kNmtkMsNotActive,           freeze },
+
+    // POWERLINK frames received in an active MN state: other MN in network
+    // $$$ d.k.: generate error history entry
+    { NMTK_STATES_MS_ACTIVE,
+      kNmtEventDllCeSoc,                kNmtkGsResetCommunication,  NULL },
+    { NMTK_STATES_MS_ACTIVE,
+      kNmtEventDllCeSoa,                kNmtkGsResetCommunication,  NULL },
+
+    // NMT_MT2: timeout in MS_NOT_ACTIVE
+    { NMTK_STATE(kNmtkMsNotActive),
+      kNmtEventTimerMsPreOp1,           kNmtkMsPreOperational1,     enterMsPreOperational1 },
+
+    // NMT_MT7: timeout in MS_NOT_ACTIVE
+    { NMTK_STATE(kNmtkMsNotActive),
+      kNmtEventTimerBasicEthernet,      kNmtkMsBasicEthernet,       leaveMsNotActive },
+
+    // NMT_MT3: all mandatory CNs identified and residence time for PreOp1 elapsed
+    { NMTK_STATE(kNmtkMsPreOperational1),
+      kNmtEventAllMandatoryCNIdent,     kNmtkMsPreOperational2,     allMandatoryCnIdent },
+    { NMTK_STATE(kNmtkMsPreOperational1),
+      kNmtEventTimerMsPreOp2,           kNmtkMsPreOperational2,     timerMsPreOperational2 },
+
+    // NMT_MT4: application ready to operate
+    { NMTK_STATE(kNmtkMsPreOperational2),
+      kNmtEventEnterReadyToOperate,     kNmtkMsReadyToOperate,      NULL },
+
+    // NMT_MT5: enter operational
+    { NMTK_STATE(kNmtkMsReadyToOperate),
+      kNmtEventEnterMsOperational,      kNmtkMsOperational,         NULL },
+
+    // NMT_MT6: error during cycle
+    { NMTK_STATE(kNmtkMsPreOperational2) | NMTK_STATE(kNmtkMsReadyToOperate) |
+      NMTK_STATE(kNmtkMsOperational),
+      kNmtEventNmtCycleError,           kNmtkMsPreOperational1,     NULL },
 #endif
 };
 
@@ -201,6 +418,8 @@ The function initializes an instance of the NMT kernel module
 //------------------------------------------------------------------------------
 tOplkError nmtk_init(void)
 {
+    OPLK_MEMSET(&nmtkInstance_g, 0, sizeof(nmtkInstance_g));
+
     // initialize intern vaiables
     nmtkInstance_g.stateIndex = kNmtkGsOff;
     nmtkInstance_g.fEnableReadyToOperate = FALSE;
@@ -209,7 +428,7 @@ tOplkError nmtk_init(void)
     nmtkInstance_g.fAllMandatoryCNIdent = FALSE;
     nmtkInstance_g.fFrozen = FALSE;
 
-    return kErrorOk;
+    return buildLookupTable();
 }
 
 //------------------------------------------------------------------------------
@@ -246,9 +465,15 @@ tOplkError nmtk_process(tEvent* pEvent_p)
 {
     tOplkError              ret;
     tNmtkStateIndexes       oldState;
+    tNmtkStateIndexes       newState;
     tNmtEvent               nmtEvent;
     tEvent                  event;
     tEventNmtStateChange    nmtStateChange;
+    const tNmtkTransition*  pTransition;
+    UINT                    transition;
+#if (CONFIG_NMTK_STATISTICS != FALSE)
+    ULONGLONG               startTime;
+#endif
 
     ret = kErrorOk;
 
@@ -266,24 +491,46 @@ tOplkError nmtk_process(tEvent* pEvent_p)
             return kErrorNmtInvalidEvent;
     }
 
-    // save NMT-State
-    // needed for later comparison to inform higher layer about state change
+    if ((UINT)nmtEvent >= NMTK_EVENT_COUNT)
+        return kErrorOk;
+
+    // look up transition of the current state
     oldState = nmtkInstance_g.stateIndex;
+    transition = nmtkInstance_g.aLookup[oldState][nmtEvent];
+    if (transition == 0)
+        return kErrorOk;
+
+    transition--;
+#if (CONFIG_NMTK_STATISTICS != FALSE)
+    startTime = target_getCurrentTimestamp();
+#endif
 
     // process NMT-State-Maschine
-    ret = nmtkStates_g[nmtkInstance_g.stateIndex].pfnState(nmtEvent);
+    pTransition = nmtkInstance_g.apTransition[transition];
+    if (pTransition->pfnTransition != NULL)
+        newState = pTransition->pfnTransition(pTransition->newStateIndex);
+    else
+        newState = pTransition->newStateIndex;
+
+    nmtkInstance_g.stateIndex = newState;
 
     // inform higher layer about State-Change if needed
-    if (oldState != nmtkInstance_g.stateIndex)
+    if (oldState != newState)
     {
-        EPL_NMTK_DBG_POST_TRACE_VALUE(nmtEvent, nmtkStates_g[oldState].nmtState,
-                                      nmtkStates_g[nmtkInstance_g.stateIndex].nmtState);
+        EPL_NMTK_DBG_POST_TRACE_VALUE(nmtEvent, nmtkStates_l[oldState], nmtkStates_l[newState]);
         DEBUG_LVL_NMTK_TRACE("EplNmtkProcess(NMT-event = 0x%04X): New NMT-State = 0x%03X\n",
-                              nmtEvent, nmtkStates_g[nmtkInstance_g.stateIndex].nmtState);
+                              nmtEvent, nmtkStates_l[newState]);
 
-        nmtStateChange.newNmtState = nmtkStates_g[nmtkInstance_g.stateIndex].nmtState;
-        nmtStateChange.oldNmtState = nmtkStates_g[oldState].nmtState;
+        nmtStateChange.newNmtState = nmtkStates_l[newState];
+        nmtStateChange.oldNmtState = nmtkStates_l[oldState];
         nmtStateChange.nmtEvent = nmtEvent;
+
+#if (TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__) && (CONFIG_MEMPOOL != FALSE)
+        // heap allocations are not allowed in operational state
+        mempool_setOperational((nmtStateChange.newNmtState == kNmtCsOperational) ||
+                               (nmtStateChange.newNmtState == kNmtMsOperational));
+#endif
+
         event.eventType = kEventTypeNmtStateChange;
         OPLK_MEMSET(&event.netTime, 0x00, sizeof(event.netTime));
         event.pEventArg = &nmtStateChange;
@@ -300,1209 +547,388 @@ tOplkError nmtk_process(tEvent* pEvent_p)
         ret = eventk_postEvent(&event);
     }
 
+#if (CONFIG_NMTK_STATISTICS != FALSE)
+    updateStatistics(transition, startTime, (oldState != newState));
+#endif
+
     return ret;
 }
 
-
-//=========================================================================//
-//                                                                         //
-//          P R I V A T E   D E F I N I T I O N S                          //
-//                                                                         //
-//=========================================================================//
-
+#if (CONFIG_NMTK_STATISTICS != FALSE)
 //------------------------------------------------------------------------------
 /**
-\brief  Process State GS_OFF
+\brief  Get NMT state machine statistics
 
-The function processes the NMT state GS_OFF.
+The function copies the transition statistics of the NMT state machine. It
+can be called from any thread.
 
-\param  nmtEvent_p      NMT event to be processed.
+\param  pStatistics_p   Pointer to store the statistics.
 
 \return The function returns a tOplkError error code.
-*/
-//------------------------------------------------------------------------------
-static tOplkError doStateGsOff(tNmtEvent nmtEvent_p)
-{
-    if (nmtEvent_p == kNmtEventSwReset)
-    {   // NMT_GT8, NMT_GT1 -> new state kNmtGsInitialising
-        nmtkInstance_g.stateIndex = kNmtkGsInitialising;
-    }
-    return kErrorOk;
-}
-
-//------------------------------------------------------------------------------
-/**
-\brief  Process State GS_INITIALISING
-
-The function processes the NMT state GS_INITIALISING.
-In this state the first init of the hardware will be done.
 
-\param  nmtEvent_p      NMT event to be processed.
-
-\return The function returns a tOplkError error code.
+\ingroup module_nmtk
 */
 //------------------------------------------------------------------------------
-static tOplkError doStateGsInitialising(tNmtEvent nmtEvent_p)
+tOplkError nmtk_getStatistics(tNmtkStatistics* pStatistics_p)
 {
-    switch(nmtEvent_p)
-    {
-        // 2006/07/31 d.k.: react also on NMT reset commands in ResetApp state
-        // NMT Command SwitchOff
-        case kNmtEventCriticalError:
-        case kNmtEventSwitchOff:
-            // NMT_GT3
-            nmtkInstance_g.stateIndex = kNmtkGsOff;
-            break;
+    UINT32      sequence;
 
-        // new state kNmtGsResetApplication
-        case kNmtEventEnterResetApp:
-            // NMT_GT10
-            nmtkInstance_g.stateIndex = kNmtkGsResetApplication;
-            break;
+    if (pStatistics_p == NULL)
+        return kErrorNmtInvalidParam;
 
-        default:
-            break;
-    }
-    return kErrorOk;
-}
-
-//------------------------------------------------------------------------------
-/**
-\brief  Process State GS_RESET_APPLICATION
-
-The function processes the NMT state GS_RESET_APPLICATION.
-In this state the initialization of the manufacturer-specific profile area
-and the standardised device profile area is done.
-
-\param  nmtEvent_p      NMT event to be processed.
-
-\return The function returns a tOplkError error code.
-*/
-//------------------------------------------------------------------------------
-static tOplkError doStateGsResetApplication(tNmtEvent nmtEvent_p)
-{
-    switch (nmtEvent_p)
+    do
     {
-        // 2006/07/31 d.k.: react also on NMT reset commands in ResetApp state
-        // NMT Command SwitchOff
-        case kNmtEventCriticalError:
-        case kNmtEventSwitchOff:
-            // NMT_GT3
-            nmtkInstance_g.stateIndex = kNmtkGsOff;
-            break;
+        // wait until no update is in progress
+        while (((sequence = nmtkInstance_g.statSequence) & 1) != 0)
+            ;
+        OPLK_MEMBAR();
 
-        // NMT Command SwReset
-        case kNmtEventSwReset:
-            // NMT_GT8
-            nmtkInstance_g.stateIndex = kNmtkGsInitialising;
-            break;
+        OPLK_MEMCPY(pStatistics_p, &nmtkInstance_g.statistics, sizeof(tNmtkStatistics));
 
-        // leave this state only if higher layer
-        // say so
-        case kNmtEventEnterResetCom:
-            // NMT_GT11
-            // new state kNmtGsResetCommunication
-            nmtkInstance_g.stateIndex = kNmtkGsResetCommunication;
-            break;
+        OPLK_MEMBAR();
+    } while (nmtkInstance_g.statSequence != sequence);
 
-        default:
-            break;
-    }
     return kErrorOk;
 }
 
 //------------------------------------------------------------------------------
 /**
-\brief  Process State GS_RESET_COMMUNICATION
+\brief  Reset NMT state machine statistics
 
-The function processes the NMT state GS_RESET_COMMUNICATION.
-In this state the initialization of the communication profile area is done.
+The function resets the counters and latencies of all transitions.
 
-\param  nmtEvent_p      NMT event to be processed.
+\note The statistics are protected by a sequence counter which only supports
+      a single writer. The function must therefore be called in the context
+      of the kernel event handler which processes the NMT events (e.g. from
+      an event handler of the kernel layer), as it would otherwise race with
+      the update of the statistics in nmtk_process().
 
-\return The function returns a tOplkError error code.
+\ingroup module_nmtk
 */
 //------------------------------------------------------------------------------
-static tOplkError doStateGsResetCommunication(tNmtEvent nmtEvent_p)
+void nmtk_resetStatistics(void)
 {
-    switch (nmtEvent_p)
-    {
-        // 2006/07/31 d.k.: react also on NMT reset commands in ResetComm state
-        // NMT Command SwitchOff
-        case kNmtEventCriticalError:
-        case kNmtEventSwitchOff:
-            // NMT_GT3
-            nmtkInstance_g.stateIndex = kNmtkGsOff;
-            break;
-
-        // NMT Command SwReset
-        case kNmtEventSwReset:
-            // NMT_GT8
-            nmtkInstance_g.stateIndex = kNmtkGsInitialising;
-            break;
-
-        // NMT Command ResetNode
-        case kNmtEventResetNode:
-            // NMT_GT4
-            nmtkInstance_g.stateIndex = kNmtkGsResetApplication;
-            break;
+    UINT        i;
+    UINT32      sequence = nmtkInstance_g.statSequence;
 
-        // leave this state only if higher layer
-        // say so
-        case kNmtEventEnterResetConfig:
-            // NMT_GT12 -> new state kNmtGsResetConfiguration
-            nmtkInstance_g.stateIndex = kNmtkGsResetConfiguration;
-            break;
-
-        default:
-            break;
-    }
-    return kErrorOk;
-}
+    nmtkInstance_g.statSequence = sequence + 1;
+    OPLK_MEMBAR();
 
-//------------------------------------------------------------------------------
-/**
-\brief  Process State GS_RESET_CONFIGURATION
-
-The function processes the NMT state GS_RESET_CONFIGURATION.
-In this state we build the configuration with information from the OD.
-
-\param  nmtEvent_p      NMT event to be processed.
-
-\return The function returns a tOplkError error code.
-*/
-//------------------------------------------------------------------------------
-static tOplkError doStateGsResetConfiguration(tNmtEvent nmtEvent_p)
-{
-    // reset flags
-    nmtkInstance_g.fEnableReadyToOperate = FALSE;
-    nmtkInstance_g.fAppReadyToOperate = FALSE;
-    nmtkInstance_g.fFrozen = FALSE;
-
-    // check events
-    switch (nmtEvent_p)
+    nmtkInstance_g.statistics.eventCount = 0;
+    nmtkInstance_g.statistics.stateChangeCount = 0;
+    for (i = 0; i < nmtkInstance_g.statistics.transitionCount; i++)
     {
-        // 2006/07/31 d.k.: react also on NMT reset commands in ResetConf state
-        // NMT Command SwitchOff
-        case kNmtEventCriticalError:
-        case kNmtEventSwitchOff:
-            // NMT_GT3
-            nmtkInstance_g.stateIndex = kNmtkGsOff;
-            break;
-
-        // NMT Command SwReset
-        case kNmtEventSwReset:
-            // NMT_GT8
-            nmtkInstance_g.stateIndex = kNmtkGsInitialising;
-            break;
-
-        // NMT Command ResetNode
-        case kNmtEventResetNode:
-            // NMT_GT4
-            nmtkInstance_g.stateIndex = kNmtkGsResetApplication;
-            break;
-
-        // NMT Command ResetCommunication
-        case kNmtEventResetCom:
-            // NMT_GT5
-            nmtkInstance_g.stateIndex = kNmtkGsResetCommunication;
-            break;
-
-        // leave this state only if higher layer says so
-        case kNmtEventEnterCsNotActive:
-            // Node should be CN (NMT_CT1)
-            nmtkInstance_g.stateIndex = kNmtkCsNotActive;
-            break;
-
-        case kNmtEventEnterMsNotActive:
-            // Node should be MN (NMT_MT1)
-#if !defined(CONFIG_INCLUDE_NMT_MN)
-                // no MN functionality
-                // TODO: -create error E_NMT_BA1_NO_MN_SUPPORT
-                nmtkInstance_g.fFrozen = TRUE;
-#else
-                nmtkInstance_g.stateIndex = kNmtkMsNotActive;
-#endif
-            break;
-
-        default:
-            break;
+        nmtkInstance_g.statistics.aTransition[i].count = 0;
+        nmtkInstance_g.statistics.aTransition[i].minLatency = 0;
+        nmtkInstance_g.statistics.aTransition[i].maxLatency = 0;
+        nmtkInstance_g.statistics.aTransition[i].totalLatency = 0;
     }
-    return kErrorOk;
-}
-
-//------------------------------------------------------------------------------
-/**
-\brief  Process State CS_NOT_ACTIVE
-
-The function processes the NMT state CS_NOT_ACTIVE.
-In this state the node listens for POWERLINK frames and checks timeout.
-
-\param  nmtEvent_p      NMT event to be processed.
-
-\return The function returns a tOplkError error code.
-*/
-//------------------------------------------------------------------------------
-static tOplkError doStateCsNotActive(tNmtEvent nmtEvent_p)
-{
-    switch(nmtEvent_p)
-    {
-        // 2006/07/31 d.k.: react also on NMT reset commands in NotActive state
-        // NMT Command SwitchOff
-        case kNmtEventCriticalError:
-        case kNmtEventSwitchOff:
-            // NMT_GT3
-            nmtkInstance_g.stateIndex = kNmtkGsOff;
-            break;
-
-        // NMT Command SwReset
-        case kNmtEventSwReset:
-            // NMT_GT8
-            nmtkInstance_g.stateIndex = kNmtkGsInitialising;
-            break;
 
-        // NMT Command ResetNode
-        case kNmtEventResetNode:
-            // NMT_GT4
-            nmtkInstance_g.stateIndex = kNmtkGsResetApplication;
-            break;
-
-        // NMT Command ResetCommunication or internal Communication error
-        case kNmtEventResetCom:          // NMT_GT5
-        case kNmtEventInternComError:    // NMT_GT6
-            nmtkInstance_g.stateIndex = kNmtkGsResetCommunication;
-            break;
-
-        // NMT Command Reset Configuration
-        case kNmtEventResetConfig:
-            // NMT_GT7
-            nmtkInstance_g.stateIndex = kNmtkGsResetConfiguration;
-            break;
-
-        // see if SoA or SoC received
-        case kNmtEventDllCeSoc:
-        case kNmtEventDllCeSoa:
-            // NMT_CT2 -> new state PRE_OPERATIONAL1
-            nmtkInstance_g.stateIndex = kNmtkCsPreOperational1;
-            break;
-
-        // timeout for SoA and Soc
-        case kNmtEventTimerBasicEthernet:
-            // NMT_CT3 -> new state BASIC_ETHERNET
-            nmtkInstance_g.stateIndex = kNmtkCsBasicEthernet;
-            break;
-
-        default:
-            break;
-    }
-    return kErrorOk;
+    OPLK_MEMBAR();
+    nmtkInstance_g.statSequence = sequence + 2;
 }
+#endif
 
-//------------------------------------------------------------------------------
-/**
-\brief  Process State CS_PRE_OPERATIONAL1
-
-The function processes the NMT state CS_PRE_OPERATIONAL1.
-In this state the node processes only async frames.
-
-\param  nmtEvent_p      NMT event to be processed.
-
-\return The function returns a tOplkError error code.
-*/
-//------------------------------------------------------------------------------
-static tOplkError doStateCsPreOperational1(tNmtEvent nmtEvent_p)
-{
-    switch (nmtEvent_p)
-    {
-        // NMT Command SwitchOff
-        case kNmtEventCriticalError:
-        case kNmtEventSwitchOff:
-            // NMT_GT3
-            nmtkInstance_g.stateIndex = kNmtkGsOff;
-            break;
-
-        // NMT Command SwReset
-        case kNmtEventSwReset:
-            // NMT_GT8
-            nmtkInstance_g.stateIndex = kNmtkGsInitialising;
-            break;
-
-        // NMT Command ResetNode
-        case kNmtEventResetNode:
-            // NMT_GT4
-            nmtkInstance_g.stateIndex = kNmtkGsResetApplication;
-            break;
-
-        // NMT Command ResetCommunication
-        // or internal Communication error
-        case kNmtEventResetCom:          // NMT_GT5
-        case kNmtEventInternComError:    // NMT_GT6
-            nmtkInstance_g.stateIndex = kNmtkGsResetCommunication;
-            break;
-
-        // NMT Command Reset Configuration
-        case kNmtEventResetConfig:
-            // NMT_GT7
-            nmtkInstance_g.stateIndex = kNmtkGsResetConfiguration;
-            break;
-
-        // check if SoC received
-        case kNmtEventDllCeSoc:
-            // NMT_CT4
-            nmtkInstance_g.stateIndex = kNmtkCsPreOperational2;
-            break;
-
-        default:
-            break;
-    }
-    return kErrorOk;
-}
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
 
 //------------------------------------------------------------------------------
 /**
-\brief  Process State CS_PRE_OPERATIONAL2
-
-The function processes the NMT state CS_PRE_OPERATIONAL2.
-In this state the node processes isochronous and asynchronous frames.
+\brief  Build transition lookup table
 
-\param  nmtEvent_p      NMT event to be processed.
+The function expands the transition table into the (state, event) lookup
+table. Each combination of start state and event gets its own entry, so that
+it can be counted separately.
 
 \return The function returns a tOplkError error code.
 */
 //------------------------------------------------------------------------------
-static tOplkError doStateCsPreOperational2(tNmtEvent nmtEvent_p)
+static tOplkError buildLookupTable(void)
 {
-    switch (nmtEvent_p)
-    {
-        // NMT Command SwitchOff
-        case kNmtEventCriticalError:
-        case kNmtEventSwitchOff:
-            // NMT_GT3
-            nmtkInstance_g.stateIndex = kNmtkGsOff;
-            break;
-
-        // NMT Command SwReset
-        case kNmtEventSwReset:
-            // NMT_GT8
-            nmtkInstance_g.stateIndex = kNmtkGsInitialising;
-            break;
-
-        // NMT Command ResetNode
-        case kNmtEventResetNode:
-            // NMT_GT4
-            nmtkInstance_g.stateIndex = kNmtkGsResetApplication;
-            break;
+    const tNmtkTransition*  pTransition;
+    UINT                    stateIndex;
+    UINT                    i;
 
-        // NMT Command ResetCommunication
-        // or internal Communication error
-        case kNmtEventResetCom:          // NMT_GT5
-        case kNmtEventInternComError:    // NMT_GT6
-            nmtkInstance_g.stateIndex = kNmtkGsResetCommunication;
-            break;
-
-        // NMT Command Reset Configuration
-        case kNmtEventResetConfig:
-            // NMT_GT7
-            nmtkInstance_g.stateIndex = kNmtkGsResetConfiguration;
-            break;
-
-        // NMT Command StopNode
-        case kNmtEventStopNode:
-            // NMT_CT8 - reset flags
-            nmtkInstance_g.fEnableReadyToOperate = FALSE;
-            nmtkInstance_g.fAppReadyToOperate = FALSE;
-            nmtkInstance_g.stateIndex = kNmtkCsStopped;
-            break;
+    for (i = 0; i < tabentries(nmtkTransitions_l); i++)
+    {
+        pTransition = &nmtkTransitions_l[i];
 
-        // error occurred
-        case kNmtEventNmtCycleError:
-            // NMT_CT11 - reset flags
-            nmtkInstance_g.fEnableReadyToOperate = FALSE;
-            nmtkInstance_g.fAppReadyToOperate = FALSE;
-            nmtkInstance_g.stateIndex = kNmtkCsPreOperational1;
-            break;
+        for (stateIndex = 0; stateIndex < NMTK_STATE_COUNT; stateIndex++)
+        {
+            if ((pTransition->stateMask & NMTK_STATE(stateIndex)) == 0)
+                continue;
 
-        // check if application is ready to operate
-        case kNmtEventEnterReadyToOperate:
-            // check if command NMTEnableReadyToOperate from MN was received
-            if (nmtkInstance_g.fEnableReadyToOperate == TRUE)
-            {   // reset flags
-                nmtkInstance_g.fEnableReadyToOperate = FALSE;
-                nmtkInstance_g.fAppReadyToOperate = FALSE;
-                // change state (NMT_CT6)
-                nmtkInstance_g.stateIndex = kNmtkCsReadyToOperate;
-            }
-            else
-            {   // set Flag (NMT_CT5)
-                nmtkInstance_g.fAppReadyToOperate = TRUE;
+            if (nmtkInstance_g.aLookup[stateIndex][pTransition->nmtEvent] != 0)
+            {
+                DEBUG_LVL_ERROR_TRACE("%s() Duplicate transition for state 0x%03X event 0x%02X\n",
+                                      __func__, nmtkStates_l[stateIndex], pTransition->nmtEvent);
+                return kErrorNmtInvalidState;
             }
-            break;
 
-        // NMT Commando EnableReadyToOperate
-        case kNmtEventEnableReadyToOperate:
-            // check if application is ready
-            if (nmtkInstance_g.fAppReadyToOperate == TRUE)
-            {   // reset flags
-                nmtkInstance_g.fEnableReadyToOperate = FALSE;
-                nmtkInstance_g.fAppReadyToOperate = FALSE;
-                // change state (NMT_CT6)
-                nmtkInstance_g.stateIndex = kNmtkCsReadyToOperate;
-            }
-            else
-            {   // set Flag (NMT_CT5)
-                nmtkInstance_g.fEnableReadyToOperate = TRUE;
+            if (nmtkInstance_g.transitionCount >= NMTK_MAX_TRANSITIONS)
+            {
+                DEBUG_LVL_ERROR_TRACE("%s() Too many transitions, increase NMTK_MAX_TRANSITIONS\n",
+                                      __func__);
+                return kErrorNmtInvalidState;
             }
-            break;
 
-        default:
-            break;
+            nmtkInstance_g.apTransition[nmtkInstance_g.transitionCount] = pTransition;
+#if (CONFIG_NMTK_STATISTICS != FALSE)
+            nmtkInstance_g.statistics.aTransition[nmtkInstance_g.transitionCount].nmtState =
+                                                                        nmtkStates_l[stateIndex];
+            nmtkInstance_g.statistics.aTransition[nmtkInstance_g.transitionCount].nmtEvent =
+                                                                        pTransition->nmtEvent;
+#endif
+            nmtkInstance_g.transitionCount++;
+            nmtkInstance_g.aLookup[stateIndex][pTransition->nmtEvent] =
+                                                        (UINT8)nmtkInstance_g.transitionCount;
+        }
     }
+
+#if (CONFIG_NMTK_STATISTICS != FALSE)
+    nmtkInstance_g.statistics.transitionCount = nmtkInstance_g.transitionCount;
+#endif
+
     return kErrorOk;
 }
 
 //------------------------------------------------------------------------------
 /**
-\brief  Process State CS_READY_TO_OPERATE
+\brief  Reset ReadyToOperate flags
 
-The function processes the NMT state CS_READY_TO_OPERATE.
-In this state the node should be configured and application is ready.
+The transition function resets the ReadyToOperate flags of the CN when it
+leaves CS_PRE_OPERATIONAL2 (NMT_CT8, NMT_CT11).
 
-\param  nmtEvent_p      NMT event to be processed.
+\param  newStateIndex_p     State after the transition.
 
-\return The function returns a tOplkError error code.
+\return The function returns the state the state machine shall enter.
 */
 //------------------------------------------------------------------------------
-static tOplkError doStateCsReadyToOperate(tNmtEvent nmtEvent_p)
+static tNmtkStateIndexes resetReadyToOperate(tNmtkStateIndexes newStateIndex_p)
 {
-    switch (nmtEvent_p)
-    {
-        // NMT Command SwitchOff
-        case kNmtEventCriticalError:
-        case kNmtEventSwitchOff:
-            // NMT_GT3
-            nmtkInstance_g.stateIndex = kNmtkGsOff;
-            break;
-
-        // NMT Command SwReset
-        case kNmtEventSwReset:
-            // NMT_GT8
-            nmtkInstance_g.stateIndex = kNmtkGsInitialising;
-            break;
-
-        // NMT Command ResetNode
-        case kNmtEventResetNode:
-            // NMT_GT4
-            nmtkInstance_g.stateIndex = kNmtkGsResetApplication;
-            break;
-
-        // NMT Command ResetCommunication or internal Communication error
-        case kNmtEventResetCom:          // NMT_GT5
-        case kNmtEventInternComError:    // NMT_GT6
-            nmtkInstance_g.stateIndex = kNmtkGsResetCommunication;
-            break;
-
-        // NMT Command ResetConfiguration
-        case kNmtEventResetConfig:
-            // NMT_GT7
-            nmtkInstance_g.stateIndex = kNmtkGsResetConfiguration;
-            break;
-
-        // NMT Command StopNode
-        case kNmtEventStopNode:
-            // NMT_CT8
-            nmtkInstance_g.stateIndex = kNmtkCsStopped;
-            break;
-
-        // error occurred
-        case kNmtEventNmtCycleError:
-            // NMT_CT11
-            nmtkInstance_g.stateIndex = kNmtkCsPreOperational1;
-            break;
-
-        // NMT Command StartNode
-        case kNmtEventStartNode:
-            // NMT_CT7
-            nmtkInstance_g.stateIndex = kNmtkCsOperational;
-            break;
+    nmtkInstance_g.fEnableReadyToOperate = FALSE;
+    nmtkInstance_g.fAppReadyToOperate = FALSE;
 
-        default:
-            break;
-    }
-    return kErrorOk;
+    return newStateIndex_p;
 }
 
 //------------------------------------------------------------------------------
 /**
-\brief  Process State CS_OPERATIONAL
+\brief  Enter GS_RESET_CONFIGURATION
 
-The function processes the NMT state CS_OPERATIONAL.
-This is the normal working state of a CN.
+The transition function resets the flags of the state machine when entering
+GS_RESET_CONFIGURATION (NMT_GT7, NMT_GT12).
 
-\param  nmtEvent_p      NMT event to be processed.
+\param  newStateIndex_p     State after the transition.
 
-\return The function returns a tOplkError error code.
+\return The function returns the state the state machine shall enter.
 */
 //------------------------------------------------------------------------------
-static tOplkError doStateCsOperational(tNmtEvent nmtEvent_p)
+static tNmtkStateIndexes resetConfiguration(tNmtkStateIndexes newStateIndex_p)
 {
-    switch (nmtEvent_p)
-    {
-        // NMT Command SwitchOff
-        case kNmtEventCriticalError:
-        case kNmtEventSwitchOff:
-            // NMT_GT3
-            nmtkInstance_g.stateIndex = kNmtkGsOff;
-            break;
-
-        // NMT Command SwReset
-        case kNmtEventSwReset:
-            // NMT_GT8
-            nmtkInstance_g.stateIndex = kNmtkGsInitialising;
-            break;
-
-        // NMT Command ResetNode
-        case kNmtEventResetNode:
-            // NMT_GT4
-            nmtkInstance_g.stateIndex = kNmtkGsResetApplication;
-            break;
-
-        // NMT Command ResetCommunication or internal Communication error
-        case kNmtEventResetCom:          // NMT_GT5
-        case kNmtEventInternComError:    // NMT_GT6
-            nmtkInstance_g.stateIndex = kNmtkGsResetCommunication;
-            break;
-
-        // NMT Command ResetConfiguration
-        case kNmtEventResetConfig:
-            // NMT_GT7
-            nmtkInstance_g.stateIndex = kNmtkGsResetConfiguration;
-            break;
-
-        // NMT Command StopNode
-        case kNmtEventStopNode:
-            // NMT_CT8
-            nmtkInstance_g.stateIndex = kNmtkCsStopped;
-            break;
-
-        // NMT Command EnterPreOperational2
-        case kNmtEventEnterPreOperational2:
-            // NMT_CT9
-            nmtkInstance_g.stateIndex = kNmtkCsPreOperational2;
-            break;
-
-        // error occurred
-        case kNmtEventNmtCycleError:
-            // NMT_CT11
-            nmtkInstance_g.stateIndex = kNmtkCsPreOperational1;
-            break;
+    nmtkInstance_g.fEnableReadyToOperate = FALSE;
+    nmtkInstance_g.fAppReadyToOperate = FALSE;
+    nmtkInstance_g.fFrozen = FALSE;
 
-        default:
-            break;
-    }
-    return kErrorOk;
+    return newStateIndex_p;
 }
 
 //------------------------------------------------------------------------------
 /**
-\brief  Process State CS_NOT_ACTIVE
+\brief  Application is ready to operate
 
-The function processes the NMT state CS_NOT_ACTIVE.
-In this state the node is stopped by the MN it processes only asynchronous
-frames.
+The transition function processes the event of the application being ready
+to operate in CS_PRE_OPERATIONAL2. The CN changes to CS_READY_TO_OPERATE if the
+NMT command EnableReadyToOperate was already received (NMT_CT6). Otherwise the
+readiness of the application is stored (NMT_CT5).
 
-\param  nmtEvent_p      NMT event to be processed.
+\param  newStateIndex_p     State after the transition.
 
-\return The function returns a tOplkError error code.
+\return The function returns the state the state machine shall enter.
 */
 //------------------------------------------------------------------------------
-static tOplkError doStateCsStopped(tNmtEvent nmtEvent_p)
+static tNmtkStateIndexes appReadyToOperate(tNmtkStateIndexes newStateIndex_p)
 {
-    switch (nmtEvent_p)
-    {
-        // NMT Command SwitchOff
-        case kNmtEventCriticalError:
-        case kNmtEventSwitchOff:
-            // NMT_GT3
-            nmtkInstance_g.stateIndex = kNmtkGsOff;
-            break;
-
-        // NMT Command SwReset
-        case kNmtEventSwReset:
-            // NMT_GT8
-            nmtkInstance_g.stateIndex = kNmtkGsInitialising;
-            break;
-
-        // NMT Command ResetNode
-        case kNmtEventResetNode:
-            // NMT_GT4
-            nmtkInstance_g.stateIndex = kNmtkGsResetApplication;
-            break;
-
-        // NMT Command ResetCommunication or internal Communication error
-        case kNmtEventResetCom:          // NMT_GT5
-        case kNmtEventInternComError:    // NMT_GT6
-            nmtkInstance_g.stateIndex = kNmtkGsResetCommunication;
-            break;
-
-        // NMT Command ResetConfiguration
-        case kNmtEventResetConfig:
-        {   // NMT_GT7
-            nmtkInstance_g.stateIndex = kNmtkGsResetConfiguration;
-            break;
-        }
-
-        // NMT Command EnterPreOperational2
-        case kNmtEventEnterPreOperational2:
-            // NMT_CT10
-            nmtkInstance_g.stateIndex = kNmtkCsPreOperational2;
-            break;
-
-        // error occurred
-        case kNmtEventNmtCycleError:
-            // NMT_CT11
-            nmtkInstance_g.stateIndex = kNmtkCsPreOperational1;
-            break;
+    if (nmtkInstance_g.fEnableReadyToOperate == TRUE)
+        return resetReadyToOperate(newStateIndex_p);
 
-        default:
-            break;
-    }
-    return kErrorOk;
+    nmtkInstance_g.fAppReadyToOperate = TRUE;
+    return nmtkInstance_g.stateIndex;
 }
 
 //------------------------------------------------------------------------------
 /**
-\brief  Process State CS_BASIC_ETHERNET
+\brief  NMT command EnableReadyToOperate
 
-The function processes the NMT state CS_BASIC_ETHERNET.
-In this state there is no POWERLINK cycle and the node performs normal Ethernet
-communication.
+The transition function processes the NMT command EnableReadyToOperate in
+CS_PRE_OPERATIONAL2. The CN changes to CS_READY_TO_OPERATE if the application is
+already ready (NMT_CT6). Otherwise the reception of the command is stored
+(NMT_CT5).
 
-\param  nmtEvent_p      NMT event to be processed.
+\param  newStateIndex_p     State after the transition.
 
-\return The function returns a tOplkError error code.
+\return The function returns the state the state machine shall enter.
 */
 //------------------------------------------------------------------------------
-static tOplkError doStateCsBasicEthernet(tNmtEvent nmtEvent_p)
+static tNmtkStateIndexes enableReadyToOperate(tNmtkStateIndexes newStateIndex_p)
 {
-    switch (nmtEvent_p)
-    {
-        // NMT Command SwitchOff
-        case kNmtEventCriticalError:
-        case kNmtEventSwitchOff:
-            // NMT_GT3
-            nmtkInstance_g.stateIndex = kNmtkGsOff;
-            break;
-
-        // NMT Command SwReset
-        case kNmtEventSwReset:
-            // NMT_GT8
-            nmtkInstance_g.stateIndex = kNmtkGsInitialising;
-            break;
-
-        // NMT Command ResetNode
-        case kNmtEventResetNode:
-            // NMT_GT4
-            nmtkInstance_g.stateIndex = kNmtkGsResetApplication;
-            break;
-
-        // NMT Command ResetCommunication or internal Communication error
-        case kNmtEventResetCom:          // NMT_GT5
-        case kNmtEventInternComError:    // NMT_GT6
-            nmtkInstance_g.stateIndex = kNmtkGsResetCommunication;
-            break;
-
-        // NMT Command ResetConfiguration
-        case kNmtEventResetConfig:
-            // NMT_GT7
-            nmtkInstance_g.stateIndex = kNmtkGsResetConfiguration;
-            break;
-
-        // error occurred
-        // d.k.: how does this error occur? on CRC errors
-/*      case kNmtEventNmtCycleError:
-            nmtkInstance_g.stateIndex = kNmtkCsPreOperational1:
-            break;
-*/
-        case kNmtEventDllCeSoc:
-        case kNmtEventDllCePreq:
-        case kNmtEventDllCePres:
-        case kNmtEventDllCeSoa:
-            // NMT_CT12 - EPL frame on net -> stop any communication
-            nmtkInstance_g.stateIndex = kNmtkCsPreOperational1;
-            break;
+    if (nmtkInstance_g.fAppReadyToOperate == TRUE)
+        return resetReadyToOperate(newStateIndex_p);
 
-        default:
-            break;
-    }
-    return kErrorOk;
+    nmtkInstance_g.fEnableReadyToOperate = TRUE;
+    return nmtkInstance_g.stateIndex;
 }
 
 //------------------------------------------------------------------------------
 /**
-\brief  Process State MS_NOT_ACTIVE
+\brief  Freeze MN state machine
 
-The function processes the NMT state MS_NOT_ACTIVE.
-In this state the MN listens to the network. If there is no POWERLINK traffic,
-the node goes to the next state.
+The transition function freezes the MN state machine because another MN was
+detected on the network or the MN functionality is not available.
 
-\param  nmtEvent_p      NMT event to be processed.
+\param  newStateIndex_p     State after the transition.
 
-\return The function returns a tOplkError error code.
+\return The function returns the state the state machine shall enter.
 */
 //------------------------------------------------------------------------------
-static tOplkError doStateMsNotActive(tNmtEvent nmtEvent_p)
+static tNmtkStateIndexes freeze(tNmtkStateIndexes newStateIndex_p)
 {
-
-#if !defined(CONFIG_INCLUDE_NMT_MN)
-    UNUSED_PARAMETER(nmtEvent_p);
-
-    // no MN functionality
-    // TODO: -create error E_NMT_BA1_NO_MN_SUPPORT
     nmtkInstance_g.fFrozen = TRUE;
-#else
-    switch (nmtEvent_p)
-    {
-        // NMT Command SwitchOff
-        case kNmtEventCriticalError:
-        case kNmtEventSwitchOff:
-            // NMT_GT3
-            nmtkInstance_g.stateIndex = kNmtkGsOff;
-            break;
-
-        // NMT Command SwReset
-        case kNmtEventSwReset:
-            // NMT_GT8
-            nmtkInstance_g.stateIndex = kNmtkGsInitialising;
-            break;
-
-        // NMT Command ResetNode
-        case kNmtEventResetNode:
-            // NMT_GT4
-            nmtkInstance_g.stateIndex = kNmtkGsResetApplication;
-            break;
-
-        // NMT Command ResetCommunication or internal Communication error
-        case kNmtEventResetCom:          // NMT_GT5
-        case kNmtEventInternComError:    // NMT_GT6
-            nmtkInstance_g.stateIndex = kNmtkGsResetCommunication;
-            break;
-
-        // NMT Command ResetConfiguration
-        case kNmtEventResetConfig:
-            // NMT_GT7
-            nmtkInstance_g.stateIndex = kNmtkGsResetConfiguration;
-            break;
-
-        // POWERLINK frames received
-        case kNmtEventDllCeSoc:
-        case kNmtEventDllCeSoa:
-            // other MN in network
-            // $$$ d.k.: generate error history entry
-            nmtkInstance_g.fFrozen = TRUE;
-            break;
-
-        // timeout event
-        case kNmtEventTimerBasicEthernet:
-           // NMT_MT7
-            if (nmtkInstance_g.fFrozen == FALSE)
-            {   // new state BasicEthernet
-                nmtkInstance_g.stateIndex = kNmtkMsBasicEthernet;
-            }
-            break;
-
-        // timeout event
-        case kNmtEventTimerMsPreOp1:
-        {   // NMT_MT2
-            if (nmtkInstance_g.fFrozen == FALSE)
-            {   // new state PreOp1
-                nmtkInstance_g.stateIndex = kNmtkMsPreOperational1;
-                nmtkInstance_g.fTimerMsPreOp2 = FALSE;
-                nmtkInstance_g.fAllMandatoryCNIdent = FALSE;
-            }
-            break;
-        }
-
-        default:
-            break;
-
-    }
-#endif
-    return kErrorOk;
+    return newStateIndex_p;
 }
 
 #if defined(CONFIG_INCLUDE_NMT_MN)
-
 //------------------------------------------------------------------------------
 /**
-\brief  Process State MS_PRE_OPERATIONAL1
+\brief  Leave MS_NOT_ACTIVE
 
-The function processes the NMT state MS_PRE_OPERATIONAL1.
-In this state the MN processes the reduced POWERLINK cycle.
+The transition function leaves MS_NOT_ACTIVE unless the MN state machine is
+frozen.
 
-\param  nmtEvent_p      NMT event to be processed.
+\param  newStateIndex_p     State after the transition.
 
-\return The function returns a tOplkError error code.
+\return The function returns the state the state machine shall enter.
 */
 //------------------------------------------------------------------------------
-static tOplkError doStateMsPreOperational1(tNmtEvent nmtEvent_p)
+static tNmtkStateIndexes leaveMsNotActive(tNmtkStateIndexes newStateIndex_p)
 {
-    switch (nmtEvent_p)
-    {
-        // NMT Command SwitchOff
-        case kNmtEventCriticalError:
-        case kNmtEventSwitchOff:
-            // NMT_GT3
-            nmtkInstance_g.stateIndex = kNmtkGsOff;
-            break;
-
-        // NMT Command SwReset
-        case kNmtEventSwReset:
-            // NMT_GT8
-            nmtkInstance_g.stateIndex = kNmtkGsInitialising;
-            break;
-
-        // NMT Command ResetNode
-        case kNmtEventResetNode:
-            // NMT_GT4
-            nmtkInstance_g.stateIndex = kNmtkGsResetApplication;
-            break;
-
-        // NMT Command ResetCommunication or internal Communication error
-        case kNmtEventResetCom:          // NMT_GT5
-        case kNmtEventInternComError:    // NMT_GT6
-            nmtkInstance_g.stateIndex = kNmtkGsResetCommunication;
-            break;
-
-        // NMT Command ResetConfiguration
-        case kNmtEventResetConfig:
-            // NMT_GT7
-            nmtkInstance_g.stateIndex = kNmtkGsResetConfiguration;
-            break;
-
-        // EPL frames received
-        case kNmtEventDllCeSoc:
-        case kNmtEventDllCeSoa:
-            // other MN in network
-            // $$$ d.k.: generate error history entry
-            nmtkInstance_g.stateIndex = kNmtkGsResetCommunication;
-            break;
-
-        // error occurred
-        // d.k. MSPreOp1->CSPreOp1: nonsense -> keep state
-        /*
-        case kNmtEventNmtCycleError:
-            nmtkInstance_g.stateIndex = kNmtkCsPreOperational1;
-            break;
-        */
+    if (nmtkInstance_g.fFrozen != FALSE)
+        return nmtkInstance_g.stateIndex;
 
-        case kNmtEventAllMandatoryCNIdent:
-            // all mandatory CN identified
-            if (nmtkInstance_g.fTimerMsPreOp2 != FALSE)
-            {   // NMT_MT3
-                nmtkInstance_g.stateIndex = kNmtkMsPreOperational2;
-            }
-            else
-            {
-                nmtkInstance_g.fAllMandatoryCNIdent = TRUE;
-            }
-            break;
-
-        case kNmtEventTimerMsPreOp2:
-            // residence time for PreOp1 is elapsed
-            if (nmtkInstance_g.fAllMandatoryCNIdent != FALSE)
-            {   // NMT_MT3
-                nmtkInstance_g.stateIndex = kNmtkMsPreOperational2;
-            }
-            else
-            {
-                nmtkInstance_g.fTimerMsPreOp2 = TRUE;
-            }
-            break;
-
-        default:
-            break;
-
-    }
-    return kErrorOk;
+    return newStateIndex_p;
 }
 
 //------------------------------------------------------------------------------
 /**
-\brief  Process State MS_PRE_OPERATIONAL2
+\brief  Enter MS_PRE_OPERATIONAL1
 
-The function processes the NMT state MS_PRE_OPERATIONAL2.
-In this state the MN processes the full POWERLINK cycle.
+The transition function changes from MS_NOT_ACTIVE to MS_PRE_OPERATIONAL1
+unless the MN state machine is frozen (NMT_MT2).
 
-\param  nmtEvent_p      NMT event to be processed.
+\param  newStateIndex_p     State after the transition.
 
-\return The function returns a tOplkError error code.
+\return The function returns the state the state machine shall enter.
 */
 //------------------------------------------------------------------------------
-static tOplkError doStateMsPreOperational2(tNmtEvent nmtEvent_p)
+static tNmtkStateIndexes enterMsPreOperational1(tNmtkStateIndexes newStateIndex_p)
 {
-    switch (nmtEvent_p)
-    {
-        // NMT Command SwitchOff
-        case kNmtEventCriticalError:
-        case kNmtEventSwitchOff:
-            // NMT_GT3
-            nmtkInstance_g.stateIndex = kNmtkGsOff;
-            break;
-
-        // NMT Command SwReset
-        case kNmtEventSwReset:
-            // NMT_GT8
-            nmtkInstance_g.stateIndex = kNmtkGsInitialising;
-            break;
-
-        // NMT Command ResetNode
-        case kNmtEventResetNode:
-            // NMT_GT4
-            nmtkInstance_g.stateIndex = kNmtkGsResetApplication;
-            break;
-
-        // NMT Command ResetCommunication or internal Communication error
-        case kNmtEventResetCom:          // NMT_GT5
-        case kNmtEventInternComError:    // NMT_GT6
-            nmtkInstance_g.stateIndex = kNmtkGsResetCommunication;
-            break;
-
-        // NMT Command ResetConfiguration
-        case kNmtEventResetConfig:
-            // NMT_GT7
-            nmtkInstance_g.stateIndex = kNmtkGsResetConfiguration;
-            break;
-
-        // EPL frames received
-        case kNmtEventDllCeSoc:
-        case kNmtEventDllCeSoa:
-            // other MN in network
-            // $$$ d.k.: generate error history entry
-            nmtkInstance_g.stateIndex = kNmtkGsResetCommunication;
-            break;
-
-        // error occurred
-        case kNmtEventNmtCycleError:
-            // NMT_MT6
-            nmtkInstance_g.stateIndex = kNmtkMsPreOperational1;
-            break;
+    if (nmtkInstance_g.fFrozen != FALSE)
+        return nmtkInstance_g.stateIndex;
 
-        case kNmtEventEnterReadyToOperate:
-            // NMT_MT4
-            nmtkInstance_g.stateIndex = kNmtkMsReadyToOperate;
-            break;
-
-        default:
-            break;
-    }
-    return kErrorOk;
+    nmtkInstance_g.fTimerMsPreOp2 = FALSE;
+    nmtkInstance_g.fAllMandatoryCNIdent = FALSE;
+    return newStateIndex_p;
 }
 
 //------------------------------------------------------------------------------
 /**
-\brief  Process State MS_READY_TO_OPERATE
+\brief  All mandatory CNs identified
 
-The function processes the NMT state MS_READY_TO_OPERATE.
-In this state all mandatory CNs are ready to operate. The MN processes the full
-POWERLINK cycle.
+The transition function changes to MS_PRE_OPERATIONAL2 if the residence time
+for MS_PRE_OPERATIONAL1 has already elapsed (NMT_MT3). Otherwise the event is
+stored.
 
-\param  nmtEvent_p      NMT event to be processed.
+\param  newStateIndex_p     State after the transition.
 
-\return The function returns a tOplkError error code.
+\return The function returns the state the state machine shall enter.
 */
 //------------------------------------------------------------------------------
-static tOplkError doStateMsReadyToOperate(tNmtEvent nmtEvent_p)
+static tNmtkStateIndexes allMandatoryCnIdent(tNmtkStateIndexes newStateIndex_p)
 {
-    switch (nmtEvent_p)
-    {
-        // NMT Command SwitchOff
-        case kNmtEventCriticalError:
-        case kNmtEventSwitchOff:
-            // NMT_GT3
-            nmtkInstance_g.stateIndex = kNmtkGsOff;
-            break;
+    if (nmtkInstance_g.fTimerMsPreOp2 != FALSE)
+        return newStateIndex_p;
 
-        // NMT Command SwReset
-        case kNmtEventSwReset:
-            // NMT_GT8
-            nmtkInstance_g.stateIndex = kNmtkGsInitialising;
-            break;
-
-        // NMT Command ResetNode
-        case kNmtEventResetNode:
-            // NMT_GT4
-            nmtkInstance_g.stateIndex = kNmtkGsResetApplication;
-            break;
-
-        // NMT Command ResetCommunication or internal Communication error
-        case kNmtEventResetCom:          // NMT_GT5
-        case kNmtEventInternComError:    // NMT_GT6
-            nmtkInstance_g.stateIndex = kNmtkGsResetCommunication;
-            break;
-
-        // NMT Command ResetConfiguration
-        case kNmtEventResetConfig:
-            // NMT_GT7
-            nmtkInstance_g.stateIndex = kNmtkGsResetConfiguration;
-            break;
-
-        // EPL frames received
-        case kNmtEventDllCeSoc:
-        case kNmtEventDllCeSoa:
-            // other MN in network
-            // $$$ d.k.: generate error history entry
-            nmtkInstance_g.stateIndex = kNmtkGsResetCommunication;
-            break;
-
-        // error occurred
-        case kNmtEventNmtCycleError:
-            // NMT_MT6
-            nmtkInstance_g.stateIndex = kNmtkMsPreOperational1;
-            break;
-
-        case kNmtEventEnterMsOperational:
-            // NMT_MT5
-            nmtkInstance_g.stateIndex = kNmtkMsOperational;
-            break;
-
-        default:
-            break;
-    }
-    return kErrorOk;
+    nmtkInstance_g.fAllMandatoryCNIdent = TRUE;
+    return nmtkInstance_g.stateIndex;
 }
+
 //------------------------------------------------------------------------------
 /**
-\brief  Process State MS_OPERATIONAL
+\brief  Residence time for MS_PRE_OPERATIONAL1 elapsed
 
-The function processes the NMT state MS_OPERATIONAL.
-This is the normal working state of a MN.
+The transition function changes to MS_PRE_OPERATIONAL2 if all mandatory CNs
+have already been identified (NMT_MT3). Otherwise the event is stored.
 
-\param  nmtEvent_p      NMT event to be processed.
+\param  newStateIndex_p     State after the transition.
 
-\return The function returns a tOplkError error code.
+\return The function returns the state the state machine shall enter.
 */
 //------------------------------------------------------------------------------
-static tOplkError doStateMsOperational(tNmtEvent nmtEvent_p)
+static tNmtkStateIndexes timerMsPreOperational2(tNmtkStateIndexes newStateIndex_p)
 {
-    switch (nmtEvent_p)
-    {
-        // NMT Command SwitchOff
-        case kNmtEventCriticalError:
-        case kNmtEventSwitchOff:
-            // NMT_GT3
-            nmtkInstance_g.stateIndex = kNmtkGsOff;
-            break;
-
-        // NMT Command SwReset
-        case kNmtEventSwReset:
-            // NMT_GT8
-            nmtkInstance_g.stateIndex = kNmtkGsInitialising;
-            break;
-
-        // NMT Command ResetNode
-        case kNmtEventResetNode:
-            // NMT_GT4
-            nmtkInstance_g.stateIndex = kNmtkGsResetApplication;
-            break;
-
-        // NMT Command ResetCommunication or internal Communication error
-        case kNmtEventResetCom:          // NMT_GT5
-        case kNmtEventInternComError:    // NMT_GT6
-            nmtkInstance_g.stateIndex = kNmtkGsResetCommunication;
-            break;
-
-        // NMT Command ResetConfiguration
-        case kNmtEventResetConfig:
-            // NMT_GT7
-            nmtkInstance_g.stateIndex = kNmtkGsResetConfiguration;
-            break;
-
-        // EPL frames received
-        case kNmtEventDllCeSoc:
-        case kNmtEventDllCeSoa:
-            // other MN in network
-            // $$$ d.k.: generate error history entry
-            nmtkInstance_g.stateIndex = kNmtkGsResetCommunication;
-            break;
+    if (nmtkInstance_g.fAllMandatoryCNIdent != FALSE)
+        return newStateIndex_p;
 
-        // error occurred
-        case kNmtEventNmtCycleError:
-            // NMT_MT6
-            nmtkInstance_g.stateIndex = kNmtkMsPreOperational1;
-            break;
-
-        default:
-            break;
-    }
-    return kErrorOk;
+    nmtkInstance_g.fTimerMsPreOp2 = TRUE;
+    return nmtkInstance_g.stateIndex;
 }
+#endif
 
+#if (CONFIG_NMTK_STATISTICS != FALSE)
 //------------------------------------------------------------------------------
 /**
-\brief  Process State MS_BASIC_ETHERNET
-
-The function processes the NMT state MS_BASIC_ETHERNET.
-In this state the MN processes normal Ethernet traffic.
+\brief  Update transition statistics
 
-\param  nmtEvent_p      NMT event to be processed.
+The function counts a processed transition and records its latency from the
+dispatch of the event until the state change was handed to the DLL and the
+user layer.
 
-\return The function returns a tOplkError error code.
+\param  transition_p        Index of the transition.
+\param  startTime_p         Timestamp of the event dispatch in ns.
+\param  fStateChange_p      TRUE if the transition changed the state.
 */
 //------------------------------------------------------------------------------
-tOplkError doStateMsBasicEthernet(tNmtEvent nmtEvent_p)
+static void updateStatistics(UINT transition_p, ULONGLONG startTime_p,
+                             BOOL fStateChange_p)
 {
-    switch (nmtEvent_p)
-    {
-        // NMT Command SwitchOff
-        case kNmtEventCriticalError:
-        case kNmtEventSwitchOff:
-            // NMT_GT3
-            nmtkInstance_g.stateIndex = kNmtkGsOff;
-            break;
-
-        // NMT Command SwReset
-        case kNmtEventSwReset:
-            // NMT_GT8
-            nmtkInstance_g.stateIndex = kNmtkGsInitialising;
-            break;
-
-        // NMT Command ResetNode
-        case kNmtEventResetNode:
-            // NMT_GT4
-            nmtkInstance_g.stateIndex = kNmtkGsResetApplication;
-            break;
-
-        // NMT Command ResetCommunication or internal Communication error
-        case kNmtEventResetCom:          // NMT_GT5
-        case kNmtEventInternComError:    // NMT_GT6
-            nmtkInstance_g.stateIndex = kNmtkGsResetCommunication;
-            break;
-
-        // NMT Command ResetConfiguration
-        case kNmtEventResetConfig:
-            // NMT_GT7
-            nmtkInstance_g.stateIndex = kNmtkGsResetConfiguration;
-            break;
-
-        // EPL frames received
-        case kNmtEventDllCeSoc:
-        case kNmtEventDllCeSoa:
-            // other MN in network
-            // $$$ d.k.: generate error history entry
-            nmtkInstance_g.stateIndex = kNmtkGsResetCommunication;
-            break;
-
-        // error occurred
-        // d.k. BE->PreOp1 on cycle error? No
-/*      case kNmtEventNmtCycleError:
-            nmtkInstance_g.stateIndex = kNmtkCsPreOperational1;
-            break;
-*/
-        default:
-            break;
-    }
-    return kErrorOk;
+    tNmtkTransitionStatistics*  pStat = &nmtkInstance_g.statistics.aTransition[transition_p];
+    UINT32                      sequence = nmtkInstance_g.statSequence;
+    ULONGLONG                   latency;
+
+    latency = target_getCurrentTimestamp() - startTime_p;
+    if (latency > 0xFFFFFFFFULL)
+        latency = 0xFFFFFFFFULL;
+
+    nmtkInstance_g.statSequence = sequence + 1;
+    OPLK_MEMBAR();
+
+    nmtkInstance_g.statistics.eventCount++;
+    if (fStateChange_p)
+        nmtkInstance_g.statistics.stateChangeCount++;
+
+    if ((pStat->count == 0) || ((UINT32)latency < pStat->minLatency))
+        pStat->minLatency = (UINT32)latency;
+    if ((UINT32)latency > pStat->maxLatency)
+        pStat->maxLatency = (UINT32)latency;
+    pStat->totalLatency += latency;
+    pStat->count++;
+
+    OPLK_MEMBAR();
+    nmtkInstance_g.statSequence = sequence + 2;
 }
-
 #endif
 
+///\}
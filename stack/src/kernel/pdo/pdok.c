@@ -47,6 +47,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <kernel/eventk.h>
 #include <kernel/dllk.h>
 #include <oplk/benchmark.h>
+#include <oplk/tracering.h>
 #include <oplk/debugstr.h>
 
 //============================================================================//
@@ -73,11 +74,28 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#define PDOK_RX_NODE_DESC_COUNT     (NMT_MAX_NODE_ID + 1)   // RX descriptors for PReq (index 0) and PRes of node 1..NMT_MAX_NODE_ID
+#define PDOK_RX_NODE_DESC_INVALID   0xFFFF                  // no RPDO channel is configured for the node
 
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
 
+/**
+\brief RX node descriptor
+
+The structure contains the precomputed information which is necessary to
+validate and forward the RPDO of a node. It is derived from the first RPDO
+channel of the node.
+*/
+typedef struct
+{
+    UINT16                  channelId;          ///< RPDO channel of the node, PDOK_RX_NODE_DESC_INVALID if none
+    UINT16                  pdoSize;            ///< Size of the RPDO
+    UINT                    minFrameSize;       ///< Minimum frame size which contains the complete RPDO
+    UINT8                   mainVersion;        ///< Main mapping version of the RPDO
+} tPdokRxNodeDesc;
+
 /**
 \brief Kernel PDO module instance
 
@@ -88,6 +106,7 @@ typedef struct
 {
     tPdoChannelSetup        pdoChannels;        ///< PDO channel setup
     BOOL                    fRunning;           ///< Flag determines if PDO engine is running
+    tPdokRxNodeDesc         aRxNodeDesc[PDOK_RX_NODE_DESC_COUNT];   ///< RX descriptors indexed by node ID (0 = PReq)
 }tPdokInstance;
 
 //------------------------------------------------------------------------------
@@ -101,6 +120,8 @@ static tPdokInstance  pdokInstance_g;
 static tOplkError cbProcessTpdo(tFrameInfo* pFrameInfo_p, BOOL fReadyFlag_p) SECTION_PDOK_PROCESS_TPDO_CB;
 static tOplkError copyTxPdo(tPlkFrame* pFrame_p, UINT frameSize_p, BOOL fReadyFlag_p);
 static void disablePdoChannels(tPdoChannel* pPdoChannel, UINT channelCnt);
+static void buildRxNodeDescs(void);
+static tPdoChannel* findRxPdoChannel(UINT nodeId_p, UINT* pChannelId_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -398,6 +419,9 @@ tOplkError pdok_processRxPdo(tPlkFrame* pFrame_p, UINT frameSize_p)
     tMsgType            msgType;
     tPdoChannel*        pPdoChannel;
     UINT                channelId;
+    tPdokRxNodeDesc*    pRxNodeDesc;
+
+    TRACE_RING(kTraceIdPdoRxCopy, ami_getUint8Le(&pFrame_p->srcNodeId));
 
     // check if received RPDO is valid
     frameData = ami_getUint8Le(&pFrame_p->data.pres.flag1);
@@ -420,45 +444,45 @@ tOplkError pdok_processRxPdo(tPlkFrame* pFrame_p, UINT frameSize_p)
 
     if (pdokInstance_g.fRunning)
     {
-        // search for appropriate valid RPDO
-        for (channelId = 0, pPdoChannel = &pdokInstance_g.pdoChannels.pRxPdoChannel[0];
-             channelId < pdokInstance_g.pdoChannels.allocation.rxPdoChannelCount;
-             channelId++, pPdoChannel++)
+        frameData = ami_getUint8Le(&pFrame_p->data.pres.pdoVersion);
+
+        if (nodeId < PDOK_RX_NODE_DESC_COUNT)
         {
-            if (pPdoChannel->nodeId != nodeId)
-            {
-                continue;
-            }
+            pRxNodeDesc = &pdokInstance_g.aRxNodeDesc[nodeId];
+            if (pRxNodeDesc->channelId == PDOK_RX_NODE_DESC_INVALID)
+                goto Exit;
+
+            // PDO versions must match and RPDO must not be too short
+            // $$$ raise PDO error
+            if (((frameData & PLK_VERSION_MAIN) != pRxNodeDesc->mainVersion) ||
+                (frameSize_p < pRxNodeDesc->minFrameSize))
+                goto Exit;
+
+            pdokcal_writeRxPdo(pRxNodeDesc->channelId,
+                               &pFrame_p->data.pres.aPayload[0],
+                               pRxNodeDesc->pdoSize);
+        }
+        else
+        {   // node is not covered by the RX descriptors, search the channel
+            pPdoChannel = findRxPdoChannel(nodeId, &channelId);
+            if (pPdoChannel == NULL)
+                goto Exit;
 
-            // retrieve PDO version from frame
-            frameData = ami_getUint8Le(&pFrame_p->data.pres.pdoVersion);
             if ((pPdoChannel->mappingVersion & PLK_VERSION_MAIN) != (frameData & PLK_VERSION_MAIN))
             {   // PDO versions do not match
                 // $$$ raise PDO error
-                // termiate processing of this RPDO
                 goto Exit;
             }
 
-            // valid RPDO found
-
             if ((unsigned int)(pPdoChannel->pdoSize + PLK_FRAME_OFFSET_PDO_PAYLOAD) > frameSize_p)
             {   // RPDO is too short
                 // $$$ raise PDO error, set Ret
                 goto Exit;
             }
 
-            /*
-            TRACE ("%s() Channel:%d Node:%d MapObjectCnt:%d PdoSize:%d\n",
-                   __func__, channelId, nodeId, pPdoChannel->mappObjectCount,
-                   pPdoChannel->pdoSize);
-            */
-
             pdokcal_writeRxPdo(channelId,
                                &pFrame_p->data.pres.aPayload[0],
                                pPdoChannel->pdoSize);
-
-            // processing finished successfully
-            break;
         }
     }
 
@@ -494,6 +518,7 @@ tOplkError pdok_setupPdoBuffers(size_t rxPdoMemSize_p, size_t txPdoMemSize_p)
     if (ret != kErrorOk)
         return ret;
 
+    buildRxNodeDescs();
     pdokInstance_g.fRunning = TRUE;
 
     return kErrorOk;
@@ -543,6 +568,78 @@ static tOplkError cbProcessTpdo(tFrameInfo* pFrameInfo_p, BOOL fReadyFlag_p)
     return Ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Build RX node descriptors
+
+The function precomputes the RX descriptors of all nodes from the configured
+RPDO channels. As pdok_processRxPdo() only forwards the first RPDO channel of
+a node, the descriptor is derived from this channel.
+*/
+//------------------------------------------------------------------------------
+static void buildRxNodeDescs(void)
+{
+    tPdokRxNodeDesc*    pRxNodeDesc;
+    tPdoChannel*        pPdoChannel;
+    UINT                channelId;
+
+    for (pRxNodeDesc = &pdokInstance_g.aRxNodeDesc[0];
+         pRxNodeDesc < &pdokInstance_g.aRxNodeDesc[PDOK_RX_NODE_DESC_COUNT];
+         pRxNodeDesc++)
+    {
+        pRxNodeDesc->channelId = PDOK_RX_NODE_DESC_INVALID;
+    }
+
+    for (channelId = 0, pPdoChannel = &pdokInstance_g.pdoChannels.pRxPdoChannel[0];
+         channelId < pdokInstance_g.pdoChannels.allocation.rxPdoChannelCount;
+         channelId++, pPdoChannel++)
+    {
+        if (pPdoChannel->nodeId >= PDOK_RX_NODE_DESC_COUNT)
+            continue;
+
+        pRxNodeDesc = &pdokInstance_g.aRxNodeDesc[pPdoChannel->nodeId];
+        if (pRxNodeDesc->channelId != PDOK_RX_NODE_DESC_INVALID)
+            continue;
+
+        pRxNodeDesc->channelId = (UINT16)channelId;
+        pRxNodeDesc->pdoSize = pPdoChannel->pdoSize;
+        pRxNodeDesc->minFrameSize = pPdoChannel->pdoSize + PLK_FRAME_OFFSET_PDO_PAYLOAD;
+        pRxNodeDesc->mainVersion = pPdoChannel->mappingVersion & PLK_VERSION_MAIN;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Find RPDO channel of node
+
+The function searches the first RPDO channel of the specified node.
+
+\param  nodeId_p            Node ID of the RPDO.
+\param  pChannelId_p        Pointer to store the channel ID.
+
+\return The function returns a pointer to the PDO channel or NULL if no
+        channel is configured for the node.
+*/
+//------------------------------------------------------------------------------
+static tPdoChannel* findRxPdoChannel(UINT nodeId_p, UINT* pChannelId_p)
+{
+    tPdoChannel*        pPdoChannel;
+    UINT                channelId;
+
+    for (channelId = 0, pPdoChannel = &pdokInstance_g.pdoChannels.pRxPdoChannel[0];
+         channelId < pdokInstance_g.pdoChannels.allocation.rxPdoChannelCount;
+         channelId++, pPdoChannel++)
+    {
+        if (pPdoChannel->nodeId == nodeId_p)
+        {
+            *pChannelId_p = channelId;
+            return pPdoChannel;
+        }
+    }
+
+    return NULL;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Disable PDO channels
@@ -603,6 +700,8 @@ static tOplkError copyTxPdo(tPlkFrame* pFrame_p, UINT frameSize_p, BOOL fReadyFl
         nodeId = ami_getUint8Le(&pFrame_p->dstNodeId);
     }
 
+    TRACE_RING(kTraceIdPdoTxCopy, nodeId);
+
     if (pdokInstance_g.fRunning)
     {
         // search for appropriate valid TPDO
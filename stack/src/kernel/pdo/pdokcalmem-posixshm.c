@@ -43,12 +43,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <oplk/oplkinc.h>
 #include <common/pdo.h>
 #include <kernel/pdokcal.h>
-
-#include <sys/mman.h>
-#include <sys/stat.h>
-#include <fcntl.h>
-#include <unistd.h>
-#include <sys/types.h>
+#include <common/shmem.h>
 
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
@@ -82,7 +77,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
-static int                  fd_l;
+static tShmemRegion         shmRegion_l;
 
 //------------------------------------------------------------------------------
 // local function prototypes
@@ -99,7 +94,8 @@ static int                  fd_l;
 The function performs all actions needed to setup the shared memory at
 the start of the stack.
 
-For the Posix shared-memory implementation it opens the shared memory segment.
+For the Posix shared-memory implementation nothing needs to be done. The
+shared memory segment is created when the PDO memory is allocated.
 
 \return The function returns a tOplkError error code.
 
@@ -108,10 +104,6 @@ For the Posix shared-memory implementation it opens the shared memory segment.
 //------------------------------------------------------------------------------
 tOplkError pdokcal_openMem(void)
 {
-    if ((fd_l = shm_open(PDO_SHMEM_NAME, O_RDWR | O_CREAT, 0)) == -1)
-    {
-        return kErrorNoResource;
-    }
     return kErrorOk;
 }
 
@@ -131,7 +123,7 @@ For the Posix shared-memory implementation it unlinks the shared memory segment.
 //------------------------------------------------------------------------------
 tOplkError pdokcal_closeMem(void)
 {
-    shm_unlink(PDO_SHMEM_NAME);
+    shmem_unlink(PDO_SHMEM_NAME);
     return kErrorOk;
 }
 
@@ -152,17 +144,15 @@ The function allocates shared memory for the kernel needed to transfer the PDOs.
 tOplkError pdokcal_allocateMem(size_t memSize_p, BYTE** ppPdoMem_p)
 {
     TRACE ("%s()\n", __func__);
-    if (ftruncate(fd_l, memSize_p) < 0)
-        return kErrorNoResource;
-
-    *ppPdoMem_p = mmap(NULL, memSize_p, PROT_READ | PROT_WRITE, MAP_SHARED, fd_l, 0);
-    if (*ppPdoMem_p == MAP_FAILED)
+    if (shmem_map(PDO_SHMEM_NAME, memSize_p, kShmemModeCreate, &shmRegion_l) != kErrorOk)
     {
-        TRACE ("%s() mmap failed!}n", __func__);
+        TRACE ("%s() mapping shared memory failed!\n", __func__);
         *ppPdoMem_p = NULL;
         return kErrorNoResource;
     }
 
+    *ppPdoMem_p = (BYTE*)shmRegion_l.pBase;
+
     TRACE ("%s() Allocated memory for PDO at %p size:%d\n", __func__, *ppPdoMem_p, memSize_p);
     return kErrorOk;
 }
@@ -185,12 +175,15 @@ transfering the PDOs.
 tOplkError pdokcal_freeMem(BYTE* pMem_p, size_t memSize_p)
 {
     TRACE ("%s()\n", __func__);
+    UNUSED_PARAMETER(memSize_p);
 
-    if (munmap(pMem_p, memSize_p) != 0)
+    if (pMem_p != (BYTE*)shmRegion_l.pBase)
     {
-        TRACE("%s() munmap failed!\n", __func__);
+        TRACE("%s() invalid PDO memory!\n", __func__);
         return kErrorGeneralError;
     }
+
+    shmem_unmap(&shmRegion_l);
     return kErrorOk;
 }
 
@@ -1,11 +1,13 @@
 /**
 ********************************************************************************
-\file   pdokcalsync-bsdsem.c
+\file   pdokcalsync-futex.c
 
-\brief  PDO CAL kernel sync module using BSD semaphores
+\brief  PDO CAL kernel sync module using a shared sync word
 
 This file contains an implementation for the kernel PDO CAL sync module which
-uses BSD semaphores for synchronisation.
+uses a sync word in POSIX shared memory for synchronisation. Every sync event
+increments the cycle number in the sync word and wakes up the user layer
+waiting on it with a futex.
 
 The sync module is responsible to notify the user layer that new PDO data
 can be transfered.
@@ -43,12 +45,16 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // includes
 //------------------------------------------------------------------------------
-#include <fcntl.h>
-#include <sys/stat.h>
-#include <semaphore.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <limits.h>
+#include <linux/futex.h>
 
 #include <oplk/oplkinc.h>
 #include <common/pdo.h>
+#include <common/target.h>
+#include <common/shmem.h>
+#include <oplk/tracering.h>
 
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
@@ -82,7 +88,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
-static sem_t*           syncSem_l;
+static tShmemRegion     shmRegion_l;
+static tPdoSyncWord*    pSyncWord_l = NULL;
 
 //------------------------------------------------------------------------------
 // local function prototypes
@@ -105,11 +112,13 @@ The function initializes the kernel PDO CAL sync module.
 //------------------------------------------------------------------------------
 tOplkError pdokcal_initSync(void)
 {
-    if ((syncSem_l = sem_open(PDO_SYNC_BSDSEM, O_CREAT, S_IRWXG, 1)) == SEM_FAILED)
+    if (shmem_map(PDO_SYNC_SHM, sizeof(tPdoSyncWord), kShmemModeCreate, &shmRegion_l) != kErrorOk)
     {
-        TRACE("%s() creating sem failed!\n", __func__);
+        TRACE("%s() creating sync shared memory failed!\n", __func__);
         return kErrorNoResource;
     }
+
+    pSyncWord_l = (tPdoSyncWord*)shmRegion_l.pBase;
     return kErrorOk;
 }
 
@@ -124,14 +133,21 @@ The function cleans up the PDO CAL sync module.
 //------------------------------------------------------------------------------
 void pdokcal_exitSync(void)
 {
-    sem_close(syncSem_l);
+    if (pSyncWord_l != NULL)
+    {
+        shmem_unmap(&shmRegion_l);
+        pSyncWord_l = NULL;
+    }
 }
 
 //------------------------------------------------------------------------------
 /**
 \brief  Send a sync event
 
-The function sends a sync event.
+The function sends a sync event. It stores the current timestamp, increments
+the cycle number of the sync word and wakes up all waiters. Waiters which
+missed sync events detect this from the cycle number instead of getting a
+backlog of wake-ups.
 
 \return The function returns a tOplkError error code.
 
@@ -140,7 +156,19 @@ The function sends a sync event.
 //------------------------------------------------------------------------------
 tOplkError pdokcal_sendSyncEvent(void)
 {
-    sem_post(syncSem_l);
+    UINT32  cycleNumber;
+
+    if (pSyncWord_l == NULL)
+        return kErrorNoResource;
+
+    cycleNumber = pSyncWord_l->cycleNumber + 1;
+    pSyncWord_l->aTimestamp[cycleNumber & 1] = target_getCurrentTimestamp();
+    OPLK_MEMBAR();
+    pSyncWord_l->cycleNumber = cycleNumber;
+    OPLK_MEMBAR();
+    TRACE_RING(kTraceIdSyncSignal, cycleNumber);
+
+    syscall(SYS_futex, &pSyncWord_l->cycleNumber, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
     return kErrorOk;
 }
 
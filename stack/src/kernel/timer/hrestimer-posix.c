@@ -45,6 +45,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <oplk/oplkinc.h>
 #include <kernel/hrestimer.h>
 #include <oplk/benchmark.h>
+#include <common/target.h>
 
 #include <time.h>
 #include <unistd.h>
@@ -161,7 +162,6 @@ tOplkError hrestimer_addInstance(void)
 {
     tOplkError              ret = kErrorOk;
     UINT                    index;
-    struct sched_param      schedParam;
     tHresTimerInfo*         pTimerInfo;
     struct sigevent         sev;
 
@@ -188,10 +188,8 @@ tOplkError hrestimer_addInstance(void)
         return kErrorNoResource;
     }
 
-    schedParam.__sched_priority = CONFIG_THREAD_PRIORITY_HIGH;
-    if (pthread_setschedparam(hresTimerInstance_l.threadId, SCHED_FIFO, &schedParam) != 0)
+    if (target_setupThread(hresTimerInstance_l.threadId, kOplkThreadHresTimer) != kErrorOk)
     {
-        DEBUG_LVL_ERROR_TRACE("%s() Couldn't set thread scheduling parameters!\n", __func__);
         pthread_cancel(hresTimerInstance_l.threadId);
         return kErrorNoResource;
     }
@@ -442,6 +440,8 @@ static void* timerThread(void* pParm_p)
 
     DEBUG_LVL_TIMERH_TRACE("%s(): ThreadId:%ld\n", __func__, syscall(SYS_gettid));
 
+    target_prefaultThreadStack();
+
     sigemptyset(&awaitedSignal);
     sigaddset(&awaitedSignal, SIGHIGHRES);
     pthread_sigmask(SIG_BLOCK, &awaitedSignal, NULL);
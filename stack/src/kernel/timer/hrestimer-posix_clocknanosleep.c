@@ -45,6 +45,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <oplk/oplkinc.h>
 #include <kernel/hrestimer.h>
 #include <oplk/benchmark.h>
+#include <common/target.h>
 
 #include <signal.h>
 #include <semaphore.h>
@@ -179,7 +180,6 @@ tOplkError hrestimer_addInstance(void)
 {
     tOplkError                  ret = kErrorOk;
     UINT                        index;
-    struct sched_param          schedParam;
     tHresTimerInfo*             pTimerInfo;
 
     OPLK_MEMSET(&hresTimerInstance_l, 0, sizeof(hresTimerInstance_l));
@@ -207,10 +207,8 @@ tOplkError hrestimer_addInstance(void)
             return kErrorNoResource;
         }
 
-        schedParam.__sched_priority = CONFIG_THREAD_PRIORITY_HIGH;
-        if (pthread_setschedparam(pTimerInfo->timerThreadId, SCHED_FIFO, &schedParam) != 0)
+        if (target_setupThread(pTimerInfo->timerThreadId, kOplkThreadHresTimer) != kErrorOk)
         {
-            DEBUG_LVL_ERROR_TRACE("%s() Couldn't set thread scheduling parameters!\n", __func__);
             sem_destroy(&pTimerInfo->syncSem);
             pthread_cancel(pTimerInfo->timerThreadId);
             return kErrorNoResource;
@@ -445,6 +443,8 @@ static void* timerThread(void* pArgument_p)
     DEBUG_LVL_TIMERH_TRACE("%s(): ThreadId:%ld\n", __func__, syscall(SYS_gettid));
     DEBUG_LVL_TIMERH_TRACE("%s(): timer:%lx\n", __func__, (unsigned long)pArgument_p);
 
+    target_prefaultThreadStack();
+
     /* thread parameter contains the address of the timer information structure */
     pTimerInfo = (tHresTimerInfo*)pArgument_p;
 
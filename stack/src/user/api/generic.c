@@ -116,6 +116,9 @@ the application must start it by performing a software reset. This is done by
 sending the NMT event kNmtEventSwReset. The event can be sent by calling
 oplk_execNmtCommand(kNmtEventSwReset).
 
+On Linux userspace the real-time thread configuration of the init parameters
+is applied to all threads created by the stack.
+
 \param  pInitParam_p            Pointer to the init parameters. The init
                                 parameters must be set by the application.
 
@@ -129,7 +132,24 @@ tOplkError oplk_init(tOplkApiInitParam* pInitParam_p)
 {
     tOplkError          ret;
 
-    target_init();
+    if ((ret = target_init()) != kErrorOk)
+        return ret;
+
+#if (TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__)
+    // the real-time thread parameters must be set before any stack thread is created
+    if (pInitParam_p->sizeOfInitParam >=
+        offsetof(tOplkApiInitParam, pThreadParam) + sizeof(pInitParam_p->pThreadParam))
+        ret = target_setThreadParam(pInitParam_p->pThreadParam);
+    else
+        ret = target_setThreadParam(NULL);
+
+    if (ret != kErrorOk)
+    {
+        target_cleanup();
+        return ret;
+    }
+#endif
+
     if ((ret=ctrlu_init()) != kErrorOk)
     {
         target_cleanup();
@@ -852,18 +872,24 @@ BOOL oplk_checkKernelStack(void)
 /**
 \brief Wait for sync event
 
-The function waits for a sync event.
+The function waits for a sync event. It always returns the latest sync event.
+If the application missed sync events since the last call, their number is
+returned in the sync event information, so the application can detect an
+overrun without processing stale sync events.
 
-\param  timeout_p       Time to wait for event
+\param  timeout_p       Time to wait for event in microseconds. If 0 it
+                        waits forever.
+\param  pSyncInfo_p     Pointer to store the cycle number and the number of
+                        skipped cycles of the received sync event. May be NULL.
 
 \return The function returns a tOplkError error code.
 
 \ingroup module_api
 */
 //------------------------------------------------------------------------------
-tOplkError oplk_waitSyncEvent(ULONG timeout_p)
+tOplkError oplk_waitSyncEvent(ULONG timeout_p, tSyncEventInfo* pSyncInfo_p)
 {
-    return pdoucal_waitSyncEvent(timeout_p);
+    return pdoucal_waitSyncEvent(timeout_p, pSyncInfo_p);
 }
 
 //------------------------------------------------------------------------------
@@ -6,6 +6,20 @@
 
 This source file contains the implementation of the process image functions.
 
+Besides the process images used by the synchronous application, the module
+can keep a double-buffered snapshot of each image. Once a reader has enabled
+the snapshot, it is published by the exchange functions after the PDOs have
+been copied. Non real-time threads can read a consistent copy of a snapshot
+without any lock. A sequence counter detects the rare case that the sync
+thread publishes twice while a reader is copying, in which case the reader
+retries. The sync thread is never delayed by a reader.
+
+In the other direction non real-time threads can publish values for the input
+process image. They are staged and copied into the input image by the sync
+thread before the TPDOs are copied from it. If a publishing thread currently
+uses the staging area, the sync thread does not wait but applies the values
+in the next cycle.
+
 *******************************************************************************/
 
 /*------------------------------------------------------------------------------
@@ -43,6 +57,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <oplk/oplk.h>
 
 #include <user/pdou.h>
+#include <common/target.h>
 
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
@@ -68,15 +83,51 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#define PI_STAGE_LOCK_RETRIES       100     ///< Attempts of a publishing thread to lock the staging area
 
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
 
+/**
+\brief Process image snapshot
+
+The structure contains the snapshot buffers of a process image. The sync thread
+writes the back buffer while the sequence counter is odd. Incrementing the
+counter to the next even value publishes the back buffer as the new front
+buffer. Bit 1 of the counter selects the front buffer.
+*/
+typedef struct
+{
+    volatile BOOL           fEnabled;           ///< Snapshot is published by the exchange function
+    volatile UINT32         sequence;           ///< Sequence counter, odd while a snapshot is written
+    BYTE*                   apBuffer[2];        ///< Front and back buffer
+} tApiProcessImageSnapshot;
+
+/**
+\brief Process image staging area
+
+The structure contains the values published for the input process image by
+non real-time threads. Each bit of the dirty mask marks a byte of the staging
+buffer which has to be copied into the process image. The lock is held by a
+publishing thread while it stages values and by the sync thread while it
+applies them.
+*/
+typedef struct
+{
+    OPLK_ATOMIC_T           lock;               ///< Lock of the staging area
+    volatile BOOL           fPending;           ///< Staged values are pending
+    BYTE*                   pBuffer;            ///< Staged values
+    UINT32*                 paDirtyMask;        ///< Bit mask of staged bytes
+} tApiProcessImageStage;
+
 typedef struct
 {
     tOplkApiProcessImage     inputImage;
     tOplkApiProcessImage     outputImage;
+    tApiProcessImageSnapshot inputSnapshot;
+    tApiProcessImageSnapshot outputSnapshot;
+    tApiProcessImageStage    inputStage;
 } tApiProcessImageInstance;
 
 //------------------------------------------------------------------------------
@@ -87,6 +138,18 @@ static tApiProcessImageInstance  instance_l;
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
+static tOplkError   enableSnapshot(tApiProcessImageSnapshot* pSnapshot_p,
+                                   tOplkApiProcessImage* pImage_p, BOOL fEnable_p);
+static void         freeSnapshot(tApiProcessImageSnapshot* pSnapshot_p);
+static tOplkError   allocStage(tApiProcessImageStage* pStage_p, UINT size_p);
+static void         freeStage(tApiProcessImageStage* pStage_p);
+static void         applyStage(tApiProcessImageStage* pStage_p,
+                               tOplkApiProcessImage* pImage_p);
+static void         publishSnapshot(tApiProcessImageSnapshot* pSnapshot_p,
+                                    tOplkApiProcessImage* pImage_p);
+static tOplkError   readSnapshot(tApiProcessImageSnapshot* pSnapshot_p,
+                                 tOplkApiProcessImage* pImage_p, UINT offset_p,
+                                 void* pDst_p, UINT size_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -173,6 +236,10 @@ tOplkError oplk_freeProcessImage(void)
     OPLK_FREE(instance_l.outputImage.pImage);
     instance_l.outputImage.pImage = NULL;
 
+    freeSnapshot(&instance_l.inputSnapshot);
+    freeSnapshot(&instance_l.outputSnapshot);
+    freeStage(&instance_l.inputStage);
+
 Exit:
     return Ret;
 }
@@ -248,7 +315,10 @@ tOplkError oplk_linkProcessImageObject(UINT objIndex_p, UINT firstSubindex_p,
 /**
 \brief  Exchange input process image
 
-The function exchanges the input process image.
+The function exchanges the input process image. Values published by
+oplk_publishProcessImageIn() are copied into the input process image before
+the TPDOs are copied from it. Afterwards the input process image is published
+as new input snapshot if the snapshot is enabled.
 
 \return The function returns a tOplkError error code.
 
@@ -259,10 +329,15 @@ tOplkError oplk_exchangeProcessImageIn(void)
 {
     tOplkError      ret;
 
-    if (instance_l.inputImage.pImage != NULL)
-        ret = pdou_copyTxPdoFromPi();
-    else
-        ret = kErrorApiPINotAllocated;
+    if (instance_l.inputImage.pImage == NULL)
+        return kErrorApiPINotAllocated;
+
+    if (instance_l.inputStage.fPending)
+        applyStage(&instance_l.inputStage, &instance_l.inputImage);
+
+    ret = pdou_copyTxPdoFromPi();
+    if ((ret == kErrorOk) && instance_l.inputSnapshot.fEnabled)
+        publishSnapshot(&instance_l.inputSnapshot, &instance_l.inputImage);
 
     return ret;
 }
@@ -271,7 +346,8 @@ tOplkError oplk_exchangeProcessImageIn(void)
 /**
 \brief  Exchange output process image
 
-The function exchanges the output process image.
+The function exchanges the output process image. Afterwards the output process
+image is published as new output snapshot if the snapshot is enabled.
 
 \return The function returns a tOplkError error code.
 
@@ -282,10 +358,12 @@ tOplkError oplk_exchangeProcessImageOut(void)
 {
     tOplkError      ret;
 
-    if (instance_l.outputImage.pImage != NULL)
-        ret = pdou_copyRxPdoToPi();
-    else
-        ret = kErrorApiPINotAllocated;
+    if (instance_l.outputImage.pImage == NULL)
+        return kErrorApiPINotAllocated;
+
+    ret = pdou_copyRxPdoToPi();
+    if ((ret == kErrorOk) && instance_l.outputSnapshot.fEnabled)
+        publishSnapshot(&instance_l.outputSnapshot, &instance_l.outputImage);
 
     return ret;
 }
@@ -322,4 +400,401 @@ void* oplk_getProcessImageOut(void)
     return instance_l.outputImage.pImage;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Enable process image snapshot
+
+The function enables or disables the snapshot of a process image. A thread
+which wants to read a snapshot has to enable it first. The snapshot buffers
+are allocated when the snapshot is enabled for the first time. While the
+snapshot is disabled, the exchange function does not copy the process image
+and the last published snapshot is kept.
+
+\param  fOutputPI_p             Determines the process image: TRUE = output
+                                image, FALSE = input image
+\param  fEnable_p               TRUE to enable, FALSE to disable the snapshot.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_enableProcessImageSnapshot(BOOL fOutputPI_p, BOOL fEnable_p)
+{
+    if (fOutputPI_p)
+        return enableSnapshot(&instance_l.outputSnapshot, &instance_l.outputImage, fEnable_p);
+    else
+        return enableSnapshot(&instance_l.inputSnapshot, &instance_l.inputImage, fEnable_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Publish values for the input process image
+
+The function hands values for the input process image from a non real-time
+thread to the sync thread. The values are staged and copied into the input
+process image by the next call of oplk_exchangeProcessImageIn() which finds
+the staging area unlocked, before the TPDOs are copied. Values published for
+the same bytes before they are applied replace each other.
+
+\param  offset_p                Offset of the data in the process image.
+\param  pSrc_p                  Pointer to the data to publish.
+\param  size_p                  Number of bytes to publish.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                Values are staged.
+\retval kErrorRetry             The staging area is continuously in use.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_publishProcessImageIn(UINT offset_p, const void* pSrc_p, UINT size_p)
+{
+    tApiProcessImageStage*  pStage = &instance_l.inputStage;
+    tOplkError              ret = kErrorOk;
+    OPLK_ATOMIC_T           lockVal;
+    UINT                    retries;
+    UINT                    index;
+
+    if (pSrc_p == NULL)
+        return kErrorApiInvalidParam;
+
+    if (instance_l.inputImage.pImage == NULL)
+        return kErrorApiPINotAllocated;
+
+    if ((offset_p > instance_l.inputImage.imageSize) ||
+        (size_p > (instance_l.inputImage.imageSize - offset_p)))
+        return kErrorApiPISizeExceeded;
+
+    for (retries = 0; ; retries++)
+    {
+        OPLK_ATOMIC_EXCHANGE(&pStage->lock, 1, lockVal);
+        if (lockVal == 0)
+            break;
+
+        if (retries >= PI_STAGE_LOCK_RETRIES)
+            return kErrorRetry;
+
+        target_msleep(1);
+    }
+
+    if (pStage->pBuffer == NULL)
+    {
+        ret = allocStage(pStage, instance_l.inputImage.imageSize);
+        if (ret != kErrorOk)
+            goto Exit;
+    }
+
+    OPLK_MEMCPY(pStage->pBuffer + offset_p, pSrc_p, size_p);
+    for (index = offset_p; index < (offset_p + size_p); index++)
+        pStage->paDirtyMask[index >> 5] |= (1UL << (index & 31));
+
+    pStage->fPending = TRUE;
+
+Exit:
+    OPLK_MEMBAR();
+    pStage->lock = 0;
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read input process image snapshot
+
+The function copies a part of the input process image as it was published by
+the latest call of oplk_exchangeProcessImageIn(). It can be called from any
+thread and never blocks the thread exchanging the process images. The snapshot
+has to be enabled with oplk_enableProcessImageSnapshot() first.
+
+\param  offset_p                Offset of the data in the process image.
+\param  pDst_p                  Pointer to the destination buffer.
+\param  size_p                  Number of bytes to copy.
+
+\return The function returns a tOplkError error code.
+\retval kErrorRetry             No snapshot has been published yet.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_getProcessImageInSnapshot(UINT offset_p, void* pDst_p, UINT size_p)
+{
+    return readSnapshot(&instance_l.inputSnapshot, &instance_l.inputImage,
+                        offset_p, pDst_p, size_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read output process image snapshot
+
+The function copies a part of the output process image as it was published by
+the latest call of oplk_exchangeProcessImageOut(). It can be called from any
+thread and never blocks the thread exchanging the process images. The snapshot
+has to be enabled with oplk_enableProcessImageSnapshot() first.
+
+\param  offset_p                Offset of the data in the process image.
+\param  pDst_p                  Pointer to the destination buffer.
+\param  size_p                  Number of bytes to copy.
+
+\return The function returns a tOplkError error code.
+\retval kErrorRetry             No snapshot has been published yet.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_getProcessImageOutSnapshot(UINT offset_p, void* pDst_p, UINT size_p)
+{
+    return readSnapshot(&instance_l.outputSnapshot, &instance_l.outputImage,
+                        offset_p, pDst_p, size_p);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Enable process image snapshot
+
+The function enables or disables a process image snapshot. The front and back
+buffer of the snapshot are allocated when it is enabled for the first time.
+
+\param  pSnapshot_p             Pointer to the snapshot.
+\param  pImage_p                Pointer to the process image.
+\param  fEnable_p               TRUE to enable, FALSE to disable the snapshot.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError enableSnapshot(tApiProcessImageSnapshot* pSnapshot_p,
+                                 tOplkApiProcessImage* pImage_p, BOOL fEnable_p)
+{
+    BYTE*       pBuffer;
+
+    if (pImage_p->pImage == NULL)
+        return kErrorApiPINotAllocated;
+
+    if (fEnable_p && (pSnapshot_p->apBuffer[0] == NULL))
+    {
+        pBuffer = (BYTE*)OPLK_MALLOC(2 * pImage_p->imageSize);
+        if (pBuffer == NULL)
+            return kErrorApiPIOutOfMemory;
+
+        OPLK_MEMSET(pBuffer, 0, 2 * pImage_p->imageSize);
+        pSnapshot_p->apBuffer[0] = pBuffer;
+        pSnapshot_p->apBuffer[1] = pBuffer + pImage_p->imageSize;
+        pSnapshot_p->sequence = 0;
+    }
+
+    // buffers must be valid before the sync thread sees the snapshot enabled
+    OPLK_MEMBAR();
+    pSnapshot_p->fEnabled = fEnable_p;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free process image snapshot
+
+The function frees the buffers of a process image snapshot.
+
+\param  pSnapshot_p             Pointer to the snapshot.
+*/
+//------------------------------------------------------------------------------
+static void freeSnapshot(tApiProcessImageSnapshot* pSnapshot_p)
+{
+    pSnapshot_p->fEnabled = FALSE;
+
+    if (pSnapshot_p->apBuffer[0] != NULL)
+        OPLK_FREE(pSnapshot_p->apBuffer[0]);
+
+    pSnapshot_p->apBuffer[0] = NULL;
+    pSnapshot_p->apBuffer[1] = NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Allocate process image staging area
+
+The function allocates the staging buffer and the dirty mask of a staging
+area. It is called with the staging area locked.
+
+\param  pStage_p                Pointer to the staging area.
+\param  size_p                  Size of the process image.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError allocStage(tApiProcessImageStage* pStage_p, UINT size_p)
+{
+    UINT        maskSize = ((size_p + 31) / 32) * sizeof(UINT32);
+    BYTE*       pBuffer;
+
+    pBuffer = (BYTE*)OPLK_MALLOC(size_p + maskSize);
+    if (pBuffer == NULL)
+        return kErrorApiPIOutOfMemory;
+
+    OPLK_MEMSET(pBuffer, 0, size_p + maskSize);
+    pStage_p->paDirtyMask = (UINT32*)pBuffer;
+    pStage_p->pBuffer = pBuffer + maskSize;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free process image staging area
+
+The function frees the buffers of a staging area and discards pending values.
+
+\param  pStage_p                Pointer to the staging area.
+*/
+//------------------------------------------------------------------------------
+static void freeStage(tApiProcessImageStage* pStage_p)
+{
+    pStage_p->fPending = FALSE;
+
+    if (pStage_p->paDirtyMask != NULL)
+        OPLK_FREE(pStage_p->paDirtyMask);
+
+    pStage_p->paDirtyMask = NULL;
+    pStage_p->pBuffer = NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Apply process image staging area
+
+The function copies the staged values into the process image and clears the
+dirty mask. It is called by the sync thread. If a publishing thread holds the
+lock of the staging area, the function returns at once and the values are
+applied in the next cycle.
+
+\param  pStage_p                Pointer to the staging area.
+\param  pImage_p                Pointer to the process image.
+*/
+//------------------------------------------------------------------------------
+static void applyStage(tApiProcessImageStage* pStage_p,
+                       tOplkApiProcessImage* pImage_p)
+{
+    OPLK_ATOMIC_T   lockVal;
+    BYTE*           pImage = (BYTE*)pImage_p->pImage;
+    UINT32          mask;
+    UINT            wordIndex;
+    UINT            offset;
+
+    OPLK_ATOMIC_EXCHANGE(&pStage_p->lock, 1, lockVal);
+    if (lockVal != 0)
+        return;
+
+    for (wordIndex = 0; wordIndex < ((pImage_p->imageSize + 31) / 32); wordIndex++)
+    {
+        mask = pStage_p->paDirtyMask[wordIndex];
+        if (mask == 0)
+            continue;
+
+        offset = wordIndex * 32;
+        if (mask == 0xFFFFFFFFUL)
+        {
+            OPLK_MEMCPY(pImage + offset, pStage_p->pBuffer + offset, 32);
+        }
+        else
+        {
+            for (; mask != 0; mask >>= 1, offset++)
+            {
+                if ((mask & 1) != 0)
+                    pImage[offset] = pStage_p->pBuffer[offset];
+            }
+        }
+        pStage_p->paDirtyMask[wordIndex] = 0;
+    }
+
+    pStage_p->fPending = FALSE;
+
+    OPLK_MEMBAR();
+    pStage_p->lock = 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Publish process image snapshot
+
+The function copies the process image into the back buffer of the snapshot and
+makes it the new front buffer. It must only be called by the thread which
+exchanges the process images.
+
+\param  pSnapshot_p             Pointer to the snapshot.
+\param  pImage_p                Pointer to the process image.
+*/
+//------------------------------------------------------------------------------
+static void publishSnapshot(tApiProcessImageSnapshot* pSnapshot_p,
+                            tOplkApiProcessImage* pImage_p)
+{
+    UINT32      sequence = pSnapshot_p->sequence;
+
+    if (pSnapshot_p->apBuffer[0] == NULL)
+        return;
+
+    pSnapshot_p->sequence = sequence + 1;
+    OPLK_MEMBAR();
+
+    OPLK_MEMCPY(pSnapshot_p->apBuffer[((sequence >> 1) + 1) & 1], pImage_p->pImage,
+                pImage_p->imageSize);
+
+    OPLK_MEMBAR();
+    pSnapshot_p->sequence = sequence + 2;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read process image snapshot
+
+The function copies data from the front buffer of a snapshot. The front buffer
+is only overwritten after the sync thread published another snapshot and
+started writing the next one. If the sequence counter shows that this happened
+during the copy, the copy is repeated.
+
+\param  pSnapshot_p             Pointer to the snapshot.
+\param  pImage_p                Pointer to the process image.
+\param  offset_p                Offset of the data in the process image.
+\param  pDst_p                  Pointer to the destination buffer.
+\param  size_p                  Number of bytes to copy.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError readSnapshot(tApiProcessImageSnapshot* pSnapshot_p,
+                               tOplkApiProcessImage* pImage_p, UINT offset_p,
+                               void* pDst_p, UINT size_p)
+{
+    UINT32      sequence;
+
+    if (pDst_p == NULL)
+        return kErrorApiInvalidParam;
+
+    if (pSnapshot_p->apBuffer[0] == NULL)
+        return kErrorApiPINotAllocated;
+
+    if (pSnapshot_p->sequence == 0)
+        return kErrorRetry;         // no snapshot published yet
+
+    if ((offset_p > pImage_p->imageSize) || (size_p > (pImage_p->imageSize - offset_p)))
+        return kErrorApiPISizeExceeded;
+
+    do
+    {
+        sequence = pSnapshot_p->sequence & ~1U;
+        OPLK_MEMBAR();
+
+        OPLK_MEMCPY(pDst_p, pSnapshot_p->apBuffer[(sequence >> 1) & 1] + offset_p,
+                    size_p);
+
+        OPLK_MEMBAR();
+    } while ((UINT32)(pSnapshot_p->sequence - sequence) > 2);
+
+    return kErrorOk;
+}
 
+///\}
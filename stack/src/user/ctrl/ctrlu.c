@@ -74,6 +74,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <user/syncu.h>
 #endif
 
+#if (TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__) && (CONFIG_MEMPOOL != FALSE)
+#include <common/mempool.h>
+#endif
+
 #include <stddef.h>
 #include <limits.h>
 
@@ -793,6 +797,12 @@ static tOplkError cbNmtStateChange(tEventNmtStateChange nmtStateChange_p)
     if(ret != kErrorOk)
         return ret;
 
+#if (TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__) && (CONFIG_MEMPOOL != FALSE)
+    // heap allocations are not allowed in operational state
+    mempool_setOperational((nmtStateChange_p.newNmtState == kNmtCsOperational) ||
+                           (nmtStateChange_p.newNmtState == kNmtMsOperational));
+#endif
+
     // do work which must be done in that state
     switch (nmtStateChange_p.newNmtState)
     {
@@ -64,7 +64,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
-#define CMD_TIMEOUT_CNT     100     // loop counter for command timeout
+#define CMD_TIMEOUT_CNT             100         // loop counter for command timeout
+#define CMD_POLL_PERIOD_US          10000       // poll period while waiting for the kernel stack
+#define KERNEL_STATUS_TIMEOUT_US    1000000     // time to wait for kernel stack shutdown
 
 //------------------------------------------------------------------------------
 // module global vars
@@ -95,6 +97,7 @@ static int fd_l;           // file descriptor for powerlink device
 // local function prototypes
 //------------------------------------------------------------------------------
 UINT16 getMagic (void);
+static BOOL isKernelStackReady(void* pArg_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -220,10 +223,8 @@ tOplkError ctrlucal_checkKernelStack(void)
                 break;
             }
 
-            target_msleep(1000);
-
-            kernelStatus = ctrlucal_getStatus();
-            if (kernelStatus != kCtrlStatusReady)
+            if (!target_pollUntil(isKernelStackReady, NULL, CMD_POLL_PERIOD_US,
+                                  KERNEL_STATUS_TIMEOUT_US))
             {
                 ret = kErrorNoResource;
             }
@@ -354,3 +355,22 @@ int ctrlucal_getFd(void)
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
 
+//------------------------------------------------------------------------------
+/**
+\brief  Check if kernel stack is ready
+
+Condition callback for target_pollUntil() which checks whether the kernel
+stack has reached the status kCtrlStatusReady.
+
+\param  pArg_p              Unused.
+
+\return Returns TRUE if the kernel stack is ready.
+*/
+//------------------------------------------------------------------------------
+static BOOL isKernelStackReady(void* pArg_p)
+{
+    UNUSED_PARAMETER(pArg_p);
+
+    return (ctrlucal_getStatus() == kCtrlStatusReady);
+}
+
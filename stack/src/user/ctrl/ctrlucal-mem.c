@@ -58,7 +58,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
-#define CMD_TIMEOUT_CNT     100     // loop counter for command timeout
+#define CMD_POLL_PERIOD_US          10000       // poll period while waiting for command completion
+#define CMD_TIMEOUT_US              1000000     // command timeout
+#define KERNEL_STATUS_TIMEOUT_US    1000000     // time to wait for kernel stack shutdown
 
 //------------------------------------------------------------------------------
 // module global vars
@@ -88,6 +90,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // local function prototypes
 //------------------------------------------------------------------------------
 UINT16 getMagic (void);
+static BOOL isKernelStackReady(void* pArg_p);
+static BOOL isCommandCompleted(void* pArg_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -154,9 +158,7 @@ The function executes a control command in the kernel stack.
 //------------------------------------------------------------------------------
 tOplkError ctrlucal_executeCmd(tCtrlCmdType cmd_p)
 {
-    tOplkError          ret;
     tCtrlCmd            ctrlCmd;
-    int                 timeout;
 
     /* write command into shared buffer */
     ctrlCmd.cmd = cmd_p;
@@ -165,16 +167,8 @@ tOplkError ctrlucal_executeCmd(tCtrlCmdType cmd_p)
     ctrlcal_writeData(offsetof(tCtrlBuf, ctrlCmd), &ctrlCmd, sizeof(tCtrlCmd));
 
     /* wait for response */
-    for (timeout = 0; timeout < CMD_TIMEOUT_CNT; timeout++)
-    {
-        target_msleep(10);
-        ctrlcal_readData(&ctrlCmd, offsetof(tCtrlBuf, ctrlCmd), sizeof(tCtrlCmd));
-        if (ctrlCmd.cmd == 0)
-        {
-            ret = ctrlCmd.retVal;
-            return ret;
-        }
-    }
+    if (target_pollUntil(isCommandCompleted, &ctrlCmd, CMD_POLL_PERIOD_US, CMD_TIMEOUT_US))
+        return ctrlCmd.retVal;
 
     TRACE("%s() Timeout waiting for return!\n", __func__);
     return kErrorGeneralError;
@@ -224,10 +218,8 @@ tOplkError ctrlucal_checkKernelStack(void)
                 break;
             }
 
-            target_msleep(1000);
-
-            kernelStatus = ctrlucal_getStatus();
-            if (kernelStatus != kCtrlStatusReady)
+            if (!target_pollUntil(isKernelStackReady, NULL, CMD_POLL_PERIOD_US,
+                                  KERNEL_STATUS_TIMEOUT_US))
             {
                 ret = kErrorNoResource;
             }
@@ -328,6 +320,46 @@ tOplkError ctrlucal_readInitParam(tCtrlInitParam* pInitParam_p)
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
 
+//------------------------------------------------------------------------------
+/**
+\brief  Check if kernel stack is ready
+
+Condition callback for target_pollUntil() which checks whether the kernel
+stack has reached the status kCtrlStatusReady.
+
+\param  pArg_p              Unused.
+
+\return Returns TRUE if the kernel stack is ready.
+*/
+//------------------------------------------------------------------------------
+static BOOL isKernelStackReady(void* pArg_p)
+{
+    UNUSED_PARAMETER(pArg_p);
+
+    return (ctrlucal_getStatus() == kCtrlStatusReady);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check if command is completed
+
+Condition callback for target_pollUntil() which reads the command from the
+shared control buffer and checks whether the kernel stack has completed it.
+
+\param  pArg_p              Pointer to the command buffer which receives the
+                            read command.
+
+\return Returns TRUE if the command is completed.
+*/
+//------------------------------------------------------------------------------
+static BOOL isCommandCompleted(void* pArg_p)
+{
+    tCtrlCmd*   pCtrlCmd = (tCtrlCmd*)pArg_p;
+
+    ctrlcal_readData(pCtrlCmd, offsetof(tCtrlBuf, ctrlCmd), sizeof(tCtrlCmd));
+    return (pCtrlCmd->cmd == 0);
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Get magic number
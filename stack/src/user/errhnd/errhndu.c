@@ -196,6 +196,29 @@ tOplkError errhndu_exit()
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief    Get all error handler objects
+
+The function reads all error counters and thresholds of the error handler at
+once. It is intended for diagnostic tools which need to monitor all counters
+without reading each object through the object dictionary.
+
+\param  pErrorObjects_p     Pointer to store the error objects.
+
+\return Returns a tOplkError error code.
+
+\ingroup module_errhndu
+*/
+//------------------------------------------------------------------------------
+tOplkError errhndu_getErrorObjects(tErrHndObjects* pErrorObjects_p)
+{
+    if (pErrorObjects_p == NULL)
+        return kErrorApiInvalidParam;
+
+    return errhnducal_getErrorObjects(pErrorObjects_p);
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief    Error handler OD callback function
@@ -218,6 +218,29 @@ tOplkError errhnducal_readErrorObject(UINT index_p, UINT subIndex_p, UINT32 * pP
 }
 
 
+//------------------------------------------------------------------------------
+/**
+\brief    Get a snapshot of all error handler objects
+
+The function copies all error handler objects from the host interface memory
+into the supplied buffer.
+
+\param  pErrorObjects_p     Pointer to store the error objects.
+
+\return Returns a tOplkError error code.
+
+\ingroup module_errhnducal
+*/
+//------------------------------------------------------------------------------
+tOplkError errhnducal_getErrorObjects(tErrHndObjects* pErrorObjects_p)
+{
+    if (pHostifMem_l == NULL)
+        return kErrorNoResource;
+
+    OPLK_MEMCPY((UINT8*)pErrorObjects_p, pHostifMem_l, sizeof(tErrHndObjects));
+    return kErrorOk;
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -224,6 +224,40 @@ tOplkError errhnducal_readErrorObject(UINT index_p, UINT subIndex_p, UINT32 *pPa
 }
 
 
+//------------------------------------------------------------------------------
+/**
+\brief    Get a snapshot of all error handler objects
+
+The function reads all error handler objects from the kernel layer into the
+supplied buffer. The objects are read one by one, therefore the copy is not
+guaranteed to be consistent.
+
+\param  pErrorObjects_p     Pointer to store the error objects.
+
+\return Returns a tOplkError error code.
+
+\ingroup module_errhnducal
+*/
+//------------------------------------------------------------------------------
+tOplkError errhnducal_getErrorObjects(tErrHndObjects* pErrorObjects_p)
+{
+    int             ret;
+    tErrHndIoctl    errObj;
+    UINT32*         pParam = (UINT32*)pErrorObjects_p;
+
+    for (errObj.offset = 0; errObj.offset < sizeof(tErrHndObjects);
+         errObj.offset += sizeof(UINT32))
+    {
+        errObj.errVal = 0;
+        ret = ioctl(instance_l.fd, PLK_CMD_ERRHND_READ, (ULONG)&errObj);
+        if (ret != 0)
+            return kErrorGeneralError;
+
+        *pParam++ = errObj.errVal;
+    }
+    return kErrorOk;
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
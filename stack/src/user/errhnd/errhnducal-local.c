@@ -189,6 +189,26 @@ tOplkError errhnducal_readErrorObject(UINT index_p, UINT subIndex_p,
 }
 
 
+//------------------------------------------------------------------------------
+/**
+\brief    Get a snapshot of all error handler objects
+
+The function copies all error handler objects of the kernel layer into the
+supplied buffer.
+
+\param  pErrorObjects_p     Pointer to store the error objects.
+
+\return Returns a tOplkError error code.
+
+\ingroup module_errhnducal
+*/
+//------------------------------------------------------------------------------
+tOplkError errhnducal_getErrorObjects(tErrHndObjects* pErrorObjects_p)
+{
+    OPLK_MEMCPY(pErrorObjects_p, &errhndk_errorObjects_g, sizeof(tErrHndObjects));
+    return kErrorOk;
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
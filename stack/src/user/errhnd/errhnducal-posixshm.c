@@ -43,11 +43,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <oplk/oplkinc.h>
 
 #include <common/errhnd.h>
-#include <unistd.h>
-#include <sys/mman.h>
-#include <sys/types.h>
-#include <fcntl.h>           /* For O_* constants */
-#include <sys/stat.h>
+#include <common/shmem.h>
+#include <user/eventu.h>
 
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
@@ -77,6 +74,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // const defines
 //------------------------------------------------------------------------------
 #define ERRHND_SHM_NAME         "/shmErrHnd"
+#define ERRHND_READ_RETRIES     1000        ///< Maximum number of attempts to take a consistent snapshot
 
 //------------------------------------------------------------------------------
 // local types
@@ -86,9 +84,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // local vars
 //------------------------------------------------------------------------------
 static tErrHndObjects           *pLocalObjects_l;       ///< pointer to user error objects
-static int                      fd_l;
-static BYTE*                    pErrHndMem_l;
-static BOOL                     fCreator_l;
+static tShmemRegion             shmRegion_l;            ///< shared memory region of the error handler
+static tErrHndShmRegion*        pErrHndShm_l;           ///< pointer to shared error handler memory
+static BYTE*                    pErrHndMem_l;           ///< pointer to shared error objects
 
 //------------------------------------------------------------------------------
 // local function prototypes
@@ -113,51 +111,24 @@ The function initializes the user layer CAL module of the error handler.
 //------------------------------------------------------------------------------
 tOplkError errhnducal_init (tErrHndObjects *pLocalObjects_p)
 {
-    struct stat             stat;
-
     pLocalObjects_l = pLocalObjects_p;
 
     if (pErrHndMem_l != NULL)
         return kErrorNoFreeInstance;
 
-    if ((fd_l = shm_open(ERRHND_SHM_NAME, O_RDWR | O_CREAT, 0)) < 0)
-    {
-        DEBUG_LVL_ERROR_TRACE("%s() shm_open failed!\n", __func__);
-        return kErrorNoResource;
-    }
-
-    if (fstat(fd_l, &stat) != 0)
-    {
-        close (fd_l);
-        return kErrorNoResource;
-    }
-
-    if (stat.st_size == 0)
-    {
-        if (ftruncate(fd_l, sizeof(tErrHndObjects)) == -1)
-        {
-            DEBUG_LVL_ERROR_TRACE("%s() ftruncate failed!\n", __func__);
-            close (fd_l);
-            shm_unlink(ERRHND_SHM_NAME);
-            return kErrorNoResource;
-        }
-        fCreator_l = TRUE;
-    }
-
-    pErrHndMem_l = mmap(NULL, sizeof(tErrHndObjects), PROT_READ | PROT_WRITE, MAP_SHARED, fd_l, 0);
-    if (pErrHndMem_l == MAP_FAILED)
+    if (shmem_map(ERRHND_SHM_NAME, sizeof(tErrHndShmRegion), kShmemModeOpen,
+                  &shmRegion_l) != kErrorOk)
     {
-        DEBUG_LVL_ERROR_TRACE("%s() mmap error handler objects failed!\n", __func__);
-        close (fd_l);
-        if (fCreator_l)
-            shm_unlink(ERRHND_SHM_NAME);
+        DEBUG_LVL_ERROR_TRACE("%s() mapping shared memory failed!\n", __func__);
         return kErrorNoResource;
     }
 
-    if (fCreator_l)
+    pErrHndShm_l = (tErrHndShmRegion*)shmRegion_l.pBase;
+    if (shmRegion_l.fCreator)
     {
-        OPLK_MEMSET(pErrHndMem_l, 0, sizeof(tErrHndObjects));
+        OPLK_MEMSET(pErrHndShm_l, 0, sizeof(tErrHndShmRegion));
     }
+    pErrHndMem_l = (BYTE*)&pErrHndShm_l->errorObjects;
     return kErrorOk;
 }
 
@@ -175,12 +146,11 @@ void errhnducal_exit (void)
 {
     if (pErrHndMem_l != NULL)
     {
-        munmap(pErrHndMem_l, sizeof(tErrHndObjects));
-        close(fd_l);
-        if (fCreator_l)
-            shm_unlink(ERRHND_SHM_NAME);
-        fd_l = 0;
-        pErrHndMem_l = 0;
+        shmem_unmap(&shmRegion_l);
+        if (shmRegion_l.fCreator)
+            shmem_unlink(ERRHND_SHM_NAME);
+        pErrHndShm_l = NULL;
+        pErrHndMem_l = NULL;
     }
 }
 
@@ -188,8 +158,10 @@ void errhnducal_exit (void)
 /**
 \brief    write an error handler object
 
-The function writes an error handler object to the shared memory region used
-by user and kernel modules.
+The function requests the write of an error handler object from the kernel
+layer. The shared memory region is only written by the kernel layer, so the
+value is passed by an event and becomes visible when the kernel layer has
+processed it.
 
 \param  index_p             Index of object in object dictionary
 \param  subIndex_p          Subindex of object
@@ -202,14 +174,21 @@ by user and kernel modules.
 //------------------------------------------------------------------------------
 tOplkError errhnducal_writeErrorObject(UINT index_p, UINT subIndex_p, UINT32 *pParam_p)
 {
-    UINT    offset;
+    tEvent                  event;
+    tErrHndObjectWrite      write;
 
     UNUSED_PARAMETER(index_p);
     UNUSED_PARAMETER(subIndex_p);
 
-    offset = (char *)pParam_p - (char *)pLocalObjects_l;
-    *(UINT32*)(pErrHndMem_l + offset) = *pParam_p;
-    return kErrorOk;
+    write.offset = (UINT32)((char *)pParam_p - (char *)pLocalObjects_l);
+    write.value = *pParam_p;
+
+    event.eventSink = kEventSinkErrk;
+    event.eventType = kEventTypeErrhndWrite;
+    OPLK_MEMSET(&event.netTime, 0x00, sizeof(event.netTime));
+    event.pEventArg = &write;
+    event.eventArgSize = sizeof(write);
+    return eventu_postEvent(&event);
 }
 
 //------------------------------------------------------------------------------
@@ -240,8 +219,53 @@ tOplkError errhnducal_readErrorObject(UINT index_p, UINT subIndex_p, UINT32* pPa
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief    Get a snapshot of all error handler objects
+
+The function copies all error handler objects from the shared memory region
+into the supplied buffer. The copy is consistent, i.e. it does not contain
+a partially applied update of the kernel layer. The kernel layer is never
+blocked by the function, if a write overlaps the copy, the copy is repeated.
+The number of attempts is limited, so a stuck kernel layer cannot block the
+caller.
+
+\param  pErrorObjects_p     Pointer to store the error objects.
+
+\return Returns a tOplkError error code.
+\retval kErrorOk            The snapshot was taken.
+\retval kErrorRetry         No consistent snapshot could be taken.
+
+\ingroup module_errhnducal
+*/
+//------------------------------------------------------------------------------
+tOplkError errhnducal_getErrorObjects(tErrHndObjects* pErrorObjects_p)
+{
+    UINT32  sequence;
+    UINT    retries;
+
+    if (pErrHndShm_l == NULL)
+        return kErrorNoResource;
+
+    for (retries = 0; retries < ERRHND_READ_RETRIES; retries++)
+    {
+        sequence = pErrHndShm_l->sequence;
+        if ((sequence & 1) != 0)
+            continue;           // write in progress
+
+        OPLK_MEMBAR();
+        OPLK_MEMCPY(pErrorObjects_p, &pErrHndShm_l->errorObjects,
+                    sizeof(tErrHndObjects));
+        OPLK_MEMBAR();
+
+        if (pErrHndShm_l->sequence == sequence)
+            return kErrorOk;
+    }
+
+    return kErrorRetry;
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
 
-
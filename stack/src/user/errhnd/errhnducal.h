@@ -64,6 +64,7 @@ tOplkError errhnducal_init (tErrHndObjects *pLocalObjects_p);
 void errhnducal_exit (void);
 tOplkError errhnducal_writeErrorObject(UINT index_p, UINT subIndex_p, UINT32 *pParam_p);
 tOplkError errhnducal_readErrorObject(UINT index_p, UINT subIndex_p, UINT32 *pParam_p);
+tOplkError errhnducal_getErrorObjects(tErrHndObjects* pErrorObjects_p);
 
 #ifdef __cplusplus
 }
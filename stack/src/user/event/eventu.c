@@ -51,6 +51,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <user/dllucal.h>
 #include <user/ledu.h>
 #include <oplk/benchmark.h>
+#include <oplk/tracering.h>
 #include <oplk/oplk.h>
 
 #include "common/event/event.h"
@@ -253,6 +254,8 @@ tOplkError eventu_postEvent (tEvent *pEvent_p)
 {
     tOplkError ret = kErrorOk;
 
+    TRACE_RING(kTraceIdEventPostUser, ((UINT32)pEvent_p->eventSink << 16) | pEvent_p->eventType);
+
     // split event post to user internal and user to kernel
     switch(pEvent_p->eventSink)
     {
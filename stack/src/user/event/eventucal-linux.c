@@ -64,7 +64,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
-#define USER_EVENT_THREAD_PRIORITY        45
+#define EVENT_THREAD_POLL_PERIOD_US     10000       ///< Poll period while waiting for the event thread
+#define EVENT_THREAD_STOP_TIMEOUT_US    1000000     ///< Time to wait for the event thread to terminate
 
 //------------------------------------------------------------------------------
 // module global vars
@@ -132,8 +133,6 @@ CAL module.
 //------------------------------------------------------------------------------
 tOplkError eventucal_init (void)
 {
-    struct sched_param  schedParam;
-
     OPLK_MEMSET(&instance_l, 0, sizeof(tEventuCalInstance));
 
     if ((instance_l.semUserData = sem_open("/semUserEvent", O_RDWR)) == SEM_FAILED)
@@ -159,12 +158,7 @@ tOplkError eventucal_init (void)
     if (pthread_create(&instance_l.threadId, NULL, eventThread, (void*)&instance_l) != 0)
         goto Exit;
 
-    schedParam.__sched_priority = USER_EVENT_THREAD_PRIORITY;
-    if (pthread_setschedparam(instance_l.threadId, SCHED_FIFO, &schedParam) != 0)
-    {
-        DEBUG_LVL_ERROR_TRACE("%s(): couldn't set thread scheduling parameters! %d\n",
-               __func__, schedParam.__sched_priority);
-    }
+    target_setupThread(instance_l.threadId, kOplkThreadEventUser);
     instance_l.fInitialized = TRUE;
     return kErrorOk;
 
@@ -198,19 +192,23 @@ functions of the queue implementations for each used queue.
 //------------------------------------------------------------------------------
 tOplkError eventucal_exit (void)
 {
-    UINT            i = 0;
+    ULONGLONG       deadline;
+    ULONGLONG       timeout;
 
     if (instance_l.fInitialized == TRUE)
     {
         instance_l.fStopThread = TRUE;
+        deadline = target_getTickCountUs();
+        timeout = deadline + EVENT_THREAD_STOP_TIMEOUT_US;
         while (instance_l.fStopThread == TRUE)
         {
-            target_msleep(10);
-            if (i++ > 100)
+            if (deadline >= timeout)
             {
                 TRACE("Event Thread is not terminating, continue shutdown...!\n");
                 break;
             }
+            deadline += EVENT_THREAD_POLL_PERIOD_US;
+            target_sleepUntil(deadline);
         }
 
         eventucal_exitQueueCircbuf(kEventQueueK2U);
@@ -319,6 +317,8 @@ static void* eventThread(void *arg)
     struct timespec         curTime, timeout;
     tEventuCalInstance*     pInstance = (tEventuCalInstance*)arg;
 
+    target_prefaultThreadStack();
+
     while (!pInstance->fStopThread)
     {
         clock_gettime(CLOCK_REALTIME, &curTime);
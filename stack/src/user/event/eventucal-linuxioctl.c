@@ -65,8 +65,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#define EVENT_THREAD_POLL_PERIOD_US     10000       ///< Poll period while waiting for the event thread
+#define EVENT_THREAD_STOP_TIMEOUT_US    10000000    ///< Time to wait for the event thread to terminate
 
-#define USER_EVENT_THREAD_PRIORITY      20
 
 //------------------------------------------------------------------------------
 // module global vars
@@ -134,7 +135,6 @@ implementations and calls the appropriate init functions.
 tOplkError eventucal_init(void)
 {
     tOplkError          ret = kErrorOk;
-    struct sched_param  schedParam;
 
     OPLK_MEMSET(&instance_l, 0, sizeof(tEventuCalInstance));
 
@@ -146,12 +146,7 @@ tOplkError eventucal_init(void)
     {
         goto Exit;
     }
-    schedParam.__sched_priority = USER_EVENT_THREAD_PRIORITY;
-    if (pthread_setschedparam(instance_l.threadId, SCHED_FIFO, &schedParam) != 0)
-    {
-        DEBUG_LVL_ERROR_TRACE("%s(): couldn't set thread scheduling parameters! %d\n",
-               __func__, schedParam.__sched_priority);
-    }
+    target_setupThread(instance_l.threadId, kOplkThreadEventUser);
 
 Exit:
     return ret;
@@ -173,17 +168,21 @@ functions of the queue implementations for each used queue.
 //------------------------------------------------------------------------------
 tOplkError eventucal_exit (void)
 {
-    UINT            i = 0;
+    ULONGLONG       deadline;
+    ULONGLONG       timeout;
 
     instance_l.fStopThread = TRUE;
+    deadline = target_getTickCountUs();
+    timeout = deadline + EVENT_THREAD_STOP_TIMEOUT_US;
     while (instance_l.fStopThread == TRUE)
     {
-        target_msleep(10);
-        if (i++ > 1000)
+        if (deadline >= timeout)
         {
             TRACE("Event Thread is not terminating, continue shutdown...!\n");
             break;
         }
+        deadline += EVENT_THREAD_POLL_PERIOD_US;
+        target_sleepUntil(deadline);
     }
 
     return kErrorOk;
@@ -300,6 +299,8 @@ static void *eventThread (void * arg_p)
 
     UNUSED_PARAMETER(arg_p);
 
+    target_prefaultThreadStack();
+
     pEvent = (tEvent*)eventBuf;
 
     while (!instance_l.fStopThread)
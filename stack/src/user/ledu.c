@@ -92,6 +92,7 @@ typedef enum
     kLeduModeSingleFlash    = 0x05,
     kLeduModeDoubleFlash    = 0x06,
     kLeduModeTripleFlash    = 0x07,
+    kLeduModeCount
 } tLeduMode;
 
 /**
@@ -105,12 +106,8 @@ typedef struct
     UINT32                      timerArg;               ///< Argument for timer
     tLeduStateChangeCallback    pfnCbStateChange;       ///< Function pointer to state change function.
     tLeduMode                   statusLedMode;          ///< Mode of the status LED
-    /**
-     *  0 - long off (e.g. 50 ms while flickering, 200 ms while blinking and 1000 ms while flashing)
-     *  1 - on (odd number)
-     *  2 - short off (even number)
-     */
-    UINT                        statusLedState;         ///< State of the status LED
+    UINT                        statusLedPhase;         ///< Current phase of the status LED pattern
+    UINT                        statusLedPhaseCount;    ///< Phase count of the pattern the current phase belongs to
 } tLeduInstance;
 
 
@@ -119,11 +116,35 @@ typedef struct
 //------------------------------------------------------------------------------
 static tLeduInstance   leduInstance_g;
 
+/**
+ * \brief   LED patterns
+ *
+ * The table contains the output pattern of each LED mode.
+ */
+static const tLeduPattern   aLeduPattern_l[kLeduModeCount] =
+{
+    { 0, { 0 } },                                                                   // kLeduModeInit
+    { 0, { 0 } },                                                                   // kLeduModeOff
+    { 1, { 0 } },                                                                   // kLeduModeOn
+    { 2, { LEDU_DURATION_FLICKERING, LEDU_DURATION_FLICKERING } },                  // kLeduModeFlickering
+    { 2, { LEDU_DURATION_BLINKING, LEDU_DURATION_BLINKING } },                      // kLeduModeBlinking
+    { 2, { LEDU_DURATION_FLASH_ON, LEDU_DURATION_FLASH_OFF } },                     // kLeduModeSingleFlash
+    { 4, { LEDU_DURATION_FLASH_ON, LEDU_DURATION_FLASH_ON,
+           LEDU_DURATION_FLASH_ON, LEDU_DURATION_FLASH_OFF } },                     // kLeduModeDoubleFlash
+    { 6, { LEDU_DURATION_FLASH_ON, LEDU_DURATION_FLASH_ON,
+           LEDU_DURATION_FLASH_ON, LEDU_DURATION_FLASH_ON,
+           LEDU_DURATION_FLASH_ON, LEDU_DURATION_FLASH_OFF } },                     // kLeduModeTripleFlash
+};
+
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
-static tOplkError callStateChanged(tLedType LedType_p, BOOL fOn_p);
 static tOplkError changeMode(tLeduMode NewMode_p);
+static tOplkError setErrorLed(BOOL fOn_p);
+#if (CONFIG_LEDU_OUTPUT_TASK == FALSE)
+static tOplkError callStateChanged(tLedType LedType_p, BOOL fOn_p);
+static tOplkError startPhase(UINT phase_p);
+#endif
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -133,7 +154,8 @@ static tOplkError changeMode(tLeduMode NewMode_p);
 /**
 \brief  Initialize user LED module
 
-The function initializes the user LED module.
+The function initializes the user LED module. If CONFIG_LEDU_OUTPUT_TASK is
+enabled, the LED output thread is started.
 
 \param  pfnCbStateChange_p      Pointer to callback function for LED state
                                 changes.
@@ -148,7 +170,11 @@ tOplkError ledu_init(tLeduStateChangeCallback pfnCbStateChange_p)
     OPLK_MEMSET(&leduInstance_g, 0, sizeof(tLeduInstance));
     leduInstance_g.pfnCbStateChange = pfnCbStateChange_p;
 
+#if (CONFIG_LEDU_OUTPUT_TASK != FALSE)
+    return ledu_initOutputTask(pfnCbStateChange_p);
+#else
     return kErrorOk;
+#endif
 }
 
 //------------------------------------------------------------------------------
@@ -166,7 +192,11 @@ tOplkError ledu_exit(void)
 {
     tOplkError ret = kErrorOk;
 
+#if (CONFIG_LEDU_OUTPUT_TASK != FALSE)
+    ledu_exitOutputTask();
+#else
     ret = timeru_deleteTimer(&leduInstance_g.timerHdlLedBlink);
+#endif
     OPLK_MEMSET(&leduInstance_g, 0, sizeof(tLeduInstance));
 
     return ret;
@@ -201,12 +231,7 @@ tOplkError ledu_cbNmtStateChange(tEventNmtStateChange nmtStateChange_p)
         case kNmtGsResetConfiguration:
         case kNmtCsNotActive:
         case kNmtMsNotActive:
-            if (leduInstance_g.statusLedMode != kLeduModeOff)
-            {   // state changed
-                leduInstance_g.statusLedMode = kLeduModeOff;
-                ret = timeru_deleteTimer(&leduInstance_g.timerHdlLedBlink);
-                ret = callStateChanged(kLedTypeStatus, FALSE);
-            }
+            ret = changeMode(kLeduModeOff);
             break;
 
         // status LED single flashing
@@ -230,12 +255,7 @@ tOplkError ledu_cbNmtStateChange(tEventNmtStateChange nmtStateChange_p)
         // status LED on
         case kNmtCsOperational:
         case kNmtMsOperational:
-            if (leduInstance_g.statusLedMode != kLeduModeOn)
-            {   // state changed
-                leduInstance_g.statusLedMode = kLeduModeOn;
-                ret = timeru_deleteTimer(&leduInstance_g.timerHdlLedBlink);
-                ret = callStateChanged(kLedTypeStatus, TRUE);
-            }
+            ret = changeMode(kLeduModeOn);
             break;
 
         // status LED blinking
@@ -258,13 +278,13 @@ tOplkError ledu_cbNmtStateChange(tEventNmtStateChange nmtStateChange_p)
         case kNmtEventStartNode:             // NMT_CT7
         case kNmtEventTimerBasicEthernet:    // NMT_CT3
         case kNmtEventEnterMsOperational:    // NMT_MT5
-            ret = callStateChanged(kLedTypeError, FALSE);
+            ret = setErrorLed(FALSE);
             break;
 
         // error LED on
         case kNmtEventNmtCycleError:     // NMT_CT11, NMT_MT6
         case kNmtEventInternComError:    // NMT_GT6
-            ret = callStateChanged(kLedTypeError, TRUE);
+            ret = setErrorLed(TRUE);
             break;
 
         default:
@@ -279,7 +299,11 @@ tOplkError ledu_cbNmtStateChange(tEventNmtStateChange nmtStateChange_p)
 /**
 \brief  Process events
 
-The function implements the event handler of the LED module.
+The function implements the event handler of the LED module. If
+CONFIG_LEDU_OUTPUT_TASK is enabled, the LED patterns are rendered by the LED
+output thread and no timer events are used. Instead, the output thread posts
+its LED state changes as events, so the state change callback is always
+called on the user event thread.
 
 \param  pEvent_p        Event to process.
 
@@ -290,16 +314,17 @@ The function implements the event handler of the LED module.
 //------------------------------------------------------------------------------
 tOplkError ledu_processEvent(tEvent* pEvent_p)
 {
-    tOplkError          ret;
-    tTimerArg           timerArg;
-    UINT32              timeout = 0;
-    BOOL                fLedOn = FALSE;
-    tTimerEventArg   *  pTimerEventArg;
-
-    ret = kErrorOk;
-
-    switch(pEvent_p->eventType)
+    tOplkError          ret = kErrorOk;
+#if (CONFIG_LEDU_OUTPUT_TASK == FALSE)
+    tTimerEventArg*     pTimerEventArg;
+    const tLeduPattern* pPattern;
+#else
+    tLeduOutputEvent*   pOutputEvent;
+#endif
+
+    switch (pEvent_p->eventType)
     {
+#if (CONFIG_LEDU_OUTPUT_TASK == FALSE)
         // timer event
         case kEventTypeTimer:
             pTimerEventArg = (tTimerEventArg*)pEvent_p->pEventArg;
@@ -309,111 +334,68 @@ tOplkError ledu_processEvent(tEvent* pEvent_p)
                 break;
             }
 
-            leduInstance_g.statusLedState++;
+            pPattern = &aLeduPattern_l[leduInstance_g.statusLedMode];
+            if (pPattern->phaseCount < 2)
+                break;      // should not occur
 
-            // select timeout and new LED state corresponding to mode
-            switch (leduInstance_g.statusLedMode)
+            ret = startPhase(ledu_getNextPhase(pPattern,
+                                               leduInstance_g.statusLedPhase,
+                                               leduInstance_g.statusLedPhaseCount));
+            break;
+#else
+        // LED state change of the output thread
+        case kEventTypeLeduOutput:
+            if (pEvent_p->eventArgSize != sizeof(tLeduOutputEvent))
             {
-                case kLeduModeInit:
-                case kLeduModeOn:
-                case kLeduModeOff:
-                    goto Exit;      // should not occur
-                    break;
-
-                case kLeduModeFlickering:
-                    if (leduInstance_g.statusLedState >= 2)
-                    {   // reset state
-                        leduInstance_g.statusLedState = 0;
-                        fLedOn = FALSE;
-                    }
-                    else
-                    {
-                        fLedOn = TRUE;
-                    }
-                    timeout = LEDU_DURATION_FLICKERING;
-                    break;
-
-                case kLeduModeBlinking:
-                    if (leduInstance_g.statusLedState >= 2)
-                    {   // reset state
-                        leduInstance_g.statusLedState = 0;
-                        fLedOn = FALSE;
-                    }
-                    else
-                    {
-                        fLedOn = TRUE;
-                    }
-                    timeout = LEDU_DURATION_BLINKING;
-
-                    break;
-
-                case kLeduModeSingleFlash:
-                    if (leduInstance_g.statusLedState >= 2)
-                    {   // reset state
-                        leduInstance_g.statusLedState = 0;
-                        timeout = LEDU_DURATION_FLASH_OFF;
-                        fLedOn = FALSE;
-                    }
-                    else
-                    {
-                        timeout = LEDU_DURATION_FLASH_ON;
-                        fLedOn = ((leduInstance_g.statusLedState & 0x01) != 0x00)
-                            ? TRUE : FALSE;
-                    }
-                    break;
-
-                case kLeduModeDoubleFlash:
-                    if (leduInstance_g.statusLedState >= 4)
-                    {   // reset state
-                        leduInstance_g.statusLedState = 0;
-                        timeout = LEDU_DURATION_FLASH_OFF;
-                        fLedOn = FALSE;
-                    }
-                    else
-                    {
-                        timeout = LEDU_DURATION_FLASH_ON;
-                        fLedOn = ((leduInstance_g.statusLedState & 0x01) != 0x00)
-                            ? TRUE : FALSE;
-                    }
-                    break;
-
-                case kLeduModeTripleFlash:
-                    if (leduInstance_g.statusLedState >= 6)
-                    {   // reset state
-                        leduInstance_g.statusLedState = 0;
-                        timeout = LEDU_DURATION_FLASH_OFF;
-                        fLedOn = FALSE;
-                    }
-                    else
-                    {
-                        timeout = LEDU_DURATION_FLASH_ON;
-                        fLedOn = ((leduInstance_g.statusLedState & 0x01) != 0x00)
-                            ? TRUE : FALSE;
-                    }
-                    break;
-
+                ret = kErrorEventWrongSize;
+                break;
             }
 
-            // create new timer
-            timerArg.eventSink = kEventSinkLedu;
-            leduInstance_g.timerArg++;
-            timerArg.argument.value = leduInstance_g.timerArg;
-            ret = timeru_modifyTimer(&leduInstance_g.timerHdlLedBlink, timeout, timerArg);
-
-            // call callback function
-            ret = callStateChanged(kLedTypeStatus, fLedOn);
-
+            pOutputEvent = (tLeduOutputEvent*)pEvent_p->pEventArg;
+            if (leduInstance_g.pfnCbStateChange != NULL)
+                ret = leduInstance_g.pfnCbStateChange(pOutputEvent->ledType, pOutputEvent->fOn);
             break;
+#endif
 
         default:
             ret = kErrorNmtInvalidEvent;
-
+            break;
     }
 
-Exit:
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get next phase of an LED pattern
+
+The function determines the phase which follows the current phase. The current
+phase may belong to a different pattern if the LED mode was changed while a
+pattern was running. A finished pattern continues with the first phase of the
+new pattern. Otherwise the next phase is used as long as it is a short phase
+of the new pattern, else the final off phase of the new pattern follows.
+
+\param  pPattern_p          Pattern the next phase is taken from.
+\param  phase_p             Current phase.
+\param  phaseCount_p        Phase count of the pattern the current phase
+                            belongs to.
+
+\return The function returns the next phase.
+
+\ingroup module_ledu
+*/
+//------------------------------------------------------------------------------
+UINT ledu_getNextPhase(const tLeduPattern* pPattern_p, UINT phase_p, UINT phaseCount_p)
+{
+    if ((phase_p + 1) >= phaseCount_p)
+        return 0;
+
+    if ((phase_p + 2) >= pPattern_p->phaseCount)
+        return pPattern_p->phaseCount - 1;
+
+    return phase_p + 1;
+}
+
 
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
@@ -421,6 +403,7 @@ Exit:
 /// \name Private Functions
 /// \{
 
+#if (CONFIG_LEDU_OUTPUT_TASK == FALSE)
 //------------------------------------------------------------------------------
 /**
 \brief  Call state changed function
@@ -443,12 +426,15 @@ static tOplkError callStateChanged(tLedType ledType_p, BOOL fOn_p)
     }
     return ret;
 }
+#endif
 
 //------------------------------------------------------------------------------
 /**
 \brief  Change the LED mode
 
-The function changes the LED mode.
+The function changes the mode of the status LED. A pattern coming from a
+steady LED starts with the phase that toggles the LED. A pattern following
+another pattern continues with its next phase.
 
 \param  newMode_p           The new mode to set.
 
@@ -457,74 +443,111 @@ The function changes the LED mode.
 //------------------------------------------------------------------------------
 static tOplkError changeMode(tLeduMode newMode_p)
 {
-    tOplkError      ret;
-    tLeduMode       oldMode;
-    tTimerArg       timerArg;
-    UINT32          timeout;
-    BOOL            fLedOn;
-
-    ret = kErrorOk;
+    tLeduMode           oldMode;
+    const tLeduPattern* pPattern;
+    UINT                phase;
 
     oldMode = leduInstance_g.statusLedMode;
+    if (oldMode == newMode_p)
+        return kErrorOk;
 
-    if (oldMode != newMode_p)
-    {   // state changed -> save new mode
-        leduInstance_g.statusLedMode = newMode_p;
-
-        // Where are we coming from?
-        if (oldMode == kLeduModeOff)
-        {   // status LED was off -> switch LED on
-            fLedOn = TRUE;
-            leduInstance_g.statusLedState = 0xFF;
-        }
-        else if (oldMode == kLeduModeOn)
-        {   // status LED was on -> switch LED off
-            fLedOn = FALSE;
-            leduInstance_g.statusLedState = 0;
-        }
-        else
-        {   // timer should be up and running
-            return ret;
-        }
-
-        // select timeout corresponding to mode
-        switch (newMode_p)
-        {
-            case kLeduModeFlickering:
-                timeout = LEDU_DURATION_FLICKERING;
-                break;
-
-            case kLeduModeBlinking:
-                timeout = LEDU_DURATION_BLINKING;
-                break;
+    leduInstance_g.statusLedMode = newMode_p;
+    pPattern = &aLeduPattern_l[newMode_p];
 
-            case kLeduModeSingleFlash:
-            case kLeduModeDoubleFlash:
-            case kLeduModeTripleFlash:
-                if (fLedOn == FALSE)
-                    timeout = LEDU_DURATION_FLASH_OFF;
-                else
-                    timeout = LEDU_DURATION_FLASH_ON;
-                break;
+    if (pPattern->phaseCount < 2)
+    {   // steady LED
+        phase = 0;
+    }
+    else if (aLeduPattern_l[oldMode].phaseCount == 1)
+    {   // status LED was on -> start with the final off phase
+        phase = pPattern->phaseCount - 1;
+    }
+    else if (aLeduPattern_l[oldMode].phaseCount == 0)
+    {   // status LED was off -> start with the final on phase
+        phase = pPattern->phaseCount - 2;
+    }
+    else
+    {   // pattern was running -> continue with its next phase
+        phase = LEDU_PHASE_CONTINUE;
+    }
 
-            default:
-                return ret;      // should not occur
-                break;
-        }
-
-        // create new timer
-        timerArg.eventSink = kEventSinkLedu;
-        leduInstance_g.timerArg++;
-        timerArg.argument.value = leduInstance_g.timerArg;
-        ret = timeru_modifyTimer(&leduInstance_g.timerHdlLedBlink,
-                                     timeout,
-                                     timerArg);
-
-        // call callback function
-        ret = callStateChanged(kLedTypeStatus, fLedOn);
+#if (CONFIG_LEDU_OUTPUT_TASK != FALSE)
+    ledu_setOutput(kLedTypeStatus, pPattern, phase);
+    return kErrorOk;
+#else
+    if (pPattern->phaseCount < 2)
+    {
+        timeru_deleteTimer(&leduInstance_g.timerHdlLedBlink);
+        leduInstance_g.statusLedPhase = 0;
+        leduInstance_g.statusLedPhaseCount = pPattern->phaseCount;
+        return callStateChanged(kLedTypeStatus, (pPattern->phaseCount != 0) ? TRUE : FALSE);
     }
+
+    if (phase == LEDU_PHASE_CONTINUE)
+        return kErrorOk;    // the running timer switches to the new pattern
+
+    return startPhase(phase);
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set the error LED
+
+The function switches the error LED on or off.
+
+\param  fOn_p               The new state of the error LED.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError setErrorLed(BOOL fOn_p)
+{
+#if (CONFIG_LEDU_OUTPUT_TASK != FALSE)
+    ledu_setOutput(kLedTypeError,
+                   &aLeduPattern_l[fOn_p ? kLeduModeOn : kLeduModeOff],
+                   0);
+    return kErrorOk;
+#else
+    return callStateChanged(kLedTypeError, fOn_p);
+#endif
+}
+
+#if (CONFIG_LEDU_OUTPUT_TASK == FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Start a phase of the status LED pattern
+
+The function sets the status LED according to the specified phase of the
+current pattern and starts the timer for the end of the phase.
+
+\param  phase_p             Phase of the pattern to start.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError startPhase(UINT phase_p)
+{
+    tOplkError          ret;
+    tTimerArg           timerArg;
+    const tLeduPattern* pPattern = &aLeduPattern_l[leduInstance_g.statusLedMode];
+
+    leduInstance_g.statusLedPhase = phase_p;
+    leduInstance_g.statusLedPhaseCount = pPattern->phaseCount;
+
+    // create new timer
+    timerArg.eventSink = kEventSinkLedu;
+    leduInstance_g.timerArg++;
+    timerArg.argument.value = leduInstance_g.timerArg;
+    ret = timeru_modifyTimer(&leduInstance_g.timerHdlLedBlink,
+                             pPattern->aDuration[phase_p],
+                             timerArg);
+
+    // call callback function, even phases switch the LED on
+    ret = callStateChanged(kLedTypeStatus, ((phase_p & 0x01) == 0) ? TRUE : FALSE);
+
     return ret;
 }
+#endif
 
 ///\}
-
@@ -0,0 +1,599 @@
+/**
+********************************************************************************
+\file   ledutask-linux.c
+
+\brief  LED output thread of the user LED module for Linux userspace
+
+This file implements the LED output thread of the user LED module on Linux
+userspace. If CONFIG_LEDU_OUTPUT_TASK is enabled, the LED module only
+publishes the pattern of each LED when its mode changes. The output thread
+renders the patterns, coalesces requests which arrive faster than they can be
+shown and limits the rate of the output writes. An LED is either written to
+its brightness file in /sys/class/leds by this non real-time thread, or its
+state changes are posted as events to the LED module. The LED module reports
+them to the application via the LED state change callback on the user event
+thread, so the application receives all API events on one thread.
+
+\ingroup module_ledu
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2014, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <oplk/oplkinc.h>
+#include <user/ledu.h>
+#include <user/eventu.h>
+
+#if (CONFIG_LEDU_OUTPUT_TASK != FALSE)
+
+#include <pthread.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <common/target.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define LEDU_OUTPUT_COUNT           2                   // status and error LED
+#define LEDU_SYSFS_LED_DIR          "/sys/class/leds/"
+#define LEDU_WAIT_FOREVER           0xFFFFFFFFFFFFFFFFULL
+#define LEDU_OUTPUT_UNKNOWN         -1
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief LED output request
+
+The structure contains the latest pattern published for an LED. It is
+protected by the mutex of the output thread.
+*/
+typedef struct
+{
+    const tLeduPattern*     pPattern;               ///< Requested pattern, NULL if nothing was requested yet
+    UINT                    startPhase;             ///< Phase the pattern starts with
+    UINT                    requestCount;           ///< Incremented with every request
+} tLeduOutputRequest;
+
+/**
+\brief LED output state
+
+The structure contains the rendering state of an LED. It is only accessed
+by the output thread, except for the request count which is protected by the
+mutex.
+*/
+typedef struct
+{
+    const tLeduPattern*     pPattern;               ///< Pattern which is currently rendered
+    UINT                    phase;                  ///< Current phase of the pattern
+    UINT                    phaseCount;             ///< Phase count of the pattern the current phase belongs to
+    ULONGLONG               phaseEndUs;             ///< End time of the current phase [us]
+    UINT                    requestCount;           ///< Request count of the last handled request
+    INT                     output;                 ///< Last written LED state, LEDU_OUTPUT_UNKNOWN if not written yet
+    ULONGLONG               lastWriteUs;            ///< Time of the last write [us]
+    int                     fd;                     ///< Brightness file of the sysfs LED, -1 if the callback is used
+    UINT                    maxBrightness;          ///< Maximum brightness of the sysfs LED
+} tLeduOutputState;
+
+/**
+\brief LED output thread instance
+
+The structure contains all information needed by the LED output thread.
+*/
+typedef struct
+{
+    pthread_t                   threadId;                       ///< Thread ID of the output thread
+    pthread_mutex_t             mutex;                          ///< Protects the requests
+    pthread_cond_t              condRequest;                    ///< Signals a new request to the output thread
+    BOOL                        fStopThread;                    ///< Flag requests the termination of the thread
+    tLeduOutputRequest          aRequest[LEDU_OUTPUT_COUNT];    ///< Requests of the LEDs
+    tLeduOutputState            aState[LEDU_OUTPUT_COUNT];      ///< Rendering state of the LEDs
+    tLeduStateChangeCallback    pfnCbStateChange;               ///< LED state change callback
+    BOOL                        fInitialized;                   ///< Output thread is initialized
+} tLeduOutputInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tLeduOutputInstance  instance_l;
+
+static const char* const    apSysfsLedName_l[LEDU_OUTPUT_COUNT] =
+{
+    CONFIG_LEDU_SYSFS_STATUS_LED,                   // kLedTypeStatus
+    CONFIG_LEDU_SYSFS_ERROR_LED,                    // kLedTypeError
+};
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void*      outputThread(void* arg_p);
+static tOplkError openSysfsLed(tLeduOutputState* pState_p, const char* pName_p);
+static void       applyRequest(tLeduOutputState* pState_p,
+                               const tLeduOutputRequest* pRequest_p,
+                               ULONGLONG now_p);
+static INT        renderPattern(tLeduOutputState* pState_p,
+                                ULONGLONG now_p,
+                                ULONGLONG* pWakeUs_p);
+static void       writeOutput(tLedType ledType_p, tLeduOutputState* pState_p, INT output_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize LED output thread
+
+The function opens the configured sysfs LEDs and creates the LED output
+thread.
+
+\param  pfnCbStateChange_p      Pointer to callback function for LED state
+                                changes. It is used for all LEDs which are not
+                                assigned to a sysfs LED.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_ledu
+*/
+//------------------------------------------------------------------------------
+tOplkError ledu_initOutputTask(tLeduStateChangeCallback pfnCbStateChange_p)
+{
+    tOplkError          ret = kErrorOk;
+    pthread_condattr_t  condAttr;
+    UINT                i;
+
+    OPLK_MEMSET(&instance_l, 0, sizeof(instance_l));
+    instance_l.pfnCbStateChange = pfnCbStateChange_p;
+
+    for (i = 0; i < LEDU_OUTPUT_COUNT; i++)
+    {
+        instance_l.aState[i].output = LEDU_OUTPUT_UNKNOWN;
+        instance_l.aState[i].fd = -1;
+    }
+
+    for (i = 0; i < LEDU_OUTPUT_COUNT; i++)
+    {
+        ret = openSysfsLed(&instance_l.aState[i], apSysfsLedName_l[i]);
+        if (ret != kErrorOk)
+            goto ExitCloseFiles;
+    }
+
+    if (pthread_mutex_init(&instance_l.mutex, NULL) != 0)
+    {
+        ret = kErrorNoResource;
+        goto ExitCloseFiles;
+    }
+
+    pthread_condattr_init(&condAttr);
+    pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+    if (pthread_cond_init(&instance_l.condRequest, &condAttr) != 0)
+    {
+        pthread_condattr_destroy(&condAttr);
+        ret = kErrorNoResource;
+        goto ExitDestroyMutex;
+    }
+    pthread_condattr_destroy(&condAttr);
+
+    if (pthread_create(&instance_l.threadId, NULL, outputThread, &instance_l) != 0)
+    {
+        ret = kErrorNoResource;
+        goto ExitDestroyCond;
+    }
+
+    target_setupThread(instance_l.threadId, kOplkThreadLedOutput);
+
+    instance_l.fInitialized = TRUE;
+    return kErrorOk;
+
+ExitDestroyCond:
+    pthread_cond_destroy(&instance_l.condRequest);
+ExitDestroyMutex:
+    pthread_mutex_destroy(&instance_l.mutex);
+ExitCloseFiles:
+    for (i = 0; i < LEDU_OUTPUT_COUNT; i++)
+    {
+        if (instance_l.aState[i].fd >= 0)
+            close(instance_l.aState[i].fd);
+    }
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Shut down LED output thread
+
+The function terminates the LED output thread and closes the sysfs LEDs.
+
+\ingroup module_ledu
+*/
+//------------------------------------------------------------------------------
+void ledu_exitOutputTask(void)
+{
+    UINT    i;
+
+    if (!instance_l.fInitialized)
+        return;
+
+    pthread_mutex_lock(&instance_l.mutex);
+    instance_l.fStopThread = TRUE;
+    pthread_cond_signal(&instance_l.condRequest);
+    pthread_mutex_unlock(&instance_l.mutex);
+    pthread_join(instance_l.threadId, NULL);
+
+    pthread_cond_destroy(&instance_l.condRequest);
+    pthread_mutex_destroy(&instance_l.mutex);
+
+    for (i = 0; i < LEDU_OUTPUT_COUNT; i++)
+    {
+        if (instance_l.aState[i].fd >= 0)
+            close(instance_l.aState[i].fd);
+    }
+
+    instance_l.fInitialized = FALSE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Publish LED pattern
+
+The function publishes a new pattern for the specified LED to the output
+thread. It only stores the request and never waits for the output. If several
+requests arrive before the output thread handles them, only the latest one is
+rendered.
+
+\param  ledType_p           The type of LED.
+\param  pPattern_p          Pattern which shall be rendered.
+\param  startPhase_p        Phase the pattern starts with. LEDU_PHASE_CONTINUE
+                            finishes the current phase of a running pattern
+                            and continues with the next phase of the new one.
+
+\ingroup module_ledu
+*/
+//------------------------------------------------------------------------------
+void ledu_setOutput(tLedType ledType_p, const tLeduPattern* pPattern_p, UINT startPhase_p)
+{
+    tLeduOutputRequest* pRequest;
+
+    if (!instance_l.fInitialized || ((UINT)ledType_p >= LEDU_OUTPUT_COUNT))
+        return;
+
+    pRequest = &instance_l.aRequest[ledType_p];
+
+    pthread_mutex_lock(&instance_l.mutex);
+    pRequest->pPattern = pPattern_p;
+    // a continuing pattern keeps the start phase of a pending request
+    if ((startPhase_p != LEDU_PHASE_CONTINUE) ||
+        (pRequest->requestCount == instance_l.aState[ledType_p].requestCount))
+        pRequest->startPhase = startPhase_p;
+    pRequest->requestCount++;
+    pthread_cond_signal(&instance_l.condRequest);
+    pthread_mutex_unlock(&instance_l.mutex);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  LED output thread function
+
+This function contains the main function of the LED output thread. It takes
+over the latest requests, renders the patterns and sleeps until the next
+phase ends or a new request arrives. The outputs are written without holding
+the mutex, so a slow output never delays the publisher.
+
+\param  arg_p               Pointer to output thread instance.
+
+\return The function returns the thread exit code.
+*/
+//------------------------------------------------------------------------------
+static void* outputThread(void* arg_p)
+{
+    tLeduOutputInstance*    pInstance = (tLeduOutputInstance*)arg_p;
+    tLeduOutputState*       pState;
+    ULONGLONG               now;
+    ULONGLONG               wakeUs;
+    ULONGLONG               minIntervalUs = (ULONGLONG)CONFIG_LEDU_OUTPUT_MIN_INTERVAL_MS * 1000ULL;
+    INT                     aOutput[LEDU_OUTPUT_COUNT];
+    struct timespec         wakeTime;
+    BOOL                    fNewRequest;
+    UINT                    i;
+
+    pthread_mutex_lock(&pInstance->mutex);
+    while (!pInstance->fStopThread)
+    {
+        now = target_getTickCountUs();
+        wakeUs = LEDU_WAIT_FOREVER;
+
+        for (i = 0; i < LEDU_OUTPUT_COUNT; i++)
+        {
+            pState = &pInstance->aState[i];
+            if (pInstance->aRequest[i].requestCount != pState->requestCount)
+                applyRequest(pState, &pInstance->aRequest[i], now);
+
+            aOutput[i] = renderPattern(pState, now, &wakeUs);
+        }
+        pthread_mutex_unlock(&pInstance->mutex);
+
+        for (i = 0; i < LEDU_OUTPUT_COUNT; i++)
+        {
+            pState = &pInstance->aState[i];
+            if ((aOutput[i] == LEDU_OUTPUT_UNKNOWN) || (aOutput[i] == pState->output))
+                continue;
+
+            if ((pState->output != LEDU_OUTPUT_UNKNOWN) &&
+                ((now - pState->lastWriteUs) < minIntervalUs))
+            {   // rate limit reached -> write the state when the interval has elapsed
+                if ((pState->lastWriteUs + minIntervalUs) < wakeUs)
+                    wakeUs = pState->lastWriteUs + minIntervalUs;
+                continue;
+            }
+
+            writeOutput((tLedType)i, pState, aOutput[i]);
+            pState->lastWriteUs = now;
+        }
+
+        pthread_mutex_lock(&pInstance->mutex);
+
+        // a request published during the output is handled immediately
+        fNewRequest = FALSE;
+        for (i = 0; i < LEDU_OUTPUT_COUNT; i++)
+        {
+            if (pInstance->aRequest[i].requestCount != pInstance->aState[i].requestCount)
+                fNewRequest = TRUE;
+        }
+
+        if (fNewRequest || pInstance->fStopThread)
+            continue;
+
+        if (wakeUs == LEDU_WAIT_FOREVER)
+        {
+            pthread_cond_wait(&pInstance->condRequest, &pInstance->mutex);
+        }
+        else
+        {
+            wakeTime.tv_sec = (time_t)(wakeUs / 1000000ULL);
+            wakeTime.tv_nsec = (long)((wakeUs % 1000000ULL) * 1000ULL);
+            pthread_cond_timedwait(&pInstance->condRequest, &pInstance->mutex, &wakeTime);
+        }
+    }
+    pthread_mutex_unlock(&pInstance->mutex);
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Open sysfs LED
+
+The function opens the brightness file of the specified LED in
+/sys/class/leds and reads its maximum brightness.
+
+\param  pState_p            Output state of the LED.
+\param  pName_p             Name of the LED, an empty name selects the callback.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError openSysfsLed(tLeduOutputState* pState_p, const char* pName_p)
+{
+    char        aPath[128];
+    char        aValue[16];
+    int         fd;
+    ssize_t     len;
+
+    if (pName_p[0] == '\0')
+        return kErrorOk;
+
+    snprintf(aPath, sizeof(aPath), LEDU_SYSFS_LED_DIR "%s/max_brightness", pName_p);
+    pState_p->maxBrightness = 1;
+    fd = open(aPath, O_RDONLY);
+    if (fd >= 0)
+    {
+        len = read(fd, aValue, sizeof(aValue) - 1);
+        if (len > 0)
+        {
+            aValue[len] = '\0';
+            pState_p->maxBrightness = (UINT)strtoul(aValue, NULL, 10);
+        }
+        close(fd);
+    }
+
+    snprintf(aPath, sizeof(aPath), LEDU_SYSFS_LED_DIR "%s/brightness", pName_p);
+    pState_p->fd = open(aPath, O_WRONLY);
+    if (pState_p->fd < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't open %s!\n", __func__, aPath);
+        return kErrorNoResource;
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Apply LED request
+
+The function takes over the latest request of an LED.
+
+\param  pState_p            Output state of the LED.
+\param  pRequest_p          Latest request of the LED.
+\param  now_p               Current time [us].
+*/
+//------------------------------------------------------------------------------
+static void applyRequest(tLeduOutputState* pState_p,
+                         const tLeduOutputRequest* pRequest_p,
+                         ULONGLONG now_p)
+{
+    UINT    startPhase = pRequest_p->startPhase;
+
+    pState_p->requestCount = pRequest_p->requestCount;
+
+    if (startPhase == LEDU_PHASE_CONTINUE)
+    {
+        if ((pState_p->pPattern != NULL) && (pState_p->pPattern->phaseCount >= 2) &&
+            (pRequest_p->pPattern->phaseCount >= 2))
+        {   // finish the current phase, the next one is taken from the new pattern
+            pState_p->pPattern = pRequest_p->pPattern;
+            return;
+        }
+        startPhase = 0;
+    }
+
+    pState_p->pPattern = pRequest_p->pPattern;
+    pState_p->phase = startPhase;
+    pState_p->phaseCount = pState_p->pPattern->phaseCount;
+    if (startPhase < pState_p->pPattern->phaseCount)
+        pState_p->phaseEndUs = now_p + ((ULONGLONG)pState_p->pPattern->aDuration[startPhase] * 1000ULL);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Render LED pattern
+
+The function determines the current state of an LED from its pattern.
+
+\param  pState_p            Output state of the LED.
+\param  now_p               Current time [us].
+\param  pWakeUs_p           Time the output thread needs to wake up [us]. It
+                            is lowered to the end of the current phase.
+
+\return The function returns the LED state (1 = on, 0 = off) or
+        LEDU_OUTPUT_UNKNOWN if no pattern was requested yet.
+*/
+//------------------------------------------------------------------------------
+static INT renderPattern(tLeduOutputState* pState_p,
+                         ULONGLONG now_p,
+                         ULONGLONG* pWakeUs_p)
+{
+    const tLeduPattern* pPattern = pState_p->pPattern;
+
+    if (pPattern == NULL)
+        return LEDU_OUTPUT_UNKNOWN;
+
+    if (pPattern->phaseCount < 2)
+        return (pPattern->phaseCount != 0) ? 1 : 0;
+
+    if (now_p >= pState_p->phaseEndUs)
+    {
+        pState_p->phase = ledu_getNextPhase(pPattern, pState_p->phase, pState_p->phaseCount);
+        pState_p->phaseCount = pPattern->phaseCount;
+        pState_p->phaseEndUs += (ULONGLONG)pPattern->aDuration[pState_p->phase] * 1000ULL;
+
+        if (now_p >= pState_p->phaseEndUs)
+        {   // thread was delayed for more than a phase -> restart timing
+            pState_p->phaseEndUs = now_p + ((ULONGLONG)pPattern->aDuration[pState_p->phase] * 1000ULL);
+        }
+    }
+
+    if (pState_p->phaseEndUs < *pWakeUs_p)
+        *pWakeUs_p = pState_p->phaseEndUs;
+
+    return ((pState_p->phase & 0x01) == 0) ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write LED output
+
+The function writes the state of an LED to its sysfs brightness file or
+posts it to the LED module, which reports it to the application.
+
+\param  ledType_p           The type of LED.
+\param  pState_p            Output state of the LED.
+\param  output_p            New state of the LED (1 = on, 0 = off).
+*/
+//------------------------------------------------------------------------------
+static void writeOutput(tLedType ledType_p, tLeduOutputState* pState_p, INT output_p)
+{
+    char                aValue[16];
+    int                 len;
+    tEvent              event;
+    tLeduOutputEvent    outputEvent;
+
+    pState_p->output = output_p;
+
+    if (pState_p->fd >= 0)
+    {
+        len = snprintf(aValue, sizeof(aValue), "%u\n",
+                       (output_p != 0) ? pState_p->maxBrightness : 0);
+        if (pwrite(pState_p->fd, aValue, (size_t)len, 0) != len)
+        {
+            DEBUG_LVL_ERROR_TRACE("%s() couldn't write LED %d!\n", __func__, ledType_p);
+        }
+    }
+    else if (instance_l.pfnCbStateChange != NULL)
+    {
+        outputEvent.ledType = ledType_p;
+        outputEvent.fOn = (output_p != 0) ? TRUE : FALSE;
+
+        event.eventSink = kEventSinkLedu;
+        event.eventType = kEventTypeLeduOutput;
+        OPLK_MEMSET(&event.netTime, 0, sizeof(event.netTime));
+        event.pEventArg = &outputEvent;
+        event.eventArgSize = sizeof(outputEvent);
+        if (eventu_postEvent(&event) != kErrorOk)
+        {
+            DEBUG_LVL_ERROR_TRACE("%s() couldn't post LED %d state!\n", __func__, ledType_p);
+        }
+    }
+}
+
+///\}
+
+#endif
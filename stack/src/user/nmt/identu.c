@@ -69,14 +69,31 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#if NMT_MAX_NODE_ID > 0
+#define IDENTU_MAX_NODE_ID      NMT_MAX_NODE_ID
+#else
+#define IDENTU_MAX_NODE_ID      1
+#endif
 
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
+/**
+\brief Ident module instance
+
+The IdentResponses are stored in an arena which is indexed by the node ID and
+preallocated together with the instance. Each slot is accompanied by a
+generation counter and a valid flag. The counter is odd while the slot is
+being updated and even otherwise. It is never reset, so a reader cannot see
+the same generation for two different IdentResponses. The valid flag tells
+whether an IdentResponse has been received for the node since the last reset.
+*/
 typedef struct
 {
-    tIdentResponse*  apIdentResponse[254];    // the IdentResponse are managed dynamically
-    tIdentuCbResponse   apfnCbResponse[254];
+    tIdentResponse          aIdentResponse[IDENTU_MAX_NODE_ID];     ///< IdentResponse arena
+    volatile UINT32         aGeneration[IDENTU_MAX_NODE_ID];        ///< Generation counter of each arena slot
+    volatile BOOL           afValid[IDENTU_MAX_NODE_ID];            ///< Arena slot contains a valid IdentResponse
+    tIdentuCbResponse       apfnCbResponse[254];                    ///< Pending request callbacks
 } tIdentuInstance;
 
 //------------------------------------------------------------------------------
@@ -159,7 +176,8 @@ tOplkError identu_delInstance(void)
 /**
 \brief  Reset ident module instance
 
-The function resets an ident module instance
+The function resets an ident module instance. All stored IdentResponses are
+invalidated and all pending requests are discarded.
 
 \return The function returns a tOplkError error code.
 
@@ -168,20 +186,13 @@ The function resets an ident module instance
 //------------------------------------------------------------------------------
 tOplkError identu_reset()
 {
-    tOplkError  ret;
-    UINT        index;
-
-    ret = kErrorOk;
-    for (index = 0; index < tabentries(instance_g.apIdentResponse); index++)
-    {
-        if (instance_g.apIdentResponse[index] != NULL)
-        {
-            OPLK_FREE(instance_g.apIdentResponse[index]);
-        }
-    }
-    OPLK_MEMSET(&instance_g, 0, sizeof (tIdentuInstance));
+    // The arena and the generation counters are left untouched, the cleared
+    // valid flags mark all slots as empty.
+    OPLK_MEMSET((void*)instance_g.afValid, 0, sizeof(instance_g.afValid));
+    OPLK_MEMBAR();
+    OPLK_MEMSET(instance_g.apfnCbResponse, 0, sizeof(instance_g.apfnCbResponse));
 
-    return ret;
+    return kErrorOk;
 }
 
 //------------------------------------------------------------------------------
@@ -202,18 +213,26 @@ The function gets the IdentResponse for a specified node.
 tOplkError identu_getIdentResponse(UINT nodeId_p, tIdentResponse** ppIdentResponse_p)
 {
     tOplkError          ret = kErrorOk;
-    tIdentResponse*  	pIdentResponse;
 
     // decrement node ID, because array is zero based
     nodeId_p--;
-    if (nodeId_p < tabentries(instance_g.apIdentResponse))
+    if (nodeId_p < tabentries(instance_g.aIdentResponse))
     {
-        pIdentResponse      = instance_g.apIdentResponse[nodeId_p];
-        *ppIdentResponse_p  = pIdentResponse;
-
         // Check if ident response is valid, adjust return value otherwise
-        if( NULL == pIdentResponse )
+        if (!instance_g.afValid[nodeId_p])
+        {
+            *ppIdentResponse_p = NULL;
             ret = kErrorInvalidOperation;
+        }
+        else
+        {
+            *ppIdentResponse_p = &instance_g.aIdentResponse[nodeId_p];
+        }
+    }
+    else if (nodeId_p < tabentries(instance_g.apfnCbResponse))
+    {   // valid node ID, but no IdentResponse is stored for it
+        *ppIdentResponse_p = NULL;
+        ret = kErrorInvalidOperation;
     }
     else
     {   // invalid node ID specified
@@ -224,6 +243,91 @@ tOplkError identu_getIdentResponse(UINT nodeId_p, tIdentResponse** ppIdentRespon
 
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get ident response generation
+
+The function returns the generation counter of the IdentResponse slot of the
+specified node. The counter is incremented twice for every received
+IdentResponse, it is odd while the slot is being updated. A caller can compare
+the generation before and after reading the IdentResponse to detect that the
+stored data has been replaced in the meantime.
+
+\param  nodeId_p            The Node ID to get the generation for.
+
+\return The function returns the generation counter. Zero is returned if no
+        IdentResponse is stored for the node or the node ID is invalid.
+
+\ingroup module_identu
+*/
+//------------------------------------------------------------------------------
+UINT32 identu_getGeneration(UINT nodeId_p)
+{
+    UINT32      generation;
+
+    // decrement node ID, because array is zero based
+    nodeId_p--;
+    if (nodeId_p >= tabentries(instance_g.aGeneration))
+        return 0;
+
+    generation = instance_g.aGeneration[nodeId_p];
+    OPLK_MEMBAR();
+    if (!instance_g.afValid[nodeId_p])
+        return 0;
+
+    return generation;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Copy ident response
+
+The function copies the stored IdentResponse of the specified node. It can be
+called from a different thread than the one receiving the IdentResponses. The
+copy is repeated if the IdentResponse was replaced while it was copied.
+
+\param  nodeId_p            The Node ID to copy the IdentResponse for.
+\param  pIdentResponse_p    Pointer to store the IdentResponse.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The IdentResponse was copied.
+\retval kErrorInvalidOperation      No IdentResponse is stored for the node.
+\retval kErrorInvalidNodeId         The node ID is invalid.
+
+\ingroup module_identu
+*/
+//------------------------------------------------------------------------------
+tOplkError identu_copyIdentResponse(UINT nodeId_p, tIdentResponse* pIdentResponse_p)
+{
+    UINT32      generation;
+
+    // decrement node ID, because array is zero based
+    nodeId_p--;
+    if (nodeId_p >= tabentries(instance_g.aIdentResponse))
+    {
+        return (nodeId_p < tabentries(instance_g.apfnCbResponse)) ?
+               kErrorInvalidOperation : kErrorInvalidNodeId;
+    }
+
+    for (;;)
+    {
+        generation = instance_g.aGeneration[nodeId_p];
+        OPLK_MEMBAR();
+        if (!instance_g.afValid[nodeId_p])
+            return kErrorInvalidOperation;
+
+        if ((generation & 1) != 0)
+            continue;       // slot is being updated
+
+        OPLK_MEMCPY(pIdentResponse_p, &instance_g.aIdentResponse[nodeId_p],
+                    sizeof(tIdentResponse));
+        OPLK_MEMBAR();
+
+        if (instance_g.aGeneration[nodeId_p] == generation)
+            return kErrorOk;
+    }
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Request ident response
@@ -354,24 +458,23 @@ static tOplkError identu_cbIdentResponse(tFrameInfo* pFrameInfo_p)
         {   // IdentResponse not received or it has invalid size
             ret = pfnCbResponse(nodeId, NULL);
         }
+        else if (index >= tabentries(instance_g.aIdentResponse))
+        {   // no arena slot available, pass frame payload directly
+            ret = pfnCbResponse(nodeId,
+                                &pFrameInfo_p->pFrame->data.asnd.payload.identResponse);
+        }
         else
-        {   // IdentResponse received
-            if (instance_g.apIdentResponse[index] == NULL)
-            {   // memory for IdentResponse must be allocated
-                instance_g.apIdentResponse[index] = OPLK_MALLOC(sizeof(tIdentResponse));
-                if (instance_g.apIdentResponse[index] == NULL)
-                {   // malloc failed
-                    ret = pfnCbResponse(nodeId,
-                                        &pFrameInfo_p->pFrame->data.asnd.payload.identResponse);
-                    goto Exit;
-                }
-            }
-
-            // copy IdentResponse to instance structure
-            OPLK_MEMCPY(instance_g.apIdentResponse[index],
+        {   // IdentResponse received, copy it to the arena slot
+            instance_g.aGeneration[index]++;
+            OPLK_MEMBAR();
+            OPLK_MEMCPY(&instance_g.aIdentResponse[index],
                        &pFrameInfo_p->pFrame->data.asnd.payload.identResponse,
                        sizeof(tIdentResponse));
-            ret = pfnCbResponse(nodeId, instance_g.apIdentResponse[index]);
+            OPLK_MEMBAR();
+            instance_g.aGeneration[index]++;
+            OPLK_MEMBAR();
+            instance_g.afValid[index] = TRUE;
+            ret = pfnCbResponse(nodeId, &instance_g.aIdentResponse[index]);
         }
     }
 
@@ -492,7 +492,7 @@ static BOOL checkNodeIdList(UINT8* pbNmtCommandDate_p)
     bitOffset = (UINT8) nmtCnuInstance_g.nodeId % 8;
 
     nodeListByte = ami_getUint8Le(&pbNmtCommandDate_p[byteOffset]);
-    if((nodeListByte & bitOffset) == 0)
+    if((nodeListByte & (1 << bitOffset)) == 0)
         fNodeIdInList = FALSE;
     else
         fNodeIdInList = TRUE;
@@ -49,6 +49,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <oplk/benchmark.h>
 #include <oplk/obd.h>
 #include <user/syncu.h>
+#include <common/target.h>
 
 #if defined(CONFIG_INCLUDE_NMT_MN)
 
@@ -130,6 +131,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define NMTMNU_TIMERARG_STATE_MON               0x00080000L // timer event for StatusRequest to monitor execution of NMT state changes
 #define NMTMNU_TIMERARG_COUNT_SR                0x00000300L // counter for StatusRequest
 #define NMTMNU_TIMERARG_COUNT_LO                0x00000C00L // counter for longer timeouts
+#define NMTMNU_TIMERARG_SUPERVISION             0x00100000L // timer event is the supervision tick
 // The counters must have the same position as in the node flags above.
 
 #define NMTMNU_SET_FLAGS_TIMERARG_STATREQ(pNodeInfo_p, nodeId_p, timerArg_p)            \
@@ -172,6 +174,17 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
                                                         // for addition to isochronous phase
 #define NMTMNU_FLAG_PRC_ADD_IN_PROGRESS         0x0010  // add-PRC-node process is in progress
 
+// defines for the supervision timers of a node
+#define NMTMNU_SUPERV_TIMER_STATREQ             0           // timer to delay StatusRequests and IdentRequests
+#define NMTMNU_SUPERV_TIMER_LONGER              1           // 2nd timer for NMT command EnableReadyToOp and CheckCommunication
+#define NMTMNU_SUPERV_TIMER_PER_NODE            2
+#define NMTMNU_SUPERV_TIMER_COUNT               (NMT_MAX_NODE_ID * NMTMNU_SUPERV_TIMER_PER_NODE)
+
+// defines for the coalescing of NMT state commands
+#define NMTMNU_COALESCED_CMD_COUNT              8           // number of plain NMT state commands which can be coalesced
+#define NMTMNU_NMTCMD_NODELIST_SIZE             32          // size of the node list of extended NMT commands
+#define NMTMNU_NMTCMD_EXT_OFFSET                (kNmtCmdStartNodeEx - kNmtCmdStartNode)
+
 // return pointer to node info structure for specified node ID
 // d.k. may be replaced by special (hash) function if node ID array is smaller than 254
 #define NMTMNU_GET_NODEINFO(nodeId_p) (&nmtMnuInstance_g.aNodeInfo[nodeId_p - 1])
@@ -237,16 +250,60 @@ typedef INT (*tProcessNodeEventFunc)(UINT nodeId_p, tNmtState nodeNmtState_p,
 */
 typedef struct
 {
-    tTimerHdl           timerHdlStatReq;        ///< Timer to delay StatusRequests and IdentRequests
-    tTimerHdl           timerHdlLonger;         ///< 2nd timer for NMT command EnableReadyToOp and CheckCommunication
     tNmtMnuNodeState    nodeState;              ///< Internal node state (kind of sub state of NMT state)
     UINT32              nodeCfg;                ///< Subindex from 0x1F81
     UINT16              flags;                  ///< Node flags (see node flag defines)
     UINT16              prcFlags;               ///< PRC specific node flags
     UINT32              relPropagationDelayNs;  ///< Propagation delay in nanoseconds
     UINT32              pResTimeFirstNs;        ///< PRes time
+    tObdEntryHdl        obdHdlCurrState;        ///< Resolved object 0x1F8E NMT_MNNodeCurrState_AU8
+    tObdEntryHdl        obdHdlExpState;         ///< Resolved object 0x1F8F NMT_MNNodeExpState_AU8
 } tNmtMnuNodeInfo;
 
+/**
+* \brief Supervision timer structure
+*
+* The following struct specifies a supervision timer of a node.
+*/
+typedef struct
+{
+    UINT32              deadline;               ///< Expiry time in ms (see target_getTickCount())
+    UINT32              timerArg;               ///< Timer argument which is processed on expiry
+    UINT                heapPos;                ///< Position in the deadline heap + 1, 0 if the timer is inactive
+} tNmtMnuSupervTimer;
+
+/**
+* \brief Supervision structure
+*
+* The following struct contains the supervision timers of all nodes. The
+* active timers are kept in a min-heap ordered by their deadline. Only one
+* timeru timer is used, which is armed for the earliest deadline.
+*/
+typedef struct
+{
+    tNmtMnuSupervTimer  aTimer[NMTMNU_SUPERV_TIMER_COUNT];  ///< Supervision timers (index = (node ID - 1) * 2 + timer)
+    UINT16              aHeap[NMTMNU_SUPERV_TIMER_COUNT];   ///< Min-heap of the active timers
+    UINT                heapSize;               ///< Number of active timers
+    tTimerHdl           timerHdl;               ///< Timer for the supervision tick
+    BOOL                fArmed;                 ///< Supervision tick is armed
+    UINT32              armedDeadline;          ///< Deadline for which the supervision tick is armed
+    BOOL                fInTick;                ///< Supervision tick is currently processed
+} tNmtMnuSupervision;
+
+/**
+* \brief Coalesced NMT command structure
+*
+* The following struct collects the nodes to which a plain NMT state command
+* was issued since the last flush. They are sent together as extended NMT
+* command with node list.
+*/
+typedef struct
+{
+    UINT8               aNodeList[NMTMNU_NMTCMD_NODELIST_SIZE];  ///< Node list (bit n of byte n / 8 represents node n)
+    UINT                nodeCount;              ///< Number of nodes in the node list
+    UINT                firstNodeId;            ///< First node in the node list
+} tNmtMnuCoalescedCmd;
+
 /**
 * \brief nmtmnu instance structure
 *
@@ -256,6 +313,7 @@ typedef struct
 {
     tNmtMnuNodeInfo     aNodeInfo[NMT_MAX_NODE_ID];  ///< Information about CNs
     tTimerHdl           timerHdlNmtState;       ///< Timeout for stay in NMT state
+    tNmtMnuSupervision  supervision;            ///< Supervision timers of the nodes
     UINT                mandatorySlaveCount;    ///< Count of found mandatory CNs
     UINT                signalSlaveCount;       ///< Count of CNs which are not identified
     ULONG               statusRequestDelay;     ///< In [ms] (object 0x1006 * C_NMT_STATREQ_CYCLE)
@@ -263,11 +321,16 @@ typedef struct
     ULONG               timeoutCheckCom;        ///< In [ms] (object 0x1006 * MultiplexedCycleCount)
     UINT16              flags;                  ///< Global flags
     UINT32              nmtStartup;             ///< Object 0x1F80 NMT_StartUp_U32
+    tObdEntryHdl        obdHdlMnCurrState;      ///< Resolved object 0x1F8E/240 NMT state of the MN
     tNmtMnuCbNodeEvent  pfnCbNodeEvent;         ///< Callback function for node events
     tNmtMnuCbBootEvent  pfnCbBootEvent;         ///< Callback function for boot events
     UINT32              prcPResMnTimeoutNs;             ///< to be commented!
     UINT32              prcPResTimeFirstCorrectionNs;   ///< to be commented!
     UINT32              prcPResTimeFirstNegOffsetNs;    ///< to be commented!
+#if CONFIG_NMTMNU_COALESCE_NMT_COMMANDS != FALSE
+    tNmtMnuCoalescedCmd aCoalescedCmd[NMTMNU_COALESCED_CMD_COUNT];  ///< Pending coalesced NMT state commands
+    BOOL                fCoalescedCmdFlushPending;  ///< Flush event for the coalesced commands was posted
+#endif
 } tNmtMnuInstance;
 
 //------------------------------------------------------------------------------
@@ -275,6 +338,22 @@ typedef struct
 //------------------------------------------------------------------------------
 static tNmtMnuInstance   nmtMnuInstance_g;
 
+#if CONFIG_NMTMNU_COALESCE_NMT_COMMANDS != FALSE
+// plain NMT state commands which can be coalesced, the index corresponds
+// to tNmtMnuInstance.aCoalescedCmd[]
+static const tNmtCommand aCoalescedCmd_l[NMTMNU_COALESCED_CMD_COUNT] =
+{
+    kNmtCmdStartNode,
+    kNmtCmdStopNode,
+    kNmtCmdEnterPreOperational2,
+    kNmtCmdEnableReadyToOperate,
+    kNmtCmdResetNode,
+    kNmtCmdResetCommunication,
+    kNmtCmdResetConfiguration,
+    kNmtCmdSwReset,
+};
+#endif
+
 
 
 //------------------------------------------------------------------------------
@@ -298,6 +377,28 @@ static tOplkError doPreop1(tEventNmtStateChange nmtStateChange_p);
 static tOplkError processInternalEvent(UINT nodeId_p, tNmtState nodeNmtState_p,
                                        UINT16 errorCode_p, tNmtMnuIntNodeEvent nodeEvent_p);
 static tOplkError reset(void);
+static tOplkError processTimerEvent(UINT32 timerArg_p);
+static tOplkError sendNmtCommandFrame(UINT nodeId_p, tNmtCommand nmtCommand_p,
+                                      void* pNmtCommandData_p, UINT dataSize_p);
+static tOplkError processNmtCommandSent(UINT nodeId_p, tNmtCommand nmtCommand_p,
+                                        const UINT8* pNodeList_p);
+
+#if CONFIG_NMTMNU_COALESCE_NMT_COMMANDS != FALSE
+static INT        getCoalescedCmdIndex(UINT nodeId_p, tNmtCommand nmtCommand_p);
+static tOplkError queueCoalescedCommand(UINT nodeId_p, UINT cmdIndex_p);
+static tOplkError flushCoalescedCommands(void);
+#endif
+
+static tOplkError setSupervisionTimer(UINT nodeId_p, UINT timer_p, ULONG timeInMs_p,
+                                      tTimerArg* pTimerArg_p);
+static void       deleteSupervisionTimer(UINT nodeId_p, UINT timer_p);
+static void       resetSupervisionTimers(void);
+static tOplkError processSupervisionTick(void);
+static tOplkError armSupervisionTick(void);
+static BOOL       isSupervisionHeapLess(UINT heapPosA_p, UINT heapPosB_p);
+static void       swapSupervisionHeap(UINT heapPosA_p, UINT heapPosB_p);
+static void       siftUpSupervisionHeap(UINT heapPos_p);
+static void       siftDownSupervisionHeap(UINT heapPos_p);
 
 static tOplkError prcMeasure(void);
 static tOplkError prcCalculate(UINT nodeIdFirstNode_p);
@@ -422,7 +523,9 @@ The function adds a nmtmnu module instance.
 tOplkError nmtmnu_addInstance(tNmtMnuCbNodeEvent pfnCbNodeEvent_p,
                               tNmtMnuCbBootEvent pfnCbBootEvent_p)
 {
-    tOplkError ret = kErrorOk;
+    tOplkError          ret = kErrorOk;
+    UINT                nodeId;
+    tNmtMnuNodeInfo*    pNodeInfo;
 
     OPLK_MEMSET(&nmtMnuInstance_g, 0, sizeof(nmtMnuInstance_g));
 
@@ -431,6 +534,16 @@ tOplkError nmtmnu_addInstance(tNmtMnuCbNodeEvent pfnCbNodeEvent_p,
         ret = kErrorNmtInvalidParam;
         goto Exit;
     }
+
+    // resolve the per-node NMT state objects which are accessed on every
+    // status response, missing sub-indices leave the handle invalid
+    for (nodeId = 1; nodeId <= tabentries(nmtMnuInstance_g.aNodeInfo); nodeId++)
+    {
+        pNodeInfo = NMTMNU_GET_NODEINFO(nodeId);
+        obd_resolveEntry(0x1F8E, nodeId, &pNodeInfo->obdHdlCurrState);
+        obd_resolveEntry(0x1F8F, nodeId, &pNodeInfo->obdHdlExpState);
+    }
+    obd_resolveEntry(0x1F8E, C_ADR_MN_DEF_NODE_ID, &nmtMnuInstance_g.obdHdlMnCurrState);
     nmtMnuInstance_g.pfnCbNodeEvent = pfnCbNodeEvent_p;
     nmtMnuInstance_g.pfnCbBootEvent = pfnCbBootEvent_p;
     nmtMnuInstance_g.statusRequestDelay = 5000L;
@@ -469,7 +582,11 @@ tOplkError nmtmnu_delInstance(void)
 /**
 \brief  Send extended NMT command
 
-The function sends a extended NMT command.
+The function sends a extended NMT command. If CONFIG_NMTMNU_COALESCE_NMT_COMMANDS
+is enabled, plain NMT state commands without command data to nodes which
+support extended NMT state commands are not sent immediately. They are
+collected until all currently pending events of the NMT MN module have been
+processed and are then sent as extended NMT command with node list.
 
 \param  nodeId_p            Node ID to which the NMT command will be sent.
 \param  nmtCommand_p        NMT command to send.
@@ -485,11 +602,11 @@ tOplkError nmtmnu_sendNmtCommandEx(UINT nodeId_p, tNmtCommand nmtCommand_p,
                                    void* pNmtCommandData_p, UINT uiDataSize_p)
 {
     tOplkError          ret;
-    tFrameInfo          frameInfo;
-    UINT8               aBuffer[C_DLL_MINSIZE_NMTCMDEXT];
-    tPlkFrame *         pFrame;
     tDllNodeOpParam     nodeOpParam;
     tNmtMnuNodeInfo*    pNodeInfo;
+#if CONFIG_NMTMNU_COALESCE_NMT_COMMANDS != FALSE
+    INT                 cmdIndex;
+#endif
 
     ret = kErrorOk;
 
@@ -585,30 +702,28 @@ tOplkError nmtmnu_sendNmtCommandEx(UINT nodeId_p, tNmtCommand nmtCommand_p,
         }
     }
 
-    // build frame
-    pFrame = (tPlkFrame*) aBuffer;
-    OPLK_MEMSET(pFrame, 0x00, sizeof(aBuffer));
-    ami_setUint8Le(&pFrame->dstNodeId, (UINT8) nodeId_p);
-    ami_setUint8Le(&pFrame->data.asnd.serviceId, (UINT8) kDllAsndNmtCommand);
-    ami_setUint8Le(&pFrame->data.asnd.payload.nmtCommandService.nmtCommandId,
-        (UINT8)nmtCommand_p);
-    if ((pNmtCommandData_p != NULL) && (uiDataSize_p > 0))
-    {   // copy command data to frame
-        OPLK_MEMCPY(&pFrame->data.asnd.payload.nmtCommandService.aNmtCommandData[0], pNmtCommandData_p, uiDataSize_p);
-    }
-
-    // build info structure
-    frameInfo.pFrame = pFrame;
-    frameInfo.frameSize = sizeof(aBuffer);
+#if CONFIG_NMTMNU_COALESCE_NMT_COMMANDS != FALSE
+    cmdIndex = -1;
+    if ((pNmtCommandData_p == NULL) || (uiDataSize_p == 0))
+        cmdIndex = getCoalescedCmdIndex(nodeId_p, nmtCommand_p);
 
-    // send NMT-Request
-    ret = dllucal_sendAsyncFrame(&frameInfo, kDllAsyncReqPrioNmt);
-    if (ret != kErrorOk)
+    if (cmdIndex >= 0)
     {
-        goto Exit;
+        ret = queueCoalescedCommand(nodeId_p, (UINT)cmdIndex);
     }
+    else
+    {   // preserve the order of the commands
+        ret = flushCoalescedCommands();
+        if (ret != kErrorOk)
+            goto Exit;
 
-    DEBUG_LVL_NMTMN_TRACE("NMTCmd(%02X->%02X)\n", nmtCommand_p, nodeId_p);
+        ret = sendNmtCommandFrame(nodeId_p, nmtCommand_p, pNmtCommandData_p, uiDataSize_p);
+    }
+#else
+    ret = sendNmtCommandFrame(nodeId_p, nmtCommand_p, pNmtCommandData_p, uiDataSize_p);
+#endif
+    if (ret != kErrorOk)
+        goto Exit;
 
     if (pNodeInfo->nodeCfg & NMT_NODEASSIGN_PRES_CHAINING)
     {   // Node is a PRes Chaining node
@@ -876,7 +991,7 @@ tOplkError nmtmnu_cbNmtStateChange(tEventNmtStateChange nmtStateChange_p)
 
     // Save new MN state in object 0x1F8E
     newMnNmtState   = (UINT8) nmtStateChange_p.newNmtState;
-    ret = obd_writeEntry(0x1F8E, 240, &newMnNmtState, 1);
+    ret = obd_writeEntryByHdl(&nmtMnuInstance_g.obdHdlMnCurrState, &newMnNmtState, 1);
     if(ret != kErrorOk)
         return  ret;
 
@@ -1032,101 +1147,10 @@ tOplkError nmtmnu_processEvent(tEvent* pEvent_p)
         case kEventTypeTimer:
             {
                 tTimerEventArg*  pTimerEventArg = (tTimerEventArg*)pEvent_p->pEventArg;
-                UINT                nodeId;
 
-                nodeId = (UINT) (pTimerEventArg->argument.value & NMTMNU_TIMERARG_NODE_MASK);
-                if (nodeId != 0)
+                if ((pTimerEventArg->argument.value & NMTMNU_TIMERARG_SUPERVISION) != 0L)
                 {
-                    tObdSize             ObdSize;
-                    UINT8                bNmtState;
-                    tNmtMnuNodeInfo* pNodeInfo;
-
-                    pNodeInfo = NMTMNU_GET_NODEINFO(nodeId);
-                    ObdSize = 1;
-                    ret = obd_readEntry(0x1F8E, nodeId, &bNmtState, &ObdSize);
-                    if (ret != kErrorOk)
-                        break;
-
-                    if ((pTimerEventArg->argument.value & NMTMNU_TIMERARG_IDENTREQ) != 0L)
-                    {
-                        if ((UINT32)(pNodeInfo->flags & NMTMNU_NODE_FLAG_COUNT_STATREQ) !=
-                            (pTimerEventArg->argument.value & NMTMNU_TIMERARG_COUNT_SR))
-                        {   // this is an old (already deleted or modified) timer
-                            // but not the current timer
-                            // so discard it
-                            NMTMNU_DBG_POST_TRACE_VALUE(kNmtMnuIntNodeEventTimerIdentReq,
-                                                        nodeId, ((pNodeInfo->nodeState << 8) | 0xFF));
-
-                            break;
-                        }
-                        /*NMTMNU_DBG_POST_TRACE_VALUE(kNmtMnuIntNodeEventTimerIdentReq, uiNodeId,
-                                                        ((pNodeInfo->nodeState << 8) | 0x80
-                                                         | ((pNodeInfo->flags & NMTMNU_NODE_FLAG_COUNT_STATREQ) >> 6)
-                                                         | ((pTimerEventArg->argument.value & NMTMNU_TIMERARG_COUNT_SR) >> 8)));*/
-                        ret = processInternalEvent(nodeId, (tNmtState) (bNmtState | NMT_TYPE_CS),
-                                                   E_NO_ERROR, kNmtMnuIntNodeEventTimerIdentReq);
-                    }
-
-                    else if ((pTimerEventArg->argument.value & NMTMNU_TIMERARG_STATREQ) != 0L)
-                    {
-                        if ((UINT32)(pNodeInfo->flags & NMTMNU_NODE_FLAG_COUNT_STATREQ)
-                            != (pTimerEventArg->argument.value & NMTMNU_TIMERARG_COUNT_SR))
-                        {   // this is an old (already deleted or modified) timer
-                            // but not the current timer
-                            // so discard it
-                            NMTMNU_DBG_POST_TRACE_VALUE(kNmtMnuIntNodeEventTimerStatReq,
-                                                            nodeId, ((pNodeInfo->nodeState << 8) | 0xFF));
-
-                            break;
-                        }
-                        /* NMTMNU_DBG_POST_TRACE_VALUE(kNmtMnuIntNodeEventTimerStatReq, uiNodeId,
-                                                        ((pNodeInfo->nodeState << 8) | 0x80
-                                                         | ((pNodeInfo->flags & NMTMNU_NODE_FLAG_COUNT_STATREQ) >> 6)
-                                                         | ((pTimerEventArg->argument.value & NMTMNU_TIMERARG_COUNT_SR) >> 8))); */
-                        ret = processInternalEvent(nodeId, (tNmtState) (bNmtState | NMT_TYPE_CS),
-                                                   E_NO_ERROR, kNmtMnuIntNodeEventTimerStatReq);
-                    }
-
-                    else if ((pTimerEventArg->argument.value & NMTMNU_TIMERARG_STATE_MON) != 0L)
-                    {
-                        if ((UINT32)(pNodeInfo->flags & NMTMNU_NODE_FLAG_COUNT_STATREQ)
-                            != (pTimerEventArg->argument.value & NMTMNU_TIMERARG_COUNT_SR))
-                        {   // this is an old (already deleted or modified) timer
-                            // but not the current timer
-                            // so discard it
-                            NMTMNU_DBG_POST_TRACE_VALUE(kNmtMnuIntNodeEventTimerStateMon,
-                                                            nodeId, ((pNodeInfo->nodeState << 8) | 0xFF));
-
-                            break;
-                        }
-                        /* NMTMNU_DBG_POST_TRACE_VALUE(kNmtMnuIntNodeEventTimerStatReq, uiNodeId,
-                                                        ((pNodeInfo->nodeState << 8) | 0x80
-                                                         | ((pNodeInfo->flags & NMTMNU_NODE_FLAG_COUNT_STATREQ) >> 6)
-                                                         | ((pTimerEventArg->argument.value & NMTMNU_TIMERARG_COUNT_SR) >> 8))); */
-                        ret = processInternalEvent(nodeId, (tNmtState) (bNmtState | NMT_TYPE_CS),
-                                                   E_NO_ERROR, kNmtMnuIntNodeEventTimerStateMon);
-                    }
-
-                    else if ((pTimerEventArg->argument.value & NMTMNU_TIMERARG_LONGER) != 0L)
-                    {
-                        if ((UINT32)(pNodeInfo->flags & NMTMNU_NODE_FLAG_COUNT_LONGER)
-                            != (pTimerEventArg->argument.value & NMTMNU_TIMERARG_COUNT_LO))
-                        {   // this is an old (already deleted or modified) timer
-                            // but not the current timer
-                            // so discard it
-                            NMTMNU_DBG_POST_TRACE_VALUE(kNmtMnuIntNodeEventTimerLonger, nodeId,
-                                                            ((pNodeInfo->nodeState << 8) | 0xFF));
-
-                            break;
-                        }
-                        /* NMTMNU_DBG_POST_TRACE_VALUE(kNmtMnuIntNodeEventTimerLonger, uiNodeId,
-                                                        ((pNodeInfo->nodeState << 8) | 0x80
-                                                         | ((pNodeInfo->flags & NMTMNU_NODE_FLAG_COUNT_LONGER) >> 6)
-                                                         | ((pTimerEventArg->argument.value & NMTMNU_TIMERARG_COUNT_LO) >> 8))); */
-                        ret = processInternalEvent(nodeId, (tNmtState) (bNmtState | NMT_TYPE_CS),
-                                                   E_NO_ERROR, kNmtMnuIntNodeEventTimerLonger);
-                    }
-
+                    ret = processSupervisionTick();
                 }
                 else
                 {   // global timer event
@@ -1144,10 +1168,9 @@ tOplkError nmtmnu_processEvent(tEvent* pEvent_p)
 
         case kEventTypeNmtMnuNmtCmdSent:
             {
-                tPlkFrame* pFrame = (tPlkFrame*)pEvent_p->pEventArg;
-                UINT                uiNodeId;
-                tNmtCommand         NmtCommand;
-                UINT8                bNmtState;
+                tPlkFrame*      pFrame = (tPlkFrame*)pEvent_p->pEventArg;
+                UINT            nodeId;
+                tNmtCommand     nmtCommand;
 
                 if (pEvent_p->eventArgSize < C_DLL_MINSIZE_NMTCMD)
                 {
@@ -1155,98 +1178,43 @@ tOplkError nmtmnu_processEvent(tEvent* pEvent_p)
                     break;
                 }
 
-                uiNodeId = ami_getUint8Le(&pFrame->dstNodeId);
-                NmtCommand = (tNmtCommand) ami_getUint8Le(&pFrame->data.asnd.payload.nmtCommandService.nmtCommandId);
-
-                switch (NmtCommand)
-                {
-                    case kNmtCmdStartNode:
-                        bNmtState = (UINT8) (kNmtCsOperational & 0xFF);
-                        break;
-
-                    case kNmtCmdStopNode:
-                        bNmtState = (UINT8) (kNmtCsStopped & 0xFF);
-                        break;
-
-                    case kNmtCmdEnterPreOperational2:
-                        bNmtState = (UINT8) (kNmtCsPreOperational2 & 0xFF);
-                        break;
-
-                    case kNmtCmdEnableReadyToOperate:
-                        // d.k. do not change expected node state, because of DS 1.0.0 7.3.1.2.1 Plain NMT State Command
-                        //      and because node may not change NMT state within C_NMT_STATE_TOLERANCE
-                        bNmtState = (UINT8) (kNmtCsPreOperational2 & 0xFF);
-                        break;
-
-                    case kNmtCmdResetNode:
-                    case kNmtCmdResetCommunication:
-                    case kNmtCmdResetConfiguration:
-                    case kNmtCmdSwReset:
-                        bNmtState = (UINT8) (kNmtCsNotActive & 0xFF);
-                        // processInternalEvent() sets internal node state to kNmtMnuNodeStateUnknown
-                        // after next unresponded IdentRequest/StatusRequest
-                        break;
-
-                    default:
-                        goto Exit;
-                }
+                nodeId = ami_getUint8Le(&pFrame->dstNodeId);
+                nmtCommand = (tNmtCommand)ami_getUint8Le(&pFrame->data.asnd.payload.nmtCommandService.nmtCommandId);
 
-                // process as internal event which update expected NMT state in OD
-                if (uiNodeId != C_ADR_BROADCAST)
+                switch (nmtCommand)
                 {
-                    ret = processInternalEvent(uiNodeId,
-                                                        (tNmtState) (bNmtState | NMT_TYPE_CS),
-                                                        0,
-                                                        kNmtMnuIntNodeEventNmtCmdSent);
-
-                }
-                else
-                {   // process internal event for all active nodes (except myself)
-                    for (uiNodeId = 1; uiNodeId <= tabentries(nmtMnuInstance_g.aNodeInfo); uiNodeId++)
-                    {
-                        if ((NMTMNU_GET_NODEINFO(uiNodeId)->nodeCfg & (NMT_NODEASSIGN_NODE_IS_CN | NMT_NODEASSIGN_NODE_EXISTS)) != 0)
+                    case kNmtCmdStartNodeEx:
+                    case kNmtCmdStopNodeEx:
+                    case kNmtCmdEnterPreOperational2Ex:
+                    case kNmtCmdEnableReadyToOperateEx:
+                    case kNmtCmdResetNodeEx:
+                    case kNmtCmdResetCommunicationEx:
+                    case kNmtCmdResetConfigurationEx:
+                    case kNmtCmdSwResetEx:
+                        if (pEvent_p->eventArgSize < C_DLL_MINSIZE_NMTCMDEXT)
                         {
-                            ret = processInternalEvent(uiNodeId, (tNmtState) (bNmtState | NMT_TYPE_CS),
-                                                       0, kNmtMnuIntNodeEventNmtCmdSent);
-                            if (ret != kErrorOk)
-                                goto Exit;
+                            ret = eventu_postError(kEventSourceNmtMnu, kErrorNmtInvalidFramePointer, sizeof (pEvent_p->eventArgSize), &pEvent_p->eventArgSize);
+                            break;
                         }
-                    }
-
-                    if ((nmtMnuInstance_g.flags & NMTMNU_FLAG_USER_RESET) != 0)
-                    {   // user or diagnostic nodes requests a reset of the MN
-                        tNmtEvent    NmtEvent;
-
-                        switch (NmtCommand)
-                        {
-                            case kNmtCmdResetNode:
-                                NmtEvent = kNmtEventResetNode;
-                                break;
-
-                            case kNmtCmdResetCommunication:
-                                NmtEvent = kNmtEventResetCom;
-                                break;
-
-                            case kNmtCmdResetConfiguration:
-                                NmtEvent = kNmtEventResetConfig;
-                                break;
-
-                            case kNmtCmdSwReset:
-                                NmtEvent = kNmtEventSwReset;
-                                break;
+                        // every node in the node list has got the plain command
+                        ret = processNmtCommandSent(nodeId, (tNmtCommand)(nmtCommand - NMTMNU_NMTCMD_EXT_OFFSET),
+                                                    &pFrame->data.asnd.payload.nmtCommandService.aNmtCommandData[0]);
+                        break;
 
-                            case kNmtCmdInvalidService:
-                            default:    // actually no reset was requested
-                                goto Exit;
-                        }
-                        ret = nmtu_postNmtEvent(NmtEvent);
-                        if (ret != kErrorOk)
-                            goto Exit;
-                    }
+                    default:
+                        ret = processNmtCommandSent(nodeId, nmtCommand, NULL);
+                        break;
                 }
             }
             break;
 
+#if CONFIG_NMTMNU_COALESCE_NMT_COMMANDS != FALSE
+        case kEventTypeNmtMnuFlushCmd:
+            nmtMnuInstance_g.fCoalescedCmdFlushPending = FALSE;
+            ret = flushCoalescedCommands();
+            break;
+#endif
+
         case kEventTypeNmtMnuNodeCmd:
             {
                 tNmtMnuNodeCmd*      pNodeCmd = (tNmtMnuNodeCmd*)pEvent_p->pEventArg;
@@ -1291,7 +1259,8 @@ tOplkError nmtmnu_processEvent(tEvent* pEvent_p)
 
                 // fetch current NMT state
                 ObdSize = sizeof (bNmtState);
-                ret = obd_readEntry(0x1F8E, pNodeCmd->nodeId, &bNmtState, &ObdSize);
+                ret = obd_readEntryByHdl(&NMTMNU_GET_NODEINFO(pNodeCmd->nodeId)->obdHdlCurrState,
+                                         &bNmtState, &ObdSize);
                 if (ret != kErrorOk)
                     goto Exit;
 
@@ -1647,6 +1616,8 @@ static tOplkError startBootStep1(BOOL fNmtResetAllIssued_p)
     tObdSize            obdSize;
     tNmtMnuNodeInfo*    pNodeInfo;
     UINT8               count;
+    tObdEntryHdl        obdHdlCurrState;
+    tObdEntryHdl        obdHdlExpState;
 
     // $$$ d.k.: save current time for 0x1F89/2 MNTimeoutPreOp1_U32
 
@@ -1727,8 +1698,12 @@ static tOplkError startBootStep1(BOOL fNmtResetAllIssued_p)
     }
 
     for (; subIndex <= tabentries(nmtMnuInstance_g.aNodeInfo); subIndex++, pNodeInfo++)
-    {   // clear node structure of unused entries
+    {   // clear node structure of unused entries, but keep the resolved object handles
+        obdHdlCurrState = pNodeInfo->obdHdlCurrState;
+        obdHdlExpState = pNodeInfo->obdHdlExpState;
         OPLK_MEMSET(pNodeInfo, 0, sizeof(*pNodeInfo));
+        pNodeInfo->obdHdlCurrState = obdHdlCurrState;
+        pNodeInfo->obdHdlExpState = obdHdlExpState;
     }
 
 Exit:
@@ -1854,7 +1829,7 @@ static tOplkError startBootStep2(void)
     {
         obdSize = 1;
         // read object 0x1F8F NMT_MNNodeExpState_AU8
-        ret = obd_readEntry(0x1F8F, index, &nmtState, &obdSize);
+        ret = obd_readEntryByHdl(&pNodeInfo->obdHdlExpState, &nmtState, &obdSize);
         if (ret != kErrorOk)
             goto Exit;
 
@@ -1873,14 +1848,14 @@ static tOplkError startBootStep2(void)
             // set NMT state change flag
             pNodeInfo->flags |= NMTMNU_NODE_FLAG_NMT_CMD_ISSUED;
 
-            ret = timeru_modifyTimer(&pNodeInfo->timerHdlStatReq,
-                                         nmtMnuInstance_g.statusRequestDelay, timerArg);
+            ret = setSupervisionTimer(index, NMTMNU_SUPERV_TIMER_STATREQ,
+                                         nmtMnuInstance_g.statusRequestDelay, &timerArg);
             if (ret != kErrorOk)
                 goto Exit;
 
             // update object 0x1F8F NMT_MNNodeExpState_AU8 to PreOp2
             nmtState = (UINT8)(kNmtCsPreOperational2 & 0xFF);
-            ret = obd_writeEntry(0x1F8F, index, &nmtState, 1);
+            ret = obd_writeEntryByHdl(&pNodeInfo->obdHdlExpState, &nmtState, 1);
             if (ret != kErrorOk)
                 goto Exit;
 
@@ -1915,7 +1890,7 @@ isochronous phase. If both checks pass, it gets the NMT command EnableReadyToOp.
 
 The CN must be in node state Configured, when it enters BootStep2. When
 BootStep2 finishes, the CN is in node state ReadyToOp. If TimeoutReadyToOp
-in object 0x1F89/5 is configured, timerHdlLonger will be started with this
+in object 0x1F89/5 is configured, the longer supervision timer will be started with this
 timeout.
 
 \param  nodeId_p        Node ID for which to start BootStep2.
@@ -1936,7 +1911,7 @@ static tOplkError nodeBootStep2(UINT nodeId_p, tNmtMnuNodeInfo* pNodeInfo_p)
     {   // node is async-only
         // read object 0x1F8E NMT_MNNodeCurrState_AU8
         obdSize = 1;
-        ret = obd_readEntry(0x1F8E, nodeId_p, &bNmtState, &obdSize);
+        ret = obd_readEntryByHdl(&pNodeInfo_p->obdHdlCurrState, &bNmtState, &obdSize);
         if (ret != kErrorOk)
             goto Exit;
 
@@ -1964,8 +1939,8 @@ static tOplkError nodeBootStep2(UINT nodeId_p, tNmtMnuNodeInfo* pNodeInfo_p)
     {   // start timer
         // when the timer expires the CN must be ReadyToOp
         NMTMNU_SET_FLAGS_TIMERARG_LONGER(pNodeInfo_p, nodeId_p, timerArg);
-        ret = timeru_modifyTimer(&pNodeInfo_p->timerHdlLonger,
-                                     nmtMnuInstance_g.timeoutReadyToOp, timerArg);
+        ret = setSupervisionTimer(nodeId_p, NMTMNU_SUPERV_TIMER_LONGER,
+                                     nmtMnuInstance_g.timeoutReadyToOp, &timerArg);
     }
 Exit:
     return ret;
@@ -2057,8 +2032,8 @@ static tOplkError nodeCheckCom(UINT nodeId_p, tNmtMnuNodeInfo* pNodeInfo_p)
 
         // start timer (when the timer expires the CN must be still ReadyToOp)
         NMTMNU_SET_FLAGS_TIMERARG_LONGER(pNodeInfo_p, nodeId_p, timerArg);
-        ret = timeru_modifyTimer(&pNodeInfo_p->timerHdlLonger,
-                                     nmtMnuInstance_g.timeoutCheckCom, timerArg);
+        ret = setSupervisionTimer(nodeId_p, NMTMNU_SUPERV_TIMER_LONGER,
+                                     nmtMnuInstance_g.timeoutCheckCom, &timerArg);
 
         // update mandatory slave counter, because timer was started
         if (ret == kErrorOk)
@@ -2196,13 +2171,13 @@ static INT processNodeEventIdentResponse(UINT nodeId_p, tNmtState nodeNmtState_p
 
             NMTMNU_SET_FLAGS_TIMERARG_STATE_MON(pNodeInfo, nodeId_p, timerArg);
 
-            *pRet_p = timeru_modifyTimer(&pNodeInfo->timerHdlStatReq,
-                                             nmtMnuInstance_g.statusRequestDelay, timerArg);
+            *pRet_p = setSupervisionTimer(nodeId_p, NMTMNU_SUPERV_TIMER_STATREQ,
+                                             nmtMnuInstance_g.statusRequestDelay, &timerArg);
             if (*pRet_p != kErrorOk)
                 return -1;
         }
     }
-    *pRet_p = obd_writeEntry(0x1F8F, nodeId_p, &bNmtState, 1);
+    *pRet_p = obd_writeEntryByHdl(&pNodeInfo->obdHdlExpState, &bNmtState, 1);
     if (*pRet_p != kErrorOk)
         return -1;
 
@@ -2455,8 +2430,8 @@ INT processNodeEventNoIdentResponse(UINT nodeId_p, tNmtState nodeNmtState_p, tNm
                                           ((pNodeInfo->nodeState << 8) | 0x80
                                            | ((pNodeInfo->flags & NMTMNU_NODE_FLAG_COUNT_STATREQ) >> 6)
                                            | ((TimerArg.argument.value & NMTMNU_TIMERARG_COUNT_SR) >> 8)));*/
-        *pRet_p = timeru_modifyTimer(&pNodeInfo->timerHdlStatReq,
-                                     nmtMnuInstance_g.statusRequestDelay, timerArg);
+        *pRet_p = setSupervisionTimer(nodeId_p, NMTMNU_SUPERV_TIMER_STATREQ,
+                                     nmtMnuInstance_g.statusRequestDelay, &timerArg);
     }
     else
     {   // trigger IdentRequest immediately
@@ -2526,8 +2501,8 @@ static INT processNodeEventStatusResponse(UINT nodeId_p, tNmtState nodeNmtState_
                                         ((pNodeInfo->nodeState << 8) | 0x80
                                          | ((pNodeInfo->flags & NMTMNU_NODE_FLAG_COUNT_STATREQ) >> 6)
                                          | ((TimerArg.argument.value & NMTMNU_TIMERARG_COUNT_SR) >> 8)));*/
-        *pRet_p = timeru_modifyTimer(&pNodeInfo->timerHdlStatReq,
-                                     nmtMnuInstance_g.statusRequestDelay, timerArg);
+        *pRet_p = setSupervisionTimer(nodeId_p, NMTMNU_SUPERV_TIMER_STATREQ,
+                                     nmtMnuInstance_g.statusRequestDelay, &timerArg);
     }
     return 0;
 }
@@ -2941,7 +2916,7 @@ static INT processNodeEventNmtCmdSent(UINT nodeId_p, tNmtState nodeNmtState_p, t
     bNmtState = (UINT8) (nodeNmtState_p & 0xFF);
 
     // write object 0x1F8F NMT_MNNodeExpState_AU8
-    *pRet_p = obd_writeEntry(0x1F8F, nodeId_p, &bNmtState, 1);
+    *pRet_p = obd_writeEntryByHdl(&pNodeInfo->obdHdlExpState, &bNmtState, 1);
     if (*pRet_p != kErrorOk)
         return -1;
 
@@ -2958,8 +2933,8 @@ static INT processNodeEventNmtCmdSent(UINT nodeId_p, tNmtState nodeNmtState_p, t
         // set NMT state change flag
         pNodeInfo->flags |= NMTMNU_NODE_FLAG_NMT_CMD_ISSUED;
     }
-    *pRet_p = timeru_modifyTimer(&pNodeInfo->timerHdlStatReq,
-                                 nmtMnuInstance_g.statusRequestDelay, timerArg);
+    *pRet_p = setSupervisionTimer(nodeId_p, NMTMNU_SUPERV_TIMER_STATREQ,
+                                 nmtMnuInstance_g.statusRequestDelay, &timerArg);
     // finish processing, because NmtState_p is the expected and not the current state
     return -1;
 }
@@ -3125,7 +3100,7 @@ static tOplkError checkNmtState(UINT nodeId_p, tNmtMnuNodeInfo* pNodeInfo_p,
 
     obdSize = 1;
     // read object 0x1F8F NMT_MNNodeExpState_AU8
-    ret = obd_readEntry(0x1F8F, nodeId_p, &bExpNmtState, &obdSize);
+    ret = obd_readEntryByHdl(&pNodeInfo_p->obdHdlExpState, &bExpNmtState, &obdSize);
     if (ret != kErrorOk)
         goto Exit;
 
@@ -3168,14 +3143,12 @@ static tOplkError checkNmtState(UINT nodeId_p, tNmtMnuNodeInfo* pNodeInfo_p,
     else if ((expNmtState == kNmtCsPreOperational2) && (nodeNmtState_p == kNmtCsReadyToOperate))
     {   // CN switched to ReadyToOp
         // delete timer for timeout handling
-        ret = timeru_deleteTimer(&pNodeInfo_p->timerHdlLonger);
-        if (ret != kErrorOk)
-            goto Exit;
+        deleteSupervisionTimer(nodeId_p, NMTMNU_SUPERV_TIMER_LONGER);
 
         pNodeInfo_p->nodeState = kNmtMnuNodeStateReadyToOp;
 
         // update object 0x1F8F NMT_MNNodeExpState_AU8 to ReadyToOp
-        ret = obd_writeEntry(0x1F8F, nodeId_p, &nodeNmtState, 1);
+        ret = obd_writeEntryByHdl(&pNodeInfo_p->obdHdlExpState, &nodeNmtState, 1);
         if (ret != kErrorOk)
             goto Exit;
 
@@ -3260,7 +3233,7 @@ static tOplkError checkNmtState(UINT nodeId_p, tNmtMnuNodeInfo* pNodeInfo_p,
 ExitButUpdate:
     // check if NMT_MNNodeCurrState_AU8 has to be changed
     obdSize = 1;
-    retUpdate = obd_readEntry(0x1F8E, nodeId_p, &nmtStatePrev, &obdSize);
+    retUpdate = obd_readEntryByHdl(&pNodeInfo_p->obdHdlCurrState, &nmtStatePrev, &obdSize);
     if (retUpdate != kErrorOk)
     {
         ret = retUpdate;
@@ -3269,7 +3242,7 @@ ExitButUpdate:
     if (nodeNmtState != nmtStatePrev)
     {
         // update object 0x1F8E NMT_MNNodeCurrState_AU8
-        retUpdate = obd_writeEntry(0x1F8E, nodeId_p, &nodeNmtState, 1);
+        retUpdate = obd_writeEntryByHdl(&pNodeInfo_p->obdHdlCurrState, &nodeNmtState, 1);
         if (retUpdate != kErrorOk)
         {
             ret =retUpdate;
@@ -3301,20 +3274,746 @@ The function resets the internal structures, e.g. timers.
 static tOplkError reset(void)
 {
     tOplkError  ret;
-    UINT        index;
 
     ret = timeru_deleteTimer(&nmtMnuInstance_g.timerHdlNmtState);
-    for (index = 1; index <= tabentries (nmtMnuInstance_g.aNodeInfo); index++)
+    resetSupervisionTimers();
+
+#if CONFIG_NMTMNU_COALESCE_NMT_COMMANDS != FALSE
+    // discard pending coalesced NMT commands
+    OPLK_MEMSET(nmtMnuInstance_g.aCoalescedCmd, 0, sizeof(nmtMnuInstance_g.aCoalescedCmd));
+#endif
+
+    nmtMnuInstance_g.prcPResMnTimeoutNs = 0;
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Send NMT command frame
+
+The function builds an NMT command frame and passes it to the DLL.
+
+\param  nodeId_p            Node ID to which the NMT command will be sent.
+\param  nmtCommand_p        NMT command to send.
+\param  pNmtCommandData_p   Pointer to additional NMT command data.
+\param  dataSize_p          Length of additional NMT command data.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError sendNmtCommandFrame(UINT nodeId_p, tNmtCommand nmtCommand_p,
+                                      void* pNmtCommandData_p, UINT dataSize_p)
+{
+    tOplkError          ret;
+    tFrameInfo          frameInfo;
+    UINT8               aBuffer[C_DLL_MINSIZE_NMTCMDEXT];
+    tPlkFrame*          pFrame;
+
+    // build frame
+    pFrame = (tPlkFrame*)aBuffer;
+    OPLK_MEMSET(pFrame, 0x00, sizeof(aBuffer));
+    ami_setUint8Le(&pFrame->dstNodeId, (UINT8)nodeId_p);
+    ami_setUint8Le(&pFrame->data.asnd.serviceId, (UINT8)kDllAsndNmtCommand);
+    ami_setUint8Le(&pFrame->data.asnd.payload.nmtCommandService.nmtCommandId,
+        (UINT8)nmtCommand_p);
+    if ((pNmtCommandData_p != NULL) && (dataSize_p > 0))
+    {   // copy command data to frame
+        OPLK_MEMCPY(&pFrame->data.asnd.payload.nmtCommandService.aNmtCommandData[0], pNmtCommandData_p, dataSize_p);
+    }
+
+    // build info structure
+    frameInfo.pFrame = pFrame;
+    frameInfo.frameSize = sizeof(aBuffer);
+
+    // send NMT-Request
+    ret = dllucal_sendAsyncFrame(&frameInfo, kDllAsyncReqPrioNmt);
+    if (ret != kErrorOk)
+        return ret;
+
+    DEBUG_LVL_NMTMN_TRACE("NMTCmd(%02X->%02X)\n", nmtCommand_p, nodeId_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process sent NMT command
+
+The function processes an NMT command which was actually sent by the DLL.
+It updates the expected NMT state of the addressed nodes.
+
+\param  nodeId_p            Destination node ID of the NMT command.
+\param  nmtCommand_p        Sent NMT command. For extended NMT commands the
+                            corresponding plain NMT command is specified.
+\param  pNodeList_p         Node list of an extended NMT command. NULL for
+                            plain NMT commands.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError processNmtCommandSent(UINT nodeId_p, tNmtCommand nmtCommand_p,
+                                        const UINT8* pNodeList_p)
+{
+    tOplkError          ret = kErrorOk;
+    UINT                nodeId;
+    UINT8               bNmtState;
+
+    switch (nmtCommand_p)
     {
-        ret = timeru_deleteTimer(&NMTMNU_GET_NODEINFO(index)->timerHdlStatReq);
-        ret = timeru_deleteTimer(&NMTMNU_GET_NODEINFO(index)->timerHdlLonger);
+        case kNmtCmdStartNode:
+            bNmtState = (UINT8) (kNmtCsOperational & 0xFF);
+            break;
+
+        case kNmtCmdStopNode:
+            bNmtState = (UINT8) (kNmtCsStopped & 0xFF);
+            break;
+
+        case kNmtCmdEnterPreOperational2:
+            bNmtState = (UINT8) (kNmtCsPreOperational2 & 0xFF);
+            break;
+
+        case kNmtCmdEnableReadyToOperate:
+            // d.k. do not change expected node state, because of DS 1.0.0 7.3.1.2.1 Plain NMT State Command
+            //      and because node may not change NMT state within C_NMT_STATE_TOLERANCE
+            bNmtState = (UINT8) (kNmtCsPreOperational2 & 0xFF);
+            break;
+
+        case kNmtCmdResetNode:
+        case kNmtCmdResetCommunication:
+        case kNmtCmdResetConfiguration:
+        case kNmtCmdSwReset:
+            bNmtState = (UINT8) (kNmtCsNotActive & 0xFF);
+            // processInternalEvent() sets internal node state to kNmtMnuNodeStateUnknown
+            // after next unresponded IdentRequest/StatusRequest
+            break;
+
+        default:
+            goto Exit;
     }
 
-    nmtMnuInstance_g.prcPResMnTimeoutNs = 0;
+    // process as internal event which update expected NMT state in OD
+    if (pNodeList_p != NULL)
+    {   // process internal event for all nodes in the node list
+        for (nodeId = 1; nodeId <= tabentries(nmtMnuInstance_g.aNodeInfo); nodeId++)
+        {
+            if ((ami_getUint8Le(&pNodeList_p[nodeId >> 3]) & (1 << (nodeId & 7))) != 0)
+            {
+                ret = processInternalEvent(nodeId, (tNmtState) (bNmtState | NMT_TYPE_CS),
+                                           0, kNmtMnuIntNodeEventNmtCmdSent);
+                if (ret != kErrorOk)
+                    goto Exit;
+            }
+        }
+    }
+    else if (nodeId_p != C_ADR_BROADCAST)
+    {
+        ret = processInternalEvent(nodeId_p, (tNmtState) (bNmtState | NMT_TYPE_CS),
+                                   0, kNmtMnuIntNodeEventNmtCmdSent);
+    }
+    else
+    {   // process internal event for all active nodes (except myself)
+        for (nodeId = 1; nodeId <= tabentries(nmtMnuInstance_g.aNodeInfo); nodeId++)
+        {
+            if ((NMTMNU_GET_NODEINFO(nodeId)->nodeCfg & (NMT_NODEASSIGN_NODE_IS_CN | NMT_NODEASSIGN_NODE_EXISTS)) != 0)
+            {
+                ret = processInternalEvent(nodeId, (tNmtState) (bNmtState | NMT_TYPE_CS),
+                                           0, kNmtMnuIntNodeEventNmtCmdSent);
+                if (ret != kErrorOk)
+                    goto Exit;
+            }
+        }
+
+        if ((nmtMnuInstance_g.flags & NMTMNU_FLAG_USER_RESET) != 0)
+        {   // user or diagnostic nodes requests a reset of the MN
+            tNmtEvent    NmtEvent;
+
+            switch (nmtCommand_p)
+            {
+                case kNmtCmdResetNode:
+                    NmtEvent = kNmtEventResetNode;
+                    break;
+
+                case kNmtCmdResetCommunication:
+                    NmtEvent = kNmtEventResetCom;
+                    break;
+
+                case kNmtCmdResetConfiguration:
+                    NmtEvent = kNmtEventResetConfig;
+                    break;
+
+                case kNmtCmdSwReset:
+                    NmtEvent = kNmtEventSwReset;
+                    break;
+
+                case kNmtCmdInvalidService:
+                default:    // actually no reset was requested
+                    goto Exit;
+            }
+            ret = nmtu_postNmtEvent(NmtEvent);
+            if (ret != kErrorOk)
+                goto Exit;
+        }
+    }
 
+Exit:
     return ret;
 }
 
+#if CONFIG_NMTMNU_COALESCE_NMT_COMMANDS != FALSE
+//------------------------------------------------------------------------------
+/**
+\brief  Get index of coalesced NMT command
+
+The function determines whether the specified NMT command can be coalesced
+into an extended NMT command. This is the case for plain NMT state commands
+to a single node which has signaled support for extended NMT state commands
+in its IdentResponse.
+
+\param  nodeId_p            Node ID to which the NMT command will be sent.
+\param  nmtCommand_p        NMT command to send.
+
+\return The function returns the index of the command in aCoalescedCmd_l or
+        -1 if the command cannot be coalesced.
+*/
+//------------------------------------------------------------------------------
+static INT getCoalescedCmdIndex(UINT nodeId_p, tNmtCommand nmtCommand_p)
+{
+    tIdentResponse*     pIdentResponse;
+    INT                 cmdIndex;
+
+    if ((nodeId_p == C_ADR_BROADCAST) || (nodeId_p > NMTMNU_NMTCMD_NODELIST_SIZE * 8 - 1))
+        return -1;
+
+    for (cmdIndex = 0; cmdIndex < (INT)tabentries(aCoalescedCmd_l); cmdIndex++)
+    {
+        if (aCoalescedCmd_l[cmdIndex] == nmtCommand_p)
+            break;
+    }
+    if (cmdIndex >= (INT)tabentries(aCoalescedCmd_l))
+        return -1;
+
+    if ((identu_getIdentResponse(nodeId_p, &pIdentResponse) != kErrorOk) ||
+        (pIdentResponse == NULL) ||
+        ((ami_getUint32Le(&pIdentResponse->featureFlagsLe) & PLK_FEATURE_NMT_EXT) == 0))
+        return -1;
+
+    return cmdIndex;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Queue coalesced NMT command
+
+The function adds the specified node to the node list of a coalesced NMT
+command. When the first command is queued, an event is posted to the NMT MN
+module which flushes all coalesced commands after the events that are pending
+at this time have been processed.
+
+\param  nodeId_p            Node ID to which the NMT command will be sent.
+\param  cmdIndex_p          Index of the NMT command in aCoalescedCmd_l.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError queueCoalescedCommand(UINT nodeId_p, UINT cmdIndex_p)
+{
+    tOplkError              ret = kErrorOk;
+    tNmtMnuCoalescedCmd*    pCmd;
+    UINT                    index;
+    UINT                    byteOffset = nodeId_p >> 3;
+    UINT8                   bitMask = (UINT8)(1 << (nodeId_p & 7));
+    tEvent                  event;
+
+    for (index = 0; index < tabentries(nmtMnuInstance_g.aCoalescedCmd); index++)
+    {
+        if ((index != cmdIndex_p) &&
+            ((nmtMnuInstance_g.aCoalescedCmd[index].aNodeList[byteOffset] & bitMask) != 0))
+        {   // another command is pending for this node, preserve the order
+            ret = flushCoalescedCommands();
+            if (ret != kErrorOk)
+                return ret;
+            break;
+        }
+    }
+
+    pCmd = &nmtMnuInstance_g.aCoalescedCmd[cmdIndex_p];
+    if ((pCmd->aNodeList[byteOffset] & bitMask) == 0)
+    {
+        pCmd->aNodeList[byteOffset] |= bitMask;
+        if (pCmd->nodeCount == 0)
+            pCmd->firstNodeId = nodeId_p;
+        pCmd->nodeCount++;
+    }
+
+    if (!nmtMnuInstance_g.fCoalescedCmdFlushPending)
+    {
+        event.eventSink = kEventSinkNmtMnu;
+        event.eventType = kEventTypeNmtMnuFlushCmd;
+        OPLK_MEMSET(&event.netTime, 0x00, sizeof(event.netTime));
+        event.pEventArg = NULL;
+        event.eventArgSize = 0;
+        ret = eventu_postEvent(&event);
+        if (ret != kErrorOk)
+        {   // send the commands immediately
+            return flushCoalescedCommands();
+        }
+        nmtMnuInstance_g.fCoalescedCmdFlushPending = TRUE;
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Flush coalesced NMT commands
+
+The function sends all pending coalesced NMT commands. A command which is
+pending for more than one node is sent as extended NMT command with node list,
+otherwise the plain NMT command is sent.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError flushCoalescedCommands(void)
+{
+    tOplkError              ret = kErrorOk;
+    tNmtMnuCoalescedCmd*    pCmd;
+    UINT                    index;
+
+    for (index = 0; index < tabentries(nmtMnuInstance_g.aCoalescedCmd); index++)
+    {
+        pCmd = &nmtMnuInstance_g.aCoalescedCmd[index];
+        if (pCmd->nodeCount == 0)
+            continue;
+
+        if (pCmd->nodeCount == 1)
+        {
+            ret = sendNmtCommandFrame(pCmd->firstNodeId, aCoalescedCmd_l[index], NULL, 0);
+        }
+        else
+        {
+            ret = sendNmtCommandFrame(C_ADR_BROADCAST,
+                                      (tNmtCommand)(aCoalescedCmd_l[index] + NMTMNU_NMTCMD_EXT_OFFSET),
+                                      pCmd->aNodeList, sizeof(pCmd->aNodeList));
+        }
+
+        OPLK_MEMSET(pCmd, 0, sizeof(*pCmd));
+        if (ret != kErrorOk)
+            break;
+    }
+
+    return ret;
+}
+#endif
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process an expired supervision timer
+
+The function processes an expired supervision timer of a node.
+
+\param  timerArg_p          Timer argument of the expired timer.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError processTimerEvent(UINT32 timerArg_p)
+{
+    tOplkError           ret = kErrorOk;
+    UINT                 nodeId;
+    tObdSize             ObdSize;
+    UINT8                bNmtState;
+    tNmtMnuNodeInfo*     pNodeInfo;
+
+    nodeId = (UINT) (timerArg_p & NMTMNU_TIMERARG_NODE_MASK);
+    if (nodeId == 0)
+        return ret;
+
+    pNodeInfo = NMTMNU_GET_NODEINFO(nodeId);
+    ObdSize = 1;
+    ret = obd_readEntryByHdl(&pNodeInfo->obdHdlCurrState, &bNmtState, &ObdSize);
+    if (ret != kErrorOk)
+        return ret;
+
+    if ((timerArg_p & NMTMNU_TIMERARG_IDENTREQ) != 0L)
+    {
+        if ((UINT32)(pNodeInfo->flags & NMTMNU_NODE_FLAG_COUNT_STATREQ) !=
+            (timerArg_p & NMTMNU_TIMERARG_COUNT_SR))
+        {   // this is an old (already deleted or modified) timer
+            // but not the current timer
+            // so discard it
+            NMTMNU_DBG_POST_TRACE_VALUE(kNmtMnuIntNodeEventTimerIdentReq,
+                                        nodeId, ((pNodeInfo->nodeState << 8) | 0xFF));
+
+            return kErrorOk;
+        }
+        /*NMTMNU_DBG_POST_TRACE_VALUE(kNmtMnuIntNodeEventTimerIdentReq, uiNodeId,
+                                        ((pNodeInfo->nodeState << 8) | 0x80
+                                         | ((pNodeInfo->flags & NMTMNU_NODE_FLAG_COUNT_STATREQ) >> 6)
+                                         | ((timerArg_p & NMTMNU_TIMERARG_COUNT_SR) >> 8)));*/
+        ret = processInternalEvent(nodeId, (tNmtState) (bNmtState | NMT_TYPE_CS),
+                                   E_NO_ERROR, kNmtMnuIntNodeEventTimerIdentReq);
+    }
+
+    else if ((timerArg_p & NMTMNU_TIMERARG_STATREQ) != 0L)
+    {
+        if ((UINT32)(pNodeInfo->flags & NMTMNU_NODE_FLAG_COUNT_STATREQ)
+            != (timerArg_p & NMTMNU_TIMERARG_COUNT_SR))
+        {   // this is an old (already deleted or modified) timer
+            // but not the current timer
+            // so discard it
+            NMTMNU_DBG_POST_TRACE_VALUE(kNmtMnuIntNodeEventTimerStatReq,
+                                            nodeId, ((pNodeInfo->nodeState << 8) | 0xFF));
+
+            return kErrorOk;
+        }
+        /* NMTMNU_DBG_POST_TRACE_VALUE(kNmtMnuIntNodeEventTimerStatReq, uiNodeId,
+                                        ((pNodeInfo->nodeState << 8) | 0x80
+                                         | ((pNodeInfo->flags & NMTMNU_NODE_FLAG_COUNT_STATREQ) >> 6)
+                                         | ((timerArg_p & NMTMNU_TIMERARG_COUNT_SR) >> 8))); */
+        ret = processInternalEvent(nodeId, (tNmtState) (bNmtState | NMT_TYPE_CS),
+                                   E_NO_ERROR, kNmtMnuIntNodeEventTimerStatReq);
+    }
+
+    else if ((timerArg_p & NMTMNU_TIMERARG_STATE_MON) != 0L)
+    {
+        if ((UINT32)(pNodeInfo->flags & NMTMNU_NODE_FLAG_COUNT_STATREQ)
+            != (timerArg_p & NMTMNU_TIMERARG_COUNT_SR))
+        {   // this is an old (already deleted or modified) timer
+            // but not the current timer
+            // so discard it
+            NMTMNU_DBG_POST_TRACE_VALUE(kNmtMnuIntNodeEventTimerStateMon,
+                                            nodeId, ((pNodeInfo->nodeState << 8) | 0xFF));
+
+            return kErrorOk;
+        }
+        /* NMTMNU_DBG_POST_TRACE_VALUE(kNmtMnuIntNodeEventTimerStatReq, uiNodeId,
+                                        ((pNodeInfo->nodeState << 8) | 0x80
+                                         | ((pNodeInfo->flags & NMTMNU_NODE_FLAG_COUNT_STATREQ) >> 6)
+                                         | ((timerArg_p & NMTMNU_TIMERARG_COUNT_SR) >> 8))); */
+        ret = processInternalEvent(nodeId, (tNmtState) (bNmtState | NMT_TYPE_CS),
+                                   E_NO_ERROR, kNmtMnuIntNodeEventTimerStateMon);
+    }
+
+    else if ((timerArg_p & NMTMNU_TIMERARG_LONGER) != 0L)
+    {
+        if ((UINT32)(pNodeInfo->flags & NMTMNU_NODE_FLAG_COUNT_LONGER)
+            != (timerArg_p & NMTMNU_TIMERARG_COUNT_LO))
+        {   // this is an old (already deleted or modified) timer
+            // but not the current timer
+            // so discard it
+            NMTMNU_DBG_POST_TRACE_VALUE(kNmtMnuIntNodeEventTimerLonger, nodeId,
+                                            ((pNodeInfo->nodeState << 8) | 0xFF));
+
+            return kErrorOk;
+        }
+        /* NMTMNU_DBG_POST_TRACE_VALUE(kNmtMnuIntNodeEventTimerLonger, uiNodeId,
+                                        ((pNodeInfo->nodeState << 8) | 0x80
+                                         | ((pNodeInfo->flags & NMTMNU_NODE_FLAG_COUNT_LONGER) >> 6)
+                                         | ((timerArg_p & NMTMNU_TIMERARG_COUNT_LO) >> 8))); */
+        ret = processInternalEvent(nodeId, (tNmtState) (bNmtState | NMT_TYPE_CS),
+                                   E_NO_ERROR, kNmtMnuIntNodeEventTimerLonger);
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set a supervision timer
+
+The function (re)starts a supervision timer of a node. A running timer of the
+node is replaced. The supervision tick is only rearmed if the new deadline is
+earlier than the currently armed one.
+
+\param  nodeId_p            Node ID of the node.
+\param  timer_p             Supervision timer of the node
+                            (NMTMNU_SUPERV_TIMER_STATREQ or
+                            NMTMNU_SUPERV_TIMER_LONGER).
+\param  timeInMs_p          Timeout in milliseconds.
+\param  pTimerArg_p         Pointer to the timer argument which is processed on
+                            expiry.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError setSupervisionTimer(UINT nodeId_p, UINT timer_p, ULONG timeInMs_p,
+                                      tTimerArg* pTimerArg_p)
+{
+    tNmtMnuSupervision*     pSuperv = &nmtMnuInstance_g.supervision;
+    UINT                    timerIndex;
+    tNmtMnuSupervTimer*     pTimer;
+
+    if ((nodeId_p == 0) || (nodeId_p > NMT_MAX_NODE_ID))
+        return kErrorInvalidNodeId;
+
+    deleteSupervisionTimer(nodeId_p, timer_p);
+
+    if (timeInMs_p == 0)
+        timeInMs_p = 1;
+
+    timerIndex = ((nodeId_p - 1) * NMTMNU_SUPERV_TIMER_PER_NODE) + timer_p;
+    pTimer = &pSuperv->aTimer[timerIndex];
+    pTimer->deadline = target_getTickCount() + (UINT32)timeInMs_p;
+    pTimer->timerArg = pTimerArg_p->argument.value;
+
+    pSuperv->aHeap[pSuperv->heapSize] = (UINT16)timerIndex;
+    pSuperv->heapSize++;
+    pTimer->heapPos = pSuperv->heapSize;
+    siftUpSupervisionHeap(pSuperv->heapSize - 1);
+
+    return armSupervisionTick();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Delete a supervision timer
+
+The function stops a supervision timer of a node. The supervision tick is left
+untouched. If it expires without an elapsed supervision timer, it is simply
+rearmed.
+
+\param  nodeId_p            Node ID of the node.
+\param  timer_p             Supervision timer of the node.
+*/
+//------------------------------------------------------------------------------
+static void deleteSupervisionTimer(UINT nodeId_p, UINT timer_p)
+{
+    tNmtMnuSupervision*     pSuperv = &nmtMnuInstance_g.supervision;
+    tNmtMnuSupervTimer*     pTimer;
+    UINT                    heapPos;
+    UINT                    lastPos;
+
+    if ((nodeId_p == 0) || (nodeId_p > NMT_MAX_NODE_ID))
+        return;
+
+    pTimer = &pSuperv->aTimer[((nodeId_p - 1) * NMTMNU_SUPERV_TIMER_PER_NODE) + timer_p];
+    if (pTimer->heapPos == 0)
+        return;     // timer is not active
+
+    heapPos = pTimer->heapPos - 1;
+    lastPos = pSuperv->heapSize - 1;
+    pTimer->heapPos = 0;
+    pSuperv->heapSize--;
+
+    if (heapPos != lastPos)
+    {   // move last entry into the gap and restore heap order
+        pSuperv->aHeap[heapPos] = pSuperv->aHeap[lastPos];
+        pSuperv->aTimer[pSuperv->aHeap[heapPos]].heapPos = heapPos + 1;
+        siftUpSupervisionHeap(heapPos);
+        siftDownSupervisionHeap(pSuperv->aTimer[pSuperv->aHeap[heapPos]].heapPos - 1);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reset supervision timers
+
+The function stops all supervision timers and the supervision tick.
+*/
+//------------------------------------------------------------------------------
+static void resetSupervisionTimers(void)
+{
+    tNmtMnuSupervision*     pSuperv = &nmtMnuInstance_g.supervision;
+    UINT                    index;
+
+    timeru_deleteTimer(&pSuperv->timerHdl);
+
+    for (index = 0; index < pSuperv->heapSize; index++)
+        pSuperv->aTimer[pSuperv->aHeap[index]].heapPos = 0;
+
+    pSuperv->heapSize = 0;
+    pSuperv->fArmed = FALSE;
+    pSuperv->fInTick = FALSE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process supervision tick
+
+The function processes all supervision timers whose deadline has elapsed and
+rearms the supervision tick for the next deadline.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError processSupervisionTick(void)
+{
+    tOplkError              ret = kErrorOk;
+    tOplkError              retArm;
+    tNmtMnuSupervision*     pSuperv = &nmtMnuInstance_g.supervision;
+    tNmtMnuSupervTimer*     pTimer;
+    UINT32                  now;
+    UINT32                  timerArg;
+    UINT                    timerIndex;
+
+    // the tick is not pending anymore
+    pSuperv->fArmed = FALSE;
+    pSuperv->fInTick = TRUE;
+
+    now = target_getTickCount();
+    while (pSuperv->heapSize > 0)
+    {
+        timerIndex = pSuperv->aHeap[0];
+        pTimer = &pSuperv->aTimer[timerIndex];
+        if ((INT32)(pTimer->deadline - now) > 0)
+            break;
+
+        timerArg = pTimer->timerArg;
+        deleteSupervisionTimer((timerIndex / NMTMNU_SUPERV_TIMER_PER_NODE) + 1,
+                               timerIndex % NMTMNU_SUPERV_TIMER_PER_NODE);
+
+        ret = processTimerEvent(timerArg);
+        if (ret != kErrorOk)
+            break;
+    }
+
+    pSuperv->fInTick = FALSE;
+
+    retArm = armSupervisionTick();
+    if (ret == kErrorOk)
+        ret = retArm;
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Arm supervision tick
+
+The function arms the supervision tick for the earliest deadline of all active
+supervision timers. The timer is only modified if it is not armed or armed for
+a later deadline.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError armSupervisionTick(void)
+{
+    tOplkError              ret;
+    tNmtMnuSupervision*     pSuperv = &nmtMnuInstance_g.supervision;
+    tTimerArg               timerArg;
+    UINT32                  deadline;
+    INT32                   timeInMs;
+
+    if (pSuperv->fInTick || (pSuperv->heapSize == 0))
+        return kErrorOk;
+
+    deadline = pSuperv->aTimer[pSuperv->aHeap[0]].deadline;
+    if (pSuperv->fArmed && ((INT32)(deadline - pSuperv->armedDeadline) >= 0))
+        return kErrorOk;
+
+    timeInMs = (INT32)(deadline - target_getTickCount());
+    if (timeInMs <= 0)
+        timeInMs = 1;
+
+    timerArg.eventSink = kEventSinkNmtMnu;
+    timerArg.argument.value = NMTMNU_TIMERARG_SUPERVISION;
+    ret = timeru_modifyTimer(&pSuperv->timerHdl, (ULONG)timeInMs, timerArg);
+    if (ret != kErrorOk)
+        return ret;
+
+    pSuperv->fArmed = TRUE;
+    pSuperv->armedDeadline = deadline;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Compare supervision heap entries
+
+\param  heapPosA_p          First heap position.
+\param  heapPosB_p          Second heap position.
+
+\return Returns TRUE if the deadline of the first entry is earlier than the
+        deadline of the second entry.
+*/
+//------------------------------------------------------------------------------
+static BOOL isSupervisionHeapLess(UINT heapPosA_p, UINT heapPosB_p)
+{
+    tNmtMnuSupervision*     pSuperv = &nmtMnuInstance_g.supervision;
+
+    return ((INT32)(pSuperv->aTimer[pSuperv->aHeap[heapPosA_p]].deadline -
+                    pSuperv->aTimer[pSuperv->aHeap[heapPosB_p]].deadline) < 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Swap supervision heap entries
+
+\param  heapPosA_p          First heap position.
+\param  heapPosB_p          Second heap position.
+*/
+//------------------------------------------------------------------------------
+static void swapSupervisionHeap(UINT heapPosA_p, UINT heapPosB_p)
+{
+    tNmtMnuSupervision*     pSuperv = &nmtMnuInstance_g.supervision;
+    UINT16                  timerIndex;
+
+    timerIndex = pSuperv->aHeap[heapPosA_p];
+    pSuperv->aHeap[heapPosA_p] = pSuperv->aHeap[heapPosB_p];
+    pSuperv->aHeap[heapPosB_p] = timerIndex;
+
+    pSuperv->aTimer[pSuperv->aHeap[heapPosA_p]].heapPos = heapPosA_p + 1;
+    pSuperv->aTimer[pSuperv->aHeap[heapPosB_p]].heapPos = heapPosB_p + 1;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Move supervision heap entry towards the root
+
+\param  heapPos_p           Heap position of the entry.
+*/
+//------------------------------------------------------------------------------
+static void siftUpSupervisionHeap(UINT heapPos_p)
+{
+    UINT    parentPos;
+
+    while (heapPos_p > 0)
+    {
+        parentPos = (heapPos_p - 1) / 2;
+        if (!isSupervisionHeapLess(heapPos_p, parentPos))
+            break;
+
+        swapSupervisionHeap(heapPos_p, parentPos);
+        heapPos_p = parentPos;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Move supervision heap entry towards the leaves
+
+\param  heapPos_p           Heap position of the entry.
+*/
+//------------------------------------------------------------------------------
+static void siftDownSupervisionHeap(UINT heapPos_p)
+{
+    tNmtMnuSupervision*     pSuperv = &nmtMnuInstance_g.supervision;
+    UINT                    childPos;
+
+    for (;;)
+    {
+        childPos = (heapPos_p * 2) + 1;
+        if (childPos >= pSuperv->heapSize)
+            break;
+
+        if (((childPos + 1) < pSuperv->heapSize) &&
+            isSupervisionHeapLess(childPos + 1, childPos))
+        {
+            childPos++;
+        }
+
+        if (!isSupervisionHeapLess(childPos, heapPos_p))
+            break;
+
+        swapSupervisionHeap(heapPos_p, childPos);
+        heapPos_p = childPos;
+    }
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Perform measure phase of PRC node insertion
@@ -1042,6 +1042,182 @@ tOplkError obd_searchVarEntry(UINT index_p, UINT subIndex_p, tObdVarEntry MEM**
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Resolve object into a handle
+
+The function searches an object in the OD and stores the found index and
+sub-index entries together with the data pointer, size, access and type of the
+object in the handle structure. The handle can be used by obd_readEntryByHdl()
+and obd_writeEntryByHdl() to access the object without searching the OD again.
+
+The OD layout must not change while the handle is in use. The data pointer of
+VAR objects is refreshed on every access, therefore obd_defineVar() may still
+be called after the object was resolved.
+
+\param  index_p                 Index of object.
+\param  subIndex_p              Sub-index of object.
+\param  pHdl_p                  Pointer to the handle which shall be filled.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_obd
+*/
+//------------------------------------------------------------------------------
+tOplkError obd_resolveEntry(UINT index_p, UINT subIndex_p, tObdEntryHdl* pHdl_p)
+{
+    tOplkError          ret;
+    tObdEntryPtr        pObdEntry;
+    tObdSubEntryPtr     pSubEntry;
+
+    if (pHdl_p == NULL)
+        return kErrorInvalidInstanceParam;
+
+    OPLK_MEMSET(pHdl_p, 0, sizeof(tObdEntryHdl));
+
+    ret = getEntry(index_p, subIndex_p, &pObdEntry, &pSubEntry);
+    if (ret != kErrorOk)
+        return ret;
+
+    ret = isNumerical(pSubEntry, &pHdl_p->fNumerical);
+    if (ret != kErrorOk)
+        return ret;
+
+    pHdl_p->index = index_p;
+    pHdl_p->subIndex = subIndex_p;
+    pHdl_p->pObdEntry = pObdEntry;
+    pHdl_p->pSubEntry = pSubEntry;
+    pHdl_p->pData = getObjectDataPtr(pSubEntry);
+    pHdl_p->size = getDataSize(pSubEntry);
+    pHdl_p->access = pSubEntry->access;
+    pHdl_p->type = pSubEntry->type;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read OD entry by handle
+
+The function reads an OD entry which was resolved by obd_resolveEntry(). The
+object callback is called the same way as by obd_readEntry(). Non-numerical
+objects are read by obd_readEntry() because their size and data pointer may
+be changed at runtime.
+
+\param  pHdl_p          Pointer to handle of the object.
+\param  pDstData_p      Pointer to store the read data.
+\param  pSize_p         Pointer to size of buffer. The real data size will
+                        be written to this location.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_obd
+*/
+//------------------------------------------------------------------------------
+tOplkError obd_readEntryByHdl(tObdEntryHdl* pHdl_p, void* pDstData_p, tObdSize* pSize_p)
+{
+    tOplkError          ret;
+    tObdCbParam MEM     cbParam;
+    void*               pSrcData;
+
+    if ((pHdl_p == NULL) || (pDstData_p == NULL) || (pSize_p == NULL))
+        return kErrorInvalidInstanceParam;
+
+    if (pHdl_p->pSubEntry == NULL)
+        return kErrorObdIndexNotExist;
+
+    if (pHdl_p->fNumerical == FALSE)
+        return obd_readEntry(pHdl_p->index, pHdl_p->subIndex, pDstData_p, pSize_p);
+
+    pSrcData = pHdl_p->pData;
+    if ((pHdl_p->access & (kObdAccVar | kObdAccConst)) == kObdAccVar)
+        pSrcData = getObjectCurrentPtr(pHdl_p->pSubEntry);
+
+    if (pSrcData == NULL)
+        return kErrorObdReadViolation;
+
+    cbParam.index = pHdl_p->index;
+    cbParam.subIndex = pHdl_p->subIndex;
+    cbParam.pArg = pSrcData;
+    cbParam.obdEvent = kObdEvPreRead;
+    ret = callObjectCallback(pHdl_p->pObdEntry->pfnCallback, &cbParam);
+    if (ret != kErrorOk)
+        return ret;
+
+    if (*pSize_p < pHdl_p->size)
+        return kErrorObdValueLengthError;
+
+    OPLK_MEMCPY(pDstData_p, pSrcData, pHdl_p->size);
+    *pSize_p = pHdl_p->size;
+
+    cbParam.pArg     = pDstData_p;
+    cbParam.obdEvent = kObdEvPostRead;
+    ret = callObjectCallback(pHdl_p->pObdEntry->pfnCallback, &cbParam);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write OD entry by handle
+
+The function writes an OD entry which was resolved by obd_resolveEntry(). The
+access rights, the value range and the object callback are checked the same way
+as by obd_writeEntry(). Non-numerical objects are written by obd_writeEntry()
+because their size and data pointer may be changed by the object callback.
+
+\param  pHdl_p          Pointer to handle of the object.
+\param  pSrcData_p      Pointer to data which should be written.
+\param  size_p          Size of data to write.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_obd
+*/
+//------------------------------------------------------------------------------
+tOplkError obd_writeEntryByHdl(tObdEntryHdl* pHdl_p, void* pSrcData_p, tObdSize size_p)
+{
+    tOplkError          ret;
+    tObdCbParam MEM     cbParam;
+    void MEM*           pDstData;
+    tObdSize            obdSize;
+
+    if ((pHdl_p == NULL) || (pSrcData_p == NULL))
+        return kErrorInvalidInstanceParam;
+
+    if (pHdl_p->pSubEntry == NULL)
+        return kErrorObdIndexNotExist;
+
+    if (pHdl_p->fNumerical == FALSE)
+        return obd_writeEntry(pHdl_p->index, pHdl_p->subIndex, pSrcData_p, size_p);
+
+    if ((pHdl_p->access & kObdAccConst) != 0)
+        return kErrorObdAccessViolation;
+
+    pDstData = pHdl_p->pData;
+    if ((pHdl_p->access & kObdAccVar) != 0)
+        pDstData = getObjectCurrentPtr(pHdl_p->pSubEntry);
+
+    if (pDstData == NULL)
+       return kErrorObdAccessViolation;
+
+    obdSize = pHdl_p->size;
+    cbParam.index    = pHdl_p->index;
+    cbParam.subIndex = pHdl_p->subIndex;
+    cbParam.pArg     = &obdSize;
+    cbParam.obdEvent = kObdEvInitWrite;
+    ret = callObjectCallback(pHdl_p->pObdEntry->pfnCallback, &cbParam);
+    if (ret != kErrorOk)
+        return ret;
+
+    // type is numerical, therefore size has to fit
+    if (size_p != obdSize)
+        return kErrorObdValueLengthError;
+
+    ret = writeEntryPost(pHdl_p->pObdEntry, pHdl_p->pSubEntry, &cbParam, pSrcData_p,
+                         pDstData, obdSize);
+    return ret;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Set callback function for load/store command
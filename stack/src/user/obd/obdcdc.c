@@ -75,6 +75,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     #include <sys/timeb.h>
     #include <utime.h>
     #include <limits.h>
+    #include <sys/mman.h>
 
 #elif (TARGET_SYSTEM == _VXWORKS_)
         #include "ioLib.h"
@@ -136,24 +137,19 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
-typedef enum
-{
-    kEplObdCdcTypeFile      = 0,
-    kEplObdCdcTypeBuffer    = 1,
-} tObdCdcType;
+/**
+\brief  CDC entry descriptor
 
+The structure describes one object entry of a CDC which was validated and
+located in the CDC buffer.
+*/
 typedef struct
 {
-    tObdCdcType         type;
-    union
-    {
-        FD_TYPE         fdCdcFile;
-        UINT8*          pNextBuffer;
-    } handle;
-    size_t              cdcSize;
-    size_t              bufferSize;
-    BYTE*               pCurBuffer;
-} tObdCdcInfo;
+    UINT16              index;              ///< Object index
+    UINT8               subIndex;           ///< Object sub-index
+    tObdSize            size;               ///< Size of the object data
+    UINT8*              pData;              ///< Pointer to the object data in the CDC buffer
+} tObdCdcEntry;
 
 typedef struct
 {
@@ -170,10 +166,14 @@ static tObdCdcInstance         cdcInstance_l;
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
-static tOplkError processCdc(tObdCdcInfo* pCdcInfo_p);
-static tOplkError loadNextBuffer(tObdCdcInfo* pCdcInfo_p, size_t bufferSize);
+static tOplkError processCdc(UINT8* pCdc_p, size_t cdcSize_p);
+static tOplkError parseCdc(UINT8* pCdc_p, size_t cdcSize_p, tObdCdcEntry* pEntries_p,
+                           UINT32 entryCount_p);
+static tOplkError applyEntries(tObdCdcEntry* pEntries_p, UINT32 entryCount_p);
 static tOplkError loadCdcBuffer(UINT8* pCdc_p, size_t cdcSize_p);
 static tOplkError loadCdcFile(char* pCdcFilename_p);
+static UINT8*     mapCdcFile(FD_TYPE fdCdcFile_p, size_t cdcSize_p);
+static void       unmapCdcFile(UINT8* pCdc_p, size_t cdcSize_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -295,8 +295,8 @@ tOplkError obdcdc_loadCdc(void)
 /**
 \brief  Load Concise Device Configuration file
 
-The function loads the concise device configuration (CDC) from the specified
-buffer and writes its contents into the OD.
+The function maps the concise device configuration (CDC) file into memory
+and writes its contents into the OD.
 
 \param  pCdcFilename_p  The filename of the CDC file to load.
 
@@ -306,32 +306,45 @@ buffer and writes its contents into the OD.
 static tOplkError loadCdcFile(char* pCdcFilename_p)
 {
     tOplkError      ret = kErrorOk;
-    tObdCdcInfo     cdcInfo;
+    FD_TYPE         fdCdcFile;
+    size_t          cdcSize;
+    UINT8*          pCdc;
     UINT32          error;
 
-    OPLK_MEMSET(&cdcInfo, 0, sizeof(tObdCdcInfo));
-    cdcInfo.type = kEplObdCdcTypeFile;
-    cdcInfo.handle.fdCdcFile = open(pCdcFilename_p, O_RDONLY | O_BINARY, 0666);
-    if (!IS_FD_VALID(cdcInfo.handle.fdCdcFile))
+    fdCdcFile = open(pCdcFilename_p, O_RDONLY | O_BINARY, 0666);
+    if (!IS_FD_VALID(fdCdcFile))
     {   // error occurred
-        errno = (UINT32)errno;
+        error = (UINT32)errno;
         ret = eventu_postError(kEventSourceObdu, kErrorObdErrnoSet, sizeof(UINT32), &error);
         return ret;
     }
 
-    cdcInfo.cdcSize = lseek(cdcInfo.handle.fdCdcFile, 0, SEEK_END);
-    lseek(cdcInfo.handle.fdCdcFile, 0, SEEK_SET);
+    cdcSize = lseek(fdCdcFile, 0, SEEK_END);
+    lseek(fdCdcFile, 0, SEEK_SET);
 
-    ret = processCdc(&cdcInfo);
+    if (cdcSize < sizeof(UINT32))
+    {
+        close(fdCdcFile);
+        ret = eventu_postError(kEventSourceObdu, kErrorObdInvalidDcf, 0, NULL);
+        if (ret != kErrorOk)
+            return ret;
+        return kErrorReject;
+    }
 
-    if (cdcInfo.pCurBuffer != NULL)
+    pCdc = mapCdcFile(fdCdcFile, cdcSize);
+    if (pCdc == NULL)
     {
-        OPLK_FREE(cdcInfo.pCurBuffer);
-        cdcInfo.pCurBuffer = NULL;
-        cdcInfo.bufferSize = 0;
+        close(fdCdcFile);
+        ret = eventu_postError(kEventSourceObdu, kErrorObdOutOfMemory, 0, NULL);
+        if (ret != kErrorOk)
+            return ret;
+        return kErrorReject;
     }
 
-    close(cdcInfo.handle.fdCdcFile);
+    ret = processCdc(pCdc, cdcSize);
+
+    unmapCdcFile(pCdc, cdcSize);
+    close(fdCdcFile);
 
     return ret;
 }
@@ -353,23 +366,14 @@ buffer and writes the contents into the OD.
 static tOplkError loadCdcBuffer(UINT8* pCdc_p, size_t cdcSize_p)
 {
     tOplkError      ret = kErrorOk;
-    tObdCdcInfo     cdcInfo;
 
-    OPLK_MEMSET(&cdcInfo, 0, sizeof(tObdCdcInfo));
-    cdcInfo.type = kEplObdCdcTypeBuffer;
-    cdcInfo.handle.pNextBuffer = pCdc_p;
-    if (cdcInfo.handle.pNextBuffer == NULL)
+    if (pCdc_p == NULL)
     {   // error occurred
         ret = eventu_postError(kEventSourceObdu, kErrorObdInvalidDcf, 0, NULL);
-        goto Exit;
+        return ret;
     }
 
-    cdcInfo.cdcSize = (size_t) cdcSize_p;
-    cdcInfo.bufferSize = cdcInfo.cdcSize;
-
-    ret = processCdc(&cdcInfo);
-
-Exit:
+    ret = processCdc(pCdc_p, cdcSize_p);
     return ret;
 }
 
@@ -378,60 +382,156 @@ Exit:
 \brief  Process Concise Device Configuration
 
 The function processes the concise device configuration and writes it into the
-OD.
+OD. The whole CDC is validated before the first object is written. The entries
+are applied in the order of the CDC, because the CDC relies on it (e.g. a PDO
+mapping is disabled before its communication parameters are written).
 
-\param  pCdcInfo_p      Pointer to the CDC information.
+\param  pCdc_p          Pointer to the CDC in memory.
+\param  cdcSize_p       Size of the CDC.
 
 \return The function returns a tOplkError error code.
 */
 //------------------------------------------------------------------------------
-static tOplkError processCdc(tObdCdcInfo* pCdcInfo_p)
+static tOplkError processCdc(UINT8* pCdc_p, size_t cdcSize_p)
 {
     tOplkError      ret = kErrorOk;
-    UINT32          entriesRemaining;
-    UINT            objectIndex;
-    UINT            objectSubIndex;
-    size_t          curDataSize;
+    UINT32          entryCount;
+    tObdCdcEntry*   pEntries;
 
-    if ((ret = loadNextBuffer(pCdcInfo_p, sizeof(UINT32)))  != kErrorOk)
-        return ret;
-
-    entriesRemaining = ami_getUint32Le(pCdcInfo_p->pCurBuffer);
+    if (cdcSize_p < sizeof(UINT32))
+    {
+        ret = eventu_postError(kEventSourceObdu, kErrorObdInvalidDcf, 0, NULL);
+        if (ret != kErrorOk)
+            return ret;
+        return kErrorReject;
+    }
 
-    if (entriesRemaining == 0)
+    entryCount = ami_getUint32Le(pCdc_p);
+    if (entryCount == 0)
     {
         ret = eventu_postError(kEventSourceObdu, kErrorObdNoConfigData, 0, NULL);
         return ret;
     }
 
-    for ( ; entriesRemaining != 0; entriesRemaining--)
+    // every entry needs at least its header, this also limits the table size
+    if (entryCount > ((cdcSize_p - sizeof(UINT32)) / CDC_OFFSET_DATA))
     {
-        if ((ret = loadNextBuffer(pCdcInfo_p, CDC_OFFSET_DATA))  != kErrorOk)
+        ret = eventu_postError(kEventSourceObdu, kErrorObdInvalidDcf, 0, NULL);
+        if (ret != kErrorOk)
             return ret;
+        return kErrorReject;
+    }
 
-        objectIndex = ami_getUint16Le(&pCdcInfo_p->pCurBuffer[CDC_OFFSET_INDEX]);
-        objectSubIndex = ami_getUint8Le(&pCdcInfo_p->pCurBuffer[CDC_OFFSET_SUBINDEX]);
-        curDataSize = (size_t)ami_getUint32Le(&pCdcInfo_p->pCurBuffer[CDC_OFFSET_SIZE]);
+    pEntries = (tObdCdcEntry*)OPLK_MALLOC(entryCount * sizeof(tObdCdcEntry));
+    if (pEntries == NULL)
+    {
+        ret = eventu_postError(kEventSourceObdu, kErrorObdOutOfMemory, 0, NULL);
+        if (ret != kErrorOk)
+            return ret;
+        return kErrorReject;
+    }
 
-        DEBUG_LVL_OBD_TRACE("%s: Reading object 0x%04X/%u with size %u from CDC\n",
-                             __func__, objectIndex, objectSubIndex, curDataSize);
-        if ((ret = loadNextBuffer(pCdcInfo_p, curDataSize)) != kErrorOk)
-        {
-            DEBUG_LVL_OBD_TRACE("%s: Reading the corresponding data from CDC failed with 0x%02X\n", __func__, ret);
+    ret = parseCdc(pCdc_p, cdcSize_p, pEntries, entryCount);
+    if (ret != kErrorOk)
+        goto Exit;
+
+    ret = applyEntries(pEntries, entryCount);
+
+Exit:
+    OPLK_FREE(pEntries);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Parse and validate Concise Device Configuration
+
+The function walks once through the CDC, checks that all entries are
+completely contained in the CDC and stores their descriptors in the entry
+table.
+
+\param  pCdc_p          Pointer to the CDC in memory.
+\param  cdcSize_p       Size of the CDC.
+\param  pEntries_p      Pointer to the entry table.
+\param  entryCount_p    Number of entries in the CDC.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError parseCdc(UINT8* pCdc_p, size_t cdcSize_p, tObdCdcEntry* pEntries_p,
+                           UINT32 entryCount_p)
+{
+    tOplkError      ret = kErrorOk;
+    UINT8*          pCur = pCdc_p + sizeof(UINT32);
+    size_t          remaining = cdcSize_p - sizeof(UINT32);
+    size_t          curDataSize;
+    UINT32          entry;
+
+    for (entry = 0; entry < entryCount_p; entry++)
+    {
+        if (remaining < CDC_OFFSET_DATA)
+            break;
+
+        curDataSize = (size_t)ami_getUint32Le(&pCur[CDC_OFFSET_SIZE]);
+        if ((remaining - CDC_OFFSET_DATA) < curDataSize)
+            break;
+
+        pEntries_p[entry].index = ami_getUint16Le(&pCur[CDC_OFFSET_INDEX]);
+        pEntries_p[entry].subIndex = ami_getUint8Le(&pCur[CDC_OFFSET_SUBINDEX]);
+        pEntries_p[entry].size = (tObdSize)curDataSize;
+        pEntries_p[entry].pData = &pCur[CDC_OFFSET_DATA];
+
+        pCur += CDC_OFFSET_DATA + curDataSize;
+        remaining -= CDC_OFFSET_DATA + curDataSize;
+    }
+
+    if (entry < entryCount_p)
+    {
+        DEBUG_LVL_OBD_TRACE("%s: CDC is truncated at entry %u of %u\n",
+                             __func__, entry, entryCount_p);
+        ret = eventu_postError(kEventSourceObdu, kErrorObdInvalidDcf, 0, NULL);
+        if (ret != kErrorOk)
             return ret;
-        }
+        return kErrorReject;
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Apply CDC entries to the OD
+
+The function writes all entries of the entry table into the OD in the order
+of the CDC. Errors of
+single objects are posted to the application and do not abort the loading.
+
+\param  pEntries_p      Pointer to the entry table.
+\param  entryCount_p    Number of entries in the table.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError applyEntries(tObdCdcEntry* pEntries_p, UINT32 entryCount_p)
+{
+    tOplkError      ret = kErrorOk;
+    tObdCdcEntry*   pEntry;
+
+    for (pEntry = pEntries_p; pEntry < &pEntries_p[entryCount_p]; pEntry++)
+    {
+        DEBUG_LVL_OBD_TRACE("%s: Writing object 0x%04X/%u with size %u from CDC\n",
+                             __func__, pEntry->index, pEntry->subIndex, pEntry->size);
 
-        ret = obd_writeEntryFromLe(objectIndex, objectSubIndex, pCdcInfo_p->pCurBuffer,
-                                     (tObdSize) curDataSize);
+        ret = obd_writeEntryFromLe(pEntry->index, pEntry->subIndex, pEntry->pData, pEntry->size);
         if (ret != kErrorOk)
         {
             tEventObdError          obdError;
 
-            obdError.index = objectIndex;
-            obdError.subIndex = objectSubIndex;
+            obdError.index = pEntry->index;
+            obdError.subIndex = pEntry->subIndex;
 
             DEBUG_LVL_OBD_TRACE("%s: Writing object 0x%04X/%u to local OBD failed with 0x%02X\n",
-                                 __func__, objectIndex, objectSubIndex, ret);
+                                 __func__, pEntry->index, pEntry->subIndex, ret);
             ret = eventu_postError(kEventSourceObdu, ret, sizeof(tEventObdError), &obdError);
             if (ret != kErrorOk)
                 return ret;
@@ -443,76 +543,73 @@ static tOplkError processCdc(tObdCdcInfo* pCdcInfo_p)
 
 //------------------------------------------------------------------------------
 /**
-\brief  Load next CDC buffer
+\brief  Map CDC file into memory
 
-The function loads the next buffer from the CDC
+The function makes the whole CDC file accessible in memory. On Linux the file
+is mapped private and writable, so object callbacks may modify the source data
+without touching the file. On other targets the file is read into a buffer.
 
-\param  pCdcInfo_p      Pointer to the CDC information.
-\param  bufferSize      Size of the buffer.
+\param  fdCdcFile_p     File descriptor of the CDC file.
+\param  cdcSize_p       Size of the CDC file.
 
-\return The function returns a tOplkError error code.
+\return The function returns a pointer to the CDC in memory or NULL on error.
 */
 //------------------------------------------------------------------------------
-static tOplkError loadNextBuffer(tObdCdcInfo* pCdcInfo_p, size_t bufferSize)
+static UINT8* mapCdcFile(FD_TYPE fdCdcFile_p, size_t cdcSize_p)
 {
-    tOplkError  ret = kErrorOk;
-    int         readSize;
+#if (TARGET_SYSTEM == _LINUX_)
+    void*       pCdc;
+
+    pCdc = mmap(NULL, cdcSize_p, PROT_READ | PROT_WRITE, MAP_PRIVATE, fdCdcFile_p, 0);
+    if (pCdc == MAP_FAILED)
+        return NULL;
+
+    posix_madvise(pCdc, cdcSize_p, POSIX_MADV_SEQUENTIAL);
+    return (UINT8*)pCdc;
+#else
+    UINT8*      pCdc;
     UINT8*      pBuffer;
+    size_t      remaining = cdcSize_p;
+    int         readSize;
 
-    switch (pCdcInfo_p->type)
-    {
-        case kEplObdCdcTypeFile:
-            if (pCdcInfo_p->bufferSize < bufferSize)
-            {
-                if (pCdcInfo_p->pCurBuffer != NULL)
-                {
-                    OPLK_FREE(pCdcInfo_p->pCurBuffer);
-                    pCdcInfo_p->pCurBuffer = NULL;
-                    pCdcInfo_p->bufferSize = 0;
-                }
-                pCdcInfo_p->pCurBuffer = OPLK_MALLOC(bufferSize);
-                if (pCdcInfo_p->pCurBuffer == NULL)
-                {
-                    ret = eventu_postError(kEventSourceObdu, kErrorObdOutOfMemory, 0, NULL);
-                    if (ret != kErrorOk)
-                        return ret;
-                    return kErrorReject;
-                }
-                pCdcInfo_p->bufferSize = bufferSize;
-            }
-            pBuffer = pCdcInfo_p->pCurBuffer;
-            do
-            {
-                readSize = read(pCdcInfo_p->handle.fdCdcFile, pBuffer, bufferSize);
-                if (readSize <= 0)
-                {
-                    ret = eventu_postError(kEventSourceObdu, kErrorObdInvalidDcf, 0, NULL);
-                    if (ret != kErrorOk)
-                        return ret;
-                    return kErrorReject;
-                }
-                pBuffer += readSize;
-                bufferSize -= readSize;
-                pCdcInfo_p->cdcSize -= readSize;
-            }
-            while (bufferSize > 0);
-            break;
+    pCdc = (UINT8*)OPLK_MALLOC(cdcSize_p);
+    if (pCdc == NULL)
+        return NULL;
 
-        case kEplObdCdcTypeBuffer:
-            if (pCdcInfo_p->bufferSize < bufferSize)
-            {
-                ret = eventu_postError(kEventSourceObdu, kErrorObdInvalidDcf, 0, NULL);
-                if (ret != kErrorOk)
-                    return ret;
-                return kErrorReject;
-            }
-            pCdcInfo_p->pCurBuffer = pCdcInfo_p->handle.pNextBuffer;
-            pCdcInfo_p->handle.pNextBuffer += bufferSize;
-            pCdcInfo_p->bufferSize -= bufferSize;
-            break;
+    pBuffer = pCdc;
+    while (remaining > 0)
+    {
+        readSize = read(fdCdcFile_p, pBuffer, remaining);
+        if (readSize <= 0)
+        {
+            OPLK_FREE(pCdc);
+            return NULL;
+        }
+        pBuffer += readSize;
+        remaining -= readSize;
     }
+    return pCdc;
+#endif
+}
 
-    return ret;
+//------------------------------------------------------------------------------
+/**
+\brief  Unmap CDC file
+
+The function releases the memory of a CDC file mapped by mapCdcFile().
+
+\param  pCdc_p          Pointer to the CDC in memory.
+\param  cdcSize_p       Size of the CDC file.
+*/
+//------------------------------------------------------------------------------
+static void unmapCdcFile(UINT8* pCdc_p, size_t cdcSize_p)
+{
+#if (TARGET_SYSTEM == _LINUX_)
+    munmap(pCdc_p, cdcSize_p);
+#else
+    UNUSED_PARAMETER(cdcSize_p);
+    OPLK_FREE(pCdc_p);
+#endif
 }
 
 ///\}
@@ -139,6 +139,12 @@ static UINT         calcPdoMemSize(tPdoChannelSetup* pPdoChannels_p, size_t* pRx
                                    size_t* pTxPdoMemSize_p);
 static tOplkError   copyVarToPdo(BYTE* pPayload_p, tPdoMappObject* pMappObject_p);
 static tOplkError   copyVarFromPdo(BYTE* pPayload_p, tPdoMappObject* pMappObject_p);
+static UINT         getArrayElementSize(tPdoMappObject* pMappObject_p);
+static UINT         getArrayLength(tPdoMappObject* pMappObject_p, UINT mappObjectCount_p);
+static void         copyArrayToPdo(BYTE* pPayload_p, tPdoMappObject* pMappObject_p,
+                                   UINT arrayLength_p);
+static void         copyArrayFromPdo(BYTE* pPayload_p, tPdoMappObject* pMappObject_p,
+                                     UINT arrayLength_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -343,6 +349,7 @@ tOplkError pdou_copyRxPdoToPi (void)
 {
     tOplkError          Ret;
     UINT                mappObjectCount;
+    UINT                arrayLength;
     tPdoChannel*        pPdoChannel;
     tPdoMappObject*     pMappObject;
     UINT                channelId;
@@ -372,8 +379,15 @@ tOplkError pdou_copyRxPdoToPi (void)
         for (mappObjectCount = pPdoChannel->mappObjectCount,
              pMappObject = pdouInstance_g.paRxObject + (channelId * D_PDO_RPDOChannelObjects_U8);
              mappObjectCount > 0;
-             mappObjectCount--, pMappObject++)
+             mappObjectCount -= arrayLength, pMappObject += arrayLength)
         {
+            arrayLength = getArrayLength(pMappObject, mappObjectCount);
+            if (arrayLength > 1)
+            {
+                copyArrayFromPdo(pPdo, pMappObject, arrayLength);
+                continue;
+            }
+
             Ret = copyVarFromPdo(pPdo, pMappObject);
             if (Ret != kErrorOk)
             {   // other fatal error occurred
@@ -401,6 +415,7 @@ tOplkError pdou_copyTxPdoFromPi (void)
 {
     tOplkError          ret = kErrorOk;
     UINT                mappObjectCount;
+    UINT                arrayLength;
     tPdoChannel*        pPdoChannel;
     tPdoMappObject*     pMappObject;
     UINT                channelId;
@@ -430,8 +445,15 @@ tOplkError pdou_copyTxPdoFromPi (void)
         for (mappObjectCount = pPdoChannel->mappObjectCount,
              pMappObject = pdouInstance_g.paTxObject + (channelId * D_PDO_TPDOChannelObjects_U8);
              mappObjectCount > 0;
-             mappObjectCount--, pMappObject++)
+             mappObjectCount -= arrayLength, pMappObject += arrayLength)
         {
+            arrayLength = getArrayLength(pMappObject, mappObjectCount);
+            if (arrayLength > 1)
+            {
+                copyArrayToPdo(pPdo, pMappObject, arrayLength);
+                continue;
+            }
+
             ret = copyVarToPdo(pPdo, pMappObject);
             if (ret != kErrorOk)
             {   // other fatal error occurred
@@ -1219,8 +1241,8 @@ static tOplkError checkAndSetObjectMapping(QWORD objectMapping_p,
     UINT                bitSize;
     UINT                byteSize;
     tObdAccess          accessType;
-    BOOL                fNumerical;
     tObdType            obdType;
+    tObdEntryHdl        obdHdl;
     void*               pVar;
 
     if (objectMapping_p == 0)
@@ -1239,13 +1261,15 @@ static tOplkError checkAndSetObjectMapping(QWORD objectMapping_p,
         goto Exit;
     }
 
-    ret = obd_getType(index, subIndex, &obdType);
+    // resolve object once and take all needed information from the handle
+    ret = obd_resolveEntry(index, subIndex, &obdHdl);
     if (ret != kErrorOk)
     {   // entry doesn't exist
         *pAbortCode_p = SDO_AC_OBJECT_NOT_EXIST;
         ret = kErrorPdoVarNotFound;
         goto Exit;
     }
+    obdType = obdHdl.type;
 
     if (((bitSize & 0x7) != 0x0) &&
         ((bitSize != 1) || (obdType != kObdTypeBool)))
@@ -1256,14 +1280,7 @@ static tOplkError checkAndSetObjectMapping(QWORD objectMapping_p,
     }
 
     // check access type
-    ret = obd_getAccessType(index, subIndex, &accessType);
-    if (ret != kErrorOk)
-    {   // entry doesn't exist
-        *pAbortCode_p = SDO_AC_OBJECT_NOT_EXIST;
-        ret = kErrorPdoVarNotFound;
-        goto Exit;
-    }
-
+    accessType = obdHdl.access;
     if ((accessType & kObdAccPdo) == 0)
     {   // object is not mappable
         *pAbortCode_p = SDO_AC_OBJECT_NOT_MAPPABLE;
@@ -1287,22 +1304,15 @@ static tOplkError checkAndSetObjectMapping(QWORD objectMapping_p,
         byteSize = (bitSize >> 3);
     }
 
-    obdSize = obd_getDataSize(index, subIndex);
+    obdSize = obdHdl.size;
     if (obdSize < byteSize)
     {   // object does not exist or has smaller size
+        // numerical objects are rejected below, non-numerical objects may grow later
         *pAbortCode_p = SDO_AC_GENERAL_ERROR;
-        ret = kErrorPdoSizeMismatch;
         // todo really don't want to exit here?
     }
 
-    ret = obd_isNumerical(index, subIndex, &fNumerical);
-    if (ret != kErrorOk)
-    {   // entry doesn't exist
-        *pAbortCode_p = SDO_AC_OBJECT_NOT_EXIST;
-        goto Exit;
-    }
-
-    if ((fNumerical != FALSE) && (byteSize != obdSize))
+    if ((obdHdl.fNumerical != FALSE) && (byteSize != obdSize))
     {
         // object is numerical,
         // therefore size has to fit, but it does not.
@@ -1311,7 +1321,7 @@ static tOplkError checkAndSetObjectMapping(QWORD objectMapping_p,
         goto Exit;
     }
 
-    pVar = obd_getObjectDataPtr(index, subIndex);
+    pVar = obdHdl.pData;
     if (pVar == NULL)
     {   // entry doesn't exist
         *pAbortCode_p = SDO_AC_OBJECT_NOT_EXIST;
@@ -1639,6 +1649,172 @@ static tOplkError copyVarFromPdo(BYTE* pPayload_p, tPdoMappObject* pMappObject_p
     return Ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get array element size of mapping object
+
+The function determines whether a mapping object can be converted as part of
+an array. This is the case for all numerical types whose size in the PDO
+payload is equal to the size of the variable in the process image.
+
+\param  pMappObject_p       Pointer to mapping object.
+
+\return The function returns the size of the variable in bytes or 0 if the
+        mapping object cannot be part of an array.
+*/
+//------------------------------------------------------------------------------
+static UINT getArrayElementSize(tPdoMappObject* pMappObject_p)
+{
+    switch (PDO_MAPPOBJECT_GET_TYPE(pMappObject_p))
+    {
+        case kObdTypeInt8:
+        case kObdTypeUInt8:
+            return 1;
+
+        case kObdTypeInt16:
+        case kObdTypeUInt16:
+            return 2;
+
+        case kObdTypeInt32:
+        case kObdTypeUInt32:
+        case kObdTypeReal32:
+            return 4;
+
+        case kObdTypeInt64:
+        case kObdTypeUInt64:
+        case kObdTypeReal64:
+            return 8;
+
+        default:
+            return 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get array length of mapping objects
+
+The function counts the consecutive mapping objects starting at the specified
+one which form an array, i.e. which have the same numerical type and are
+placed back to back in the PDO payload as well as in the process image. This
+is usually the case if the subindices of an array object are mapped in order.
+Such a sequence is converted with a single ami array function instead of
+converting each variable separately.
+
+\param  pMappObject_p       Pointer to first mapping object.
+\param  mappObjectCount_p   Number of remaining mapping objects of the channel.
+
+\return The function returns the number of mapping objects forming the array.
+        It returns 1 if the mapping object has to be converted separately.
+*/
+//------------------------------------------------------------------------------
+static UINT getArrayLength(tPdoMappObject* pMappObject_p, UINT mappObjectCount_p)
+{
+    UINT                elemSize;
+    UINT                arrayLength;
+    tPdoMappObject*     pNext;
+
+    elemSize = getArrayElementSize(pMappObject_p);
+    if ((elemSize == 0) || ((PDO_MAPPOBJECT_GET_BITOFFSET(pMappObject_p) & 0x7) != 0))
+        return 1;
+
+    for (arrayLength = 1, pNext = pMappObject_p + 1;
+         arrayLength < mappObjectCount_p;
+         arrayLength++, pNext++)
+    {
+        if ((pNext->byteSizeOrType != pMappObject_p->byteSizeOrType) ||
+            (PDO_MAPPOBJECT_GET_BITOFFSET(pNext) !=
+             PDO_MAPPOBJECT_GET_BITOFFSET(pMappObject_p) + (arrayLength * elemSize * 8)) ||
+            ((BYTE*)PDO_MAPPOBJECT_GET_VAR(pNext) !=
+             (BYTE*)PDO_MAPPOBJECT_GET_VAR(pMappObject_p) + (arrayLength * elemSize)))
+        {
+            break;
+        }
+    }
+
+    return arrayLength;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Copy array to PDO
+
+This function copies an array of variables specified by consecutive mapping
+objects to the PDO payload.
+
+\param  pPayload_p          Pointer to PDO payload in destination frame.
+\param  pMappObject_p       Pointer to first mapping object of the array.
+\param  arrayLength_p       Number of mapping objects forming the array.
+*/
+//------------------------------------------------------------------------------
+static void copyArrayToPdo(BYTE* pPayload_p, tPdoMappObject* pMappObject_p,
+                           UINT arrayLength_p)
+{
+    void*       pVar;
+
+    pPayload_p += PDO_MAPPOBJECT_GET_BITOFFSET(pMappObject_p) >> 3;
+    pVar = PDO_MAPPOBJECT_GET_VAR(pMappObject_p);
+
+    switch (getArrayElementSize(pMappObject_p))
+    {
+        case 2:
+            ami_setUint16ArrayLe(pPayload_p, (UINT16*)pVar, arrayLength_p);
+            break;
+
+        case 4:
+            ami_setUint32ArrayLe(pPayload_p, (UINT32*)pVar, arrayLength_p);
+            break;
+
+        case 8:
+            ami_setUint64ArrayLe(pPayload_p, (UINT64*)pVar, arrayLength_p);
+            break;
+
+        default:
+            OPLK_MEMCPY(pPayload_p, pVar, arrayLength_p);
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Copy array from PDO
+
+This function copies an array of variables specified by consecutive mapping
+objects from the PDO payload.
+
+\param  pPayload_p          Pointer to PDO payload in source frame.
+\param  pMappObject_p       Pointer to first mapping object of the array.
+\param  arrayLength_p       Number of mapping objects forming the array.
+*/
+//------------------------------------------------------------------------------
+static void copyArrayFromPdo(BYTE* pPayload_p, tPdoMappObject* pMappObject_p,
+                             UINT arrayLength_p)
+{
+    void*       pVar;
+
+    pPayload_p += PDO_MAPPOBJECT_GET_BITOFFSET(pMappObject_p) >> 3;
+    pVar = PDO_MAPPOBJECT_GET_VAR(pMappObject_p);
+
+    switch (getArrayElementSize(pMappObject_p))
+    {
+        case 2:
+            ami_getUint16ArrayLe(pPayload_p, (UINT16*)pVar, arrayLength_p);
+            break;
+
+        case 4:
+            ami_getUint32ArrayLe(pPayload_p, (UINT32*)pVar, arrayLength_p);
+            break;
+
+        case 8:
+            ami_getUint64ArrayLe(pPayload_p, (UINT64*)pVar, arrayLength_p);
+            break;
+
+        default:
+            OPLK_MEMCPY(pVar, pPayload_p, arrayLength_p);
+            break;
+    }
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Calculate PDO memory size
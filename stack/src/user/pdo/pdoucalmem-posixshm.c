@@ -43,13 +43,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 #include <oplk/oplkinc.h>
 #include <common/pdo.h>
-
-#include <unistd.h>
-#include <sys/types.h>
-#include <sys/stat.h>
-#include <fcntl.h>
-#include <sys/mman.h>
-#include <errno.h>
+#include <common/shmem.h>
 
 
 //============================================================================//
@@ -83,7 +77,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
-static int                  fd_l;
+static tShmemRegion         shmRegion_l;
 
 //------------------------------------------------------------------------------
 // local function prototypes
@@ -100,7 +94,8 @@ static int                  fd_l;
 The function performs all actions needed to setup the shared memory at
 starting of the stack.
 
-For the Posix shared-memory implementation it opens the shared memory segment.
+For the Posix shared-memory implementation nothing needs to be done. The
+shared memory segment is attached when the PDO memory is allocated.
 
 \return The function returns a tOplkError error code.
 
@@ -109,11 +104,6 @@ For the Posix shared-memory implementation it opens the shared memory segment.
 //------------------------------------------------------------------------------
 tOplkError pdoucal_openMem(void)
 {
-    if ((fd_l = shm_open(PDO_SHMEM_NAME, O_RDWR, 0)) < 0)
-    {
-        TRACE ("%s() Error open shared memory!\n", __func__);
-        return kErrorNoResource;
-    }
     return kErrorOk;
 }
 
@@ -133,7 +123,7 @@ For the Posix shared-memory implementation it unlinks the shared memory segment.
 //------------------------------------------------------------------------------
 tOplkError pdoucal_closeMem(void)
 {
-    shm_unlink(PDO_SHMEM_NAME);
+    shmem_unlink(PDO_SHMEM_NAME);
     return kErrorOk;
 }
 
@@ -153,14 +143,14 @@ The function allocates shared memory for the user needed to transfer the PDOs.
 //------------------------------------------------------------------------------
 tOplkError pdoucal_allocateMem(size_t memSize_p, BYTE** ppPdoMem_p)
 {
-    *ppPdoMem_p = mmap(NULL, memSize_p, PROT_READ | PROT_WRITE, MAP_SHARED,
-                     fd_l, 0);
-    if (*ppPdoMem_p == MAP_FAILED)
+    if (shmem_map(PDO_SHMEM_NAME, memSize_p, kShmemModeAttach, &shmRegion_l) != kErrorOk)
     {
-        TRACE ("%s() mmap failed!\n", __func__);
+        TRACE ("%s() mapping shared memory failed!\n", __func__);
         *ppPdoMem_p = NULL;
         return kErrorNoResource;
     }
+
+    *ppPdoMem_p = (BYTE*)shmRegion_l.pBase;
     return kErrorOk;
 }
 
@@ -181,11 +171,15 @@ transfering the PDOs.
 //------------------------------------------------------------------------------
 tOplkError pdoucal_freeMem(BYTE* pMem_p, size_t memSize_p)
 {
-    if(munmap(pMem_p, memSize_p) != 0)
+    UNUSED_PARAMETER(memSize_p);
+
+    if (pMem_p != (BYTE*)shmRegion_l.pBase)
     {
-        TRACE ("%s() munmap failed (%s)\n", __func__, strerror(errno));
+        TRACE ("%s() invalid PDO memory!\n", __func__);
         return kErrorGeneralError;
     }
+
+    shmem_unmap(&shmRegion_l);
     return kErrorOk;
 }
 
@@ -1,11 +1,13 @@
 /**
 ********************************************************************************
-\file   pdoucalsync-bsdsem.c
+\file   pdoucalsync-futex.c
 
-\brief  Sync implementation for the PDO user CAL module using BSD semaphores
+\brief  Sync implementation for the PDO user CAL module using a shared sync word
 
 This file contains a sync implementation for the PDU user CAL module. It
-uses BSD semaphores for synchronisation.
+waits with a futex on the cycle number of a sync word in POSIX shared memory
+which is incremented by the kernel layer on every sync event. A waiter always
+wakes up on the latest cycle and gets the number of cycles it has missed.
 
 \ingroup module_pdoucal
 *******************************************************************************/
@@ -40,15 +42,18 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // includes
 //------------------------------------------------------------------------------
-#include <fcntl.h>
-#include <sys/stat.h>
-#include <semaphore.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 #include <time.h>
+#include <errno.h>
+#include <linux/futex.h>
 
 #include <oplk/oplkinc.h>
 #include <common/pdo.h>
 #include <user/pdoucal.h>
-#include <errno.h>
+#include <common/shmem.h>
+#include <oplk/tracering.h>
+
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
 //============================================================================//
@@ -81,7 +86,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
-static sem_t*           syncSem_l;
+static tShmemRegion     shmRegion_l;
+static tPdoSyncWord*    pSyncWord_l = NULL;
+static UINT32           lastCycleNumber_l;
 
 //------------------------------------------------------------------------------
 // local function prototypes
@@ -106,11 +113,14 @@ tOplkError pdoucal_initSync(tSyncCb pfnSyncCb_p)
 {
     UNUSED_PARAMETER(pfnSyncCb_p);
 
-    if ((syncSem_l = sem_open(PDO_SYNC_BSDSEM, O_CREAT, S_IRWXG, 1)) == SEM_FAILED)
+    if (shmem_map(PDO_SYNC_SHM, sizeof(tPdoSyncWord), kShmemModeCreate, &shmRegion_l) != kErrorOk)
     {
-        TRACE ("%s() creating sem failed!\n", __func__);
+        TRACE("%s() opening sync shared memory failed!\n", __func__);
         return kErrorNoResource;
     }
+
+    pSyncWord_l = (tPdoSyncWord*)shmRegion_l.pBase;
+    lastCycleNumber_l = pSyncWord_l->cycleNumber;
     return kErrorOk;
 }
 
@@ -123,54 +133,84 @@ The function cleans up the PDO user CAL sync module
 //------------------------------------------------------------------------------
 void pdoucal_exitSync(void)
 {
-    sem_close(syncSem_l);
+    if (pSyncWord_l != NULL)
+    {
+        shmem_unmap(&shmRegion_l);
+        pSyncWord_l = NULL;
+    }
 }
 
 //------------------------------------------------------------------------------
 /**
 \brief  Wait for a sync event
 
-The function waits for a sync event.
+The function waits for a sync event. If sync events have occurred since the
+last call, it returns immediately with the latest one. Missed sync events are
+reported in the sync event information instead of being delivered one by one.
 
 \param  timeout_p       Specifies a timeout in microseconds. If 0 it waits
                         forever.
+\param  pSyncInfo_p     Pointer to store the information about the received
+                        sync event. May be NULL.
 
 \return The function returns a tOplkError error code.
 \retval kErrorOk      Successfully received sync event
 \retval kErrorGeneralError    Error while waiting on sync event
 */
 //------------------------------------------------------------------------------
-tOplkError pdoucal_waitSyncEvent(ULONG timeout_p)
+tOplkError pdoucal_waitSyncEvent(ULONG timeout_p, tSyncEventInfo* pSyncInfo_p)
 {
-    int                 semRet;
+    UINT32              cycleNumber;
+    UINT64              timestamp;
     struct timespec     currentTime;
-    struct timespec     semTimeout;
+    struct timespec     deadline;
+    struct timespec*    pDeadline = NULL;
+
+    if (pSyncWord_l == NULL)
+        return kErrorGeneralError;
 
     if (timeout_p != 0)
     {
-        if (timeout_p >= 1000000)
+        deadline.tv_sec = (timeout_p / 1000000);
+        deadline.tv_nsec = (timeout_p % 1000000) * 1000;
+        clock_gettime(CLOCK_MONOTONIC, &currentTime);
+        TIMESPECADD(&deadline, &currentTime);
+        pDeadline = &deadline;
+    }
+
+    for (;;)
+    {
+        cycleNumber = pSyncWord_l->cycleNumber;
+        OPLK_MEMBAR();
+        timestamp = pSyncWord_l->aTimestamp[cycleNumber & 1];
+        OPLK_MEMBAR();
+
+        if (cycleNumber != lastCycleNumber_l)
         {
-            semTimeout.tv_sec = (timeout_p / 1000000);
-            semTimeout.tv_nsec = (timeout_p % 1000000) * 1000 ;
+            // retry if the timestamp slot could have been overwritten meanwhile
+            if ((UINT32)(pSyncWord_l->cycleNumber - cycleNumber) >= 2)
+                continue;
+            break;
         }
-        else
+
+        if ((syscall(SYS_futex, &pSyncWord_l->cycleNumber, FUTEX_WAIT_BITSET,
+                     cycleNumber, pDeadline, NULL, FUTEX_BITSET_MATCH_ANY) != 0) &&
+            (errno == ETIMEDOUT))
         {
-            semTimeout.tv_sec = 0;
-            semTimeout.tv_nsec = timeout_p * 1000;
+            return kErrorGeneralError;
         }
-        clock_gettime(CLOCK_REALTIME, &currentTime);
-        TIMESPECADD(&semTimeout, &currentTime);
-        semRet = sem_timedwait(syncSem_l, &semTimeout);
     }
-    else
+
+    if (pSyncInfo_p != NULL)
     {
-        semRet = sem_wait(syncSem_l);
+        pSyncInfo_p->cycleNumber = cycleNumber;
+        pSyncInfo_p->skippedCycles = cycleNumber - lastCycleNumber_l - 1;
+        pSyncInfo_p->timestamp = timestamp;
     }
+    lastCycleNumber_l = cycleNumber;
+    TRACE_RING(kTraceIdSyncWakeup, cycleNumber);
 
-    if (semRet == 0)
-        return kErrorOk;
-    else
-        return kErrorGeneralError;
+    return kErrorOk;
 }
 
 //============================================================================//
@@ -85,6 +85,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // local vars
 //------------------------------------------------------------------------------
 static int              fd_l;
+static UINT32           syncCycleNumber_l = 0;
 
 //------------------------------------------------------------------------------
 // local function prototypes
@@ -132,22 +133,31 @@ The function waits for a sync event.
 
 \param  timeout_p       Specifies a timeout in microseconds. If 0 it waits
                         forever.
+\param  pSyncInfo_p     Pointer to store the information about the received
+                        sync event. May be NULL. Missed sync events cannot be
+                        detected by this implementation.
 
 \return The function returns a tOplkError error code.
 \retval kErrorOk      Successfully received sync event
 \retval kErrorGeneralError    Error while waiting on sync event
 */
 //------------------------------------------------------------------------------
-tOplkError pdoucal_waitSyncEvent(ULONG timeout_p)
+tOplkError pdoucal_waitSyncEvent(ULONG timeout_p, tSyncEventInfo* pSyncInfo_p)
 {
     int         ret;
 
     ret = ioctl(fd_l, PLK_CMD_PDO_SYNC, timeout_p);
-    if (ret == 0)
+    if (ret != 0)
+        return kErrorGeneralError;
+
+    if (pSyncInfo_p != NULL)
     {
-        return kErrorOk;
+        pSyncInfo_p->cycleNumber = ++syncCycleNumber_l;
+        pSyncInfo_p->skippedCycles = 0;
+        pSyncInfo_p->timestamp = 0;
     }
-    return kErrorGeneralError;
+
+    return kErrorOk;
 }
 
 //============================================================================//
@@ -42,6 +42,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // includes
 //------------------------------------------------------------------------------
 #include <user/timeru.h>
+#include <common/target.h>
 
 #include <stdio.h>
 #include <unistd.h>
@@ -146,7 +147,6 @@ The function adds a user timer instance.
 //------------------------------------------------------------------------------
 tOplkError timeru_addInstance(void)
 {
-    struct sched_param          schedParam;
     INT                         retVal;
 
     // reset instance structure
@@ -169,13 +169,7 @@ tOplkError timeru_addInstance(void)
         return kErrorNoResource;
     }
 
-    schedParam.__sched_priority = CONFIG_THREAD_PRIORITY_LOW;
-    if (pthread_setschedparam(timeruInstance_g.processThread, SCHED_RR,
-                              &schedParam) != 0)
-    {
-        DEBUG_LVL_ERROR_TRACE("%s() couldn't set thread scheduling parameters!\n",
-                                __func__);
-    }
+    target_setupThread(timeruInstance_g.processThread, kOplkThreadTimerUser);
 
     return kErrorOk;
 }
@@ -477,6 +471,8 @@ static void* processThread(void *pArgument_p)
 
     DEBUG_LVL_TIMERU_TRACE("%s() ThreadId:%d\n", __func__, syscall(SYS_gettid));
 
+    target_prefaultThreadStack();
+
     sigemptyset(&awaitedSignal);
     sigaddset(&awaitedSignal, SIGRTMIN);
     pthread_sigmask(SIG_BLOCK, &awaitedSignal, NULL);
@@ -0,0 +1,93 @@
+/**
+********************************************************************************
+\file   benchami-call.c
+
+\brief  ami benchmark loops calling the exported accessors
+
+The file contains the ami benchmark loops which call the exported accessor
+functions of the stack library. They are the reference for the inline
+accessors and the array functions. The file is compiled with AMI_OUT_OF_LINE,
+therefore ami.h only provides the function prototypes.
+*******************************************************************************/
+
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2014, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+// Call the exported functions instead of the inline versions of ami.h
+#define AMI_OUT_OF_LINE
+
+#include <oplk/ami.h>
+
+#include "oplkbench.h"
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+// Generates the loops which write and read values of the specified type
+#define BENCHAMICALL_LOOPS(bits_p, order_p)                                     \
+void benchamicall_setUint##bits_p##order_p(void* pFrame_p, void* pImage_p,      \
+                                           UINT count_p)                        \
+{                                                                               \
+    UINT8*                  pFrame = (UINT8*)pFrame_p;                          \
+    const UINT##bits_p*     pImage = (const UINT##bits_p*)pImage_p;            \
+    UINT                    index;                                              \
+                                                                                \
+    for (index = 0; index < count_p; index++)                                   \
+        ami_setUint##bits_p##order_p(pFrame + (index * (bits_p / 8)),           \
+                                     pImage[index]);                            \
+}                                                                               \
+                                                                                \
+void benchamicall_getUint##bits_p##order_p(void* pFrame_p, void* pImage_p,      \
+                                           UINT count_p)                        \
+{                                                                               \
+    UINT8*                  pFrame = (UINT8*)pFrame_p;                          \
+    UINT##bits_p*           pImage = (UINT##bits_p*)pImage_p;                   \
+    UINT                    index;                                              \
+                                                                                \
+    for (index = 0; index < count_p; index++)                                   \
+        pImage[index] = ami_getUint##bits_p##order_p(pFrame + (index * (bits_p / 8))); \
+}
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+BENCHAMICALL_LOOPS(16, Le)
+BENCHAMICALL_LOOPS(16, Be)
+BENCHAMICALL_LOOPS(32, Le)
+BENCHAMICALL_LOOPS(32, Be)
+BENCHAMICALL_LOOPS(64, Le)
+BENCHAMICALL_LOOPS(64, Be)
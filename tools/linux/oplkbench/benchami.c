@@ -0,0 +1,254 @@
+/**
+********************************************************************************
+\file   benchami.c
+
+\brief  ami benchmark
+
+The benchmark measures the conversion of process image values into PDO frames
+and back. Every accessor is measured in three variants:
+
+ - call:    A loop calling the exported accessor function for every value.
+ - inline:  A loop using the inline accessor of ami.h for every value.
+ - array:   A single call of the array conversion function.
+*******************************************************************************/
+
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2014, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+
+#include <oplk/ami.h>
+#include <oplk/frame.h>
+
+#include "oplkbench.h"
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+// Generates the loops which write and read values with the inline accessors
+#define BENCHAMI_INLINE_LOOPS(bits_p, order_p)                                  \
+static void setUint##bits_p##order_p##Inline(void* pFrame_p, void* pImage_p,    \
+                                             UINT count_p)                      \
+{                                                                               \
+    UINT8*                  pFrame = (UINT8*)pFrame_p;                          \
+    const UINT##bits_p*     pImage = (const UINT##bits_p*)pImage_p;            \
+    UINT                    index;                                              \
+                                                                                \
+    for (index = 0; index < count_p; index++)                                   \
+        ami_setUint##bits_p##order_p(pFrame + (index * (bits_p / 8)),           \
+                                     pImage[index]);                            \
+}                                                                               \
+                                                                                \
+static void getUint##bits_p##order_p##Inline(void* pFrame_p, void* pImage_p,    \
+                                             UINT count_p)                      \
+{                                                                               \
+    UINT8*                  pFrame = (UINT8*)pFrame_p;                          \
+    UINT##bits_p*           pImage = (UINT##bits_p*)pImage_p;                   \
+    UINT                    index;                                              \
+                                                                                \
+    for (index = 0; index < count_p; index++)                                   \
+        pImage[index] = ami_getUint##bits_p##order_p(pFrame + (index * (bits_p / 8))); \
+}                                                                               \
+                                                                                \
+static void setUint##bits_p##order_p##Array(void* pFrame_p, void* pImage_p,     \
+                                            UINT count_p)                       \
+{                                                                               \
+    ami_setUint##bits_p##Array##order_p(pFrame_p, (const UINT##bits_p*)pImage_p, count_p); \
+}                                                                               \
+                                                                                \
+static void getUint##bits_p##order_p##Array(void* pFrame_p, void* pImage_p,     \
+                                            UINT count_p)                       \
+{                                                                               \
+    ami_getUint##bits_p##Array##order_p(pFrame_p, (UINT##bits_p*)pImage_p, count_p); \
+}
+
+// Generates the benchmark table entries of an accessor
+#define BENCHAMI_ENTRIES(bits_p, order_p)                                       \
+    {"setUint" #bits_p #order_p, bits_p / 8, TRUE,                              \
+     {benchamicall_setUint##bits_p##order_p, setUint##bits_p##order_p##Inline,  \
+      setUint##bits_p##order_p##Array}},                                        \
+    {"getUint" #bits_p #order_p, bits_p / 8, FALSE,                             \
+     {benchamicall_getUint##bits_p##order_p, getUint##bits_p##order_p##Inline,  \
+      getUint##bits_p##order_p##Array}}
+
+#define BENCHAMI_VARIANT_COUNT      3
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief ami benchmark entry
+
+The structure describes the benchmarked variants of an accessor.
+*/
+typedef struct
+{
+    const char*     pName;                              ///< Name of the accessor
+    UINT            elementSize;                        ///< Size of a value in bytes
+    BOOL            fSet;                               ///< TRUE if the accessor writes the frame
+    tBenchAmiFunc   apfnVariant[BENCHAMI_VARIANT_COUNT];    ///< Benchmarked variants
+} tBenchAmiEntry;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void fillPattern(UINT8* pBuffer_p, size_t size_p, UINT8 seed_p);
+
+// the inline and array variants are referenced by the benchmark table
+BENCHAMI_INLINE_LOOPS(16, Le)
+BENCHAMI_INLINE_LOOPS(16, Be)
+BENCHAMI_INLINE_LOOPS(32, Le)
+BENCHAMI_INLINE_LOOPS(32, Be)
+BENCHAMI_INLINE_LOOPS(64, Le)
+BENCHAMI_INLINE_LOOPS(64, Be)
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static const char* aVariantName_l[BENCHAMI_VARIANT_COUNT] =
+{
+    "call",
+    "inline",
+    "array",
+};
+
+static const tBenchAmiEntry aBenchAmi_l[] =
+{
+    BENCHAMI_ENTRIES(16, Le),
+    BENCHAMI_ENTRIES(16, Be),
+    BENCHAMI_ENTRIES(32, Le),
+    BENCHAMI_ENTRIES(32, Be),
+    BENCHAMI_ENTRIES(64, Le),
+    BENCHAMI_ENTRIES(64, Be),
+};
+
+// The payload is placed at its offset in a PDO frame like in the stack
+static UINT8    aFrameBuffer_l[PLK_FRAME_OFFSET_PDO_PAYLOAD + (OPLKBENCH_AMI_ELEMENTS * 8)];
+static UINT64   aImage_l[OPLKBENCH_AMI_ELEMENTS];
+static UINT8    aReference_l[OPLKBENCH_AMI_ELEMENTS * 8];
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run the ami benchmark
+
+The function runs all variants of all benchmarked accessors and prints the
+results. Before measuring, the result of every variant is compared with the
+result of the exported function.
+
+\param  loops_p             Number of loops of every variant.
+
+\return The function returns 0 on success or -1 if the variants differ.
+*/
+//------------------------------------------------------------------------------
+int benchami_run(ULONG loops_p)
+{
+    UINT8*                  pFrame = &aFrameBuffer_l[PLK_FRAME_OFFSET_PDO_PAYLOAD];
+    const tBenchAmiEntry*   pEntry;
+    UINT                    variant;
+    UINT                    size;
+    ULONG                   loop;
+    UINT64                  startTime;
+
+    printf("# ami: %u values per loop, payload offset %u\n",
+           OPLKBENCH_AMI_ELEMENTS, PLK_FRAME_OFFSET_PDO_PAYLOAD);
+
+    for (pEntry = &aBenchAmi_l[0];
+         pEntry < &aBenchAmi_l[sizeof(aBenchAmi_l) / sizeof(aBenchAmi_l[0])];
+         pEntry++)
+    {
+        size = pEntry->elementSize * OPLKBENCH_AMI_ELEMENTS;
+
+        for (variant = 0; variant < BENCHAMI_VARIANT_COUNT; variant++)
+        {
+            fillPattern((UINT8*)aImage_l, size, 0x11);
+            fillPattern(pFrame, size, 0x5A);
+            pEntry->apfnVariant[variant](pFrame, aImage_l, OPLKBENCH_AMI_ELEMENTS);
+            if (variant == 0)
+                memcpy(aReference_l, pEntry->fSet ? pFrame : (UINT8*)aImage_l, size);
+            else if (memcmp(aReference_l, pEntry->fSet ? pFrame : (UINT8*)aImage_l, size) != 0)
+            {
+                fprintf(stderr, "ami_%s: result of variant %s differs!\n",
+                        pEntry->pName, aVariantName_l[variant]);
+                return -1;
+            }
+
+            startTime = oplkbench_getTimeNs();
+            for (loop = 0; loop < loops_p; loop++)
+            {
+                pEntry->apfnVariant[variant](pFrame, aImage_l, OPLKBENCH_AMI_ELEMENTS);
+                // keep the compiler from merging the loops
+                __asm__ __volatile__("" : : "r" (pFrame), "r" (aImage_l) : "memory");
+            }
+
+            oplkbench_printResult(pEntry->pName, aVariantName_l[variant],
+                                  oplkbench_getTimeNs() - startTime,
+                                  loops_p, OPLKBENCH_AMI_ELEMENTS, "value");
+        }
+    }
+
+    return 0;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Fill buffer with test pattern
+
+\param  pBuffer_p           Pointer to the buffer.
+\param  size_p              Size of the buffer.
+\param  seed_p              Start value of the pattern.
+*/
+//------------------------------------------------------------------------------
+static void fillPattern(UINT8* pBuffer_p, size_t size_p, UINT8 seed_p)
+{
+    size_t  index;
+
+    for (index = 0; index < size_p; index++)
+        pBuffer_p[index] = (UINT8)(seed_p + (index * 7));
+}
+
+///\}
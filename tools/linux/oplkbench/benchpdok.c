@@ -0,0 +1,340 @@
+/**
+********************************************************************************
+\file   benchpdok.c
+
+\brief  Kernel PDO RX forwarding benchmark
+
+The benchmark measures pdok_processRxPdo() for a cycle in which the MN
+receives the PRes of every configured CN. The kernel PDO module is compiled
+into the tool; its interfaces to the DLL and to the kernel PDO CAL are
+replaced by the stubs in this file. The stub of pdokcal_writeRxPdo() copies
+the RPDO into a per-channel buffer like the PDO buffer of the stack.
+
+The PDO module source can be selected with the CMake variable
+OPLKBENCH_PDOK_SOURCE to compare a different version of the module.
+*******************************************************************************/
+
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2014, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <oplk/ami.h>
+#include <oplk/frame.h>
+#include <kernel/pdok.h>
+#include <kernel/pdokcal.h>
+#include <kernel/dllk.h>
+
+#include "oplkbench.h"
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define BENCHPDOK_PDO_SIZE          32      ///< Size of the RPDO of every node
+#define BENCHPDOK_MAX_NODE_COUNT    239     ///< Maximum number of CNs of a POWERLINK network
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static const UINT   aNodeCount_l[] = {4, 32, 128, 239};
+
+static tPlkFrame*   apFrame_l[BENCHPDOK_MAX_NODE_COUNT];
+static UINT8        aRxPdoBuffer_l[BENCHPDOK_MAX_NODE_COUNT][BENCHPDOK_PDO_SIZE];
+static ULONG        rxPdoCount_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tOplkError setupChannels(UINT nodeCount_p);
+static int        checkRxPdos(UINT nodeCount_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run the kernel PDO RX forwarding benchmark
+
+The function measures the forwarding of the PRes frames of all nodes for
+different numbers of configured nodes and prints the results. Before
+measuring, the function checks that every RPDO is forwarded to the buffer of
+its channel.
+
+\param  loops_p             Number of cycles of every measurement.
+
+\return The function returns 0 on success or -1 on error.
+*/
+//------------------------------------------------------------------------------
+int benchpdok_run(ULONG loops_p)
+{
+    const UINT*     pNodeCount;
+    char            aName[32];
+    UINT            nodeId;
+    UINT            index;
+    ULONG           loop;
+    UINT64          startTime;
+    UINT            frameSize = PLK_FRAME_OFFSET_PDO_PAYLOAD + BENCHPDOK_PDO_SIZE;
+    int             result = 0;
+
+    printf("# pdok: PRes of all nodes per loop, RPDO size %u\n", BENCHPDOK_PDO_SIZE);
+
+    for (index = 0; index < BENCHPDOK_MAX_NODE_COUNT; index++)
+    {
+        nodeId = index + 1;
+        apFrame_l[index] = (tPlkFrame*)calloc(1, sizeof(tPlkFrame));
+        if (apFrame_l[index] == NULL)
+        {
+            result = -1;
+            goto Exit;
+        }
+
+        ami_setUint8Le(&apFrame_l[index]->messageType, (UINT8)kMsgTypePres);
+        ami_setUint8Le(&apFrame_l[index]->srcNodeId, (UINT8)nodeId);
+        ami_setUint8Le(&apFrame_l[index]->data.pres.flag1, PLK_FRAME_FLAG1_RD);
+        ami_setUint8Le(&apFrame_l[index]->data.pres.pdoVersion, 0);
+        memset(&apFrame_l[index]->data.pres.aPayload[0], (int)nodeId, BENCHPDOK_PDO_SIZE);
+    }
+
+    for (pNodeCount = &aNodeCount_l[0];
+         pNodeCount < &aNodeCount_l[sizeof(aNodeCount_l) / sizeof(aNodeCount_l[0])];
+         pNodeCount++)
+    {
+        if (setupChannels(*pNodeCount) != kErrorOk)
+        {
+            fprintf(stderr, "Couldn't set up %u RPDO channels!\n", *pNodeCount);
+            result = -1;
+            goto Exit;
+        }
+
+        memset(aRxPdoBuffer_l, 0, sizeof(aRxPdoBuffer_l));
+        rxPdoCount_l = 0;
+        for (index = 0; index < *pNodeCount; index++)
+            pdok_processRxPdo(apFrame_l[index], frameSize);
+
+        if (checkRxPdos(*pNodeCount) != 0)
+        {
+            result = -1;
+            goto Exit;
+        }
+
+        startTime = oplkbench_getTimeNs();
+        for (loop = 0; loop < loops_p; loop++)
+        {
+            for (index = 0; index < *pNodeCount; index++)
+                pdok_processRxPdo(apFrame_l[index], frameSize);
+        }
+
+        snprintf(aName, sizeof(aName), "processRxPdo/%u", *pNodeCount);
+        oplkbench_printResult(aName, "cycle", oplkbench_getTimeNs() - startTime,
+                              loops_p, *pNodeCount, "frame");
+        pdok_exit();
+    }
+
+Exit:
+    for (index = 0; index < BENCHPDOK_MAX_NODE_COUNT; index++)
+    {
+        free(apFrame_l[index]);
+        apFrame_l[index] = NULL;
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+// Stubs for the interfaces of the kernel PDO module
+//------------------------------------------------------------------------------
+
+tOplkError pdokcal_init(void)
+{
+    return kErrorOk;
+}
+
+tOplkError pdokcal_exit(void)
+{
+    return kErrorOk;
+}
+
+tOplkError pdokcal_initPdoMem(tPdoChannelSetup* pPdoChannels, size_t rxPdoMemSize_p,
+                              size_t txPdoMemSize_p)
+{
+    UNUSED_PARAMETER(pPdoChannels);
+    UNUSED_PARAMETER(rxPdoMemSize_p);
+    UNUSED_PARAMETER(txPdoMemSize_p);
+
+    return kErrorOk;
+}
+
+void pdokcal_cleanupPdoMem(void)
+{
+}
+
+tOplkError pdokcal_writeRxPdo(UINT channelId_p, BYTE* pPayload_p, UINT16 pdoSize_p)
+{
+    if ((channelId_p >= BENCHPDOK_MAX_NODE_COUNT) || (pdoSize_p > BENCHPDOK_PDO_SIZE))
+        return kErrorPdoNotExist;
+
+    memcpy(aRxPdoBuffer_l[channelId_p], pPayload_p, pdoSize_p);
+    rxPdoCount_l++;
+    return kErrorOk;
+}
+
+tOplkError pdokcal_readTxPdo(UINT channelId_p, BYTE* pPayload_p, UINT16 pdoSize_p)
+{
+    UNUSED_PARAMETER(channelId_p);
+    UNUSED_PARAMETER(pPayload_p);
+    UNUSED_PARAMETER(pdoSize_p);
+
+    return kErrorOk;
+}
+
+tOplkError pdokcal_sendSyncEvent(void)
+{
+    return kErrorOk;
+}
+
+void dllk_regTpdoHandler(tDllkCbProcessTpdo pfnDllkCbProcessTpdo_p)
+{
+    UNUSED_PARAMETER(pfnDllkCbProcessTpdo_p);
+}
+
+tOplkError dllk_addNode(tDllNodeOpParam* pNodeOpParam_p)
+{
+    UNUSED_PARAMETER(pNodeOpParam_p);
+
+    return kErrorOk;
+}
+
+tOplkError dllk_deleteNode(tDllNodeOpParam* pNodeOpParam_p)
+{
+    UNUSED_PARAMETER(pNodeOpParam_p);
+
+    return kErrorOk;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set up the RPDO channels
+
+The function initializes the kernel PDO module and configures one RPDO
+channel for the PRes of each node.
+
+\param  nodeCount_p         Number of nodes.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError setupChannels(UINT nodeCount_p)
+{
+    tOplkError              ret;
+    tPdoAllocationParam     allocParam;
+    tPdoChannelConf         channelConf;
+    UINT                    channelId;
+
+    ret = pdok_init();
+    if (ret != kErrorOk)
+        return ret;
+
+    allocParam.rxPdoChannelCount = nodeCount_p;
+    allocParam.txPdoChannelCount = 0;
+    ret = pdok_allocChannelMem(&allocParam);
+    if (ret != kErrorOk)
+        return ret;
+
+    for (channelId = 0; channelId < nodeCount_p; channelId++)
+    {
+        memset(&channelConf, 0, sizeof(channelConf));
+        channelConf.channelId = channelId;
+        channelConf.fTx = FALSE;
+        channelConf.pdoChannel.nodeId = channelId + 1;
+        channelConf.pdoChannel.pdoSize = BENCHPDOK_PDO_SIZE;
+        channelConf.pdoChannel.mappingVersion = 0;
+        channelConf.pdoChannel.mappObjectCount = 1;
+
+        ret = pdok_configureChannel(&channelConf);
+        if (ret != kErrorOk)
+            return ret;
+    }
+
+    return pdok_setupPdoBuffers(0, 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check forwarded RPDOs
+
+The function checks that the RPDO of every node has been copied to the buffer
+of its channel.
+
+\param  nodeCount_p         Number of nodes.
+
+\return The function returns 0 if all RPDOs are correct, otherwise -1.
+*/
+//------------------------------------------------------------------------------
+static int checkRxPdos(UINT nodeCount_p)
+{
+    UINT    channelId;
+    UINT    index;
+
+    if (rxPdoCount_l != nodeCount_p)
+    {
+        fprintf(stderr, "%lu of %u RPDOs forwarded!\n", rxPdoCount_l, nodeCount_p);
+        return -1;
+    }
+
+    for (channelId = 0; channelId < nodeCount_p; channelId++)
+    {
+        for (index = 0; index < BENCHPDOK_PDO_SIZE; index++)
+        {
+            if (aRxPdoBuffer_l[channelId][index] != (UINT8)(channelId + 1))
+            {
+                fprintf(stderr, "RPDO of channel %u is wrong!\n", channelId);
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+///\}
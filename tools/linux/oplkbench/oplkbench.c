@@ -0,0 +1,213 @@
+/**
+********************************************************************************
+\file   oplkbench.c
+
+\brief  openPOWERLINK stack benchmark tool
+
+The tool measures the hot paths of the stack in isolation. The benchmarked
+stack sources are compiled into the tool, therefore it measures the code of
+the tree it is built from.
+
+Usage: oplkbench <benchmark> [loops]
+*******************************************************************************/
+
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2014, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "oplkbench.h"
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief Benchmark
+
+The structure describes a benchmark of the tool.
+*/
+typedef struct
+{
+    const char*     pName;                      ///< Name of the benchmark
+    const char*     pDescription;               ///< Description printed by the usage
+    int             (*pfnRun)(ULONG loops_p);   ///< Function running the benchmark
+} tBenchmark;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static const tBenchmark aBenchmark_l[] =
+{
+    {"ami", "byte order accessors and array conversion", benchami_run},
+    {"pdok", "kernel PDO RX forwarding", benchpdok_run},
+};
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void printUsage(const char* pProgName_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Main function
+
+\param  argc                Number of arguments.
+\param  argv                Pointer to argument strings.
+
+\return The function returns the exit code of the tool.
+*/
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    const tBenchmark*   pBenchmark;
+    ULONG               loops = OPLKBENCH_DEFAULT_LOOPS;
+    BOOL                fAll;
+
+    if ((argc < 2) || (argc > 3))
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (argc == 3)
+    {
+        loops = strtoul(argv[2], NULL, 0);
+        if (loops == 0)
+        {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    fAll = (strcmp(argv[1], "all") == 0);
+    for (pBenchmark = &aBenchmark_l[0];
+         pBenchmark < &aBenchmark_l[sizeof(aBenchmark_l) / sizeof(aBenchmark_l[0])];
+         pBenchmark++)
+    {
+        if (!fAll && (strcmp(argv[1], pBenchmark->pName) != 0))
+            continue;
+
+        if (pBenchmark->pfnRun(loops) != 0)
+            return EXIT_FAILURE;
+
+        if (!fAll)
+            return EXIT_SUCCESS;
+    }
+
+    if (!fAll)
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get monotonic time
+
+\return The function returns the monotonic time in ns.
+*/
+//------------------------------------------------------------------------------
+UINT64 oplkbench_getTimeNs(void)
+{
+    struct timespec     curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+    return ((UINT64)curTime.tv_sec * 1000000000ULL) + (UINT64)curTime.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Print benchmark result
+
+The function prints the time per loop and per processed element.
+
+\param  pName_p             Name of the benchmarked function.
+\param  pVariant_p          Name of the benchmarked variant.
+\param  timeNs_p            Measured time of all loops in ns.
+\param  loops_p             Number of loops.
+\param  elements_p          Number of elements processed by a loop.
+\param  pElementName_p      Name of the elements.
+*/
+//------------------------------------------------------------------------------
+void oplkbench_printResult(const char* pName_p, const char* pVariant_p,
+                           UINT64 timeNs_p, ULONG loops_p, UINT elements_p,
+                           const char* pElementName_p)
+{
+    double  loopNs = (double)timeNs_p / (double)loops_p;
+
+    printf("%-20s %-10s %10.1f ns/loop %8.2f ns/%s\n",
+           pName_p, pVariant_p, loopNs, loopNs / (double)elements_p, pElementName_p);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Print usage of the tool
+
+\param  pProgName_p         Name of the tool executable.
+*/
+//------------------------------------------------------------------------------
+static void printUsage(const char* pProgName_p)
+{
+    const tBenchmark*   pBenchmark;
+
+    fprintf(stderr, "Usage: %s <benchmark> [loops]\n\nBenchmarks:\n", pProgName_p);
+    fprintf(stderr, "  %-8s %s\n", "all", "run all benchmarks");
+    for (pBenchmark = &aBenchmark_l[0];
+         pBenchmark < &aBenchmark_l[sizeof(aBenchmark_l) / sizeof(aBenchmark_l[0])];
+         pBenchmark++)
+    {
+        fprintf(stderr, "  %-8s %s\n", pBenchmark->pName, pBenchmark->pDescription);
+    }
+    fprintf(stderr, "\nThe default number of loops is %u.\n", OPLKBENCH_DEFAULT_LOOPS);
+}
+
+///\}
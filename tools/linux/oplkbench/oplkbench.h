@@ -0,0 +1,99 @@
+/**
+********************************************************************************
+\file   oplkbench.h
+
+\brief  Definitions for the openPOWERLINK stack benchmark tool
+
+The file contains the definitions which are shared by the benchmarks of the
+stack benchmark tool.
+*******************************************************************************/
+
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2014, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+#ifndef _INC_oplkbench_H_
+#define _INC_oplkbench_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <oplk/oplkinc.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define OPLKBENCH_DEFAULT_LOOPS     1000000     ///< Default number of loops of a benchmark
+#define OPLKBENCH_AMI_ELEMENTS      64          ///< Number of values converted by an ami benchmark loop
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+/**
+\brief ami benchmark function
+
+The function converts \p count_p values between the process image
+\p pImage_p and the frame \p pFrame_p. The direction depends on the
+benchmarked accessor.
+*/
+typedef void (*tBenchAmiFunc)(void* pFrame_p, void* pImage_p, UINT count_p);
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+UINT64 oplkbench_getTimeNs(void);
+void   oplkbench_printResult(const char* pName_p, const char* pVariant_p,
+                             UINT64 timeNs_p, ULONG loops_p, UINT elements_p,
+                             const char* pElementName_p);
+
+int    benchami_run(ULONG loops_p);
+int    benchpdok_run(ULONG loops_p);
+
+// ami benchmark loops calling the exported accessor functions
+void   benchamicall_setUint16Le(void* pFrame_p, void* pImage_p, UINT count_p);
+void   benchamicall_setUint16Be(void* pFrame_p, void* pImage_p, UINT count_p);
+void   benchamicall_getUint16Le(void* pFrame_p, void* pImage_p, UINT count_p);
+void   benchamicall_getUint16Be(void* pFrame_p, void* pImage_p, UINT count_p);
+void   benchamicall_setUint32Le(void* pFrame_p, void* pImage_p, UINT count_p);
+void   benchamicall_setUint32Be(void* pFrame_p, void* pImage_p, UINT count_p);
+void   benchamicall_getUint32Le(void* pFrame_p, void* pImage_p, UINT count_p);
+void   benchamicall_getUint32Be(void* pFrame_p, void* pImage_p, UINT count_p);
+void   benchamicall_setUint64Le(void* pFrame_p, void* pImage_p, UINT count_p);
+void   benchamicall_setUint64Be(void* pFrame_p, void* pImage_p, UINT count_p);
+void   benchamicall_getUint64Le(void* pFrame_p, void* pImage_p, UINT count_p);
+void   benchamicall_getUint64Be(void* pFrame_p, void* pImage_p, UINT count_p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_oplkbench_H_ */
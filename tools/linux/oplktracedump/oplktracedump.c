@@ -0,0 +1,271 @@
+/**
+********************************************************************************
+\file   oplktracedump.c
+
+\brief  openPOWERLINK trace ring dump tool
+
+The tool reads the binary trace ring of a running openPOWERLINK process and
+prints the recorded trace events of all threads sorted by their timestamps.
+
+Usage: oplktracedump <pid>
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2014, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <oplk/tracering.h>
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief Dump entry
+
+The structure describes a trace entry copied from a ring buffer.
+*/
+typedef struct
+{
+    tTraceRingEntry     entry;                  ///< Copy of the trace entry
+    UINT32              threadId;               ///< Thread which recorded the entry
+} tDumpEntry;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static const char* aTraceIdName_l[kTraceIdCount] =
+{
+    "INVALID",
+    "SOC_TX",
+    "SOC_RX",
+    "FRAME_RX",
+    "FRAME_TX",
+    "EVENT_POST_K",
+    "EVENT_POST_U",
+    "PDO_RX_COPY",
+    "PDO_TX_COPY",
+    "SYNC_SIGNAL",
+    "SYNC_WAKEUP",
+};
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static UINT copyRing(const tTraceRingHeader* pHeader_p, UINT index_p, tDumpEntry* pDest_p);
+static int  compareEntries(const void* pA_p, const void* pB_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Main function
+
+\param  argc                Number of arguments.
+\param  argv                Pointer to argument strings.
+
+\return The function returns the exit code of the tool.
+*/
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    char                aShmName[32];
+    int                 fd;
+    struct stat         shmStat;
+    tTraceRingHeader*   pHeader;
+    tDumpEntry*         pEntries;
+    UINT                entryCount = 0;
+    UINT                ringCount;
+    UINT                index;
+    UINT64              firstTimestamp;
+
+    if (argc != 2)
+    {
+        fprintf(stderr, "Usage: %s <pid>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    snprintf(aShmName, sizeof(aShmName), TRACERING_SHM_NAME_FORMAT, atoi(argv[1]));
+    if ((fd = shm_open(aShmName, O_RDONLY, 0)) < 0)
+    {
+        fprintf(stderr, "Couldn't open trace ring %s!\n", aShmName);
+        return EXIT_FAILURE;
+    }
+
+    if ((fstat(fd, &shmStat) != 0) || ((size_t)shmStat.st_size < sizeof(tTraceRingHeader)))
+    {
+        fprintf(stderr, "Invalid trace ring %s!\n", aShmName);
+        close(fd);
+        return EXIT_FAILURE;
+    }
+
+    pHeader = (tTraceRingHeader*)mmap(NULL, shmStat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (pHeader == MAP_FAILED)
+    {
+        fprintf(stderr, "Couldn't map trace ring %s!\n", aShmName);
+        return EXIT_FAILURE;
+    }
+
+    if ((pHeader->magic != TRACERING_MAGIC) || (pHeader->version != TRACERING_VERSION) ||
+        ((size_t)shmStat.st_size < sizeof(tTraceRingHeader) +
+                                   (pHeader->ringCount * TRACERING_BUFFER_SIZE(pHeader->entryCount))))
+    {
+        fprintf(stderr, "Trace ring %s has an unsupported layout!\n", aShmName);
+        munmap(pHeader, shmStat.st_size);
+        return EXIT_FAILURE;
+    }
+
+    ringCount = pHeader->usedRingCount;
+    if (ringCount > pHeader->ringCount)
+        ringCount = pHeader->ringCount;
+
+    pEntries = (tDumpEntry*)malloc(ringCount * pHeader->entryCount * sizeof(tDumpEntry) + 1);
+    if (pEntries == NULL)
+    {
+        munmap(pHeader, shmStat.st_size);
+        return EXIT_FAILURE;
+    }
+
+    for (index = 0; index < ringCount; index++)
+        entryCount += copyRing(pHeader, index, &pEntries[entryCount]);
+
+    qsort(pEntries, entryCount, sizeof(tDumpEntry), compareEntries);
+
+    printf("# %u events of %u threads, timestamps in %s\n", entryCount, ringCount,
+           (pHeader->timestampType == TRACERING_TIMESTAMP_TSC) ? "TSC ticks" : "ns");
+    printf("# time thread event arg\n");
+
+    firstTimestamp = (entryCount > 0) ? pEntries[0].entry.timestamp : 0;
+    for (index = 0; index < entryCount; index++)
+    {
+        UINT traceId = pEntries[index].entry.traceId;
+
+        printf("%12llu %6u %-14s 0x%08X\n",
+               (unsigned long long)(pEntries[index].entry.timestamp - firstTimestamp),
+               pEntries[index].threadId,
+               (traceId < kTraceIdCount) ? aTraceIdName_l[traceId] : "UNKNOWN",
+               pEntries[index].entry.arg);
+    }
+
+    free(pEntries);
+    munmap(pHeader, shmStat.st_size);
+    return EXIT_SUCCESS;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Copy the entries of a ring buffer
+
+The function copies the valid entries of a ring buffer. As the owning thread
+may continue writing, entries which could have been overwritten while copying
+are dropped.
+
+\param  pHeader_p           Pointer to the trace ring header.
+\param  index_p             Index of the ring buffer.
+\param  pDest_p             Pointer to store the entries.
+
+\return The function returns the number of copied entries.
+*/
+//------------------------------------------------------------------------------
+static UINT copyRing(const tTraceRingHeader* pHeader_p, UINT index_p, tDumpEntry* pDest_p)
+{
+    const tTraceRingBuffer* pRing = TRACERING_GET_BUFFER(pHeader_p, index_p);
+    const tTraceRingEntry*  pRingEntries = (const tTraceRingEntry*)(pRing + 1);
+    UINT32                  entryCount = pHeader_p->entryCount;
+    UINT32                  writeCount;
+    UINT32                  firstCount;
+    UINT32                  count;
+    UINT                    copied = 0;
+
+    writeCount = __atomic_load_n(&pRing->writeCount, __ATOMIC_ACQUIRE);
+    firstCount = (writeCount > entryCount) ? (writeCount - entryCount) : 0;
+
+    for (count = firstCount; count != writeCount; count++)
+    {
+        pDest_p[copied].entry = pRingEntries[count & (entryCount - 1)];
+        pDest_p[copied].threadId = pRing->threadId;
+        copied++;
+    }
+
+    // drop the entries which have been overwritten meanwhile
+    writeCount = __atomic_load_n(&pRing->writeCount, __ATOMIC_ACQUIRE);
+    if (writeCount - firstCount > entryCount)
+    {
+        count = writeCount - firstCount - entryCount;
+        if (count > copied)
+            count = copied;
+        memmove(pDest_p, pDest_p + count, (copied - count) * sizeof(tDumpEntry));
+        copied -= count;
+    }
+
+    return copied;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Compare the timestamps of two entries
+
+\param  pA_p                Pointer to first entry.
+\param  pB_p                Pointer to second entry.
+
+\return The function returns the comparison result for qsort().
+*/
+//------------------------------------------------------------------------------
+static int compareEntries(const void* pA_p, const void* pB_p)
+{
+    UINT64  timestampA = ((const tDumpEntry*)pA_p)->entry.timestamp;
+    UINT64  timestampB = ((const tDumpEntry*)pB_p)->entry.timestamp;
+
+    if (timestampA < timestampB)
+        return -1;
+    return (timestampA > timestampB) ? 1 : 0;
+}
+
+///\}